@@ -25,8 +25,8 @@ public class BallMovement : MonoBehaviour
     {
         if (!gameEnded)
         {
-            movement = VectorMath.VectorScale2D(direction, speed * Time.deltaTime);
-            position = VectorMath.VectorAdd2D(position, movement);
+            movement = VectorMathNative.VectorScale2D(direction, speed * Time.deltaTime);
+            position = VectorMathNative.VectorAdd2D(position, movement);
             transform.position = position.ToUnityVector2();
         }
     }
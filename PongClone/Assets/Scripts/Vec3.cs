@@ -61,3 +61,142 @@ public struct Vec2
     
     
 }
+
+[StructLayout((LayoutKind.Sequential))]
+public struct RayHit
+{
+    public int id;          //-1 when nothing was hit
+    public float distance;  //in units of the ray direction
+}
+
+[StructLayout((LayoutKind.Sequential))]
+public struct SweepHit2D
+{
+    public float time;      //fraction of the motion before contact, 1 on a miss
+    public Vec2 normal;     //zero on a miss
+}
+
+//Shortest and longest vector of an array (VectorMathMagnitudeRange)
+[StructLayout(LayoutKind.Sequential)]
+public struct MagnitudeRange
+{
+    public float minMagnitude;
+    public float maxMagnitude;
+    public System.UIntPtr minIndex;    //all bits set when the array was empty
+    public System.UIntPtr maxIndex;
+}
+
+//One recorded array of a snapshot file (VectorMathSnapshotChannel)
+[StructLayout(LayoutKind.Sequential, CharSet = CharSet.Ansi)]
+public struct SnapshotChannel
+{
+    [MarshalAs(UnmanagedType.ByValTStr, SizeConst = 32)]
+    public string name;
+    public uint components; //1 = float, 2 = Vec2, 3 = Vec3
+    public uint count;      //elements per frame
+    public uint encoding;   //0 = raw floats, 1 = delta of values rounded to step
+    public float step;
+}
+
+//16-byte vectors matching Vec4 / Vec3A in VectorMath.h (one SIMD register each)
+[StructLayout(LayoutKind.Sequential, Size = 16)]
+public struct Vec4
+{
+    public float x;
+    public float y;
+    public float z;
+    public float w;
+
+    public Vec4(float x, float y, float z, float w)
+    {
+        this.x = x;
+        this.y = y;
+        this.z = z;
+        this.w = w;
+    }
+
+    public static Vec4 FromUnityVector4(Vector4 v)
+    {
+        return new Vec4(v.x, v.y, v.z, v.w);
+    }
+
+    public Vector4 ToUnityVector4()
+    {
+        return new Vector4(x, y, z, w);
+    }
+}
+
+[StructLayout(LayoutKind.Sequential, Size = 16)]
+public struct Vec3A
+{
+    public float x;
+    public float y;
+    public float z;
+    public float pad;       //not part of the vector
+
+    public Vec3A(float x, float y, float z)
+    {
+        this.x = x;
+        this.y = y;
+        this.z = z;
+        this.pad = 0.0f;
+    }
+
+    public static Vec3A FromUnityVector3(Vector3 v)
+    {
+        return new Vec3A(v.x, v.y, v.z);
+    }
+
+    public Vector3 ToUnityVector3()
+    {
+        return new Vector3(x, y, z);
+    }
+}
+
+//Double precision vectors for positions far from the origin
+[StructLayout((LayoutKind.Sequential))]
+public struct Vec2d
+{
+    public double x;
+    public double y;
+
+    public Vec2d(double x, double y)
+    {
+        this.x = x;
+        this.y = y;
+    }
+}
+
+[StructLayout((LayoutKind.Sequential))]
+public struct Vec3d
+{
+    public double x;
+    public double y;
+    public double z;
+
+    public Vec3d(double x, double y, double z)
+    {
+        this.x = x;
+        this.y = y;
+        this.z = z;
+    }
+
+    public override string ToString()
+    {
+        return $"({x}, {y}, {z})";
+    }
+}
+
+//16-bit storage only, convert with VectorMath.VectorFromHalf2D / ConvertHalfToFloat
+[StructLayout((LayoutKind.Sequential))]
+public struct Half
+{
+    public ushort bits;
+}
+
+[StructLayout((LayoutKind.Sequential))]
+public struct Vec2h
+{
+    public Half x;
+    public Half y;
+}
@@ -1,3 +1,4 @@
+using System;
 using System.Runtime.InteropServices;
 
 public static class VectorMath
@@ -23,6 +24,9 @@ public static class VectorMath
     [DllImport(DllName)]
     public static extern Vec2 VectorNormalize2D(Vec2 v);
 
+    [DllImport(DllName)]
+    public static extern Vec2 VectorNormalizeFast2D(Vec2 v);
+
     [DllImport(DllName)]
     public static extern float VectorDot2D(Vec2 a, Vec2 b);
     
@@ -45,6 +49,9 @@ public static class VectorMath
     [DllImport(DllName)]
     public static extern Vec3 VectorNormalize(Vec3 v);
 
+    [DllImport(DllName)]
+    public static extern Vec3 VectorNormalizeFast(Vec3 v);
+
     [DllImport(DllName)]
     public static extern float VectorDot(Vec3 a, Vec3 b);
 
@@ -79,4 +86,398 @@ public static class VectorMath
 
     [DllImport(DllName)]
     public static extern Vec2 VectorClamp2D(Vec2 v, float minVal, float maxVal);
+
+    //Fused Operations (same results as the separate calls, in one step)
+    [DllImport(DllName)]
+    public static extern Vec2 VectorScaleAdd2D(Vec2 a, Vec2 b, float scale);
+
+    [DllImport(DllName)]
+    public static extern Vec3 VectorScaleAdd(Vec3 a, Vec3 b, float scale);
+
+    [DllImport(DllName)]
+    public static extern Vec2 VectorMulAdd2D(Vec2 a, Vec2 b, Vec2 c);
+
+    [DllImport(DllName)]
+    public static extern Vec3 VectorMulAdd(Vec3 a, Vec3 b, Vec3 c);
+
+    [DllImport(DllName)]
+    public static extern Vec2 VectorLerpClamp2D(Vec2 a, Vec2 b, float t, float minVal, float maxVal);
+
+    [DllImport(DllName)]
+    public static extern Vec3 VectorLerpClamp(Vec3 a, Vec3 b, float t, float minVal, float maxVal);
+
+    [DllImport(DllName)]
+    public static extern Vec2 VectorClampMagnitudeRange2D(Vec2 v, float minLength, float maxLength);
+
+    [DllImport(DllName)]
+    public static extern Vec3 VectorClampMagnitudeRange(Vec3 v, float minLength, float maxLength);
+
+    //Aligned Vectors (passed by ref like the C pointers)
+    [DllImport(DllName)]
+    public static extern void VectorAdd4D(ref Vec4 a, ref Vec4 b, out Vec4 result);
+
+    [DllImport(DllName)]
+    public static extern float VectorDot4D(ref Vec4 a, ref Vec4 b);
+
+    [DllImport(DllName)]
+    public static extern void VectorNormalize4D(ref Vec4 v, out Vec4 result);
+
+    [DllImport(DllName)]
+    public static extern void VectorAdd3A(ref Vec3A a, ref Vec3A b, out Vec3A result);
+
+    [DllImport(DllName)]
+    public static extern float VectorDot3A(ref Vec3A a, ref Vec3A b);
+
+    [DllImport(DllName)]
+    public static extern void VectorCross3A(ref Vec3A a, ref Vec3A b, out Vec3A result);
+
+    [DllImport(DllName)]
+    public static extern void VectorNormalize3A(ref Vec3A v, out Vec3A result);
+
+    [DllImport(DllName)]
+    public static extern float VectorMagnitude3A(ref Vec3A v);
+
+    [DllImport(DllName)]
+    public static extern void VectorNormalize3AArray(Vec3A[] v, [Out] Vec3A[] result, UIntPtr n);
+
+    [DllImport(DllName)]
+    public static extern void VectorDot3AArray(Vec3A[] a, Vec3A[] b, [Out] float[] result, UIntPtr n);
+
+    [DllImport(DllName)]
+    public static extern void VectorCross3AArray(Vec3A[] a, Vec3A[] b, [Out] Vec3A[] result, UIntPtr n);
+
+    [DllImport(DllName)]
+    public static extern void VectorNormalize4DArray(Vec4[] v, [Out] Vec4[] result, UIntPtr n);
+
+    //Double Precision
+    [DllImport(DllName)]
+    public static extern Vec2d VectorAdd2DDouble(Vec2d a, Vec2d b);
+
+    [DllImport(DllName)]
+    public static extern Vec2d VectorSubtract2DDouble(Vec2d a, Vec2d b);
+
+    [DllImport(DllName)]
+    public static extern double VectorMagnitude2DDouble(Vec2d v);
+
+    [DllImport(DllName)]
+    public static extern Vec2d VectorNormalize2DDouble(Vec2d v);
+
+    [DllImport(DllName)]
+    public static extern Vec3d VectorAddDouble(Vec3d a, Vec3d b);
+
+    [DllImport(DllName)]
+    public static extern Vec3d VectorSubtractDouble(Vec3d a, Vec3d b);
+
+    [DllImport(DllName)]
+    public static extern Vec3d VectorScaleDouble(Vec3d v, double scale);
+
+    [DllImport(DllName)]
+    public static extern double VectorMagnitudeDouble(Vec3d v);
+
+    [DllImport(DllName)]
+    public static extern Vec3d VectorNormalizeDouble(Vec3d v);
+
+    [DllImport(DllName)]
+    public static extern Vec3d VectorLerpDouble(Vec3d a, Vec3d b, double t);
+
+    [DllImport(DllName)]
+    public static extern Vec3d VectorToDouble(Vec3 v);
+
+    [DllImport(DllName)]
+    public static extern Vec3 VectorFromDouble(Vec3d v);
+
+    //Precision Conversion (flat arrays; a Vec2/Vec3 array is 2n/3n values)
+    [DllImport(DllName)]
+    public static extern void ConvertFloatToHalf(float[] input, [Out] Half[] output, UIntPtr n);
+
+    [DllImport(DllName)]
+    public static extern void ConvertHalfToFloat(Half[] input, [Out] float[] output, UIntPtr n);
+
+    [DllImport(DllName)]
+    public static extern Vec2h VectorToHalf2D(Vec2 v);
+
+    [DllImport(DllName)]
+    public static extern Vec2 VectorFromHalf2D(Vec2h v);
+
+    //Physics Integration (whole arrays updated in place, accelerations may be null)
+    [DllImport(DllName)]
+    public static extern void IntegrateBodies2D([In, Out] Vec2[] positions, [In, Out] Vec2[] velocities, Vec2[] accelerations, UIntPtr n, float dt);
+
+    [DllImport(DllName)]
+    public static extern void IntegrateBodiesVerlet2D([In, Out] Vec2[] positions, [In, Out] Vec2[] previousPositions, Vec2[] accelerations, UIntPtr n, float dt);
+
+    //Collision Response (velocities updated in place, mask may be null)
+    public const int ReflectDefault = 0;
+    public const int ReflectUnitNormals = 1;
+
+    [DllImport(DllName)]
+    public static extern void VectorReflectResponse2DArray([In, Out] Vec2[] velocities, Vec2[] normals, byte[] mask, UIntPtr n, float restitution, float friction, int flags);
+
+    //Swept Collision (return 1 on a hit)
+    [DllImport(DllName)]
+    public static extern int SweepCircleSegment2D(Vec2 center, float radius, Vec2 motion, Vec2 segmentStart, Vec2 segmentEnd, out SweepHit2D hit);
+
+    [DllImport(DllName)]
+    public static extern int SweepCircleAABB2D(Vec2 center, float radius, Vec2 motion, Vec2 boxMin, Vec2 boxMax, out SweepHit2D hit);
+
+    [DllImport(DllName)]
+    public static extern int RayAABB2D(Vec2 origin, Vec2 motion, Vec2 boxMin, Vec2 boxMax, out SweepHit2D hit);
+
+    [DllImport(DllName)]
+    public static extern int SegmentIntersect2D(Vec2 start, Vec2 end, Vec2 otherStart, Vec2 otherEnd, out SweepHit2D hit);
+
+    [DllImport(DllName)]
+    public static extern void SweepCircleAABB2DArray(Vec2[] centers, float[] radii, Vec2[] motions, Vec2[] boxMin, Vec2[] boxMax, [Out] SweepHit2D[] hits, UIntPtr n);
+
+    //Spatial Hash Grid (the grid is an opaque native handle, free it with SpatialGrid2DDestroy)
+    [DllImport(DllName)]
+    public static extern IntPtr SpatialGrid2DCreate(float cellSize);
+
+    [DllImport(DllName)]
+    public static extern void SpatialGrid2DDestroy(IntPtr grid);
+
+    [DllImport(DllName)]
+    public static extern void SpatialGrid2DBuild(IntPtr grid, Vec2[] positions, UIntPtr n);
+
+    [DllImport(DllName)]
+    public static extern void SpatialGrid2DUpdate(IntPtr grid, Vec2[] positions, UIntPtr n);
+
+    [DllImport(DllName)]
+    public static extern UIntPtr SpatialGrid2DQueryRadius(IntPtr grid, Vec2 center, float radius, [Out] int[] outIds, UIntPtr capacity);
+
+    [DllImport(DllName)]
+    public static extern UIntPtr SpatialGrid2DQueryAABB(IntPtr grid, Vec2 boxMin, Vec2 boxMax, [Out] int[] outIds, UIntPtr capacity);
+
+    [DllImport(DllName)]
+    public static extern UIntPtr SpatialGrid2DQueryPairs(IntPtr grid, float distance, [Out] int[] outPairs, UIntPtr capacity);
+
+    //Bounding Volume Hierarchy (opaque native handle, free it with Bvh3DDestroy)
+    [DllImport(DllName)]
+    public static extern IntPtr Bvh3DCreate();
+
+    [DllImport(DllName)]
+    public static extern void Bvh3DDestroy(IntPtr bvh);
+
+    [DllImport(DllName)]
+    public static extern void Bvh3DBuild(IntPtr bvh, Vec3[] boxMin, Vec3[] boxMax, UIntPtr n);
+
+    [DllImport(DllName)]
+    public static extern void Bvh3DBuildSpheres(IntPtr bvh, Vec3[] centers, float[] radii, UIntPtr n);
+
+    [DllImport(DllName)]
+    public static extern void Bvh3DRefit(IntPtr bvh, Vec3[] boxMin, Vec3[] boxMax);
+
+    [DllImport(DllName)]
+    public static extern void Bvh3DRefitSpheres(IntPtr bvh, Vec3[] centers, float[] radii);
+
+    [DllImport(DllName)]
+    public static extern int Bvh3DRaycast(IntPtr bvh, Vec3 origin, Vec3 direction, float maxDistance, out RayHit hit);
+
+    [DllImport(DllName)]
+    public static extern void Bvh3DRaycastBatch(IntPtr bvh, Vec3[] origins, Vec3[] directions, UIntPtr n, float maxDistance, [Out] RayHit[] hits);
+
+    [DllImport(DllName)]
+    public static extern UIntPtr Bvh3DOverlapSphere(IntPtr bvh, Vec3 center, float radius, [Out] int[] outIds, UIntPtr capacity);
+
+    [DllImport(DllName)]
+    public static extern UIntPtr Bvh3DOverlapAABB(IntPtr bvh, Vec3 boxMin, Vec3 boxMax, [Out] int[] outIds, UIntPtr capacity);
+
+    //Reductions (mode: 0 = pairwise, 1 = Kahan; bit-identical on every CPU and thread count)
+    [DllImport(DllName)]
+    public static extern void VectorBounds2DArray(Vec2[] v, UIntPtr n, out Vec2 outMin, out Vec2 outMax);
+
+    [DllImport(DllName)]
+    public static extern void VectorBoundsArray(Vec3[] v, UIntPtr n, out Vec3 outMin, out Vec3 outMax);
+
+    [DllImport(DllName)]
+    public static extern Vec2 VectorSum2DArray(Vec2[] v, UIntPtr n, int mode);
+
+    [DllImport(DllName)]
+    public static extern Vec3 VectorSumArray(Vec3[] v, UIntPtr n, int mode);
+
+    [DllImport(DllName)]
+    public static extern Vec2 VectorCentroid2DArray(Vec2[] v, UIntPtr n);
+
+    [DllImport(DllName)]
+    public static extern Vec3 VectorCentroidArray(Vec3[] v, UIntPtr n);
+
+    [DllImport(DllName)]
+    public static extern float VectorDotTotal2DArray(Vec2[] a, Vec2[] b, UIntPtr n, int mode);
+
+    [DllImport(DllName)]
+    public static extern float VectorDotTotalArray(Vec3[] a, Vec3[] b, UIntPtr n, int mode);
+
+    [DllImport(DllName)]
+    public static extern void VectorMagnitudeRange2DArray(Vec2[] v, UIntPtr n, out MagnitudeRange range);
+
+    [DllImport(DllName)]
+    public static extern void VectorMagnitudeRangeArray(Vec3[] v, UIntPtr n, out MagnitudeRange range);
+
+    //Curves (type: 0 = Bezier, 1 = Catmull-Rom, 2 = Hermite; t in [0, 1] over the whole curve)
+    [DllImport(DllName)]
+    public static extern int VectorCurveEvaluate2D(int type, Vec2[] points, UIntPtr pointsPerCurve, UIntPtr curveCount, float[] t, UIntPtr tCount, [Out] Vec2[] output);
+
+    [DllImport(DllName)]
+    public static extern int VectorCurveEvaluate3D(int type, Vec3[] points, UIntPtr pointsPerCurve, UIntPtr curveCount, float[] t, UIntPtr tCount, [Out] Vec3[] output);
+
+    [DllImport(DllName)]
+    public static extern IntPtr Curve2DCreate(int type, Vec2[] points, UIntPtr pointCount, UIntPtr samplesPerSegment);
+
+    [DllImport(DllName)]
+    public static extern void Curve2DDestroy(IntPtr curve);
+
+    [DllImport(DllName)]
+    public static extern void Curve2DUpdate(IntPtr curve, Vec2[] points);
+
+    [DllImport(DllName)]
+    public static extern float Curve2DLength(IntPtr curve);
+
+    [DllImport(DllName)]
+    public static extern void Curve2DSample(IntPtr curve, float[] t, [Out] Vec2[] output, UIntPtr n);
+
+    [DllImport(DllName)]
+    public static extern void Curve2DSampleDistance(IntPtr curve, float[] distances, [Out] Vec2[] output, UIntPtr n);
+
+    [DllImport(DllName)]
+    public static extern void Curve2DParameterAtDistance(IntPtr curve, float[] distances, [Out] float[] outT, UIntPtr n);
+
+    [DllImport(DllName)]
+    public static extern IntPtr Curve3DCreate(int type, Vec3[] points, UIntPtr pointCount, UIntPtr samplesPerSegment);
+
+    [DllImport(DllName)]
+    public static extern void Curve3DDestroy(IntPtr curve);
+
+    [DllImport(DllName)]
+    public static extern void Curve3DUpdate(IntPtr curve, Vec3[] points);
+
+    [DllImport(DllName)]
+    public static extern float Curve3DLength(IntPtr curve);
+
+    [DllImport(DllName)]
+    public static extern void Curve3DSample(IntPtr curve, float[] t, [Out] Vec3[] output, UIntPtr n);
+
+    [DllImport(DllName)]
+    public static extern void Curve3DSampleDistance(IntPtr curve, float[] distances, [Out] Vec3[] output, UIntPtr n);
+
+    [DllImport(DllName)]
+    public static extern void Curve3DParameterAtDistance(IntPtr curve, float[] distances, [Out] float[] outT, UIntPtr n);
+
+    //Spatial Sorting (permutation[i] = old index of the element moved to i; outPositions may be null)
+    [DllImport(DllName)]
+    public static extern void VectorMortonSort2D(Vec2[] positions, [Out] uint[] outPermutation, [Out] Vec2[] outPositions, UIntPtr n);
+
+    [DllImport(DllName)]
+    public static extern void VectorMortonSort3D(Vec3[] positions, [Out] uint[] outPermutation, [Out] Vec3[] outPositions, UIntPtr n);
+
+    [DllImport(DllName)]
+    public static extern void VectorRadixSortKeys(uint[] keys, [Out] uint[] outPermutation, UIntPtr n);
+
+    [DllImport(DllName)]
+    public static extern void VectorReorder2DArray(Vec2[] input, uint[] permutation, [Out] Vec2[] output, UIntPtr n);
+
+    [DllImport(DllName)]
+    public static extern void VectorReorderArray(Vec3[] input, uint[] permutation, [Out] Vec3[] output, UIntPtr n);
+
+    [DllImport(DllName)]
+    public static extern void VectorReorderFloatArray(float[] input, uint[] permutation, [Out] float[] output, UIntPtr n);
+
+    //Snapshots (record per-frame arrays for replays; the writer encodes and writes on its own thread)
+    [DllImport(DllName)]
+    public static extern IntPtr SnapshotWriterCreate(string path, SnapshotChannel[] channels, UIntPtr channelCount, uint framesPerChunk);
+
+    [DllImport(DllName, EntryPoint = "SnapshotWriterWrite")]
+    public static extern int SnapshotWriterWrite2D(IntPtr writer, UIntPtr channel, Vec2[] values);
+
+    [DllImport(DllName, EntryPoint = "SnapshotWriterWrite")]
+    public static extern int SnapshotWriterWrite3D(IntPtr writer, UIntPtr channel, Vec3[] values);
+
+    [DllImport(DllName)]
+    public static extern int SnapshotWriterEndFrame(IntPtr writer);
+
+    [DllImport(DllName)]
+    public static extern int SnapshotWriterClose(IntPtr writer);
+
+    [DllImport(DllName)]
+    public static extern IntPtr SnapshotReaderOpen(string path);
+
+    [DllImport(DllName)]
+    public static extern void SnapshotReaderClose(IntPtr reader);
+
+    [DllImport(DllName)]
+    public static extern ulong SnapshotReaderFrameCount(IntPtr reader);
+
+    [DllImport(DllName)]
+    public static extern int SnapshotReaderFindChannel(IntPtr reader, string name);
+
+    [DllImport(DllName, EntryPoint = "SnapshotReaderRead")]
+    public static extern UIntPtr SnapshotReaderRead2D(IntPtr reader, UIntPtr channel, ulong firstFrame, UIntPtr frameCount, [Out] Vec2[] output);
+
+    [DllImport(DllName, EntryPoint = "SnapshotReaderRead")]
+    public static extern UIntPtr SnapshotReaderRead3D(IntPtr reader, UIntPtr channel, ulong firstFrame, UIntPtr frameCount, [Out] Vec3[] output);
+
+    //1 when the DLL was built with VECTORMATH_DETERMINISTIC (bit-identical results on every machine)
+    [DllImport(DllName)]
+    public static extern int VectorMathIsDeterministic();
+
+    //Threading (0 = one thread per CPU, 1 = single threaded)
+    [DllImport(DllName)]
+    public static extern void VectorMathSetThreadCount(int count);
+
+    [DllImport(DllName)]
+    public static extern int VectorMathGetThreadCount();
+
+    [DllImport(DllName)]
+    public static extern void VectorMathSetParallelThreshold(UIntPtr minElements);
+
+    [DllImport(DllName)]
+    public static extern void VectorMathSetThreadPinning(int enabled);
+
+    //Joins the worker threads. Called by ShutdownOnUnload below; call it
+    //yourself before unloading the DLL any other way
+    [DllImport(DllName)]
+    public static extern void VectorMathShutdownThreads();
+
+    //The DLL cannot join its workers while it is being unloaded, so the pool is
+    //stopped while it is still loaded: when the application quits and before
+    //the editor reloads scripts
+    [UnityEngine.RuntimeInitializeOnLoadMethod(UnityEngine.RuntimeInitializeLoadType.SubsystemRegistration)]
+    private static void ShutdownOnUnload()
+    {
+        UnityEngine.Application.quitting -= VectorMathShutdownThreads;
+        UnityEngine.Application.quitting += VectorMathShutdownThreads;
+        AppDomain.CurrentDomain.DomainUnload -= OnDomainUnload;
+        AppDomain.CurrentDomain.DomainUnload += OnDomainUnload;
+    }
+
+    private static void OnDomainUnload(object sender, EventArgs args)
+    {
+        VectorMathShutdownThreads();
+    }
+
+    //Frame Arena (per-thread scratch memory, emptied by Begin and End)
+    [DllImport(DllName)]
+    public static extern void VectorMathFrameBegin();
+
+    [DllImport(DllName)]
+    public static extern void VectorMathFrameEnd();
+
+    [DllImport(DllName)]
+    public static extern IntPtr VectorMathFrameAlloc(UIntPtr size, UIntPtr alignment);
+
+    [DllImport(DllName)]
+    public static extern void VectorMathSetFrameArenaCapacity(UIntPtr bytesPerThread);
+
+    //Instrumentation (DLL built with VECTORMATH_ENABLE_STATS; otherwise empty)
+    [DllImport(DllName)]
+    public static extern int VectorMathStatsEnabled();
+
+    [DllImport(DllName)]
+    public static extern void VectorMathResetStats();
+
+    //UTF-8 JSON, returns the full length (call with null / 0 to size the buffer)
+    [DllImport(DllName)]
+    public static extern UIntPtr VectorMathGetStatsJson(byte[] buffer, UIntPtr capacity);
+
+    [DllImport(DllName)]
+    public static extern int VectorMathWriteStatsJson(string path);
 }
\ No newline at end of file
@@ -0,0 +1,355 @@
+using System;
+using System.Runtime.InteropServices;
+using Unity.Collections;
+using Unity.Collections.LowLevel.Unsafe;
+
+//Zero-copy entry points for the per-frame path.
+//The array functions take raw pointers, so NativeArray and Span data goes
+//straight to the DLL without the marshaller copying or pinning arrays and
+//without managed allocations. The short scalar functions are marked
+//SuppressGCTransition: they never block, allocate or call back into managed
+//code, so the runtime can call them like a plain function.
+//Requires "Allow unsafe code" in the Player settings.
+public static unsafe class VectorMathNative
+{
+    private const string DllName = "VectorMathematics";
+
+    //Scalar Operations (same names as in VectorMath, without the GC transition)
+    [DllImport(DllName), SuppressGCTransition]
+    public static extern Vec2 VectorAdd2D(Vec2 a, Vec2 b);
+
+    [DllImport(DllName), SuppressGCTransition]
+    public static extern Vec2 VectorSubtract2D(Vec2 a, Vec2 b);
+
+    [DllImport(DllName), SuppressGCTransition]
+    public static extern Vec2 VectorScale2D(Vec2 v, float scale);
+
+    [DllImport(DllName), SuppressGCTransition]
+    public static extern float VectorMagnitude2D(Vec2 v);
+
+    [DllImport(DllName), SuppressGCTransition]
+    public static extern Vec2 VectorNormalize2D(Vec2 v);
+
+    [DllImport(DllName), SuppressGCTransition]
+    public static extern float VectorDot2D(Vec2 a, Vec2 b);
+
+    [DllImport(DllName), SuppressGCTransition]
+    public static extern Vec2 VectorReflect2D(Vec2 v, Vec2 normal);
+
+    [DllImport(DllName), SuppressGCTransition]
+    public static extern Vec2 VectorClampMagnitude2D(Vec2 v, float maxLength);
+
+    [DllImport(DllName), SuppressGCTransition]
+    public static extern Vec2 VectorScaleAdd2D(Vec2 a, Vec2 b, float scale);
+
+    [DllImport(DllName), SuppressGCTransition]
+    public static extern Vec2 VectorClampMagnitudeRange2D(Vec2 v, float minLength, float maxLength);
+
+    [DllImport(DllName), SuppressGCTransition]
+    public static extern Vec3 VectorAdd(Vec3 a, Vec3 b);
+
+    [DllImport(DllName), SuppressGCTransition]
+    public static extern Vec3 VectorScale(Vec3 v, float scale);
+
+    [DllImport(DllName), SuppressGCTransition]
+    public static extern Vec3 VectorNormalize(Vec3 v);
+
+    [DllImport(DllName), SuppressGCTransition]
+    public static extern float Clamp(float v, float minVal, float maxVal);
+
+    [DllImport(DllName), SuppressGCTransition]
+    public static extern int SweepCircleAABB2D(Vec2 center, float radius, Vec2 motion, Vec2 boxMin, Vec2 boxMax, SweepHit2D* hit);
+
+
+    //Pointer Entry Points (out may alias an input)
+    [DllImport(DllName)]
+    public static extern void VectorAdd2DArray(Vec2* a, Vec2* b, Vec2* output, UIntPtr n);
+
+    [DllImport(DllName)]
+    public static extern void VectorScale2DArray(Vec2* v, float scale, Vec2* output, UIntPtr n);
+
+    [DllImport(DllName)]
+    public static extern void VectorNormalize2DArray(Vec2* v, Vec2* output, UIntPtr n);
+
+    [DllImport(DllName)]
+    public static extern void VectorReflect2DArray(Vec2* v, Vec2* normals, Vec2* output, UIntPtr n);
+
+    [DllImport(DllName)]
+    public static extern void VectorClampMagnitude2DArray(Vec2* v, float maxLength, Vec2* output, UIntPtr n);
+
+    [DllImport(DllName)]
+    public static extern void VectorScaleAdd2DArray(Vec2* a, Vec2* b, float scale, Vec2* output, UIntPtr n);
+
+    [DllImport(DllName)]
+    public static extern void VectorClampMagnitudeRange2DArray(Vec2* v, float minLength, float maxLength, Vec2* output, UIntPtr n);
+
+    [DllImport(DllName)]
+    public static extern void VectorAddArray(Vec3* a, Vec3* b, Vec3* output, UIntPtr n);
+
+    [DllImport(DllName)]
+    public static extern void VectorScaleArray(Vec3* v, float scale, Vec3* output, UIntPtr n);
+
+    [DllImport(DllName)]
+    public static extern void VectorNormalizeArray(Vec3* v, Vec3* output, UIntPtr n);
+
+    [DllImport(DllName)]
+    public static extern void IntegrateBodies2D(Vec2* positions, Vec2* velocities, Vec2* accelerations, UIntPtr n, float dt);
+
+    [DllImport(DllName)]
+    public static extern void IntegrateBodies(Vec3* positions, Vec3* velocities, Vec3* accelerations, UIntPtr n, float dt);
+
+    [DllImport(DllName)]
+    public static extern void VectorReflectResponse2DArray(Vec2* velocities, Vec2* normals, byte* mask, UIntPtr n, float restitution, float friction, int flags);
+
+    [DllImport(DllName)]
+    public static extern void SpatialGrid2DUpdate(IntPtr grid, Vec2* positions, UIntPtr n);
+
+    [DllImport(DllName)]
+    public static extern UIntPtr SpatialGrid2DQueryRadius(IntPtr grid, Vec2 center, float radius, int* outIds, UIntPtr capacity);
+
+    [DllImport(DllName)]
+    public static extern void SweepCircleAABB2DArray(Vec2* centers, float* radii, Vec2* motions, Vec2* boxMin, Vec2* boxMax, SweepHit2D* hits, UIntPtr n);
+
+
+    //NativeArray Overloads
+    //The read-only pointer is used for inputs, so these also work on arrays
+    //that a job is only reading.
+    private static Vec2* Read(NativeArray<Vec2> array) => (Vec2*)NativeArrayUnsafeUtility.GetUnsafeReadOnlyPtr(array);
+    private static Vec2* Write(NativeArray<Vec2> array) => (Vec2*)NativeArrayUnsafeUtility.GetUnsafePtr(array);
+    private static Vec3* Read(NativeArray<Vec3> array) => (Vec3*)NativeArrayUnsafeUtility.GetUnsafeReadOnlyPtr(array);
+    private static Vec3* Write(NativeArray<Vec3> array) => (Vec3*)NativeArrayUnsafeUtility.GetUnsafePtr(array);
+
+    private static void CheckLength(int expected, int actual)
+    {
+        if (actual < expected)
+            throw new ArgumentException($"Buffer holds {actual} elements, {expected} are needed");
+    }
+
+    public static void Add(NativeArray<Vec2> a, NativeArray<Vec2> b, NativeArray<Vec2> output)
+    {
+        CheckLength(a.Length, b.Length);
+        CheckLength(a.Length, output.Length);
+        VectorAdd2DArray(Read(a), Read(b), Write(output), (UIntPtr)a.Length);
+    }
+
+    public static void Scale(NativeArray<Vec2> v, float scale, NativeArray<Vec2> output)
+    {
+        CheckLength(v.Length, output.Length);
+        VectorScale2DArray(Read(v), scale, Write(output), (UIntPtr)v.Length);
+    }
+
+    public static void Normalize(NativeArray<Vec2> v, NativeArray<Vec2> output)
+    {
+        CheckLength(v.Length, output.Length);
+        VectorNormalize2DArray(Read(v), Write(output), (UIntPtr)v.Length);
+    }
+
+    public static void Reflect(NativeArray<Vec2> v, NativeArray<Vec2> normals, NativeArray<Vec2> output)
+    {
+        CheckLength(v.Length, normals.Length);
+        CheckLength(v.Length, output.Length);
+        VectorReflect2DArray(Read(v), Read(normals), Write(output), (UIntPtr)v.Length);
+    }
+
+    public static void ClampMagnitude(NativeArray<Vec2> v, float maxLength, NativeArray<Vec2> output)
+    {
+        CheckLength(v.Length, output.Length);
+        VectorClampMagnitude2DArray(Read(v), maxLength, Write(output), (UIntPtr)v.Length);
+    }
+
+    //output = a + b * scale, e.g. positions + velocities * dt (output may be a)
+    public static void ScaleAdd(NativeArray<Vec2> a, NativeArray<Vec2> b, float scale, NativeArray<Vec2> output)
+    {
+        CheckLength(a.Length, b.Length);
+        CheckLength(a.Length, output.Length);
+        VectorScaleAdd2DArray(Read(a), Read(b), scale, Write(output), (UIntPtr)a.Length);
+    }
+
+    public static void ClampMagnitudeRange(NativeArray<Vec2> v, float minLength, float maxLength, NativeArray<Vec2> output)
+    {
+        CheckLength(v.Length, output.Length);
+        VectorClampMagnitudeRange2DArray(Read(v), minLength, maxLength, Write(output), (UIntPtr)v.Length);
+    }
+
+    public static void Add(NativeArray<Vec3> a, NativeArray<Vec3> b, NativeArray<Vec3> output)
+    {
+        CheckLength(a.Length, b.Length);
+        CheckLength(a.Length, output.Length);
+        VectorAddArray(Read(a), Read(b), Write(output), (UIntPtr)a.Length);
+    }
+
+    public static void Scale(NativeArray<Vec3> v, float scale, NativeArray<Vec3> output)
+    {
+        CheckLength(v.Length, output.Length);
+        VectorScaleArray(Read(v), scale, Write(output), (UIntPtr)v.Length);
+    }
+
+    public static void Normalize(NativeArray<Vec3> v, NativeArray<Vec3> output)
+    {
+        CheckLength(v.Length, output.Length);
+        VectorNormalizeArray(Read(v), Write(output), (UIntPtr)v.Length);
+    }
+
+    //accelerations may be default(NativeArray) when no force acts on the bodies
+    public static void Integrate(NativeArray<Vec2> positions, NativeArray<Vec2> velocities, NativeArray<Vec2> accelerations, float dt)
+    {
+        CheckLength(positions.Length, velocities.Length);
+        Vec2* acceleration = null;
+        if (accelerations.IsCreated)
+        {
+            CheckLength(positions.Length, accelerations.Length);
+            acceleration = Read(accelerations);
+        }
+        IntegrateBodies2D(Write(positions), Write(velocities), acceleration, (UIntPtr)positions.Length, dt);
+    }
+
+    public static void Integrate(NativeArray<Vec3> positions, NativeArray<Vec3> velocities, NativeArray<Vec3> accelerations, float dt)
+    {
+        CheckLength(positions.Length, velocities.Length);
+        Vec3* acceleration = null;
+        if (accelerations.IsCreated)
+        {
+            CheckLength(positions.Length, accelerations.Length);
+            acceleration = Read(accelerations);
+        }
+        IntegrateBodies(Write(positions), Write(velocities), acceleration, (UIntPtr)positions.Length, dt);
+    }
+
+    //mask may be default(NativeArray) when every contact is active
+    public static void ReflectResponse(NativeArray<Vec2> velocities, NativeArray<Vec2> normals, NativeArray<byte> mask, float restitution, float friction, int flags)
+    {
+        CheckLength(velocities.Length, normals.Length);
+        byte* maskPointer = null;
+        if (mask.IsCreated)
+        {
+            CheckLength(velocities.Length, mask.Length);
+            maskPointer = (byte*)NativeArrayUnsafeUtility.GetUnsafeReadOnlyPtr(mask);
+        }
+        VectorReflectResponse2DArray(Write(velocities), Read(normals), maskPointer, (UIntPtr)velocities.Length, restitution, friction, flags);
+    }
+
+    public static void UpdateGrid(IntPtr grid, NativeArray<Vec2> positions)
+    {
+        SpatialGrid2DUpdate(grid, Read(positions), (UIntPtr)positions.Length);
+    }
+
+    //Returns the total found; only the first outIds.Length are written
+    public static int QueryRadius(IntPtr grid, Vec2 center, float radius, NativeArray<int> outIds)
+    {
+        int* ids = (int*)NativeArrayUnsafeUtility.GetUnsafePtr(outIds);
+        return (int)SpatialGrid2DQueryRadius(grid, center, radius, ids, (UIntPtr)outIds.Length);
+    }
+
+    public static void SweepCircleAABB(NativeArray<Vec2> centers, NativeArray<float> radii, NativeArray<Vec2> motions, NativeArray<Vec2> boxMin, NativeArray<Vec2> boxMax, NativeArray<SweepHit2D> hits)
+    {
+        int n = centers.Length;
+        CheckLength(n, radii.Length);
+        CheckLength(n, motions.Length);
+        CheckLength(n, boxMin.Length);
+        CheckLength(n, boxMax.Length);
+        CheckLength(n, hits.Length);
+        SweepCircleAABB2DArray(Read(centers), (float*)NativeArrayUnsafeUtility.GetUnsafeReadOnlyPtr(radii), Read(motions), Read(boxMin), Read(boxMax),
+            (SweepHit2D*)NativeArrayUnsafeUtility.GetUnsafePtr(hits), (UIntPtr)n);
+    }
+
+
+    //Span Overloads (managed arrays, stackalloc or slices; pinned only for the call)
+    public static void Add(ReadOnlySpan<Vec2> a, ReadOnlySpan<Vec2> b, Span<Vec2> output)
+    {
+        CheckLength(a.Length, b.Length);
+        CheckLength(a.Length, output.Length);
+        fixed (Vec2* pa = a)
+        fixed (Vec2* pb = b)
+        fixed (Vec2* po = output)
+        {
+            VectorAdd2DArray(pa, pb, po, (UIntPtr)a.Length);
+        }
+    }
+
+    public static void Scale(ReadOnlySpan<Vec2> v, float scale, Span<Vec2> output)
+    {
+        CheckLength(v.Length, output.Length);
+        fixed (Vec2* pv = v)
+        fixed (Vec2* po = output)
+        {
+            VectorScale2DArray(pv, scale, po, (UIntPtr)v.Length);
+        }
+    }
+
+    public static void ScaleAdd(ReadOnlySpan<Vec2> a, ReadOnlySpan<Vec2> b, float scale, Span<Vec2> output)
+    {
+        CheckLength(a.Length, b.Length);
+        CheckLength(a.Length, output.Length);
+        fixed (Vec2* pa = a)
+        fixed (Vec2* pb = b)
+        fixed (Vec2* po = output)
+        {
+            VectorScaleAdd2DArray(pa, pb, scale, po, (UIntPtr)a.Length);
+        }
+    }
+
+    public static void Normalize(ReadOnlySpan<Vec2> v, Span<Vec2> output)
+    {
+        CheckLength(v.Length, output.Length);
+        fixed (Vec2* pv = v)
+        fixed (Vec2* po = output)
+        {
+            VectorNormalize2DArray(pv, po, (UIntPtr)v.Length);
+        }
+    }
+
+    public static void Reflect(ReadOnlySpan<Vec2> v, ReadOnlySpan<Vec2> normals, Span<Vec2> output)
+    {
+        CheckLength(v.Length, normals.Length);
+        CheckLength(v.Length, output.Length);
+        fixed (Vec2* pv = v)
+        fixed (Vec2* pn = normals)
+        fixed (Vec2* po = output)
+        {
+            VectorReflect2DArray(pv, pn, po, (UIntPtr)v.Length);
+        }
+    }
+
+    //An empty accelerations span means no force acts on the bodies
+    public static void Integrate(Span<Vec2> positions, Span<Vec2> velocities, ReadOnlySpan<Vec2> accelerations, float dt)
+    {
+        CheckLength(positions.Length, velocities.Length);
+        if (!accelerations.IsEmpty)
+            CheckLength(positions.Length, accelerations.Length);
+        fixed (Vec2* pp = positions)
+        fixed (Vec2* pv = velocities)
+        fixed (Vec2* pa = accelerations)
+        {
+            IntegrateBodies2D(pp, pv, pa, (UIntPtr)positions.Length, dt);
+        }
+    }
+
+    public static void UpdateGrid(IntPtr grid, ReadOnlySpan<Vec2> positions)
+    {
+        fixed (Vec2* pp = positions)
+        {
+            SpatialGrid2DUpdate(grid, pp, (UIntPtr)positions.Length);
+        }
+    }
+
+    public static int QueryRadius(IntPtr grid, Vec2 center, float radius, Span<int> outIds)
+    {
+        fixed (int* ids = outIds)
+        {
+            return (int)SpatialGrid2DQueryRadius(grid, center, radius, ids, (UIntPtr)outIds.Length);
+        }
+    }
+}
+
+#if !NET5_0_OR_GREATER
+namespace System.Runtime.InteropServices
+{
+    //Unity's .NET Standard 2.1 profile does not ship this attribute. Declaring
+    //it lets the file compile there (Mono and IL2CPP ignore it); runtimes that
+    //support it provide their own and skip this block.
+    [AttributeUsage(AttributeTargets.Method, Inherited = false)]
+    internal sealed class SuppressGCTransitionAttribute : Attribute
+    {
+    }
+}
+#endif
@@ -3,158 +3,191 @@
 
 //Then include own items
 #include "VectorMath.h"
+#include "VectorMathStats.h"
 #include <cmath>
 
+//The exported functions are thin wrappers over the inline layer in
+//VectorMathInline.h so the C ABI and native C++ callers share one implementation.
+
+using namespace vmath;
 
 Vec2 VectorAdd2D(Vec2 a, Vec2 b) {
-	return { a.x + b.x, a.y + b.y };
+	VECTORMATH_STATS(1);
+	return a + b;
 }
 
 Vec2 VectorSubtract2D(Vec2 a, Vec2 b) {
-	return { a.x - b.x, a.y - b.y};
+	VECTORMATH_STATS(1);
+	return a - b;
 }
 
 Vec2 VectorScale2D(Vec2 v, float scale) {
-	return { scale * v.x, scale * v.y};
+	VECTORMATH_STATS(1);
+	return v * scale;
 }
 
 Vec2 VectorDivide2D(Vec2 v, float scalar) {
-	if (scalar < 0.0001f) {
-		return {0.0f};
-	}
-	return { v.x / scalar, v.y / scalar};
+	VECTORMATH_STATS(1);
+	return v / scalar;
 }
 
 float VectorMagnitude2D(Vec2 v) {
-	return sqrtf(v.x * v.x + v.y * v.y);
+	VECTORMATH_STATS(1);
+	return Magnitude(v);
 }
 
 Vec2 VectorNormalize2D(Vec2 v) {
-	float m = VectorMagnitude2D(v);
-	if (m < 0.0001f) {
-		return {0.0f, 0.0f};
-	}
-	return VectorDivide2D(v, m);
+	VECTORMATH_STATS(1);
+	return Normalize(v);
+}
+
+Vec2 VectorNormalizeFast2D(Vec2 v) {
+	VECTORMATH_STATS(1);
+	return NormalizeFast(v);
 }
 
 float VectorDot2D(Vec2 a, Vec2 b) {
-	return a.x * b.x + a.y * b.y;
+	VECTORMATH_STATS(1);
+	return Dot(a, b);
 }
 
 float VectorCross2D(Vec2 a, Vec2 b)
 {
-	return a.x * b.y - a.y * b.x;
+	VECTORMATH_STATS(1);
+	return Cross(a, b);
 }
 
 Vec3 VectorAdd(Vec3 a, Vec3 b) {
-	return { a.x + b.x, a.y + b.y, a.z + b.z };
+	VECTORMATH_STATS(1);
+	return a + b;
 }
 
 Vec3 VectorSubtract(Vec3 a, Vec3 b) {
-	return { a.x - b.x, a.y - b.y, a.z - b.z };
+	VECTORMATH_STATS(1);
+	return a - b;
 }
 
 Vec3 VectorScale(Vec3 v, float scale) {
-	return { scale * v.x, scale * v.y, scale * v.z };
+	VECTORMATH_STATS(1);
+	return v * scale;
 }
 
 Vec3 VectorDivide(Vec3 v, float scalar) {
-	if (scalar < 0.0001f) {
-		return { 0.0f };
-	}
-	return { v.x / scalar, v.y / scalar, v.z / scalar };
+	VECTORMATH_STATS(1);
+	return v / scalar;
 }
 
 float VectorMagnitude(Vec3 v) {
-	return sqrtf(v.x * v.x + v.y * v.y + v.z * v.z);
+	VECTORMATH_STATS(1);
+	return Magnitude(v);
 }
 
 Vec3 VectorNormalize(Vec3 v) {
-	float m = VectorMagnitude(v);
-	if (m < 0.0001f){
-		return {0.0f, 0.0f, 0.0f};
-	}
-	return VectorDivide(v, m);
+	VECTORMATH_STATS(1);
+	return Normalize(v);
+}
+
+Vec3 VectorNormalizeFast(Vec3 v) {
+	VECTORMATH_STATS(1);
+	return NormalizeFast(v);
 }
 
 float VectorDot(Vec3 a, Vec3 b) {
-	return a.x * b.x + a.y * b.y + a.z * b.z;
+	VECTORMATH_STATS(1);
+	return Dot(a, b);
 }
 
 Vec3 VectorCross(Vec3 a, Vec3 b) {
-	return { a.y * b.z - a.z * b.y,
-			 a.z * b.x - a.x * b.z,
-			 a.x * b.y - a.y * b.x };
+	VECTORMATH_STATS(1);
+	return Cross(a, b);
 }
 
 Vec3 VectorLerp(Vec3 a, Vec3 b, float t) {
-	return {
-		a.x + t * (b.x - a.x),
-		a.y + t * (b.y - a.y),
-		a.z + t * (b.z - a.z)
-	};
+	VECTORMATH_STATS(1);
+	return Lerp(a, b, t);
 }
 
 Vec3 VectorReflect(Vec3 v, Vec3 normal) {
-	normal = VectorNormalize(normal);
-	float d = VectorDot(v, normal);
-	return VectorSubtract(v, VectorScale(normal, 2.0f * d));
+	VECTORMATH_STATS(1);
+	return Reflect(v, normal);
 }
 
 Vec2 VectorLerp2D(Vec2 a, Vec2 b, float t) {
-	return {
-		a.x + t * (b.x - a.x),
-		a.y + t * (b.y - a.y),
-	};
+	VECTORMATH_STATS(1);
+	return Lerp(a, b, t);
 }
 
 Vec2 VectorReflect2D(Vec2 v, Vec2 normal) {
-	normal = VectorNormalize2D(normal);
-	float d = VectorDot2D(v, normal);
-	return VectorSubtract2D(v, VectorScale2D(normal, 2.0f * d));
+	VECTORMATH_STATS(1);
+	return Reflect(v, normal);
 }
 
 Vec2 VectorClampMagnitude2D(Vec2 v, float maxLength) {
-	float m = VectorMagnitude2D(v);
-	if (m < 0.0001f) {
-		return { 0.0f, 0.0f };
-	}
-	if (m > maxLength) {
-		v = VectorNormalize2D(v);
-		return VectorScale2D(v, maxLength);
-	}
-	return v;
+	VECTORMATH_STATS(1);
+	return ClampMagnitude(v, maxLength);
 }
 
 Vec3 VectorClampMagnitude(Vec3 v, float maxLength) {
-	float m = VectorMagnitude(v);
-	if (m < 0.0001f) {
-		return { 0.0f, 0.0f, 0.0f };
-	}
-	if (m > maxLength) {
-		v = VectorNormalize(v);
-		return VectorScale(v, maxLength);
-	}
-	return v;
+	VECTORMATH_STATS(1);
+	return ClampMagnitude(v, maxLength);
 }
 
 float Clamp(float v, float minVal, float maxVal) {
-	if (v > maxVal) 
-		return maxVal;
-	if (v < minVal) 
-		return minVal;
-	return v;
+	VECTORMATH_STATS(1);
+	return vmath::Clamp(v, minVal, maxVal);
 }
 
 Vec3 VectorClamp(Vec3 v, float minVal, float maxVal) {
-	return{ Clamp(v.x, minVal, maxVal),
-		Clamp(v.y, minVal,maxVal),
-		Clamp(v.z, minVal, maxVal)};
+	VECTORMATH_STATS(1);
+	return vmath::Clamp(v, minVal, maxVal);
 }
 
 Vec2 VectorClamp2D(Vec2 v, float minVal, float maxVal) {
-	return{ Clamp(v.x, minVal, maxVal),
-		Clamp(v.y, minVal,maxVal)};
+	VECTORMATH_STATS(1);
+	return vmath::Clamp(v, minVal, maxVal);
+}
+
+
+//Fused Operations
+
+Vec2 VectorScaleAdd2D(Vec2 a, Vec2 b, float scale) {
+	VECTORMATH_STATS(1);
+	return ScaleAdd(a, b, scale);
+}
+
+Vec3 VectorScaleAdd(Vec3 a, Vec3 b, float scale) {
+	VECTORMATH_STATS(1);
+	return ScaleAdd(a, b, scale);
+}
+
+Vec2 VectorMulAdd2D(Vec2 a, Vec2 b, Vec2 c) {
+	VECTORMATH_STATS(1);
+	return MulAdd(a, b, c);
+}
+
+Vec3 VectorMulAdd(Vec3 a, Vec3 b, Vec3 c) {
+	VECTORMATH_STATS(1);
+	return MulAdd(a, b, c);
+}
+
+Vec2 VectorLerpClamp2D(Vec2 a, Vec2 b, float t, float minVal, float maxVal) {
+	VECTORMATH_STATS(1);
+	return LerpClamp(a, b, t, minVal, maxVal);
+}
+
+Vec3 VectorLerpClamp(Vec3 a, Vec3 b, float t, float minVal, float maxVal) {
+	VECTORMATH_STATS(1);
+	return LerpClamp(a, b, t, minVal, maxVal);
+}
+
+Vec2 VectorClampMagnitudeRange2D(Vec2 v, float minLength, float maxLength) {
+	VECTORMATH_STATS(1);
+	return ClampMagnitude(v, minLength, maxLength);
+}
+
+Vec3 VectorClampMagnitudeRange(Vec3 v, float minLength, float maxLength) {
+	VECTORMATH_STATS(1);
+	return ClampMagnitude(v, minLength, maxLength);
 }
 
 
@@ -3,21 +3,154 @@
 #ifndef VECTOR_MATH_H
 #define VECTOR_MATH_H
 
-#ifdef _WIN32
+//VECTORMATH_STATIC is defined by the static library build (CMake), where
+//there is nothing to export.
+#if defined(VECTORMATH_STATIC)
+#define EXPORT
+#elif defined(_WIN32)
 #define EXPORT __declspec(dllexport)
 #else
 #define EXPORT __attribute__((visibility("default")))
 #endif
 
-struct Vec2 {
-    float x;
-    float y;
+#include <cstddef>
+#include <cstdint>
+#include "VectorMathInline.h"
+#include "VectorMathMatrix.h"
+#include "VectorMathHalf.h"
+#include "VectorMathAligned.h"
+
+//Plain float structs shared with C# (see Vec3.cs). They are the float
+//instantiations of the header-only types, so C++ callers can also use the
+//inline operators from VectorMathInline.h on them.
+typedef vmath::Vec2T<float> Vec2;
+typedef vmath::Vec3T<float> Vec3;
+
+//Column-major matrices (m[col * N + row]) and rotation quaternions, see
+//VectorMathMatrix.h. Mat4 is 16-byte aligned.
+typedef vmath::Mat3T<float> Mat3;
+typedef vmath::Mat4T<float> Mat4;
+typedef vmath::QuatT<float> Quat;
+
+//Double precision vectors for large worlds, and 16-bit storage vectors for
+//bulk data and snapshots (see VectorMathHalf.h). Half / BFloat16 only hold
+//bits: convert to float to do maths on them.
+typedef vmath::Vec2T<double> Vec2d;
+typedef vmath::Vec3T<double> Vec3d;
+typedef vmath::Half Half;
+typedef vmath::BFloat16 BFloat16;
+typedef vmath::Vec2T<Half> Vec2h;
+typedef vmath::Vec3T<Half> Vec3h;
+
+//16-byte aligned vectors, one SIMD register per element (see
+//VectorMathAligned.h). Vec3A is a Vec3 plus an unused pad component.
+typedef vmath::Vec4T<float> Vec4;
+typedef vmath::Vec3AT<float> Vec3A;
+
+//Opaque handles for the broad-phase structures (see the Spatial Hash Grid and
+//Bounding Volume Hierarchy sections)
+struct SpatialGrid2D;
+struct Bvh3D;
+
+//Opaque handles for snapshot files (see the Snapshots section)
+struct SnapshotWriter;
+struct SnapshotReader;
+
+//Opaque handles for spline curves with arc-length tables (see the Curves section)
+struct Curve2D;
+struct Curve3D;
+
+//Closest hit of a ray cast: id is -1 on a miss
+struct RayHit {
+    int id;
+    float distance;
+};
+
+//First contact of a swept test: time is the fraction of the motion travelled
+//(0..1) and normal the unit surface normal facing the moving shape. A miss
+//gives time 1 and a zero normal, so moving by motion * time is always safe.
+struct SweepHit2D {
+    float time;
+    Vec2 normal;
+};
+
+//Shortest and longest vector of an array (see the Reductions section).
+//The indices are SIZE_MAX and the magnitudes 0 when there is no vector.
+struct VectorMathMagnitudeRange {
+    float minMagnitude;
+    float maxMagnitude;
+    size_t minIndex;
+    size_t maxIndex;
+};
+
+//Usage of the per-thread frame arenas (see VectorMathGetFrameArenaStats)
+struct VectorMathArenaStats {
+    size_t capacity;      //bytes per thread
+    size_t peakUsed;      //most bytes any one arena has held at once
+    size_t overflowCount; //requests that did not fit (scratch went to the heap instead)
+    size_t arenaCount;    //threads that own an arena
+};
+
+//Counters of one exported function since the last VectorMathResetStats
+//(see the Instrumentation section). ticks is the CPU time stamp counter on
+//x86 (roughly the nominal clock rate), the generic timer on ARM64 and
+//nanoseconds elsewhere; compare them within one machine only.
+struct VectorMathFunctionStats {
+    const char* name;  //function name, valid for the lifetime of the library
+    uint64_t calls;
+    uint64_t elements; //n for batch and array calls, 1 per call otherwise
+    uint64_t ticks;    //total time inside the function, callees included
+};
+
+//One recorded array of a snapshot: count elements of components floats each
+//per frame (1 = float, 2 = Vec2, 3 = Vec3, 4 = Vec4)
+struct VectorMathSnapshotChannel {
+    char name[32];      //0-terminated
+    uint32_t components;
+    uint32_t count;
+    uint32_t encoding;  //VectorMathSnapshotEncoding
+    float step;         //quantization step of VECTORMATH_SNAPSHOT_DELTA
+};
+
+//Instruction sets the batch functions can run on
+enum VectorMathSimdLevel {
+    VECTORMATH_SIMD_BEST = -1,
+    VECTORMATH_SIMD_SCALAR = 0,
+    VECTORMATH_SIMD_SSE41 = 1,
+    VECTORMATH_SIMD_AVX2 = 2,
+    VECTORMATH_SIMD_NEON = 3
+};
+
+//Precision used by the batch normalize functions
+enum VectorMathPrecision {
+    VECTORMATH_PRECISION_DEFAULT = -1, //use the global setting
+    VECTORMATH_PRECISION_EXACT = 0,    //sqrt + divide, same as VectorNormalize
+    VECTORMATH_PRECISION_FAST = 1      //rsqrt + Newton-Raphson, max 5 ULP error
+};
+
+//How a snapshot channel is stored
+enum VectorMathSnapshotEncoding {
+    VECTORMATH_SNAPSHOT_RAW = 0,  //floats as given, readable in place from the mapped file
+    VECTORMATH_SNAPSHOT_DELTA = 1 //rounded to multiples of step, stored as the change from the previous frame in 1, 2 or 4 bytes
 };
 
-struct Vec3 {
-    float x;
-    float y;
-    float z;
+//How the points of a curve are read (see the Curves section)
+enum VectorMathCurveType {
+    VECTORMATH_CURVE_BEZIER = 0,      //cubic Bezier: end point, two control points, end point, two control points, ... (3k + 1 points)
+    VECTORMATH_CURVE_CATMULL_ROM = 1, //uniform Catmull-Rom through every point (at least 2)
+    VECTORMATH_CURVE_HERMITE = 2      //cubic Hermite: position, tangent, position, tangent, ... (at least 2 pairs)
+};
+
+//Summation used by the reduction functions
+enum VectorMathSumMode {
+    VECTORMATH_SUM_PAIRWISE = 0, //lanes and blocks added pairwise, error grows with log(n)
+    VECTORMATH_SUM_KAHAN = 1     //compensated lanes added in double, error independent of n
+};
+
+//Flags for the VectorReflectResponse functions
+enum VectorMathReflectFlags {
+    VECTORMATH_REFLECT_DEFAULT = 0,         //normalize each normal first, like VectorReflect
+    VECTORMATH_REFLECT_UNIT_NORMALS = 1     //normals are already unit length, skip the sqrt and divide
 };
 
 extern "C" {
@@ -61,6 +194,591 @@ extern "C" {
     EXPORT float Clamp(float v, float minVal, float maxVal);
     EXPORT Vec3 VectorClamp(Vec3 v, float minVal, float maxVal);
     EXPORT Vec2 VectorClamp2D(Vec2 v, float minVal, float maxVal);
+
+
+    //Everything above only does arithmetic on its arguments (no blocking,
+    //allocation or callbacks), so managed callers may skip the GC transition
+    //for these (SuppressGCTransition, see VectorMathNative.cs). The array,
+    //query and threading functions below can wait on the thread pool and must
+    //keep it.
+
+    //Batch Operations (Structure of Arrays)
+    //Each component lives in its own contiguous float array. Output arrays may
+    //alias the matching input arrays, so results can be written in place.
+    EXPORT void VectorAdd2DBatch(const float* ax, const float* ay, const float* bx, const float* by, float* outX, float* outY, size_t n);
+    EXPORT void VectorSubtract2DBatch(const float* ax, const float* ay, const float* bx, const float* by, float* outX, float* outY, size_t n);
+    EXPORT void VectorScale2DBatch(const float* x, const float* y, float scale, float* outX, float* outY, size_t n);
+    EXPORT void VectorDivide2DBatch(const float* x, const float* y, float scalar, float* outX, float* outY, size_t n);
+
+    EXPORT void VectorMagnitude2DBatch(const float* x, const float* y, float* out, size_t n);
+    EXPORT void VectorNormalize2DBatch(const float* x, const float* y, float* outX, float* outY, size_t n);
+    EXPORT void VectorDot2DBatch(const float* ax, const float* ay, const float* bx, const float* by, float* out, size_t n);
+    EXPORT void VectorCross2DBatch(const float* ax, const float* ay, const float* bx, const float* by, float* out, size_t n);
+
+    EXPORT void VectorLerp2DBatch(const float* ax, const float* ay, const float* bx, const float* by, float t, float* outX, float* outY, size_t n);
+    EXPORT void VectorReflect2DBatch(const float* vx, const float* vy, const float* nx, const float* ny, float* outX, float* outY, size_t n);
+    EXPORT void VectorClampMagnitude2DBatch(const float* x, const float* y, float maxLength, float* outX, float* outY, size_t n);
+    EXPORT void VectorClamp2DBatch(const float* x, const float* y, float minVal, float maxVal, float* outX, float* outY, size_t n);
+
+    EXPORT void VectorAddBatch(const float* ax, const float* ay, const float* az, const float* bx, const float* by, const float* bz, float* outX, float* outY, float* outZ, size_t n);
+    EXPORT void VectorSubtractBatch(const float* ax, const float* ay, const float* az, const float* bx, const float* by, const float* bz, float* outX, float* outY, float* outZ, size_t n);
+    EXPORT void VectorScaleBatch(const float* x, const float* y, const float* z, float scale, float* outX, float* outY, float* outZ, size_t n);
+    EXPORT void VectorDivideBatch(const float* x, const float* y, const float* z, float scalar, float* outX, float* outY, float* outZ, size_t n);
+
+    EXPORT void VectorMagnitudeBatch(const float* x, const float* y, const float* z, float* out, size_t n);
+    EXPORT void VectorNormalizeBatch(const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ, size_t n);
+    EXPORT void VectorDotBatch(const float* ax, const float* ay, const float* az, const float* bx, const float* by, const float* bz, float* out, size_t n);
+    EXPORT void VectorCrossBatch(const float* ax, const float* ay, const float* az, const float* bx, const float* by, const float* bz, float* outX, float* outY, float* outZ, size_t n);
+
+    EXPORT void VectorLerpBatch(const float* ax, const float* ay, const float* az, const float* bx, const float* by, const float* bz, float t, float* outX, float* outY, float* outZ, size_t n);
+    EXPORT void VectorReflectBatch(const float* vx, const float* vy, const float* vz, const float* nx, const float* ny, const float* nz, float* outX, float* outY, float* outZ, size_t n);
+    EXPORT void VectorClampMagnitudeBatch(const float* x, const float* y, const float* z, float maxLength, float* outX, float* outY, float* outZ, size_t n);
+    EXPORT void VectorClampBatch(const float* x, const float* y, const float* z, float minVal, float maxVal, float* outX, float* outY, float* outZ, size_t n);
+
+    EXPORT void ClampBatch(const float* v, float minVal, float maxVal, float* out, size_t n);
+
+
+    //Batch Operations (Array of Structures)
+    //Same operations over packed Vec2/Vec3 arrays. out may alias an input array.
+    EXPORT void VectorAdd2DArray(const Vec2* a, const Vec2* b, Vec2* out, size_t n);
+    EXPORT void VectorSubtract2DArray(const Vec2* a, const Vec2* b, Vec2* out, size_t n);
+    EXPORT void VectorScale2DArray(const Vec2* v, float scale, Vec2* out, size_t n);
+    EXPORT void VectorDivide2DArray(const Vec2* v, float scalar, Vec2* out, size_t n);
+
+    EXPORT void VectorMagnitude2DArray(const Vec2* v, float* out, size_t n);
+    EXPORT void VectorNormalize2DArray(const Vec2* v, Vec2* out, size_t n);
+    EXPORT void VectorDot2DArray(const Vec2* a, const Vec2* b, float* out, size_t n);
+    EXPORT void VectorCross2DArray(const Vec2* a, const Vec2* b, float* out, size_t n);
+
+    EXPORT void VectorLerp2DArray(const Vec2* a, const Vec2* b, float t, Vec2* out, size_t n);
+    EXPORT void VectorReflect2DArray(const Vec2* v, const Vec2* normals, Vec2* out, size_t n);
+    EXPORT void VectorClampMagnitude2DArray(const Vec2* v, float maxLength, Vec2* out, size_t n);
+    EXPORT void VectorClamp2DArray(const Vec2* v, float minVal, float maxVal, Vec2* out, size_t n);
+
+    EXPORT void VectorAddArray(const Vec3* a, const Vec3* b, Vec3* out, size_t n);
+    EXPORT void VectorSubtractArray(const Vec3* a, const Vec3* b, Vec3* out, size_t n);
+    EXPORT void VectorScaleArray(const Vec3* v, float scale, Vec3* out, size_t n);
+    EXPORT void VectorDivideArray(const Vec3* v, float scalar, Vec3* out, size_t n);
+
+    EXPORT void VectorMagnitudeArray(const Vec3* v, float* out, size_t n);
+    EXPORT void VectorNormalizeArray(const Vec3* v, Vec3* out, size_t n);
+    EXPORT void VectorDotArray(const Vec3* a, const Vec3* b, float* out, size_t n);
+    EXPORT void VectorCrossArray(const Vec3* a, const Vec3* b, Vec3* out, size_t n);
+
+    EXPORT void VectorLerpArray(const Vec3* a, const Vec3* b, float t, Vec3* out, size_t n);
+    EXPORT void VectorReflectArray(const Vec3* v, const Vec3* normals, Vec3* out, size_t n);
+    EXPORT void VectorClampMagnitudeArray(const Vec3* v, float maxLength, Vec3* out, size_t n);
+    EXPORT void VectorClampArray(const Vec3* v, float minVal, float maxVal, Vec3* out, size_t n);
+
+
+    //Fast Normalize
+    //Reciprocal square root estimate refined by Newton-Raphson instead of sqrt
+    //and a divide per component. Max error is 5 ULP per component; vectors
+    //shorter than 0.0001f still return zero. The estimate differs between
+    //CPUs, so deterministic builds use an exact 1 / sqrt instead.
+    EXPORT Vec2 VectorNormalizeFast2D(Vec2 v);
+    EXPORT Vec3 VectorNormalizeFast(Vec3 v);
+
+    EXPORT void VectorNormalizeFast2DBatch(const float* x, const float* y, float* outX, float* outY, size_t n);
+    EXPORT void VectorNormalizeFastBatch(const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ, size_t n);
+    EXPORT void VectorNormalizeFast2DArray(const Vec2* v, Vec2* out, size_t n);
+    EXPORT void VectorNormalizeFastArray(const Vec3* v, Vec3* out, size_t n);
+
+    //The plain batch normalize functions follow the global precision (exact by
+    //default). The Ex versions take a VectorMathPrecision per call.
+    EXPORT void VectorMathSetPrecision(int precision);
+    EXPORT int VectorMathGetPrecision();
+
+    EXPORT void VectorNormalize2DBatchEx(const float* x, const float* y, float* outX, float* outY, size_t n, int precision);
+    EXPORT void VectorNormalizeBatchEx(const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ, size_t n, int precision);
+    EXPORT void VectorNormalize2DArrayEx(const Vec2* v, Vec2* out, size_t n, int precision);
+    EXPORT void VectorNormalizeArrayEx(const Vec3* v, Vec3* out, size_t n, int precision);
+
+
+    //Fused Operations
+    //Common chains done in one pass, so each element is read and written once
+    //instead of once per step. Results match the separate calls exactly.
+    //ScaleAdd: a + b * scale (e.g. position + velocity * dt)
+    //MulAdd: a * b + c, component-wise
+    //LerpClamp: VectorClamp(VectorLerp(a, b, t), minVal, maxVal)
+    //ClampMagnitudeRange: length clamped to [minLength, maxLength] with a
+    //single sqrt; vectors shorter than 0.0001f become zero
+    EXPORT Vec2 VectorScaleAdd2D(Vec2 a, Vec2 b, float scale);
+    EXPORT Vec3 VectorScaleAdd(Vec3 a, Vec3 b, float scale);
+    EXPORT Vec2 VectorMulAdd2D(Vec2 a, Vec2 b, Vec2 c);
+    EXPORT Vec3 VectorMulAdd(Vec3 a, Vec3 b, Vec3 c);
+    EXPORT Vec2 VectorLerpClamp2D(Vec2 a, Vec2 b, float t, float minVal, float maxVal);
+    EXPORT Vec3 VectorLerpClamp(Vec3 a, Vec3 b, float t, float minVal, float maxVal);
+    EXPORT Vec2 VectorClampMagnitudeRange2D(Vec2 v, float minLength, float maxLength);
+    EXPORT Vec3 VectorClampMagnitudeRange(Vec3 v, float minLength, float maxLength);
+
+    EXPORT void VectorScaleAdd2DBatch(const float* ax, const float* ay, const float* bx, const float* by, float scale, float* outX, float* outY, size_t n);
+    EXPORT void VectorScaleAddBatch(const float* ax, const float* ay, const float* az, const float* bx, const float* by, const float* bz, float scale, float* outX, float* outY, float* outZ, size_t n);
+    EXPORT void VectorMulAdd2DBatch(const float* ax, const float* ay, const float* bx, const float* by, const float* cx, const float* cy, float* outX, float* outY, size_t n);
+    EXPORT void VectorMulAddBatch(const float* ax, const float* ay, const float* az, const float* bx, const float* by, const float* bz, const float* cx, const float* cy, const float* cz, float* outX, float* outY, float* outZ, size_t n);
+    EXPORT void VectorLerpClamp2DBatch(const float* ax, const float* ay, const float* bx, const float* by, float t, float minVal, float maxVal, float* outX, float* outY, size_t n);
+    EXPORT void VectorLerpClampBatch(const float* ax, const float* ay, const float* az, const float* bx, const float* by, const float* bz, float t, float minVal, float maxVal, float* outX, float* outY, float* outZ, size_t n);
+    EXPORT void VectorClampMagnitudeRange2DBatch(const float* x, const float* y, float minLength, float maxLength, float* outX, float* outY, size_t n);
+    EXPORT void VectorClampMagnitudeRangeBatch(const float* x, const float* y, const float* z, float minLength, float maxLength, float* outX, float* outY, float* outZ, size_t n);
+
+    EXPORT void VectorScaleAdd2DArray(const Vec2* a, const Vec2* b, float scale, Vec2* out, size_t n);
+    EXPORT void VectorScaleAddArray(const Vec3* a, const Vec3* b, float scale, Vec3* out, size_t n);
+    EXPORT void VectorMulAdd2DArray(const Vec2* a, const Vec2* b, const Vec2* c, Vec2* out, size_t n);
+    EXPORT void VectorMulAddArray(const Vec3* a, const Vec3* b, const Vec3* c, Vec3* out, size_t n);
+    EXPORT void VectorLerpClamp2DArray(const Vec2* a, const Vec2* b, float t, float minVal, float maxVal, Vec2* out, size_t n);
+    EXPORT void VectorLerpClampArray(const Vec3* a, const Vec3* b, float t, float minVal, float maxVal, Vec3* out, size_t n);
+    EXPORT void VectorClampMagnitudeRange2DArray(const Vec2* v, float minLength, float maxLength, Vec2* out, size_t n);
+    EXPORT void VectorClampMagnitudeRangeArray(const Vec3* v, float minLength, float maxLength, Vec3* out, size_t n);
+
+
+    //Aligned Vectors (Vec4 / Vec3A)
+    //Passed by pointer like Mat4, since 32-bit callers cannot pass 16-byte
+    //aligned structs by value; out may alias an input. Vec3A functions give
+    //the same x/y/z as the Vec3 ones and write pad as 0, except the
+    //component-wise Add, Subtract, Scale, Divide, Lerp and Clamp, which apply
+    //to pad too.
+    EXPORT void VectorAdd4D(const Vec4* a, const Vec4* b, Vec4* out);
+    EXPORT void VectorSubtract4D(const Vec4* a, const Vec4* b, Vec4* out);
+    EXPORT void VectorScale4D(const Vec4* v, float scale, Vec4* out);
+    EXPORT void VectorDivide4D(const Vec4* v, float scalar, Vec4* out);
+    EXPORT float VectorMagnitude4D(const Vec4* v);
+    EXPORT void VectorNormalize4D(const Vec4* v, Vec4* out);
+    EXPORT float VectorDot4D(const Vec4* a, const Vec4* b);
+    EXPORT void VectorLerp4D(const Vec4* a, const Vec4* b, float t, Vec4* out);
+    EXPORT void VectorReflect4D(const Vec4* v, const Vec4* normal, Vec4* out);
+    EXPORT void VectorClampMagnitude4D(const Vec4* v, float maxLength, Vec4* out);
+    EXPORT void VectorClamp4D(const Vec4* v, float minVal, float maxVal, Vec4* out);
+
+    EXPORT void VectorAdd3A(const Vec3A* a, const Vec3A* b, Vec3A* out);
+    EXPORT void VectorSubtract3A(const Vec3A* a, const Vec3A* b, Vec3A* out);
+    EXPORT void VectorScale3A(const Vec3A* v, float scale, Vec3A* out);
+    EXPORT void VectorDivide3A(const Vec3A* v, float scalar, Vec3A* out);
+    EXPORT float VectorMagnitude3A(const Vec3A* v);
+    EXPORT void VectorNormalize3A(const Vec3A* v, Vec3A* out);
+    EXPORT float VectorDot3A(const Vec3A* a, const Vec3A* b);
+    EXPORT void VectorCross3A(const Vec3A* a, const Vec3A* b, Vec3A* out);
+    EXPORT void VectorLerp3A(const Vec3A* a, const Vec3A* b, float t, Vec3A* out);
+    EXPORT void VectorReflect3A(const Vec3A* v, const Vec3A* normal, Vec3A* out);
+    EXPORT void VectorClampMagnitude3A(const Vec3A* v, float maxLength, Vec3A* out);
+    EXPORT void VectorClamp3A(const Vec3A* v, float minVal, float maxVal, Vec3A* out);
+
+    //Arrays run on the SIMD kernels with one load per element. Keep them
+    //16-byte aligned (arrays of Vec4 / Vec3A on the stack, and 64-bit heap
+    //allocations, are); other addresses work but are slower. Normalize is
+    //always exact here.
+    EXPORT void VectorAdd4DArray(const Vec4* a, const Vec4* b, Vec4* out, size_t n);
+    EXPORT void VectorSubtract4DArray(const Vec4* a, const Vec4* b, Vec4* out, size_t n);
+    EXPORT void VectorScale4DArray(const Vec4* v, float scale, Vec4* out, size_t n);
+    EXPORT void VectorDivide4DArray(const Vec4* v, float scalar, Vec4* out, size_t n);
+    EXPORT void VectorMagnitude4DArray(const Vec4* v, float* out, size_t n);
+    EXPORT void VectorNormalize4DArray(const Vec4* v, Vec4* out, size_t n);
+    EXPORT void VectorDot4DArray(const Vec4* a, const Vec4* b, float* out, size_t n);
+    EXPORT void VectorLerp4DArray(const Vec4* a, const Vec4* b, float t, Vec4* out, size_t n);
+    EXPORT void VectorReflect4DArray(const Vec4* v, const Vec4* normals, Vec4* out, size_t n);
+    EXPORT void VectorClampMagnitude4DArray(const Vec4* v, float maxLength, Vec4* out, size_t n);
+    EXPORT void VectorClamp4DArray(const Vec4* v, float minVal, float maxVal, Vec4* out, size_t n);
+
+    EXPORT void VectorAdd3AArray(const Vec3A* a, const Vec3A* b, Vec3A* out, size_t n);
+    EXPORT void VectorSubtract3AArray(const Vec3A* a, const Vec3A* b, Vec3A* out, size_t n);
+    EXPORT void VectorScale3AArray(const Vec3A* v, float scale, Vec3A* out, size_t n);
+    EXPORT void VectorDivide3AArray(const Vec3A* v, float scalar, Vec3A* out, size_t n);
+    EXPORT void VectorMagnitude3AArray(const Vec3A* v, float* out, size_t n);
+    EXPORT void VectorNormalize3AArray(const Vec3A* v, Vec3A* out, size_t n);
+    EXPORT void VectorDot3AArray(const Vec3A* a, const Vec3A* b, float* out, size_t n);
+    EXPORT void VectorCross3AArray(const Vec3A* a, const Vec3A* b, Vec3A* out, size_t n);
+    EXPORT void VectorLerp3AArray(const Vec3A* a, const Vec3A* b, float t, Vec3A* out, size_t n);
+    EXPORT void VectorReflect3AArray(const Vec3A* v, const Vec3A* normals, Vec3A* out, size_t n);
+    EXPORT void VectorClampMagnitude3AArray(const Vec3A* v, float maxLength, Vec3A* out, size_t n);
+    EXPORT void VectorClamp3AArray(const Vec3A* v, float minVal, float maxVal, Vec3A* out, size_t n);
+
+    //Vec3 <-> Vec3A arrays (pad written as 0)
+    EXPORT void VectorToVec3AArray(const Vec3* v, Vec3A* out, size_t n);
+    EXPORT void VectorFromVec3AArray(const Vec3A* v, Vec3* out, size_t n);
+
+
+    //Double Precision
+    //The Vec2/Vec3 operations on Vec2d/Vec3d, for positions far from the
+    //origin where float runs out of precision (about 1 mm at 16 km)
+    EXPORT Vec2d VectorAdd2DDouble(Vec2d a, Vec2d b);
+    EXPORT Vec2d VectorSubtract2DDouble(Vec2d a, Vec2d b);
+    EXPORT Vec2d VectorScale2DDouble(Vec2d v, double scale);
+    EXPORT Vec2d VectorDivide2DDouble(Vec2d v, double scalar);
+    EXPORT double VectorMagnitude2DDouble(Vec2d v);
+    EXPORT Vec2d VectorNormalize2DDouble(Vec2d v);
+    EXPORT double VectorDot2DDouble(Vec2d a, Vec2d b);
+    EXPORT double VectorCross2DDouble(Vec2d a, Vec2d b);
+    EXPORT Vec2d VectorLerp2DDouble(Vec2d a, Vec2d b, double t);
+    EXPORT Vec2d VectorReflect2DDouble(Vec2d v, Vec2d normal);
+    EXPORT Vec2d VectorClampMagnitude2DDouble(Vec2d v, double maxLength);
+
+    EXPORT Vec3d VectorAddDouble(Vec3d a, Vec3d b);
+    EXPORT Vec3d VectorSubtractDouble(Vec3d a, Vec3d b);
+    EXPORT Vec3d VectorScaleDouble(Vec3d v, double scale);
+    EXPORT Vec3d VectorDivideDouble(Vec3d v, double scalar);
+    EXPORT double VectorMagnitudeDouble(Vec3d v);
+    EXPORT Vec3d VectorNormalizeDouble(Vec3d v);
+    EXPORT double VectorDotDouble(Vec3d a, Vec3d b);
+    EXPORT Vec3d VectorCrossDouble(Vec3d a, Vec3d b);
+    EXPORT Vec3d VectorLerpDouble(Vec3d a, Vec3d b, double t);
+    EXPORT Vec3d VectorReflectDouble(Vec3d v, Vec3d normal);
+    EXPORT Vec3d VectorClampMagnitudeDouble(Vec3d v, double maxLength);
+
+
+    //Precision Conversion
+    //Flat arrays of n values; a packed Vec2/Vec3 array is 2n/3n values, and
+    //Vec2h/Vec3h arrays can be passed as Half arrays the same way. float to
+    //Half / BFloat16 rounds to nearest even and gives the same bits on every
+    //SIMD level (F16C on AVX2 CPUs). Half overflows to infinity above 65504.
+    //out must not overlap in.
+    EXPORT void ConvertFloatToHalf(const float* in, Half* out, size_t n);
+    EXPORT void ConvertHalfToFloat(const Half* in, float* out, size_t n);
+    EXPORT void ConvertFloatToBFloat16(const float* in, BFloat16* out, size_t n);
+    EXPORT void ConvertBFloat16ToFloat(const BFloat16* in, float* out, size_t n);
+    EXPORT void ConvertFloatToDouble(const float* in, double* out, size_t n);
+    EXPORT void ConvertDoubleToFloat(const double* in, float* out, size_t n);
+
+    EXPORT Vec2h VectorToHalf2D(Vec2 v);
+    EXPORT Vec2 VectorFromHalf2D(Vec2h v);
+    EXPORT Vec2d VectorToDouble2D(Vec2 v);
+    EXPORT Vec2 VectorFromDouble2D(Vec2d v);
+    EXPORT Vec3d VectorToDouble(Vec3 v);
+    EXPORT Vec3 VectorFromDouble(Vec3d v);
+
+    //Matrices & Quaternions
+    //Matrices are passed by pointer (they are too large for registers and a
+    //Mat4 must stay 16-byte aligned). out may alias an input.
+    //Singular matrices invert to the zero matrix.
+    EXPORT void Mat3Identity(Mat3* out);
+    EXPORT void Mat3Multiply(const Mat3* a, const Mat3* b, Mat3* out);
+    EXPORT Vec3 Mat3MultiplyVector(const Mat3* m, Vec3 v);
+    EXPORT void Mat3Transpose(const Mat3* m, Mat3* out);
+    EXPORT float Mat3Determinant(const Mat3* m);
+    EXPORT void Mat3Inverse(const Mat3* m, Mat3* out);
+
+    EXPORT void Mat4Identity(Mat4* out);
+    EXPORT void Mat4Multiply(const Mat4* a, const Mat4* b, Mat4* out);
+    EXPORT void Mat4Transpose(const Mat4* m, Mat4* out);
+    EXPORT float Mat4Determinant(const Mat4* m);
+    EXPORT void Mat4Inverse(const Mat4* m, Mat4* out);
+
+    EXPORT Vec3 Mat4TransformPoint(const Mat4* m, Vec3 p);
+    EXPORT Vec3 Mat4TransformDirection(const Mat4* m, Vec3 d);
+
+    //Translation * Rotation * Scale. Decompose expects an affine matrix
+    //without shear; a mirrored matrix gives a negative scale.x.
+    EXPORT void Mat4ComposeTRS(Vec3 translation, Quat rotation, Vec3 scale, Mat4* out);
+    EXPORT void Mat4DecomposeTRS(const Mat4* m, Vec3* translation, Quat* rotation, Vec3* scale);
+
+    EXPORT Quat QuatIdentity();
+    EXPORT Quat QuatFromAxisAngle(Vec3 axis, float angle);
+    EXPORT Quat QuatMultiply(Quat a, Quat b);
+    EXPORT Quat QuatConjugate(Quat q);
+    EXPORT Quat QuatInverse(Quat q);
+    EXPORT Quat QuatNormalize(Quat q);
+    EXPORT Vec3 QuatRotateVector(Quat q, Vec3 v);
+    EXPORT void QuatToMat3(Quat q, Mat3* out);
+    EXPORT Quat QuatFromMat3(const Mat3* m);
+
+    //Transform a packed Vec3 array by one matrix on the SIMD kernels.
+    //Points get the translation (w = 1), directions do not (w = 0).
+    //out may alias in.
+    EXPORT void Mat4TransformPoints(const Mat4* m, const Vec3* in, Vec3* out, size_t n);
+    EXPORT void Mat4TransformDirections(const Mat4* m, const Vec3* in, Vec3* out, size_t n);
+
+
+    //Physics Integration
+    //positions, velocities / previousPositions and accelerations are parallel
+    //arrays of n bodies; positions and velocities are updated in place.
+    //accelerations may be nullptr when no force acts on the bodies.
+    //Semi-implicit Euler: v += a * dt, then p += v * dt
+    EXPORT void IntegrateBodies2D(Vec2* positions, Vec2* velocities, const Vec2* accelerations, size_t n, float dt);
+    EXPORT void IntegrateBodies(Vec3* positions, Vec3* velocities, const Vec3* accelerations, size_t n, float dt);
+
+    //Position Verlet: p' = 2p - previous + a * dt * dt, then previous = p.
+    //Velocity is implicit (p - previous), so a body starts at rest when
+    //previousPositions equals positions.
+    EXPORT void IntegrateBodiesVerlet2D(Vec2* positions, Vec2* previousPositions, const Vec2* accelerations, size_t n, float dt);
+    EXPORT void IntegrateBodiesVerlet(Vec3* positions, Vec3* previousPositions, const Vec3* accelerations, size_t n, float dt);
+
+
+    //Collision Response
+    //Bounces each velocity off its contact normal in place: the normal part is
+    //reversed and scaled by restitution, the tangential part is scaled by
+    //(1 - friction). restitution 1 and friction 0 match VectorReflect.
+    //mask holds one byte per contact (0 = no contact, velocity kept) and may be
+    //nullptr when every contact is active. Zero length normals are treated as
+    //no contact unless VECTORMATH_REFLECT_UNIT_NORMALS is set.
+    EXPORT void VectorReflectResponse2DBatch(float* vx, float* vy, const float* nx, const float* ny, const unsigned char* mask, size_t n, float restitution, float friction, int flags);
+    EXPORT void VectorReflectResponseBatch(float* vx, float* vy, float* vz, const float* nx, const float* ny, const float* nz, const unsigned char* mask, size_t n, float restitution, float friction, int flags);
+    EXPORT void VectorReflectResponse2DArray(Vec2* velocities, const Vec2* normals, const unsigned char* mask, size_t n, float restitution, float friction, int flags);
+    EXPORT void VectorReflectResponseArray(Vec3* velocities, const Vec3* normals, const unsigned char* mask, size_t n, float restitution, float friction, int flags);
+
+
+    //Swept Collision
+    //Continuous tests for shapes moving along motion during one step, so fast
+    //objects cannot pass through thin colliders between frames. Return 1 on a
+    //hit; hit may be nullptr. A shape that already overlaps at the start hits
+    //at time 0 with the normal to push it out along.
+    EXPORT int SweepCircleSegment2D(Vec2 center, float radius, Vec2 motion, Vec2 segmentStart, Vec2 segmentEnd, SweepHit2D* hit);
+    EXPORT int SweepCircleAABB2D(Vec2 center, float radius, Vec2 motion, Vec2 boxMin, Vec2 boxMax, SweepHit2D* hit);
+    //Ray from origin to origin + motion
+    EXPORT int RayAABB2D(Vec2 origin, Vec2 motion, Vec2 boxMin, Vec2 boxMax, SweepHit2D* hit);
+    //time is along the first segment, normal faces against it. Parallel
+    //segments never hit.
+    EXPORT int SegmentIntersect2D(Vec2 start, Vec2 end, Vec2 otherStart, Vec2 otherEnd, SweepHit2D* hit);
+
+    //The same tests over parallel arrays, one pair per element
+    EXPORT void SweepCircleSegment2DArray(const Vec2* centers, const float* radii, const Vec2* motions, const Vec2* segmentStarts, const Vec2* segmentEnds, SweepHit2D* hits, size_t n);
+    EXPORT void SweepCircleAABB2DArray(const Vec2* centers, const float* radii, const Vec2* motions, const Vec2* boxMin, const Vec2* boxMax, SweepHit2D* hits, size_t n);
+    EXPORT void RayAABB2DArray(const Vec2* origins, const Vec2* motions, const Vec2* boxMin, const Vec2* boxMax, SweepHit2D* hits, size_t n);
+    EXPORT void SegmentIntersect2DArray(const Vec2* starts, const Vec2* ends, const Vec2* otherStarts, const Vec2* otherEnds, SweepHit2D* hits, size_t n);
+
+
+    //Spatial Hash Grid
+    //Broad-phase lookup over Vec2 points. Objects are identified by their index
+    //in the positions array (or the id returned by Insert). cellSize should be
+    //about the typical query radius.
+    //Query functions write up to capacity results and return the total found,
+    //so a caller can grow its buffer and query again. Pairs are written as two
+    //ids each (outPairs holds 2 * capacity ints), lower id first.
+    EXPORT SpatialGrid2D* SpatialGrid2DCreate(float cellSize); //nullptr if cellSize <= 0
+    EXPORT void SpatialGrid2DDestroy(SpatialGrid2D* grid);
+    EXPORT void SpatialGrid2DClear(SpatialGrid2D* grid);
+    EXPORT size_t SpatialGrid2DCount(const SpatialGrid2D* grid);
+    EXPORT void SpatialGrid2DBuild(SpatialGrid2D* grid, const Vec2* positions, size_t n);
+    EXPORT int SpatialGrid2DInsert(SpatialGrid2D* grid, Vec2 position);
+    EXPORT void SpatialGrid2DMove(SpatialGrid2D* grid, int id, Vec2 position);
+    //Per frame update: objects that stay in their cell are updated in place,
+    //the grid is only re-sorted when something changed cell.
+    //Build and Update leave the grid sorted, so the queries after them only
+    //read it and may run on several threads at once. Insert, Move and Clear
+    //leave the re-sort to the next query, which writes to the grid: run one
+    //query (or Update) first before querying from several threads.
+    EXPORT void SpatialGrid2DUpdate(SpatialGrid2D* grid, const Vec2* positions, size_t n);
+    EXPORT size_t SpatialGrid2DQueryRadius(SpatialGrid2D* grid, Vec2 center, float radius, int* outIds, size_t capacity);
+    EXPORT size_t SpatialGrid2DQueryAABB(SpatialGrid2D* grid, Vec2 boxMin, Vec2 boxMax, int* outIds, size_t capacity);
+    EXPORT size_t SpatialGrid2DQueryPairs(SpatialGrid2D* grid, float distance, int* outPairs, size_t capacity);
+
+    //Bounding Volume Hierarchy
+    //3D tree over boxes (boxMin / boxMax per object) or spheres, for ray casts
+    //and overlap queries in O(log n). Ids are indices into the build arrays.
+    //Refit keeps the tree shape and only updates the bounds (same object count
+    //as the build); rebuild once objects have moved far.
+    EXPORT Bvh3D* Bvh3DCreate();
+    EXPORT void Bvh3DDestroy(Bvh3D* bvh);
+    EXPORT void Bvh3DBuild(Bvh3D* bvh, const Vec3* boxMin, const Vec3* boxMax, size_t n);
+    EXPORT void Bvh3DBuildSpheres(Bvh3D* bvh, const Vec3* centers, const float* radii, size_t n);
+    EXPORT void Bvh3DRefit(Bvh3D* bvh, const Vec3* boxMin, const Vec3* boxMax);
+    EXPORT void Bvh3DRefitSpheres(Bvh3D* bvh, const Vec3* centers, const float* radii);
+    EXPORT size_t Bvh3DCount(const Bvh3D* bvh);
+    EXPORT size_t Bvh3DNodeCount(const Bvh3D* bvh);
+    //Closest object hit within maxDistance; direction does not need to be unit
+    //length, distances are along the normalized direction. Returns 1 on a hit.
+    EXPORT int Bvh3DRaycast(const Bvh3D* bvh, Vec3 origin, Vec3 direction, float maxDistance, RayHit* hit);
+    //Casts n rays in packets of 8 sharing one traversal, so coherent rays
+    //(e.g. from one camera) are cheaper than n Bvh3DRaycast calls
+    EXPORT void Bvh3DRaycastBatch(const Bvh3D* bvh, const Vec3* origins, const Vec3* directions, size_t n, float maxDistance, RayHit* hits);
+    //Overlap queries write up to capacity ids and return the total found
+    EXPORT size_t Bvh3DOverlapSphere(const Bvh3D* bvh, Vec3 center, float radius, int* outIds, size_t capacity);
+    EXPORT size_t Bvh3DOverlapAABB(const Bvh3D* bvh, Vec3 boxMin, Vec3 boxMax, int* outIds, size_t capacity);
+
+    //Reductions
+    //One value over a whole packed array, on the SIMD kernels and the thread
+    //pool. Each block of the array is reduced in a fixed lane order and the
+    //blocks are combined in array order, so results are bit-identical for
+    //every SIMD level and thread count. Large arrays run at memory bandwidth.
+    //Bounds skip NaN components; an empty array gives min +inf and max -inf.
+    EXPORT void VectorBounds2DArray(const Vec2* v, size_t n, Vec2* outMin, Vec2* outMax);
+    EXPORT void VectorBoundsArray(const Vec3* v, size_t n, Vec3* outMin, Vec3* outMax);
+    //Component sums; mode is a VectorMathSumMode
+    EXPORT Vec2 VectorSum2DArray(const Vec2* v, size_t n, int mode);
+    EXPORT Vec3 VectorSumArray(const Vec3* v, size_t n, int mode);
+    //Mean position (Kahan sums), zero for an empty array
+    EXPORT Vec2 VectorCentroid2DArray(const Vec2* v, size_t n);
+    EXPORT Vec3 VectorCentroidArray(const Vec3* v, size_t n);
+    //Sum of VectorDot(a[i], b[i]) over the array
+    EXPORT float VectorDotTotal2DArray(const Vec2* a, const Vec2* b, size_t n, int mode);
+    EXPORT float VectorDotTotalArray(const Vec3* a, const Vec3* b, size_t n, int mode);
+    //Shortest and longest vector; ties go to the lower index and vectors with
+    //a NaN component are skipped
+    EXPORT void VectorMagnitudeRange2DArray(const Vec2* v, size_t n, VectorMathMagnitudeRange* out);
+    EXPORT void VectorMagnitudeRangeArray(const Vec3* v, size_t n, VectorMathMagnitudeRange* out);
+
+    //Curves
+    //Cubic splines for camera rails, projectile paths and animation, sampled
+    //many at a time on the SIMD kernels. A curve is a run of points read as
+    //its VectorMathCurveType. t runs from 0 at the start to 1 at the end, each
+    //segment taking an equal share; t outside [0, 1] (and NaN) is clamped.
+    //Samples in the same segment are evaluated together, so sorted t is
+    //fastest. End points (and Catmull-Rom / Hermite points) are hit exactly.
+    //Evaluates curveCount curves of pointsPerCurve points each, stored one
+    //after the other, at the same tCount parameters: out[curve * tCount + i].
+    //Returns 0 and writes nothing when pointsPerCurve does not fit the type.
+    EXPORT int VectorCurveEvaluate2D(int type, const Vec2* points, size_t pointsPerCurve, size_t curveCount, const float* t, size_t tCount, Vec2* out);
+    EXPORT int VectorCurveEvaluate3D(int type, const Vec3* points, size_t pointsPerCurve, size_t curveCount, const float* t, size_t tCount, Vec3* out);
+    //Curve objects copy the points and cache the segments and an arc-length
+    //table of samplesPerSegment chords per segment (0 = 32), so sampling at
+    //distances along the curve (constant speed) needs no integration. Create
+    //returns nullptr when pointCount does not fit the type. Update takes the
+    //same number of points and rebuilds the table.
+    EXPORT Curve2D* Curve2DCreate(int type, const Vec2* points, size_t pointCount, size_t samplesPerSegment);
+    EXPORT void Curve2DDestroy(Curve2D* curve);
+    EXPORT void Curve2DUpdate(Curve2D* curve, const Vec2* points);
+    EXPORT float Curve2DLength(const Curve2D* curve);
+    EXPORT void Curve2DSample(const Curve2D* curve, const float* t, Vec2* out, size_t n);
+    //distances are clamped to [0, length]
+    EXPORT void Curve2DSampleDistance(const Curve2D* curve, const float* distances, Vec2* out, size_t n);
+    EXPORT void Curve2DParameterAtDistance(const Curve2D* curve, const float* distances, float* outT, size_t n);
+    EXPORT Curve3D* Curve3DCreate(int type, const Vec3* points, size_t pointCount, size_t samplesPerSegment);
+    EXPORT void Curve3DDestroy(Curve3D* curve);
+    EXPORT void Curve3DUpdate(Curve3D* curve, const Vec3* points);
+    EXPORT float Curve3DLength(const Curve3D* curve);
+    EXPORT void Curve3DSample(const Curve3D* curve, const float* t, Vec3* out, size_t n);
+    EXPORT void Curve3DSampleDistance(const Curve3D* curve, const float* distances, Vec3* out, size_t n);
+    EXPORT void Curve3DParameterAtDistance(const Curve3D* curve, const float* distances, float* outT, size_t n);
+
+    //Spatial Sorting
+    //Orders entities along a Z-order (Morton) curve, so entities close in
+    //space end up close in memory and the grid, BVH and array functions touch
+    //fewer cache lines. Re-sort every few frames as things move.
+    //Morton codes quantize positions inside the bounds (outside points are
+    //clamped) to 16 bits per axis in 2D and 10 bits per axis in 3D.
+    EXPORT void VectorMortonCodes2D(const Vec2* positions, Vec2 boundsMin, Vec2 boundsMax, uint32_t* outCodes, size_t n);
+    EXPORT void VectorMortonCodes3D(const Vec3* positions, Vec3 boundsMin, Vec3 boundsMax, uint32_t* outCodes, size_t n);
+    //Stable sort of the indices 0..n-1 by key (parallel LSD radix sort):
+    //outPermutation[i] is the index of the element that goes to position i.
+    //n must be below 2^32.
+    EXPORT void VectorRadixSortKeys(const uint32_t* keys, uint32_t* outPermutation, size_t n);
+    //Morton codes over the positions' own bounds, then the sort above.
+    //outPositions (may be nullptr) receives the positions in sorted order and
+    //must not overlap positions.
+    EXPORT void VectorMortonSort2D(const Vec2* positions, uint32_t* outPermutation, Vec2* outPositions, size_t n);
+    EXPORT void VectorMortonSort3D(const Vec3* positions, uint32_t* outPermutation, Vec3* outPositions, size_t n);
+    //out[i] = in[permutation[i]], to apply a sort to the companion arrays
+    //(velocities, ids, ...). out must not overlap in.
+    EXPORT void VectorReorder2DArray(const Vec2* in, const uint32_t* permutation, Vec2* out, size_t n);
+    EXPORT void VectorReorderArray(const Vec3* in, const uint32_t* permutation, Vec3* out, size_t n);
+    EXPORT void VectorReorderFloatArray(const float* in, const uint32_t* permutation, float* out, size_t n);
+    //Any element type, elementSize bytes each
+    EXPORT void VectorReorderElements(const void* in, size_t elementSize, const uint32_t* permutation, void* out, size_t n);
+
+    //Snapshots
+    //Records per-frame arrays (positions, directions, ...) to a file for
+    //replays and offline analysis. Frames are stored in chunks of
+    //framesPerChunk (0 = 64), each chunk holding every channel as one
+    //contiguous column.
+    //Create returns nullptr when a channel is invalid or the file cannot be
+    //created. Write copies one channel's count * components floats into the
+    //current frame; channels not written keep their previous values (zeros
+    //at first). EndFrame only copies the frame: full chunks are encoded and
+    //written by a background thread, and EndFrame waits only when the disk
+    //falls 8 chunks behind. Write and EndFrame return 0 once the file could
+    //not be written (disk full, ...).
+    EXPORT SnapshotWriter* SnapshotWriterCreate(const char* path, const VectorMathSnapshotChannel* channels, size_t channelCount, uint32_t framesPerChunk);
+    EXPORT int SnapshotWriterWrite(SnapshotWriter* writer, size_t channel, const float* values);
+    EXPORT int SnapshotWriterEndFrame(SnapshotWriter* writer);
+    EXPORT uint64_t SnapshotWriterFrameCount(const SnapshotWriter* writer);
+    //Writes the remaining frames and the chunk index, then frees the writer.
+    //Returns 1 when everything reached the file.
+    EXPORT int SnapshotWriterClose(SnapshotWriter* writer);
+
+    //The reader maps the file into memory instead of reading it. A file whose
+    //writer never closed (crash) is read up to its last complete chunk.
+    //Readers are immutable after Open, so any number of threads may read.
+    EXPORT SnapshotReader* SnapshotReaderOpen(const char* path); //nullptr if not a snapshot file
+    EXPORT void SnapshotReaderClose(SnapshotReader* reader);
+    EXPORT uint64_t SnapshotReaderFrameCount(const SnapshotReader* reader);
+    EXPORT size_t SnapshotReaderChannelCount(const SnapshotReader* reader);
+    EXPORT int SnapshotReaderGetChannel(const SnapshotReader* reader, size_t channel, VectorMathSnapshotChannel* out);
+    EXPORT int SnapshotReaderFindChannel(const SnapshotReader* reader, const char* name); //-1 if missing
+    //One frame of a raw channel inside the mapping (no copy), valid until
+    //Close: pass it straight to the array functions (as const Vec2* etc.).
+    //nullptr for delta channels and frames out of range.
+    EXPORT const float* SnapshotReaderFrameData(const SnapshotReader* reader, size_t channel, uint64_t frame);
+    //Copies (raw) or decodes (delta) frameCount frames from firstFrame into
+    //out, frame after frame. Returns the frames read, fewer at the end of the
+    //file. Reading many frames per call is much cheaper for delta channels,
+    //which decode from the start of a chunk.
+    EXPORT size_t SnapshotReaderRead(const SnapshotReader* reader, size_t channel, uint64_t firstFrame, size_t frameCount, float* out);
+
+    //CPU Dispatch
+    //The batch functions run on the fastest instruction set the CPU supports,
+    //chosen once when the library loads. These report or override that choice.
+    EXPORT int VectorMathGetSimdLevel();
+    EXPORT const char* VectorMathGetSimdName();
+    EXPORT int VectorMathIsSimdLevelSupported(int level);
+    EXPORT int VectorMathSetSimdLevel(int level);
+
+    //1 when the library was built with VECTORMATH_DETERMINISTIC: results are
+    //then bit-identical on every compiler, OS and CPU (x86 and ARM), whatever
+    //the SIMD level and thread count, as long as the FPU is left in its
+    //default mode (round to nearest, denormals not flushed to zero).
+    EXPORT int VectorMathIsDeterministic();
+
+
+    //Threading
+    //Batch, Array and physics calls over at least the parallel threshold
+    //(default 65536 vectors) are split across a pool of worker threads owned by
+    //the library. Results are identical to a single threaded run.
+    //count is the total number of threads including the caller: 0 = one per
+    //logical CPU (default), 1 = run everything on the calling thread.
+    EXPORT void VectorMathSetThreadCount(int count);
+    EXPORT int VectorMathGetThreadCount();
+    EXPORT void VectorMathSetParallelThreshold(size_t minElements);
+    EXPORT size_t VectorMathGetParallelThreshold();
+    //Pins worker i to logical CPU i; the calling thread is left alone.
+    //Windows and Linux only, ignored elsewhere.
+    EXPORT void VectorMathSetThreadPinning(int enabled);
+    //Stops and joins the worker threads; the next call that needs them starts
+    //them again. Call it before unloading the library (FreeLibrary, or
+    //OnApplicationQuit in Unity): a Windows DLL cannot join threads while it
+    //is being unloaded, so there the workers are only detached.
+    EXPORT void VectorMathShutdownThreads();
+
+    //Runs task(userData, begin, end) over [0, n) on the pool, in chunks of
+    //grain elements (0 = 4096), regardless of the threshold. Chunks run
+    //concurrently, so the task must be thread safe. Nested calls from inside a
+    //task, or calls while another thread's job is running, run on the calling
+    //thread instead.
+    typedef void (*VectorMathTask)(void* userData, size_t begin, size_t end);
+    EXPORT void VectorMathParallelFor(size_t n, size_t grain, VectorMathTask task, void* userData);
+
+
+    //Frame Arena
+    //Every thread gets one fixed-capacity arena (default 4 MB), created the
+    //first time it is needed. The library takes its temporary buffers from it
+    //instead of the heap, and callers can use it for their own per-frame data.
+    //Call Begin and End once per frame from one thread while no other library
+    //call is running: both empty every thread's arena.
+    EXPORT void VectorMathFrameBegin();
+    EXPORT void VectorMathFrameEnd();
+    //Memory from the calling thread's arena, valid until the next Begin/End.
+    //alignment is a power of two (0 = 16). Returns nullptr when the arena is
+    //full; memory use never grows past the capacity.
+    EXPORT void* VectorMathFrameAlloc(size_t size, size_t alignment);
+    //Takes effect at the next Begin/End (0 = default)
+    EXPORT void VectorMathSetFrameArenaCapacity(size_t bytesPerThread);
+    EXPORT void VectorMathGetFrameArenaStats(VectorMathArenaStats* stats);
+
+    //Instrumentation
+    //Builds configured with VECTORMATH_ENABLE_STATS count the calls, elements
+    //and time of every exported function, per thread and without locks. An
+    //export that calls another one (the plain normalize functions call the Ex
+    //ones) counts in both. In normal builds the counting compiles away and
+    //these report nothing.
+    EXPORT int VectorMathStatsEnabled();
+    //Copies up to capacity entries, slowest (most ticks) first, for the
+    //functions called since the last reset. Returns the total count, so call
+    //with capacity 0 to size the array.
+    EXPORT size_t VectorMathGetStats(VectorMathFunctionStats* stats, size_t capacity);
+    EXPORT void VectorMathResetStats();
+    //The same entries as JSON:
+    //{"enabled":true,"functions":[{"name":"...","calls":1,"elements":1,"ticks":1},...]}
+    //Writes at most capacity - 1 characters plus a terminating 0 and returns
+    //the full length, so a result >= capacity means the text was cut short.
+    EXPORT size_t VectorMathGetStatsJson(char* buffer, size_t capacity);
+    //Returns 1 once the JSON is written to path, 0 on failure
+    EXPORT int VectorMathWriteStatsJson(const char* path);
 }
 
 #endif
\ No newline at end of file
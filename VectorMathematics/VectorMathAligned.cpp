@@ -0,0 +1,340 @@
+//Always include the pch.h first in every cpp
+#include "pch.h"
+
+//Then include own items
+#include "VectorMath.h"
+#include "VectorMathKernels.h"
+#include "VectorMathThreads.h"
+#include "VectorMathStats.h"
+
+//C exports for the aligned Vec4 / Vec3A types. The single vector functions
+//are thin wrappers over VectorMathAligned.h. In the arrays every element is
+//four floats, so the component-wise operations run over 4n floats as one flat
+//stream and Dot, Magnitude, Normalize and Cross use the packed-4 kernels.
+
+using namespace vmath;
+
+static_assert(sizeof(Vec4) == 16 && alignof(Vec4) == 16, "Vec4 must be one 16-byte register");
+static_assert(sizeof(Vec3A) == 16 && alignof(Vec3A) == 16, "Vec3A must be one 16-byte register");
+
+
+//Vec4
+
+void VectorAdd4D(const Vec4* a, const Vec4* b, Vec4* out) {
+	VECTORMATH_STATS(1);
+	*out = *a + *b;
+}
+
+void VectorSubtract4D(const Vec4* a, const Vec4* b, Vec4* out) {
+	VECTORMATH_STATS(1);
+	*out = *a - *b;
+}
+
+void VectorScale4D(const Vec4* v, float scale, Vec4* out) {
+	VECTORMATH_STATS(1);
+	*out = *v * scale;
+}
+
+void VectorDivide4D(const Vec4* v, float scalar, Vec4* out) {
+	VECTORMATH_STATS(1);
+	*out = *v / scalar;
+}
+
+float VectorMagnitude4D(const Vec4* v) {
+	VECTORMATH_STATS(1);
+	return Magnitude(*v);
+}
+
+void VectorNormalize4D(const Vec4* v, Vec4* out) {
+	VECTORMATH_STATS(1);
+	*out = Normalize(*v);
+}
+
+float VectorDot4D(const Vec4* a, const Vec4* b) {
+	VECTORMATH_STATS(1);
+	return Dot(*a, *b);
+}
+
+void VectorLerp4D(const Vec4* a, const Vec4* b, float t, Vec4* out) {
+	VECTORMATH_STATS(1);
+	*out = Lerp(*a, *b, t);
+}
+
+void VectorReflect4D(const Vec4* v, const Vec4* normal, Vec4* out) {
+	VECTORMATH_STATS(1);
+	*out = Reflect(*v, *normal);
+}
+
+void VectorClampMagnitude4D(const Vec4* v, float maxLength, Vec4* out) {
+	VECTORMATH_STATS(1);
+	*out = ClampMagnitude(*v, maxLength);
+}
+
+void VectorClamp4D(const Vec4* v, float minVal, float maxVal, Vec4* out) {
+	VECTORMATH_STATS(1);
+	*out = vmath::Clamp(*v, minVal, maxVal);
+}
+
+
+//Vec3A
+
+void VectorAdd3A(const Vec3A* a, const Vec3A* b, Vec3A* out) {
+	VECTORMATH_STATS(1);
+	*out = *a + *b;
+}
+
+void VectorSubtract3A(const Vec3A* a, const Vec3A* b, Vec3A* out) {
+	VECTORMATH_STATS(1);
+	*out = *a - *b;
+}
+
+void VectorScale3A(const Vec3A* v, float scale, Vec3A* out) {
+	VECTORMATH_STATS(1);
+	*out = *v * scale;
+}
+
+void VectorDivide3A(const Vec3A* v, float scalar, Vec3A* out) {
+	VECTORMATH_STATS(1);
+	*out = *v / scalar;
+}
+
+float VectorMagnitude3A(const Vec3A* v) {
+	VECTORMATH_STATS(1);
+	return Magnitude(*v);
+}
+
+void VectorNormalize3A(const Vec3A* v, Vec3A* out) {
+	VECTORMATH_STATS(1);
+	*out = Normalize(*v);
+}
+
+float VectorDot3A(const Vec3A* a, const Vec3A* b) {
+	VECTORMATH_STATS(1);
+	return Dot(*a, *b);
+}
+
+void VectorCross3A(const Vec3A* a, const Vec3A* b, Vec3A* out) {
+	VECTORMATH_STATS(1);
+	*out = Cross(*a, *b);
+}
+
+void VectorLerp3A(const Vec3A* a, const Vec3A* b, float t, Vec3A* out) {
+	VECTORMATH_STATS(1);
+	*out = Lerp(*a, *b, t);
+}
+
+void VectorReflect3A(const Vec3A* v, const Vec3A* normal, Vec3A* out) {
+	VECTORMATH_STATS(1);
+	*out = Reflect(*v, *normal);
+}
+
+void VectorClampMagnitude3A(const Vec3A* v, float maxLength, Vec3A* out) {
+	VECTORMATH_STATS(1);
+	*out = ClampMagnitude(*v, maxLength);
+}
+
+void VectorClamp3A(const Vec3A* v, float minVal, float maxVal, Vec3A* out) {
+	VECTORMATH_STATS(1);
+	*out = vmath::Clamp(*v, minVal, maxVal);
+}
+
+
+//Arrays
+//Vec4 and Vec3A share the flat and packed-4 kernels; only the component count
+//and the element type differ, so both go through these helpers.
+
+template <typename V>
+static void AddArray(const V* a, const V* b, V* out, size_t n) {
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.add(&a[begin].x, &b[begin].x, &out[begin].x, (end - begin) * 4);
+	});
+}
+
+template <typename V>
+static void SubtractArray(const V* a, const V* b, V* out, size_t n) {
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.subtract(&a[begin].x, &b[begin].x, &out[begin].x, (end - begin) * 4);
+	});
+}
+
+template <typename V>
+static void ScaleArray(const V* v, float scale, V* out, size_t n) {
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.scale(&v[begin].x, scale, &out[begin].x, (end - begin) * 4);
+	});
+}
+
+template <typename V>
+static void ClampArray(const V* v, float minVal, float maxVal, V* out, size_t n) {
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.clamp(&v[begin].x, minVal, maxVal, &out[begin].x, (end - begin) * 4);
+	});
+}
+
+template <typename V>
+static void MagnitudeArray(const V* v, int components, float* out, size_t n) {
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.magnitude4(&v[begin].x, components, out + begin, end - begin);
+	});
+}
+
+template <typename V>
+static void NormalizeArray(const V* v, int components, V* out, size_t n) {
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.normalize4(&v[begin].x, components, &out[begin].x, end - begin);
+	});
+}
+
+template <typename V>
+static void DotArray(const V* a, const V* b, int components, float* out, size_t n) {
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.dot4(&a[begin].x, &b[begin].x, components, out + begin, end - begin);
+	});
+}
+
+//The rest have no kernel and call the inline layer per element
+template <typename V, typename Op>
+static void ForEachArray(V* out, size_t n, const Op& op) {
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			out[i] = op(i);
+		}
+	});
+}
+
+
+void VectorAdd4DArray(const Vec4* a, const Vec4* b, Vec4* out, size_t n) {
+	VECTORMATH_STATS(n);
+	AddArray(a, b, out, n);
+}
+
+void VectorSubtract4DArray(const Vec4* a, const Vec4* b, Vec4* out, size_t n) {
+	VECTORMATH_STATS(n);
+	SubtractArray(a, b, out, n);
+}
+
+void VectorScale4DArray(const Vec4* v, float scale, Vec4* out, size_t n) {
+	VECTORMATH_STATS(n);
+	ScaleArray(v, scale, out, n);
+}
+
+void VectorDivide4DArray(const Vec4* v, float scalar, Vec4* out, size_t n) {
+	VECTORMATH_STATS(n);
+	ForEachArray(out, n, [&](size_t i) { return v[i] / scalar; });
+}
+
+void VectorMagnitude4DArray(const Vec4* v, float* out, size_t n) {
+	VECTORMATH_STATS(n);
+	MagnitudeArray(v, 4, out, n);
+}
+
+void VectorNormalize4DArray(const Vec4* v, Vec4* out, size_t n) {
+	VECTORMATH_STATS(n);
+	NormalizeArray(v, 4, out, n);
+}
+
+void VectorDot4DArray(const Vec4* a, const Vec4* b, float* out, size_t n) {
+	VECTORMATH_STATS(n);
+	DotArray(a, b, 4, out, n);
+}
+
+void VectorLerp4DArray(const Vec4* a, const Vec4* b, float t, Vec4* out, size_t n) {
+	VECTORMATH_STATS(n);
+	ForEachArray(out, n, [&](size_t i) { return Lerp(a[i], b[i], t); });
+}
+
+void VectorReflect4DArray(const Vec4* v, const Vec4* normals, Vec4* out, size_t n) {
+	VECTORMATH_STATS(n);
+	ForEachArray(out, n, [&](size_t i) { return Reflect(v[i], normals[i]); });
+}
+
+void VectorClampMagnitude4DArray(const Vec4* v, float maxLength, Vec4* out, size_t n) {
+	VECTORMATH_STATS(n);
+	ForEachArray(out, n, [&](size_t i) { return ClampMagnitude(v[i], maxLength); });
+}
+
+void VectorClamp4DArray(const Vec4* v, float minVal, float maxVal, Vec4* out, size_t n) {
+	VECTORMATH_STATS(n);
+	ClampArray(v, minVal, maxVal, out, n);
+}
+
+
+void VectorAdd3AArray(const Vec3A* a, const Vec3A* b, Vec3A* out, size_t n) {
+	VECTORMATH_STATS(n);
+	AddArray(a, b, out, n);
+}
+
+void VectorSubtract3AArray(const Vec3A* a, const Vec3A* b, Vec3A* out, size_t n) {
+	VECTORMATH_STATS(n);
+	SubtractArray(a, b, out, n);
+}
+
+void VectorScale3AArray(const Vec3A* v, float scale, Vec3A* out, size_t n) {
+	VECTORMATH_STATS(n);
+	ScaleArray(v, scale, out, n);
+}
+
+void VectorDivide3AArray(const Vec3A* v, float scalar, Vec3A* out, size_t n) {
+	VECTORMATH_STATS(n);
+	ForEachArray(out, n, [&](size_t i) { return v[i] / scalar; });
+}
+
+void VectorMagnitude3AArray(const Vec3A* v, float* out, size_t n) {
+	VECTORMATH_STATS(n);
+	MagnitudeArray(v, 3, out, n);
+}
+
+void VectorNormalize3AArray(const Vec3A* v, Vec3A* out, size_t n) {
+	VECTORMATH_STATS(n);
+	NormalizeArray(v, 3, out, n);
+}
+
+void VectorDot3AArray(const Vec3A* a, const Vec3A* b, float* out, size_t n) {
+	VECTORMATH_STATS(n);
+	DotArray(a, b, 3, out, n);
+}
+
+void VectorCross3AArray(const Vec3A* a, const Vec3A* b, Vec3A* out, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.cross3A(&a[begin].x, &b[begin].x, &out[begin].x, end - begin);
+	});
+}
+
+void VectorLerp3AArray(const Vec3A* a, const Vec3A* b, float t, Vec3A* out, size_t n) {
+	VECTORMATH_STATS(n);
+	ForEachArray(out, n, [&](size_t i) { return Lerp(a[i], b[i], t); });
+}
+
+void VectorReflect3AArray(const Vec3A* v, const Vec3A* normals, Vec3A* out, size_t n) {
+	VECTORMATH_STATS(n);
+	ForEachArray(out, n, [&](size_t i) { return Reflect(v[i], normals[i]); });
+}
+
+void VectorClampMagnitude3AArray(const Vec3A* v, float maxLength, Vec3A* out, size_t n) {
+	VECTORMATH_STATS(n);
+	ForEachArray(out, n, [&](size_t i) { return ClampMagnitude(v[i], maxLength); });
+}
+
+void VectorClamp3AArray(const Vec3A* v, float minVal, float maxVal, Vec3A* out, size_t n) {
+	VECTORMATH_STATS(n);
+	ClampArray(v, minVal, maxVal, out, n);
+}
+
+void VectorToVec3AArray(const Vec3* v, Vec3A* out, size_t n) {
+	VECTORMATH_STATS(n);
+	ForEachArray(out, n, [&](size_t i) { return ToVec3A(v[i]); });
+}
+
+void VectorFromVec3AArray(const Vec3A* v, Vec3* out, size_t n) {
+	VECTORMATH_STATS(n);
+	ForEachArray(out, n, [&](size_t i) { return ToVec3(v[i]); });
+}
@@ -0,0 +1,327 @@
+#pragma once
+
+#ifndef VECTOR_MATH_ALIGNED_H
+#define VECTOR_MATH_ALIGNED_H
+
+#include "VectorMathInline.h"
+
+//16-byte (for float) aligned vector types for SIMD-friendly storage. A Vec3T
+//is 12 bytes, so SIMD code has to assemble it from unaligned or partial
+//loads; these are exactly one register wide and load with a single aligned
+//instruction.
+//  Vec4T:  four components, all of them part of the vector.
+//  Vec3AT: a Vec3T padded to four components. pad is not part of the
+//          vector: Dot, Magnitude, Normalize, Cross, ... ignore it and write
+//          0. The component-wise operations (+, -, *, /, Lerp, Clamp,
+//          ScaleAdd) apply to pad as well, so it can hold any value.
+//Vec3AT functions give exactly the x/y/z results of the Vec3T functions.
+//
+//Like Mat4T, the aligned types are passed by const reference: 32-bit MSVC
+//cannot pass over-aligned structs by value.
+
+namespace vmath {
+
+template <typename T>
+struct alignas(4 * sizeof(T)) Vec4T {
+    T x;
+    T y;
+    T z;
+    T w;
+};
+
+template <typename T>
+struct alignas(4 * sizeof(T)) Vec3AT {
+    T x;
+    T y;
+    T z;
+    T pad;
+};
+
+
+//Conversion
+template <typename T>
+constexpr Vec3AT<T> ToVec3A(Vec3T<T> v) {
+    return { v.x, v.y, v.z, T(0) };
+}
+
+template <typename T>
+constexpr Vec3T<T> ToVec3(const Vec3AT<T>& v) {
+    return { v.x, v.y, v.z };
+}
+
+template <typename T>
+constexpr Vec4T<T> ToVec4(Vec3T<T> v, Scalar<T> w) {
+    return { v.x, v.y, v.z, w };
+}
+
+
+//Vec4 Operators
+template <typename T>
+constexpr Vec4T<T> operator+(const Vec4T<T>& a, const Vec4T<T>& b) {
+    return { a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w };
+}
+
+template <typename T>
+constexpr Vec4T<T> operator-(const Vec4T<T>& a, const Vec4T<T>& b) {
+    return { a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w };
+}
+
+template <typename T>
+constexpr Vec4T<T> operator-(const Vec4T<T>& v) {
+    return { -v.x, -v.y, -v.z, -v.w };
+}
+
+template <typename T>
+constexpr Vec4T<T> operator*(const Vec4T<T>& v, Scalar<T> scale) {
+    return { v.x * scale, v.y * scale, v.z * scale, v.w * scale };
+}
+
+template <typename T>
+constexpr Vec4T<T> operator*(Scalar<T> scale, const Vec4T<T>& v) {
+    return { scale * v.x, scale * v.y, scale * v.z, scale * v.w };
+}
+
+//Safe divide: returns the zero vector when scalar < Epsilon
+template <typename T>
+constexpr Vec4T<T> operator/(const Vec4T<T>& v, Scalar<T> scalar) {
+    return scalar < Epsilon<T>() ? Vec4T<T>{ T(0), T(0), T(0), T(0) } : Vec4T<T>{ v.x / scalar, v.y / scalar, v.z / scalar, v.w / scalar };
+}
+
+template <typename T>
+constexpr Vec4T<T>& operator+=(Vec4T<T>& a, const Vec4T<T>& b) {
+    return a = a + b;
+}
+
+template <typename T>
+constexpr Vec4T<T>& operator-=(Vec4T<T>& a, const Vec4T<T>& b) {
+    return a = a - b;
+}
+
+template <typename T>
+constexpr Vec4T<T>& operator*=(Vec4T<T>& v, Scalar<T> scale) {
+    return v = v * scale;
+}
+
+template <typename T>
+constexpr Vec4T<T>& operator/=(Vec4T<T>& v, Scalar<T> scalar) {
+    return v = v / scalar;
+}
+
+template <typename T>
+constexpr bool operator==(const Vec4T<T>& a, const Vec4T<T>& b) {
+    return a.x == b.x && a.y == b.y && a.z == b.z && a.w == b.w;
+}
+
+template <typename T>
+constexpr bool operator!=(const Vec4T<T>& a, const Vec4T<T>& b) {
+    return !(a == b);
+}
+
+
+//Vec4 Functions
+template <typename T>
+constexpr T Dot(const Vec4T<T>& a, const Vec4T<T>& b) {
+    return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+}
+
+template <typename T>
+constexpr T MagnitudeSquared(const Vec4T<T>& v) {
+    return v.x * v.x + v.y * v.y + v.z * v.z + v.w * v.w;
+}
+
+template <typename T>
+inline T Magnitude(const Vec4T<T>& v) {
+    return Sqrt(MagnitudeSquared(v));
+}
+
+//Safe normalize: returns the zero vector when the length is below Epsilon
+template <typename T>
+inline Vec4T<T> Normalize(const Vec4T<T>& v) {
+    T m = Magnitude(v);
+    if (m < Epsilon<T>()) {
+        return { T(0), T(0), T(0), T(0) };
+    }
+    return v / m;
+}
+
+template <typename T>
+constexpr Vec4T<T> Lerp(const Vec4T<T>& a, const Vec4T<T>& b, Scalar<T> t) {
+    return { a.x + t * (b.x - a.x), a.y + t * (b.y - a.y), a.z + t * (b.z - a.z), a.w + t * (b.w - a.w) };
+}
+
+//R = V - 2 * dot(V, N) * N, normalizing N first
+template <typename T>
+inline Vec4T<T> Reflect(const Vec4T<T>& v, const Vec4T<T>& normal) {
+    Vec4T<T> n = Normalize(normal);
+    T d = Dot(v, n);
+    return v - n * (T(2) * d);
+}
+
+template <typename T>
+constexpr Vec4T<T> Clamp(const Vec4T<T>& v, Scalar<T> minVal, Scalar<T> maxVal) {
+    return { Clamp(v.x, minVal, maxVal), Clamp(v.y, minVal, maxVal), Clamp(v.z, minVal, maxVal), Clamp(v.w, minVal, maxVal) };
+}
+
+template <typename T>
+inline Vec4T<T> ClampMagnitude(const Vec4T<T>& v, Scalar<T> maxLength) {
+    T m = Magnitude(v);
+    if (m < Epsilon<T>()) {
+        return { T(0), T(0), T(0), T(0) };
+    }
+    if (m > maxLength) {
+        return (v / m) * maxLength;
+    }
+    return v;
+}
+
+template <typename T>
+constexpr Vec4T<T> ScaleAdd(const Vec4T<T>& a, const Vec4T<T>& b, Scalar<T> scale) {
+    return { a.x + b.x * scale, a.y + b.y * scale, a.z + b.z * scale, a.w + b.w * scale };
+}
+
+template <typename T>
+constexpr Vec4T<T> Min(const Vec4T<T>& a, const Vec4T<T>& b) {
+    return { a.x < b.x ? a.x : b.x, a.y < b.y ? a.y : b.y, a.z < b.z ? a.z : b.z, a.w < b.w ? a.w : b.w };
+}
+
+template <typename T>
+constexpr Vec4T<T> Max(const Vec4T<T>& a, const Vec4T<T>& b) {
+    return { a.x > b.x ? a.x : b.x, a.y > b.y ? a.y : b.y, a.z > b.z ? a.z : b.z, a.w > b.w ? a.w : b.w };
+}
+
+
+//Vec3A Operators
+//Component-wise over all four lanes, so compilers can keep them in one register
+template <typename T>
+constexpr Vec3AT<T> operator+(const Vec3AT<T>& a, const Vec3AT<T>& b) {
+    return { a.x + b.x, a.y + b.y, a.z + b.z, a.pad + b.pad };
+}
+
+template <typename T>
+constexpr Vec3AT<T> operator-(const Vec3AT<T>& a, const Vec3AT<T>& b) {
+    return { a.x - b.x, a.y - b.y, a.z - b.z, a.pad - b.pad };
+}
+
+template <typename T>
+constexpr Vec3AT<T> operator-(const Vec3AT<T>& v) {
+    return { -v.x, -v.y, -v.z, -v.pad };
+}
+
+template <typename T>
+constexpr Vec3AT<T> operator*(const Vec3AT<T>& v, Scalar<T> scale) {
+    return { v.x * scale, v.y * scale, v.z * scale, v.pad * scale };
+}
+
+template <typename T>
+constexpr Vec3AT<T> operator*(Scalar<T> scale, const Vec3AT<T>& v) {
+    return { scale * v.x, scale * v.y, scale * v.z, scale * v.pad };
+}
+
+//Safe divide: returns the zero vector when scalar < Epsilon
+template <typename T>
+constexpr Vec3AT<T> operator/(const Vec3AT<T>& v, Scalar<T> scalar) {
+    return scalar < Epsilon<T>() ? Vec3AT<T>{ T(0), T(0), T(0), T(0) } : Vec3AT<T>{ v.x / scalar, v.y / scalar, v.z / scalar, v.pad / scalar };
+}
+
+template <typename T>
+constexpr Vec3AT<T>& operator+=(Vec3AT<T>& a, const Vec3AT<T>& b) {
+    return a = a + b;
+}
+
+template <typename T>
+constexpr Vec3AT<T>& operator-=(Vec3AT<T>& a, const Vec3AT<T>& b) {
+    return a = a - b;
+}
+
+template <typename T>
+constexpr Vec3AT<T>& operator*=(Vec3AT<T>& v, Scalar<T> scale) {
+    return v = v * scale;
+}
+
+template <typename T>
+constexpr Vec3AT<T>& operator/=(Vec3AT<T>& v, Scalar<T> scalar) {
+    return v = v / scalar;
+}
+
+//pad is not compared
+template <typename T>
+constexpr bool operator==(const Vec3AT<T>& a, const Vec3AT<T>& b) {
+    return a.x == b.x && a.y == b.y && a.z == b.z;
+}
+
+template <typename T>
+constexpr bool operator!=(const Vec3AT<T>& a, const Vec3AT<T>& b) {
+    return !(a == b);
+}
+
+
+//Vec3A Functions
+//The same maths as the Vec3T versions, so the results match them exactly
+template <typename T>
+constexpr T Dot(const Vec3AT<T>& a, const Vec3AT<T>& b) {
+    return Dot(ToVec3(a), ToVec3(b));
+}
+
+template <typename T>
+constexpr Vec3AT<T> Cross(const Vec3AT<T>& a, const Vec3AT<T>& b) {
+    return ToVec3A(Cross(ToVec3(a), ToVec3(b)));
+}
+
+template <typename T>
+constexpr T MagnitudeSquared(const Vec3AT<T>& v) {
+    return MagnitudeSquared(ToVec3(v));
+}
+
+template <typename T>
+inline T Magnitude(const Vec3AT<T>& v) {
+    return Magnitude(ToVec3(v));
+}
+
+template <typename T>
+inline Vec3AT<T> Normalize(const Vec3AT<T>& v) {
+    return ToVec3A(Normalize(ToVec3(v)));
+}
+
+template <typename T>
+inline Vec3AT<T> NormalizeFast(const Vec3AT<T>& v) {
+    return ToVec3A(NormalizeFast(ToVec3(v)));
+}
+
+template <typename T>
+constexpr Vec3AT<T> Lerp(const Vec3AT<T>& a, const Vec3AT<T>& b, Scalar<T> t) {
+    return { a.x + t * (b.x - a.x), a.y + t * (b.y - a.y), a.z + t * (b.z - a.z), a.pad + t * (b.pad - a.pad) };
+}
+
+template <typename T>
+inline Vec3AT<T> Reflect(const Vec3AT<T>& v, const Vec3AT<T>& normal) {
+    return ToVec3A(Reflect(ToVec3(v), ToVec3(normal)));
+}
+
+template <typename T>
+constexpr Vec3AT<T> Clamp(const Vec3AT<T>& v, Scalar<T> minVal, Scalar<T> maxVal) {
+    return { Clamp(v.x, minVal, maxVal), Clamp(v.y, minVal, maxVal), Clamp(v.z, minVal, maxVal), Clamp(v.pad, minVal, maxVal) };
+}
+
+template <typename T>
+inline Vec3AT<T> ClampMagnitude(const Vec3AT<T>& v, Scalar<T> maxLength) {
+    return ToVec3A(ClampMagnitude(ToVec3(v), maxLength));
+}
+
+template <typename T>
+constexpr Vec3AT<T> ScaleAdd(const Vec3AT<T>& a, const Vec3AT<T>& b, Scalar<T> scale) {
+    return { a.x + b.x * scale, a.y + b.y * scale, a.z + b.z * scale, a.pad + b.pad * scale };
+}
+
+template <typename T>
+constexpr Vec3AT<T> Min(const Vec3AT<T>& a, const Vec3AT<T>& b) {
+    return ToVec3A(Min(ToVec3(a), ToVec3(b)));
+}
+
+template <typename T>
+constexpr Vec3AT<T> Max(const Vec3AT<T>& a, const Vec3AT<T>& b) {
+    return ToVec3A(Max(ToVec3(a), ToVec3(b)));
+}
+
+} // namespace vmath
+
+#endif
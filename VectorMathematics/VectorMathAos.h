@@ -0,0 +1,64 @@
+#pragma once
+
+#ifndef VECTOR_MATH_AOS_H
+#define VECTOR_MATH_AOS_H
+
+#include <cstddef>
+#include "VectorMath.h"
+#include "VectorMathArena.h"
+
+//Internal header - not part of the exported API.
+//Array operations that mix components of packed Vec2/Vec3 arrays (magnitude,
+//normalize, reflect, collision response, ...) split kAosBlock vectors at a
+//time into SoA columns, run the SoA kernel there and interleave the result
+//back. The columns come from the thread's scratch arena, and a block is read
+//completely before it is written, so in-place calls stay correct.
+
+static const size_t kAosBlock = 256;
+
+//kAosBlock floats per column, from the calling thread's scratch arena
+class AosColumns {
+public:
+	explicit AosColumns(size_t columns) : buffer(columns * kAosBlock) {}
+	float* operator[](size_t column) { return buffer.Data() + column * kAosBlock; }
+
+private:
+	ScratchBuffer<float> buffer;
+};
+
+inline void Split(const Vec2* v, size_t count, float* x, float* y) {
+	for (size_t i = 0; i < count; ++i) {
+		x[i] = v[i].x;
+		y[i] = v[i].y;
+	}
+}
+
+inline void Split(const Vec3* v, size_t count, float* x, float* y, float* z) {
+	for (size_t i = 0; i < count; ++i) {
+		x[i] = v[i].x;
+		y[i] = v[i].y;
+		z[i] = v[i].z;
+	}
+}
+
+inline void Join(const float* x, const float* y, size_t count, Vec2* out) {
+	for (size_t i = 0; i < count; ++i) {
+		out[i] = { x[i], y[i] };
+	}
+}
+
+inline void Join(const float* x, const float* y, const float* z, size_t count, Vec3* out) {
+	for (size_t i = 0; i < count; ++i) {
+		out[i] = { x[i], y[i], z[i] };
+	}
+}
+
+//Calls block(first, count) for [begin, end) in pieces of at most kAosBlock
+template <typename Block>
+inline void ForEachAosBlock(size_t begin, size_t end, Block block) {
+	for (size_t first = begin; first < end; first += kAosBlock) {
+		block(first, end - first < kAosBlock ? end - first : kAosBlock);
+	}
+}
+
+#endif
@@ -0,0 +1,171 @@
+//Always include the pch.h first in every cpp
+#include "pch.h"
+
+//Then include own items
+#include "VectorMath.h"
+#include "VectorMathArena.h"
+#include "VectorMathStats.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+//Per-thread frame arenas.
+//Each arena is one block of the configured capacity, allocated the first time
+//its thread needs memory. Allocation bumps an offset; nothing is freed until
+//the frame ends, except scratch buffers rolling back to their mark. A thread
+//only ever touches its own arena, so allocation needs no lock. The registry
+//of all arenas is only used by the frame calls, which reset every thread's
+//arena, and by the stats.
+
+static const size_t kDefaultCapacity = 4 * 1024 * 1024;
+
+struct FrameArena {
+	char* memory;
+	size_t capacity;
+	size_t used;
+	std::atomic<size_t> peak;
+};
+
+struct ArenaRegistry {
+	std::mutex lock; //guards arenas and capacity
+	std::vector<FrameArena*> arenas;
+	size_t capacity = kDefaultCapacity;
+	std::atomic<size_t> overflows{ 0 };
+};
+
+//Never destroyed: pool workers release their arenas while the library is being
+//unloaded, possibly after this file's statics would have been destroyed
+static ArenaRegistry& Registry() {
+	static ArenaRegistry* registry = new ArenaRegistry();
+	return *registry;
+}
+
+//Owns the calling thread's arena and returns it to the registry on thread exit
+struct ThreadArena {
+	FrameArena* arena = nullptr;
+
+	~ThreadArena() {
+		if (arena == nullptr) {
+			return;
+		}
+		ArenaRegistry& registry = Registry();
+		std::lock_guard<std::mutex> guard(registry.lock);
+		registry.arenas.erase(std::find(registry.arenas.begin(), registry.arenas.end(), arena));
+		delete[] arena->memory;
+		delete arena;
+	}
+};
+
+static thread_local ThreadArena t_arena;
+
+static FrameArena* CurrentArena() {
+	if (t_arena.arena == nullptr) {
+		ArenaRegistry& registry = Registry();
+		std::lock_guard<std::mutex> guard(registry.lock);
+		FrameArena* arena = new FrameArena();
+		arena->capacity = registry.capacity;
+		arena->memory = new char[arena->capacity];
+		arena->used = 0;
+		arena->peak = 0;
+		registry.arenas.push_back(arena);
+		t_arena.arena = arena;
+	}
+	return t_arena.arena;
+}
+
+void* ArenaAllocate(size_t size, size_t alignment) {
+	FrameArena* arena = CurrentArena();
+	uintptr_t base = (uintptr_t)arena->memory;
+	uintptr_t start = (base + arena->used + alignment - 1) & ~(uintptr_t)(alignment - 1);
+	size_t offset = (size_t)(start - base);
+	if (offset > arena->capacity || size > arena->capacity - offset) {
+		return nullptr;
+	}
+	arena->used = offset + size;
+	if (arena->used > arena->peak.load(std::memory_order_relaxed)) {
+		arena->peak.store(arena->used, std::memory_order_relaxed);
+	}
+	return arena->memory + offset;
+}
+
+size_t ArenaMark() {
+	return t_arena.arena != nullptr ? t_arena.arena->used : 0;
+}
+
+void ArenaRelease(size_t mark) {
+	if (t_arena.arena != nullptr) {
+		t_arena.arena->used = mark;
+	}
+}
+
+void ArenaRecordOverflow() {
+	Registry().overflows.fetch_add(1, std::memory_order_relaxed);
+}
+
+//Empties every arena and resizes the ones that do not match the capacity.
+//Resizing happens here, between frames, so no pointer into an arena is live.
+static void ResetArenas() {
+	ArenaRegistry& registry = Registry();
+	std::lock_guard<std::mutex> guard(registry.lock);
+	for (FrameArena* arena : registry.arenas) {
+		if (arena->capacity != registry.capacity) {
+			delete[] arena->memory;
+			arena->memory = new char[registry.capacity];
+			arena->capacity = registry.capacity;
+			arena->peak = 0;
+		}
+		arena->used = 0;
+	}
+}
+
+
+void VectorMathFrameBegin() {
+	VECTORMATH_STATS(1);
+	ResetArenas();
+	CurrentArena();
+}
+
+void VectorMathFrameEnd() {
+	VECTORMATH_STATS(1);
+	ResetArenas();
+}
+
+void* VectorMathFrameAlloc(size_t size, size_t alignment) {
+	VECTORMATH_STATS(1);
+	if (alignment == 0) {
+		alignment = 16;
+	}
+	if ((alignment & (alignment - 1)) != 0) {
+		return nullptr;
+	}
+	void* memory = ArenaAllocate(size, alignment);
+	if (memory == nullptr) {
+		ArenaRecordOverflow();
+	}
+	return memory;
+}
+
+void VectorMathSetFrameArenaCapacity(size_t bytesPerThread) {
+	VECTORMATH_STATS(1);
+	ArenaRegistry& registry = Registry();
+	std::lock_guard<std::mutex> guard(registry.lock);
+	registry.capacity = bytesPerThread > 0 ? bytesPerThread : kDefaultCapacity;
+}
+
+void VectorMathGetFrameArenaStats(VectorMathArenaStats* stats) {
+	VECTORMATH_STATS(1);
+	if (stats == nullptr) {
+		return;
+	}
+	ArenaRegistry& registry = Registry();
+	std::lock_guard<std::mutex> guard(registry.lock);
+	stats->capacity = registry.capacity;
+	stats->peakUsed = 0;
+	for (FrameArena* arena : registry.arenas) {
+		stats->peakUsed = std::max(stats->peakUsed, arena->peak.load(std::memory_order_relaxed));
+	}
+	stats->overflowCount = registry.overflows.load(std::memory_order_relaxed);
+	stats->arenaCount = registry.arenas.size();
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#ifndef VECTOR_MATH_ARENA_H
+#define VECTOR_MATH_ARENA_H
+
+#include <cstddef>
+
+//Internal header - not part of the exported API.
+//Every thread that needs scratch memory (callers and pool workers alike) owns
+//one fixed-capacity bump arena (see VectorMathArena.cpp). Frame allocations
+//from VectorMathFrameAlloc stay until VectorMathFrameEnd; scratch buffers
+//inside a call are taken on top of them and given back when they go out of
+//scope, so the arena is used like a stack within a frame.
+
+//Returns size bytes from the calling thread's arena, or nullptr when it is full.
+//alignment must be a power of two.
+void* ArenaAllocate(size_t size, size_t alignment);
+
+//Current top of the calling thread's arena, to roll back to with ArenaRelease
+size_t ArenaMark();
+void ArenaRelease(size_t mark);
+
+//Counts a request the arena could not hold
+void ArenaRecordOverflow();
+
+//Uninitialized scratch array of count Ts for the current scope. It comes from
+//the calling thread's arena and only falls back to the heap (counted as an
+//overflow) when the arena is full. T must be trivially constructible.
+template <typename T>
+class ScratchBuffer {
+public:
+	explicit ScratchBuffer(size_t count) : mark(ArenaMark()), heap(nullptr) {
+		buffer = (T*)ArenaAllocate(count * sizeof(T), alignof(T) < 16 ? 16 : alignof(T));
+		if (buffer == nullptr) {
+			ArenaRecordOverflow();
+			heap = new T[count];
+			buffer = heap;
+		}
+	}
+
+	~ScratchBuffer() {
+		delete[] heap;
+		ArenaRelease(mark);
+	}
+
+	ScratchBuffer(const ScratchBuffer&) = delete;
+	ScratchBuffer& operator=(const ScratchBuffer&) = delete;
+
+	T* Data() { return buffer; }
+	T& operator[](size_t i) { return buffer[i]; }
+	const T& operator[](size_t i) const { return buffer[i]; }
+
+private:
+	size_t mark;
+	T* heap;
+	T* buffer;
+};
+
+#endif
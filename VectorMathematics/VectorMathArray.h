@@ -0,0 +1,555 @@
+#pragma once
+
+#ifndef VECTOR_MATH_ARRAY_H
+#define VECTOR_MATH_ARRAY_H
+
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "VectorMathInline.h"
+
+//Vector arrays with lazy, fused arithmetic for native C++ simulation code.
+//
+//Arithmetic on VecArray / VecSpan does not compute anything; it builds a
+//small expression object. Assigning the expression runs one loop that
+//evaluates the whole chain per element, so
+//
+//    pos = pos + vel * dt;                       //or pos += vel * dt
+//    vel = ClampMagnitude(vel + accel * dt, 10.0f);
+//
+//read each input once and write the output once, with no temporary arrays.
+//The loop body is the inline vmath functions, so the results are the same
+//bits as the per-element loop written out by hand, and the compiler is free
+//to vectorize it.
+//
+//Every operation is element-wise (element i only reads element i of its
+//inputs), so the output may also be one of the inputs (but not memory that
+//overlaps it at an offset). Operands must have
+//the same size; a plain Vec2 / Vec3 or scalar operand applies to every
+//element. Expressions hold views of their arrays, so evaluate them before
+//the arrays change size or go away - do not store them with auto.
+//
+//  VecArrayT<V>: owns its elements (std::vector), resizes on assignment.
+//  VecSpanT<V>:  a view of existing memory (a C# array, a Vec2* from the C
+//                API); assignment writes through it and never resizes.
+//                Use VecSpanT<const V> for read-only inputs.
+//
+//Element-wise functions: Dot, Cross, MagnitudeSquared, Magnitude, Normalize,
+//NormalizeFast, Lerp, Clamp, ClampMagnitude, Min, Max. Dot, Cross (2D) and
+//Magnitude give scalar expressions, which can scale vector expressions
+//(v * Magnitude(w)), be summed with Sum or be written with EvaluateTo.
+
+namespace vmath {
+
+//Base of every array expression. Derived types provide Value (the element
+//type), size() and operator[](i) returning the element by value.
+template <typename E>
+struct ArrayExpr {
+    const E& Self() const {
+        return static_cast<const E&>(*this);
+    }
+};
+
+//Component type of an element: float for Vec2T<float> and for float
+template <typename V>
+struct ArrayScalar {
+    using Type = V;
+};
+
+template <typename T>
+struct ArrayScalar<Vec2T<T>> {
+    using Type = T;
+};
+
+template <typename T>
+struct ArrayScalar<Vec3T<T>> {
+    using Type = T;
+};
+
+//Size of an operand that applies to every element
+constexpr size_t kArrayBroadcast = (size_t)-1;
+
+constexpr size_t ArrayCombinedSize(size_t a, size_t b) {
+    return a == kArrayBroadcast ? b : a;
+}
+
+//Read-only view of array elements, what expressions keep of a VecArray or
+//VecSpan operand
+template <typename V>
+class ArrayRef : public ArrayExpr<ArrayRef<V>> {
+public:
+    using Value = V;
+
+    ArrayRef(const V* data, size_t n) : elements(data), count(n) {}
+
+    size_t size() const { return count; }
+    V operator[](size_t i) const { return elements[i]; }
+
+private:
+    const V* elements;
+    size_t count;
+};
+
+//A single vector or scalar used for every element
+template <typename V>
+class ArrayValue : public ArrayExpr<ArrayValue<V>> {
+public:
+    using Value = V;
+
+    explicit ArrayValue(V value) : value(value) {}
+
+    size_t size() const { return kArrayBroadcast; }
+    V operator[](size_t) const { return value; }
+
+private:
+    V value;
+};
+
+template <typename Op, typename E>
+class ArrayUnary : public ArrayExpr<ArrayUnary<Op, E>> {
+public:
+    using Value = decltype(std::declval<const Op&>()(std::declval<typename E::Value>()));
+
+    ArrayUnary(Op op, E e) : op(op), e(e) {}
+
+    size_t size() const { return e.size(); }
+    Value operator[](size_t i) const { return op(e[i]); }
+
+private:
+    Op op;
+    E e;
+};
+
+template <typename Op, typename L, typename R>
+class ArrayBinary : public ArrayExpr<ArrayBinary<Op, L, R>> {
+public:
+    using Value = decltype(std::declval<const Op&>()(std::declval<typename L::Value>(), std::declval<typename R::Value>()));
+
+    ArrayBinary(Op op, L l, R r) : op(op), l(l), r(r) {
+        assert(l.size() == r.size() || l.size() == kArrayBroadcast || r.size() == kArrayBroadcast);
+    }
+
+    size_t size() const { return ArrayCombinedSize(l.size(), r.size()); }
+    Value operator[](size_t i) const { return op(l[i], r[i]); }
+
+private:
+    Op op;
+    L l;
+    R r;
+};
+
+template <typename V>
+class VecArrayT;
+
+template <typename V>
+class VecSpanT;
+
+//What an expression stores for an operand: a view for the arrays, a copy for
+//the (small) expression objects
+template <typename E>
+struct ArrayOperand {
+    using Type = E;
+    static const E& Make(const E& e) { return e; }
+};
+
+template <typename V>
+struct ArrayOperand<VecArrayT<V>> {
+    using Type = ArrayRef<V>;
+    static Type Make(const VecArrayT<V>& a) { return Type(a.data(), a.size()); }
+};
+
+template <typename V>
+struct ArrayOperand<VecSpanT<V>> {
+    using Type = ArrayRef<typename std::remove_const<V>::type>;
+    static Type Make(const VecSpanT<V>& s) { return Type(s.data(), s.size()); }
+};
+
+template <typename E>
+typename ArrayOperand<E>::Type MakeArrayOperand(const ArrayExpr<E>& e) {
+    return ArrayOperand<E>::Make(e.Self());
+}
+
+//The fused loop. out may be one of the expression's inputs: element i is
+//read before it is written and nothing reads another index, so there is no
+//dependency between iterations. Telling the compiler so lets it vectorize
+//without a run-time overlap check (which GCC skips at -O2). Memory that
+//overlaps only partly (a span shifted by a few elements) is not supported.
+#if defined(__clang__)
+#define VMATH_ARRAY_IVDEP _Pragma("clang loop vectorize(assume_safety)")
+#elif defined(__GNUC__)
+#define VMATH_ARRAY_IVDEP _Pragma("GCC ivdep")
+#elif defined(_MSC_VER)
+#define VMATH_ARRAY_IVDEP __pragma(loop(ivdep))
+#else
+#define VMATH_ARRAY_IVDEP
+#endif
+
+template <typename V, typename E>
+inline void ArrayEvaluate(V* out, size_t n, const E& e) {
+    VMATH_ARRAY_IVDEP
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = e[i];
+    }
+}
+
+
+//Operations
+struct ArrayAddOp {
+    template <typename A, typename B>
+    auto operator()(A a, B b) const { return a + b; }
+};
+
+struct ArraySubtractOp {
+    template <typename A, typename B>
+    auto operator()(A a, B b) const { return a - b; }
+};
+
+struct ArrayMultiplyOp {
+    template <typename A, typename B>
+    auto operator()(A a, B b) const { return a * b; }
+};
+
+struct ArrayDivideOp {
+    template <typename A, typename B>
+    auto operator()(A a, B b) const { return a / b; }
+};
+
+struct ArrayNegateOp {
+    template <typename A>
+    auto operator()(A a) const { return -a; }
+};
+
+struct ArrayDotOp {
+    template <typename A>
+    auto operator()(A a, A b) const { return Dot(a, b); }
+};
+
+struct ArrayCrossOp {
+    template <typename A>
+    auto operator()(A a, A b) const { return Cross(a, b); }
+};
+
+struct ArrayMinOp {
+    template <typename A>
+    auto operator()(A a, A b) const { return Min(a, b); }
+};
+
+struct ArrayMaxOp {
+    template <typename A>
+    auto operator()(A a, A b) const { return Max(a, b); }
+};
+
+struct ArrayMagnitudeSquaredOp {
+    template <typename A>
+    auto operator()(A a) const { return MagnitudeSquared(a); }
+};
+
+struct ArrayMagnitudeOp {
+    template <typename A>
+    auto operator()(A a) const { return Magnitude(a); }
+};
+
+struct ArrayNormalizeOp {
+    template <typename A>
+    auto operator()(A a) const { return Normalize(a); }
+};
+
+struct ArrayNormalizeFastOp {
+    template <typename A>
+    auto operator()(A a) const { return NormalizeFast(a); }
+};
+
+template <typename T>
+struct ArrayLerpOp {
+    T t;
+    template <typename A>
+    auto operator()(A a, A b) const { return Lerp(a, b, t); }
+};
+
+template <typename T>
+struct ArrayClampOp {
+    T minVal;
+    T maxVal;
+    template <typename A>
+    auto operator()(A a) const { return Clamp(a, minVal, maxVal); }
+};
+
+template <typename T>
+struct ArrayClampMagnitudeOp {
+    T maxLength;
+    template <typename A>
+    auto operator()(A a) const { return ClampMagnitude(a, maxLength); }
+};
+
+template <typename T>
+using ArrayScalarOf = typename ArrayScalar<typename T::Value>::Type;
+
+template <typename Op, typename E>
+using ArrayUnaryOf = ArrayUnary<Op, typename ArrayOperand<E>::Type>;
+
+template <typename Op, typename L, typename R>
+using ArrayBinaryOf = ArrayBinary<Op, typename ArrayOperand<L>::Type, typename ArrayOperand<R>::Type>;
+
+template <typename Op, typename L, typename R>
+ArrayBinaryOf<Op, L, R> MakeArrayBinary(Op op, const ArrayExpr<L>& l, const ArrayExpr<R>& r) {
+    return ArrayBinaryOf<Op, L, R>(op, MakeArrayOperand(l), MakeArrayOperand(r));
+}
+
+template <typename Op, typename E>
+ArrayUnaryOf<Op, E> MakeArrayUnary(Op op, const ArrayExpr<E>& e) {
+    return ArrayUnaryOf<Op, E>(op, MakeArrayOperand(e));
+}
+
+
+//Operators: array with array, or with one value for every element
+template <typename L, typename R>
+ArrayBinaryOf<ArrayAddOp, L, R> operator+(const ArrayExpr<L>& l, const ArrayExpr<R>& r) {
+    return MakeArrayBinary(ArrayAddOp(), l, r);
+}
+
+template <typename L>
+ArrayBinaryOf<ArrayAddOp, L, ArrayValue<typename L::Value>> operator+(const ArrayExpr<L>& l, typename L::Value v) {
+    return MakeArrayBinary(ArrayAddOp(), l, ArrayValue<typename L::Value>(v));
+}
+
+template <typename R>
+ArrayBinaryOf<ArrayAddOp, ArrayValue<typename R::Value>, R> operator+(typename R::Value v, const ArrayExpr<R>& r) {
+    return MakeArrayBinary(ArrayAddOp(), ArrayValue<typename R::Value>(v), r);
+}
+
+template <typename L, typename R>
+ArrayBinaryOf<ArraySubtractOp, L, R> operator-(const ArrayExpr<L>& l, const ArrayExpr<R>& r) {
+    return MakeArrayBinary(ArraySubtractOp(), l, r);
+}
+
+template <typename L>
+ArrayBinaryOf<ArraySubtractOp, L, ArrayValue<typename L::Value>> operator-(const ArrayExpr<L>& l, typename L::Value v) {
+    return MakeArrayBinary(ArraySubtractOp(), l, ArrayValue<typename L::Value>(v));
+}
+
+template <typename R>
+ArrayBinaryOf<ArraySubtractOp, ArrayValue<typename R::Value>, R> operator-(typename R::Value v, const ArrayExpr<R>& r) {
+    return MakeArrayBinary(ArraySubtractOp(), ArrayValue<typename R::Value>(v), r);
+}
+
+template <typename E>
+ArrayUnaryOf<ArrayNegateOp, E> operator-(const ArrayExpr<E>& e) {
+    return MakeArrayUnary(ArrayNegateOp(), e);
+}
+
+//Array * array needs a scalar on one side: v * Magnitude(w), weights * v
+template <typename L, typename R>
+ArrayBinaryOf<ArrayMultiplyOp, L, R> operator*(const ArrayExpr<L>& l, const ArrayExpr<R>& r) {
+    return MakeArrayBinary(ArrayMultiplyOp(), l, r);
+}
+
+template <typename L>
+ArrayBinaryOf<ArrayMultiplyOp, L, ArrayValue<ArrayScalarOf<L>>> operator*(const ArrayExpr<L>& l, ArrayScalarOf<L> scale) {
+    return MakeArrayBinary(ArrayMultiplyOp(), l, ArrayValue<ArrayScalarOf<L>>(scale));
+}
+
+template <typename R>
+ArrayBinaryOf<ArrayMultiplyOp, ArrayValue<ArrayScalarOf<R>>, R> operator*(ArrayScalarOf<R> scale, const ArrayExpr<R>& r) {
+    return MakeArrayBinary(ArrayMultiplyOp(), ArrayValue<ArrayScalarOf<R>>(scale), r);
+}
+
+template <typename L, typename R>
+ArrayBinaryOf<ArrayDivideOp, L, R> operator/(const ArrayExpr<L>& l, const ArrayExpr<R>& r) {
+    return MakeArrayBinary(ArrayDivideOp(), l, r);
+}
+
+template <typename L>
+ArrayBinaryOf<ArrayDivideOp, L, ArrayValue<ArrayScalarOf<L>>> operator/(const ArrayExpr<L>& l, ArrayScalarOf<L> scalar) {
+    return MakeArrayBinary(ArrayDivideOp(), l, ArrayValue<ArrayScalarOf<L>>(scalar));
+}
+
+
+//Element-wise functions
+template <typename L, typename R>
+ArrayBinaryOf<ArrayDotOp, L, R> Dot(const ArrayExpr<L>& a, const ArrayExpr<R>& b) {
+    return MakeArrayBinary(ArrayDotOp(), a, b);
+}
+
+template <typename L, typename R>
+ArrayBinaryOf<ArrayCrossOp, L, R> Cross(const ArrayExpr<L>& a, const ArrayExpr<R>& b) {
+    return MakeArrayBinary(ArrayCrossOp(), a, b);
+}
+
+template <typename L, typename R>
+ArrayBinaryOf<ArrayMinOp, L, R> Min(const ArrayExpr<L>& a, const ArrayExpr<R>& b) {
+    return MakeArrayBinary(ArrayMinOp(), a, b);
+}
+
+template <typename L, typename R>
+ArrayBinaryOf<ArrayMaxOp, L, R> Max(const ArrayExpr<L>& a, const ArrayExpr<R>& b) {
+    return MakeArrayBinary(ArrayMaxOp(), a, b);
+}
+
+template <typename E>
+ArrayUnaryOf<ArrayMagnitudeSquaredOp, E> MagnitudeSquared(const ArrayExpr<E>& v) {
+    return MakeArrayUnary(ArrayMagnitudeSquaredOp(), v);
+}
+
+template <typename E>
+ArrayUnaryOf<ArrayMagnitudeOp, E> Magnitude(const ArrayExpr<E>& v) {
+    return MakeArrayUnary(ArrayMagnitudeOp(), v);
+}
+
+template <typename E>
+ArrayUnaryOf<ArrayNormalizeOp, E> Normalize(const ArrayExpr<E>& v) {
+    return MakeArrayUnary(ArrayNormalizeOp(), v);
+}
+
+template <typename E>
+ArrayUnaryOf<ArrayNormalizeFastOp, E> NormalizeFast(const ArrayExpr<E>& v) {
+    return MakeArrayUnary(ArrayNormalizeFastOp(), v);
+}
+
+template <typename L, typename R>
+ArrayBinaryOf<ArrayLerpOp<ArrayScalarOf<L>>, L, R> Lerp(const ArrayExpr<L>& a, const ArrayExpr<R>& b, ArrayScalarOf<L> t) {
+    return MakeArrayBinary(ArrayLerpOp<ArrayScalarOf<L>>{ t }, a, b);
+}
+
+template <typename E>
+ArrayUnaryOf<ArrayClampOp<ArrayScalarOf<E>>, E> Clamp(const ArrayExpr<E>& v, ArrayScalarOf<E> minVal, ArrayScalarOf<E> maxVal) {
+    return MakeArrayUnary(ArrayClampOp<ArrayScalarOf<E>>{ minVal, maxVal }, v);
+}
+
+template <typename E>
+ArrayUnaryOf<ArrayClampMagnitudeOp<ArrayScalarOf<E>>, E> ClampMagnitude(const ArrayExpr<E>& v, ArrayScalarOf<E> maxLength) {
+    return MakeArrayUnary(ArrayClampMagnitudeOp<ArrayScalarOf<E>>{ maxLength }, v);
+}
+
+
+//Evaluation without an array to assign to
+//Writes every element of e to out (n = e.size() elements)
+template <typename E>
+inline void EvaluateTo(const ArrayExpr<E>& e, typename E::Value* out) {
+    ArrayEvaluate(out, e.Self().size(), e.Self());
+}
+
+//Sum of every element, in index order
+template <typename E>
+inline typename E::Value Sum(const ArrayExpr<E>& e) {
+    const E& expr = e.Self();
+    typename E::Value total{};
+    for (size_t i = 0; i < expr.size(); ++i) {
+        total = total + expr[i];
+    }
+    return total;
+}
+
+
+//Containers
+template <typename V>
+class VecArrayT : public ArrayExpr<VecArrayT<V>> {
+public:
+    using Value = V;
+
+    VecArrayT() = default;
+    explicit VecArrayT(size_t n, V value = V{}) : elements(n, value) {}
+    VecArrayT(const V* data, size_t n) : elements(data, data + n) {}
+    VecArrayT(std::initializer_list<V> values) : elements(values) {}
+
+    template <typename E>
+    VecArrayT(const ArrayExpr<E>& e) : elements(e.Self().size()) {
+        ArrayEvaluate(elements.data(), elements.size(), e.Self());
+    }
+
+    //Evaluates e in one pass. The array takes e's size; when that differs
+    //from the current size, e must not read this array.
+    template <typename E>
+    VecArrayT& operator=(const ArrayExpr<E>& e) {
+        const E& expr = e.Self();
+        if (expr.size() != elements.size()) {
+            elements.resize(expr.size());
+        }
+        ArrayEvaluate(elements.data(), elements.size(), expr);
+        return *this;
+    }
+
+    template <typename E>
+    VecArrayT& operator+=(const ArrayExpr<E>& e) { return *this = *this + e; }
+    template <typename E>
+    VecArrayT& operator-=(const ArrayExpr<E>& e) { return *this = *this - e; }
+    VecArrayT& operator*=(typename ArrayScalar<V>::Type scale) { return *this = *this * scale; }
+    VecArrayT& operator/=(typename ArrayScalar<V>::Type scalar) { return *this = *this / scalar; }
+
+    size_t size() const { return elements.size(); }
+    bool empty() const { return elements.empty(); }
+    void resize(size_t n, V value = V{}) { elements.resize(n, value); }
+
+    V* data() { return elements.data(); }
+    const V* data() const { return elements.data(); }
+    V& operator[](size_t i) { return elements[i]; }
+    const V& operator[](size_t i) const { return elements[i]; }
+    V* begin() { return elements.data(); }
+    V* end() { return elements.data() + elements.size(); }
+    const V* begin() const { return elements.data(); }
+    const V* end() const { return elements.data() + elements.size(); }
+
+private:
+    std::vector<V> elements;
+};
+
+template <typename V>
+class VecSpanT : public ArrayExpr<VecSpanT<V>> {
+public:
+    using Value = typename std::remove_const<V>::type;
+
+    VecSpanT(V* data, size_t n) : elements(data), count(n) {}
+
+    //Copying a span makes another view of the same memory, but assigning to
+    //one writes the elements, like any other expression
+    VecSpanT(const VecSpanT&) = default;
+
+    VecSpanT& operator=(const VecSpanT& other) {
+        assert(other.size() == count);
+        ArrayEvaluate(elements, count, ArrayRef<Value>(other.data(), other.size()));
+        return *this;
+    }
+
+    template <typename E>
+    VecSpanT& operator=(const ArrayExpr<E>& e) {
+        const E& expr = e.Self();
+        assert(expr.size() == count || expr.size() == kArrayBroadcast);
+        ArrayEvaluate(elements, count, expr);
+        return *this;
+    }
+
+    template <typename E>
+    VecSpanT& operator+=(const ArrayExpr<E>& e) { return *this = *this + e; }
+    template <typename E>
+    VecSpanT& operator-=(const ArrayExpr<E>& e) { return *this = *this - e; }
+    VecSpanT& operator*=(typename ArrayScalar<Value>::Type scale) { return *this = *this * scale; }
+    VecSpanT& operator/=(typename ArrayScalar<Value>::Type scalar) { return *this = *this / scalar; }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    V* data() const { return elements; }
+    V& operator[](size_t i) const { return elements[i]; }
+    V* begin() const { return elements; }
+    V* end() const { return elements + count; }
+
+private:
+    V* elements;
+    size_t count;
+};
+
+template <typename V>
+VecSpanT<V> MakeVecSpan(V* data, size_t n) {
+    return VecSpanT<V>(data, n);
+}
+
+using VecArray2 = VecArrayT<Vec2T<float>>;
+using VecArray3 = VecArrayT<Vec3T<float>>;
+using VecSpan2 = VecSpanT<Vec2T<float>>;
+using VecSpan3 = VecSpanT<Vec3T<float>>;
+
+} // namespace vmath
+
+#endif
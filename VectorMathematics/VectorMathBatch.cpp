@@ -0,0 +1,808 @@
+//Always include the pch.h first in every cpp
+#include "pch.h"
+
+//Then include own items
+#include "VectorMath.h"
+#include "VectorMathKernels.h"
+#include "VectorMathThreads.h"
+#include "VectorMathStats.h"
+#include "VectorMathAos.h"
+#include <cmath>
+
+using namespace vmath;
+
+//Batch versions of every VectorMath.h operation. Each loop body mirrors the
+//matching scalar function (including the 0.0001f safety checks) so the
+//results are identical, but one call walks a whole array of vectors.
+//The packed Array versions call the inline layer directly.
+//Every element is read into locals before anything is written, which keeps
+//in-place calls (out == input) correct.
+//
+//The hot operations forward to the SIMD kernel table picked for this CPU.
+//A packed Vec2/Vec3 array is just 2n/3n floats, so the component-wise
+//operations run over it as one flat stream. Dot has packed kernels; the other
+//Array operations that mix components (magnitude, normalize, reflect, clamp
+//magnitude) split kAosBlock vectors at a time into SoA columns, run the SoA
+//kernel there and interleave the result back (VectorMathAos.h). With the
+//scalar table they run the inline functions per vector instead (RunPerVector).
+//Large calls are split into chunks across the thread pool (VectorMathThreads.h).
+
+static const float kEpsilon = 0.0001f;
+
+//The scalar table gains nothing from the split and only pays for the copies,
+//so with it op(i) runs per vector instead. Returns false for the SIMD tables.
+template <typename Op>
+static bool RunPerVector(const VectorKernels& k, size_t n, Op op) {
+	if (&k != GetScalarKernels()) {
+		return false;
+	}
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			op(i);
+		}
+	});
+	return true;
+}
+
+static void NormalizeArray(const Vec2* v, Vec2* out, size_t n, bool fast) {
+	const VectorKernels& k = ActiveKernels();
+	if (RunPerVector(k, n, [&](size_t i) { out[i] = fast ? NormalizeFast(v[i]) : Normalize(v[i]); })) {
+		return;
+	}
+	auto normalize = fast ? k.normalizeFast2 : k.normalize2;
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		AosColumns c(2);
+		ForEachAosBlock(begin, end, [&](size_t first, size_t count) {
+			Split(v + first, count, c[0], c[1]);
+			normalize(c[0], c[1], c[0], c[1], count);
+			Join(c[0], c[1], count, out + first);
+		});
+	});
+}
+
+static void NormalizeArray(const Vec3* v, Vec3* out, size_t n, bool fast) {
+	const VectorKernels& k = ActiveKernels();
+	if (RunPerVector(k, n, [&](size_t i) { out[i] = fast ? NormalizeFast(v[i]) : Normalize(v[i]); })) {
+		return;
+	}
+	auto normalize = fast ? k.normalizeFast3 : k.normalize3;
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		AosColumns c(3);
+		ForEachAosBlock(begin, end, [&](size_t first, size_t count) {
+			Split(v + first, count, c[0], c[1], c[2]);
+			normalize(c[0], c[1], c[2], c[0], c[1], c[2], count);
+			Join(c[0], c[1], c[2], count, out + first);
+		});
+	});
+}
+
+static bool UseFastPath(int precision) {
+	if (precision == VECTORMATH_PRECISION_DEFAULT) {
+		precision = ActivePrecision();
+	}
+	return precision == VECTORMATH_PRECISION_FAST;
+}
+
+//The plain and Ex normalize exports share these and NormalizeArray so each
+//call is counted once
+static void NormalizeBatch(const float* x, const float* y, float* outX, float* outY, size_t n, int precision) {
+	const VectorKernels& k = ActiveKernels();
+	auto normalize = UseFastPath(precision) ? k.normalizeFast2 : k.normalize2;
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		normalize(x + begin, y + begin, outX + begin, outY + begin, end - begin);
+	});
+}
+
+static void NormalizeBatch(const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ, size_t n, int precision) {
+	const VectorKernels& k = ActiveKernels();
+	auto normalize = UseFastPath(precision) ? k.normalizeFast3 : k.normalize3;
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		normalize(x + begin, y + begin, z + begin, outX + begin, outY + begin, outZ + begin, end - begin);
+	});
+}
+
+
+//Structure of Arrays - Vec2
+
+void VectorAdd2DBatch(const float* ax, const float* ay, const float* bx, const float* by, float* outX, float* outY, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.add(ax + begin, bx + begin, outX + begin, end - begin);
+		k.add(ay + begin, by + begin, outY + begin, end - begin);
+	});
+}
+
+void VectorSubtract2DBatch(const float* ax, const float* ay, const float* bx, const float* by, float* outX, float* outY, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.subtract(ax + begin, bx + begin, outX + begin, end - begin);
+		k.subtract(ay + begin, by + begin, outY + begin, end - begin);
+	});
+}
+
+void VectorScale2DBatch(const float* x, const float* y, float scale, float* outX, float* outY, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.scale(x + begin, scale, outX + begin, end - begin);
+		k.scale(y + begin, scale, outY + begin, end - begin);
+	});
+}
+
+void VectorDivide2DBatch(const float* x, const float* y, float scalar, float* outX, float* outY, size_t n) {
+	VECTORMATH_STATS(n);
+	if (scalar < kEpsilon) {
+		ParallelRange(n, [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i) {
+				outX[i] = 0.0f;
+				outY[i] = 0.0f;
+			}
+		});
+		return;
+	}
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			outX[i] = x[i] / scalar;
+			outY[i] = y[i] / scalar;
+		}
+	});
+}
+
+void VectorMagnitude2DBatch(const float* x, const float* y, float* out, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.magnitude2(x + begin, y + begin, out + begin, end - begin);
+	});
+}
+
+void VectorNormalize2DBatch(const float* x, const float* y, float* outX, float* outY, size_t n) {
+	VECTORMATH_STATS(n);
+	NormalizeBatch(x, y, outX, outY, n, VECTORMATH_PRECISION_DEFAULT);
+}
+
+void VectorDot2DBatch(const float* ax, const float* ay, const float* bx, const float* by, float* out, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.dot2(ax + begin, ay + begin, bx + begin, by + begin, out + begin, end - begin);
+	});
+}
+
+void VectorCross2DBatch(const float* ax, const float* ay, const float* bx, const float* by, float* out, size_t n) {
+	VECTORMATH_STATS(n);
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			out[i] = ax[i] * by[i] - ay[i] * bx[i];
+		}
+	});
+}
+
+void VectorLerp2DBatch(const float* ax, const float* ay, const float* bx, const float* by, float t, float* outX, float* outY, size_t n) {
+	VECTORMATH_STATS(n);
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			float x = ax[i] + t * (bx[i] - ax[i]);
+			float y = ay[i] + t * (by[i] - ay[i]);
+			outX[i] = x;
+			outY[i] = y;
+		}
+	});
+}
+
+void VectorReflect2DBatch(const float* vx, const float* vy, const float* nx, const float* ny, float* outX, float* outY, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.reflect2(vx + begin, vy + begin, nx + begin, ny + begin, outX + begin, outY + begin, end - begin);
+	});
+}
+
+void VectorClampMagnitude2DBatch(const float* x, const float* y, float maxLength, float* outX, float* outY, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.clampMagnitude2(x + begin, y + begin, maxLength, outX + begin, outY + begin, end - begin);
+	});
+}
+
+void VectorClamp2DBatch(const float* x, const float* y, float minVal, float maxVal, float* outX, float* outY, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.clamp(x + begin, minVal, maxVal, outX + begin, end - begin);
+		k.clamp(y + begin, minVal, maxVal, outY + begin, end - begin);
+	});
+}
+
+
+//Structure of Arrays - Vec3
+
+void VectorAddBatch(const float* ax, const float* ay, const float* az, const float* bx, const float* by, const float* bz, float* outX, float* outY, float* outZ, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.add(ax + begin, bx + begin, outX + begin, end - begin);
+		k.add(ay + begin, by + begin, outY + begin, end - begin);
+		k.add(az + begin, bz + begin, outZ + begin, end - begin);
+	});
+}
+
+void VectorSubtractBatch(const float* ax, const float* ay, const float* az, const float* bx, const float* by, const float* bz, float* outX, float* outY, float* outZ, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.subtract(ax + begin, bx + begin, outX + begin, end - begin);
+		k.subtract(ay + begin, by + begin, outY + begin, end - begin);
+		k.subtract(az + begin, bz + begin, outZ + begin, end - begin);
+	});
+}
+
+void VectorScaleBatch(const float* x, const float* y, const float* z, float scale, float* outX, float* outY, float* outZ, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.scale(x + begin, scale, outX + begin, end - begin);
+		k.scale(y + begin, scale, outY + begin, end - begin);
+		k.scale(z + begin, scale, outZ + begin, end - begin);
+	});
+}
+
+void VectorDivideBatch(const float* x, const float* y, const float* z, float scalar, float* outX, float* outY, float* outZ, size_t n) {
+	VECTORMATH_STATS(n);
+	if (scalar < kEpsilon) {
+		ParallelRange(n, [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i) {
+				outX[i] = 0.0f;
+				outY[i] = 0.0f;
+				outZ[i] = 0.0f;
+			}
+		});
+		return;
+	}
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			outX[i] = x[i] / scalar;
+			outY[i] = y[i] / scalar;
+			outZ[i] = z[i] / scalar;
+		}
+	});
+}
+
+void VectorMagnitudeBatch(const float* x, const float* y, const float* z, float* out, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.magnitude3(x + begin, y + begin, z + begin, out + begin, end - begin);
+	});
+}
+
+void VectorNormalizeBatch(const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ, size_t n) {
+	VECTORMATH_STATS(n);
+	NormalizeBatch(x, y, z, outX, outY, outZ, n, VECTORMATH_PRECISION_DEFAULT);
+}
+
+void VectorDotBatch(const float* ax, const float* ay, const float* az, const float* bx, const float* by, const float* bz, float* out, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.dot3(ax + begin, ay + begin, az + begin, bx + begin, by + begin, bz + begin, out + begin, end - begin);
+	});
+}
+
+void VectorCrossBatch(const float* ax, const float* ay, const float* az, const float* bx, const float* by, const float* bz, float* outX, float* outY, float* outZ, size_t n) {
+	VECTORMATH_STATS(n);
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			float x = ay[i] * bz[i] - az[i] * by[i];
+			float y = az[i] * bx[i] - ax[i] * bz[i];
+			float z = ax[i] * by[i] - ay[i] * bx[i];
+			outX[i] = x;
+			outY[i] = y;
+			outZ[i] = z;
+		}
+	});
+}
+
+void VectorLerpBatch(const float* ax, const float* ay, const float* az, const float* bx, const float* by, const float* bz, float t, float* outX, float* outY, float* outZ, size_t n) {
+	VECTORMATH_STATS(n);
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			float x = ax[i] + t * (bx[i] - ax[i]);
+			float y = ay[i] + t * (by[i] - ay[i]);
+			float z = az[i] + t * (bz[i] - az[i]);
+			outX[i] = x;
+			outY[i] = y;
+			outZ[i] = z;
+		}
+	});
+}
+
+void VectorReflectBatch(const float* vx, const float* vy, const float* vz, const float* nx, const float* ny, const float* nz, float* outX, float* outY, float* outZ, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.reflect3(vx + begin, vy + begin, vz + begin, nx + begin, ny + begin, nz + begin, outX + begin, outY + begin, outZ + begin, end - begin);
+	});
+}
+
+void VectorClampMagnitudeBatch(const float* x, const float* y, const float* z, float maxLength, float* outX, float* outY, float* outZ, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.clampMagnitude3(x + begin, y + begin, z + begin, maxLength, outX + begin, outY + begin, outZ + begin, end - begin);
+	});
+}
+
+void VectorClampBatch(const float* x, const float* y, const float* z, float minVal, float maxVal, float* outX, float* outY, float* outZ, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.clamp(x + begin, minVal, maxVal, outX + begin, end - begin);
+		k.clamp(y + begin, minVal, maxVal, outY + begin, end - begin);
+		k.clamp(z + begin, minVal, maxVal, outZ + begin, end - begin);
+	});
+}
+
+void ClampBatch(const float* v, float minVal, float maxVal, float* out, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.clamp(v + begin, minVal, maxVal, out + begin, end - begin);
+	});
+}
+
+
+//Array of Structures - Vec2
+
+void VectorAdd2DArray(const Vec2* a, const Vec2* b, Vec2* out, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.add(&a[begin].x, &b[begin].x, &out[begin].x, (end - begin) * 2);
+	});
+}
+
+void VectorSubtract2DArray(const Vec2* a, const Vec2* b, Vec2* out, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.subtract(&a[begin].x, &b[begin].x, &out[begin].x, (end - begin) * 2);
+	});
+}
+
+void VectorScale2DArray(const Vec2* v, float scale, Vec2* out, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.scale(&v[begin].x, scale, &out[begin].x, (end - begin) * 2);
+	});
+}
+
+void VectorDivide2DArray(const Vec2* v, float scalar, Vec2* out, size_t n) {
+	VECTORMATH_STATS(n);
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			out[i] = v[i] / scalar;
+		}
+	});
+}
+
+void VectorMagnitude2DArray(const Vec2* v, float* out, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	if (RunPerVector(k, n, [&](size_t i) { out[i] = Magnitude(v[i]); })) {
+		return;
+	}
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		AosColumns c(2);
+		ForEachAosBlock(begin, end, [&](size_t first, size_t count) {
+			Split(v + first, count, c[0], c[1]);
+			k.magnitude2(c[0], c[1], out + first, count);
+		});
+	});
+}
+
+void VectorNormalize2DArray(const Vec2* v, Vec2* out, size_t n) {
+	VECTORMATH_STATS(n);
+	NormalizeArray(v, out, n, UseFastPath(VECTORMATH_PRECISION_DEFAULT));
+}
+
+void VectorDot2DArray(const Vec2* a, const Vec2* b, float* out, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.dotPacked2(&a[begin].x, &b[begin].x, out + begin, end - begin);
+	});
+}
+
+void VectorCross2DArray(const Vec2* a, const Vec2* b, float* out, size_t n) {
+	VECTORMATH_STATS(n);
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			out[i] = Cross(a[i], b[i]);
+		}
+	});
+}
+
+void VectorLerp2DArray(const Vec2* a, const Vec2* b, float t, Vec2* out, size_t n) {
+	VECTORMATH_STATS(n);
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			out[i] = Lerp(a[i], b[i], t);
+		}
+	});
+}
+
+void VectorReflect2DArray(const Vec2* v, const Vec2* normals, Vec2* out, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	if (RunPerVector(k, n, [&](size_t i) { out[i] = Reflect(v[i], normals[i]); })) {
+		return;
+	}
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		AosColumns c(4);
+		ForEachAosBlock(begin, end, [&](size_t first, size_t count) {
+			Split(v + first, count, c[0], c[1]);
+			Split(normals + first, count, c[2], c[3]);
+			k.reflect2(c[0], c[1], c[2], c[3], c[0], c[1], count);
+			Join(c[0], c[1], count, out + first);
+		});
+	});
+}
+
+void VectorClampMagnitude2DArray(const Vec2* v, float maxLength, Vec2* out, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	if (RunPerVector(k, n, [&](size_t i) { out[i] = ClampMagnitude(v[i], maxLength); })) {
+		return;
+	}
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		AosColumns c(2);
+		ForEachAosBlock(begin, end, [&](size_t first, size_t count) {
+			Split(v + first, count, c[0], c[1]);
+			k.clampMagnitude2(c[0], c[1], maxLength, c[0], c[1], count);
+			Join(c[0], c[1], count, out + first);
+		});
+	});
+}
+
+void VectorClamp2DArray(const Vec2* v, float minVal, float maxVal, Vec2* out, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.clamp(&v[begin].x, minVal, maxVal, &out[begin].x, (end - begin) * 2);
+	});
+}
+
+
+//Array of Structures - Vec3
+
+void VectorAddArray(const Vec3* a, const Vec3* b, Vec3* out, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.add(&a[begin].x, &b[begin].x, &out[begin].x, (end - begin) * 3);
+	});
+}
+
+void VectorSubtractArray(const Vec3* a, const Vec3* b, Vec3* out, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.subtract(&a[begin].x, &b[begin].x, &out[begin].x, (end - begin) * 3);
+	});
+}
+
+void VectorScaleArray(const Vec3* v, float scale, Vec3* out, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.scale(&v[begin].x, scale, &out[begin].x, (end - begin) * 3);
+	});
+}
+
+void VectorDivideArray(const Vec3* v, float scalar, Vec3* out, size_t n) {
+	VECTORMATH_STATS(n);
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			out[i] = v[i] / scalar;
+		}
+	});
+}
+
+void VectorMagnitudeArray(const Vec3* v, float* out, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	if (RunPerVector(k, n, [&](size_t i) { out[i] = Magnitude(v[i]); })) {
+		return;
+	}
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		AosColumns c(3);
+		ForEachAosBlock(begin, end, [&](size_t first, size_t count) {
+			Split(v + first, count, c[0], c[1], c[2]);
+			k.magnitude3(c[0], c[1], c[2], out + first, count);
+		});
+	});
+}
+
+void VectorNormalizeArray(const Vec3* v, Vec3* out, size_t n) {
+	VECTORMATH_STATS(n);
+	NormalizeArray(v, out, n, UseFastPath(VECTORMATH_PRECISION_DEFAULT));
+}
+
+void VectorDotArray(const Vec3* a, const Vec3* b, float* out, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.dotPacked3(&a[begin].x, &b[begin].x, out + begin, end - begin);
+	});
+}
+
+void VectorCrossArray(const Vec3* a, const Vec3* b, Vec3* out, size_t n) {
+	VECTORMATH_STATS(n);
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			out[i] = Cross(a[i], b[i]);
+		}
+	});
+}
+
+void VectorLerpArray(const Vec3* a, const Vec3* b, float t, Vec3* out, size_t n) {
+	VECTORMATH_STATS(n);
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			out[i] = Lerp(a[i], b[i], t);
+		}
+	});
+}
+
+void VectorReflectArray(const Vec3* v, const Vec3* normals, Vec3* out, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	if (RunPerVector(k, n, [&](size_t i) { out[i] = Reflect(v[i], normals[i]); })) {
+		return;
+	}
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		AosColumns c(6);
+		ForEachAosBlock(begin, end, [&](size_t first, size_t count) {
+			Split(v + first, count, c[0], c[1], c[2]);
+			Split(normals + first, count, c[3], c[4], c[5]);
+			k.reflect3(c[0], c[1], c[2], c[3], c[4], c[5], c[0], c[1], c[2], count);
+			Join(c[0], c[1], c[2], count, out + first);
+		});
+	});
+}
+
+void VectorClampMagnitudeArray(const Vec3* v, float maxLength, Vec3* out, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	if (RunPerVector(k, n, [&](size_t i) { out[i] = ClampMagnitude(v[i], maxLength); })) {
+		return;
+	}
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		AosColumns c(3);
+		ForEachAosBlock(begin, end, [&](size_t first, size_t count) {
+			Split(v + first, count, c[0], c[1], c[2]);
+			k.clampMagnitude3(c[0], c[1], c[2], maxLength, c[0], c[1], c[2], count);
+			Join(c[0], c[1], c[2], count, out + first);
+		});
+	});
+}
+
+void VectorClampArray(const Vec3* v, float minVal, float maxVal, Vec3* out, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.clamp(&v[begin].x, minVal, maxVal, &out[begin].x, (end - begin) * 3);
+	});
+}
+
+
+//Fast Normalize & Precision
+
+void VectorNormalizeFast2DBatch(const float* x, const float* y, float* outX, float* outY, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.normalizeFast2(x + begin, y + begin, outX + begin, outY + begin, end - begin);
+	});
+}
+
+void VectorNormalizeFastBatch(const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.normalizeFast3(x + begin, y + begin, z + begin, outX + begin, outY + begin, outZ + begin, end - begin);
+	});
+}
+
+void VectorNormalizeFast2DArray(const Vec2* v, Vec2* out, size_t n) {
+	VECTORMATH_STATS(n);
+	NormalizeArray(v, out, n, true);
+}
+
+void VectorNormalizeFastArray(const Vec3* v, Vec3* out, size_t n) {
+	VECTORMATH_STATS(n);
+	NormalizeArray(v, out, n, true);
+}
+
+void VectorNormalize2DBatchEx(const float* x, const float* y, float* outX, float* outY, size_t n, int precision) {
+	VECTORMATH_STATS(n);
+	NormalizeBatch(x, y, outX, outY, n, precision);
+}
+
+void VectorNormalizeBatchEx(const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ, size_t n, int precision) {
+	VECTORMATH_STATS(n);
+	NormalizeBatch(x, y, z, outX, outY, outZ, n, precision);
+}
+
+void VectorNormalize2DArrayEx(const Vec2* v, Vec2* out, size_t n, int precision) {
+	VECTORMATH_STATS(n);
+	NormalizeArray(v, out, n, UseFastPath(precision));
+}
+
+void VectorNormalizeArrayEx(const Vec3* v, Vec3* out, size_t n, int precision) {
+	VECTORMATH_STATS(n);
+	NormalizeArray(v, out, n, UseFastPath(precision));
+}
+
+
+//Fused Operations
+//ScaleAdd, MulAdd and LerpClamp are component-wise, so the Array versions run
+//over the packed floats as one flat stream like Add and Clamp.
+
+void VectorScaleAdd2DBatch(const float* ax, const float* ay, const float* bx, const float* by, float scale, float* outX, float* outY, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.scaleAdd(ax + begin, bx + begin, scale, outX + begin, end - begin);
+		k.scaleAdd(ay + begin, by + begin, scale, outY + begin, end - begin);
+	});
+}
+
+void VectorScaleAddBatch(const float* ax, const float* ay, const float* az, const float* bx, const float* by, const float* bz, float scale, float* outX, float* outY, float* outZ, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.scaleAdd(ax + begin, bx + begin, scale, outX + begin, end - begin);
+		k.scaleAdd(ay + begin, by + begin, scale, outY + begin, end - begin);
+		k.scaleAdd(az + begin, bz + begin, scale, outZ + begin, end - begin);
+	});
+}
+
+void VectorMulAdd2DBatch(const float* ax, const float* ay, const float* bx, const float* by, const float* cx, const float* cy, float* outX, float* outY, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.mulAdd(ax + begin, bx + begin, cx + begin, outX + begin, end - begin);
+		k.mulAdd(ay + begin, by + begin, cy + begin, outY + begin, end - begin);
+	});
+}
+
+void VectorMulAddBatch(const float* ax, const float* ay, const float* az, const float* bx, const float* by, const float* bz, const float* cx, const float* cy, const float* cz, float* outX, float* outY, float* outZ, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.mulAdd(ax + begin, bx + begin, cx + begin, outX + begin, end - begin);
+		k.mulAdd(ay + begin, by + begin, cy + begin, outY + begin, end - begin);
+		k.mulAdd(az + begin, bz + begin, cz + begin, outZ + begin, end - begin);
+	});
+}
+
+void VectorLerpClamp2DBatch(const float* ax, const float* ay, const float* bx, const float* by, float t, float minVal, float maxVal, float* outX, float* outY, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.lerpClamp(ax + begin, bx + begin, t, minVal, maxVal, outX + begin, end - begin);
+		k.lerpClamp(ay + begin, by + begin, t, minVal, maxVal, outY + begin, end - begin);
+	});
+}
+
+void VectorLerpClampBatch(const float* ax, const float* ay, const float* az, const float* bx, const float* by, const float* bz, float t, float minVal, float maxVal, float* outX, float* outY, float* outZ, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.lerpClamp(ax + begin, bx + begin, t, minVal, maxVal, outX + begin, end - begin);
+		k.lerpClamp(ay + begin, by + begin, t, minVal, maxVal, outY + begin, end - begin);
+		k.lerpClamp(az + begin, bz + begin, t, minVal, maxVal, outZ + begin, end - begin);
+	});
+}
+
+void VectorClampMagnitudeRange2DBatch(const float* x, const float* y, float minLength, float maxLength, float* outX, float* outY, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.clampMagnitudeRange2(x + begin, y + begin, minLength, maxLength, outX + begin, outY + begin, end - begin);
+	});
+}
+
+void VectorClampMagnitudeRangeBatch(const float* x, const float* y, const float* z, float minLength, float maxLength, float* outX, float* outY, float* outZ, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.clampMagnitudeRange3(x + begin, y + begin, z + begin, minLength, maxLength, outX + begin, outY + begin, outZ + begin, end - begin);
+	});
+}
+
+void VectorScaleAdd2DArray(const Vec2* a, const Vec2* b, float scale, Vec2* out, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.scaleAdd(&a[begin].x, &b[begin].x, scale, &out[begin].x, (end - begin) * 2);
+	});
+}
+
+void VectorScaleAddArray(const Vec3* a, const Vec3* b, float scale, Vec3* out, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.scaleAdd(&a[begin].x, &b[begin].x, scale, &out[begin].x, (end - begin) * 3);
+	});
+}
+
+void VectorMulAdd2DArray(const Vec2* a, const Vec2* b, const Vec2* c, Vec2* out, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.mulAdd(&a[begin].x, &b[begin].x, &c[begin].x, &out[begin].x, (end - begin) * 2);
+	});
+}
+
+void VectorMulAddArray(const Vec3* a, const Vec3* b, const Vec3* c, Vec3* out, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.mulAdd(&a[begin].x, &b[begin].x, &c[begin].x, &out[begin].x, (end - begin) * 3);
+	});
+}
+
+void VectorLerpClamp2DArray(const Vec2* a, const Vec2* b, float t, float minVal, float maxVal, Vec2* out, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.lerpClamp(&a[begin].x, &b[begin].x, t, minVal, maxVal, &out[begin].x, (end - begin) * 2);
+	});
+}
+
+void VectorLerpClampArray(const Vec3* a, const Vec3* b, float t, float minVal, float maxVal, Vec3* out, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.lerpClamp(&a[begin].x, &b[begin].x, t, minVal, maxVal, &out[begin].x, (end - begin) * 3);
+	});
+}
+
+void VectorClampMagnitudeRange2DArray(const Vec2* v, float minLength, float maxLength, Vec2* out, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	if (RunPerVector(k, n, [&](size_t i) { out[i] = ClampMagnitude(v[i], minLength, maxLength); })) {
+		return;
+	}
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		AosColumns c(2);
+		ForEachAosBlock(begin, end, [&](size_t first, size_t count) {
+			Split(v + first, count, c[0], c[1]);
+			k.clampMagnitudeRange2(c[0], c[1], minLength, maxLength, c[0], c[1], count);
+			Join(c[0], c[1], count, out + first);
+		});
+	});
+}
+
+void VectorClampMagnitudeRangeArray(const Vec3* v, float minLength, float maxLength, Vec3* out, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	if (RunPerVector(k, n, [&](size_t i) { out[i] = ClampMagnitude(v[i], minLength, maxLength); })) {
+		return;
+	}
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		AosColumns c(3);
+		ForEachAosBlock(begin, end, [&](size_t first, size_t count) {
+			Split(v + first, count, c[0], c[1], c[2]);
+			k.clampMagnitudeRange3(c[0], c[1], c[2], minLength, maxLength, c[0], c[1], c[2], count);
+			Join(c[0], c[1], c[2], count, out + first);
+		});
+	});
+}
@@ -0,0 +1,696 @@
+//Always include the pch.h first in every cpp
+#include "pch.h"
+
+//Then include own items
+#include "VectorMath.h"
+#include "VectorMathArena.h"
+#include "VectorMathThreads.h"
+#include "VectorMathStats.h"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+//Bounding volume hierarchy over 3D boxes or spheres.
+//The tree is built top-down with a binned surface area heuristic and stored as
+//one flat array in depth-first order: an inner node's left child is the next
+//node and only the right child index is stored, so every node is 32 bytes and
+//the near side of a traversal walks forward through memory. Leaves point at a
+//run of slots that map to object ids.
+//Refit keeps the tree shape and only recomputes the bounds bottom-up, which is
+//enough for objects that move a little each frame; rebuild when they have
+//moved far.
+
+using namespace vmath;
+
+static const float kEpsilon = 0.0001f;
+static const float kInfinity = std::numeric_limits<float>::infinity();
+static const uint32_t kMaxLeafSize = 4;
+static const int kSahBins = 12;
+//Past this depth nodes are split at the median, which bounds the tree depth
+//(and the traversal stacks below) at kMaxDepth + 32
+static const int kMaxDepth = 64;
+static const int kStackSize = 128;
+static const int kPacketSize = 8;
+
+struct Bounds {
+	Vec3 min;
+	Vec3 max;
+};
+
+struct BvhNode {
+	Vec3 boundsMin;
+	uint32_t leftOrFirst; //inner node: right child index, leaf: first slot
+	Vec3 boundsMax;
+	uint32_t count;       //0 for inner nodes
+};
+
+struct Bvh3D {
+	std::vector<BvhNode> nodes;
+	std::vector<uint32_t> slotIds;
+	std::vector<Bounds> primitiveBounds; //by id
+	std::vector<Vec3> centers;           //by id, sphere trees only
+	std::vector<float> radii;
+	bool spheres;
+};
+
+static Bounds EmptyBounds() {
+	return { { kInfinity, kInfinity, kInfinity }, { -kInfinity, -kInfinity, -kInfinity } };
+}
+
+static void Grow(Bounds& b, const Bounds& other) {
+	b.min = Min(b.min, other.min);
+	b.max = Max(b.max, other.max);
+}
+
+static void Grow(Bounds& b, Vec3 p) {
+	b.min = Min(b.min, p);
+	b.max = Max(b.max, p);
+}
+
+static float HalfArea(const Bounds& b) {
+	Vec3 e = b.max - b.min;
+	if (e.x < 0.0f) {
+		return 0.0f;
+	}
+	return e.x * e.y + e.y * e.z + e.z * e.x;
+}
+
+static float Axis(Vec3 v, int axis) {
+	return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+}
+
+
+//Build
+struct BvhBuilder {
+	Bvh3D* bvh;
+	Vec3* centroids; //by id, arena scratch for the build
+};
+
+struct SahBin {
+	Bounds bounds;
+	uint32_t count;
+};
+
+static int BinIndex(float centroid, float minCentroid, float scale) {
+	int bin = (int)((centroid - minCentroid) * scale);
+	return bin < 0 ? 0 : (bin >= kSahBins ? kSahBins - 1 : bin);
+}
+
+//Returns the number of slots that go to the left child, or 0 to make a leaf
+static uint32_t PartitionNode(BvhBuilder& builder, uint32_t first, uint32_t count, const Bounds& bounds, const Bounds& centroidBounds, int depth) {
+	if (count <= 1) {
+		return 0;
+	}
+	std::vector<uint32_t>& ids = builder.bvh->slotIds;
+	Vec3 extent = centroidBounds.max - centroidBounds.min;
+
+	int bestAxis = -1;
+	int bestPlane = 0;
+	float bestCost = kInfinity;
+	if (depth < kMaxDepth) {
+		for (int axis = 0; axis < 3; ++axis) {
+			float axisExtent = Axis(extent, axis);
+			if (!(axisExtent > 0.0f)) {
+				continue;
+			}
+			float minCentroid = Axis(centroidBounds.min, axis);
+			float scale = kSahBins / axisExtent;
+			SahBin bins[kSahBins];
+			for (SahBin& bin : bins) {
+				bin.bounds = EmptyBounds();
+				bin.count = 0;
+			}
+			for (uint32_t i = first; i < first + count; ++i) {
+				uint32_t id = ids[i];
+				SahBin& bin = bins[BinIndex(Axis(builder.centroids[id], axis), minCentroid, scale)];
+				Grow(bin.bounds, builder.bvh->primitiveBounds[id]);
+				++bin.count;
+			}
+
+			//Sweep from the right, then from the left evaluating every plane
+			float rightArea[kSahBins];
+			uint32_t rightCount[kSahBins];
+			Bounds right = EmptyBounds();
+			uint32_t rightTotal = 0;
+			for (int plane = kSahBins - 1; plane > 0; --plane) {
+				Grow(right, bins[plane].bounds);
+				rightTotal += bins[plane].count;
+				rightArea[plane] = HalfArea(right);
+				rightCount[plane] = rightTotal;
+			}
+			Bounds left = EmptyBounds();
+			uint32_t leftTotal = 0;
+			for (int plane = 1; plane < kSahBins; ++plane) {
+				Grow(left, bins[plane - 1].bounds);
+				leftTotal += bins[plane - 1].count;
+				if (leftTotal == 0 || rightCount[plane] == 0) {
+					continue;
+				}
+				float cost = HalfArea(left) * leftTotal + rightArea[plane] * rightCount[plane];
+				if (cost < bestCost) {
+					bestCost = cost;
+					bestAxis = axis;
+					bestPlane = plane;
+				}
+			}
+		}
+	}
+
+	if (bestAxis >= 0) {
+		//Traversal costs one unit, each primitive test one unit
+		float area = HalfArea(bounds);
+		float splitCost = 1.0f + (area > 0.0f ? bestCost / area : (float)count);
+		if (count <= kMaxLeafSize && splitCost >= (float)count) {
+			return 0;
+		}
+		float minCentroid = Axis(centroidBounds.min, bestAxis);
+		float scale = kSahBins / Axis(extent, bestAxis);
+		uint32_t* middle = std::partition(ids.data() + first, ids.data() + first + count, [&](uint32_t id) {
+			return BinIndex(Axis(builder.centroids[id], bestAxis), minCentroid, scale) < bestPlane;
+		});
+		uint32_t leftCount = (uint32_t)(middle - (ids.data() + first));
+		if (leftCount > 0 && leftCount < count) {
+			return leftCount;
+		}
+	}
+	if (count <= kMaxLeafSize) {
+		return 0;
+	}
+
+	//No useful SAH split (all centroids equal, or too deep): median on the widest axis
+	int axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+	uint32_t half = count / 2;
+	std::nth_element(ids.data() + first, ids.data() + first + half, ids.data() + first + count, [&](uint32_t a, uint32_t b) {
+		return Axis(builder.centroids[a], axis) < Axis(builder.centroids[b], axis);
+	});
+	return half;
+}
+
+static void BuildNode(BvhBuilder& builder, uint32_t first, uint32_t count, int depth) {
+	Bvh3D* bvh = builder.bvh;
+	uint32_t index = (uint32_t)bvh->nodes.size();
+	bvh->nodes.push_back(BvhNode());
+
+	Bounds bounds = EmptyBounds();
+	Bounds centroidBounds = EmptyBounds();
+	for (uint32_t i = first; i < first + count; ++i) {
+		uint32_t id = bvh->slotIds[i];
+		Grow(bounds, bvh->primitiveBounds[id]);
+		Grow(centroidBounds, builder.centroids[id]);
+	}
+	bvh->nodes[index].boundsMin = bounds.min;
+	bvh->nodes[index].boundsMax = bounds.max;
+
+	uint32_t leftCount = PartitionNode(builder, first, count, bounds, centroidBounds, depth);
+	if (leftCount == 0) {
+		bvh->nodes[index].leftOrFirst = first;
+		bvh->nodes[index].count = count;
+		return;
+	}
+	BuildNode(builder, first, leftCount, depth + 1);
+	bvh->nodes[index].leftOrFirst = (uint32_t)bvh->nodes.size();
+	bvh->nodes[index].count = 0;
+	BuildNode(builder, first + leftCount, count - leftCount, depth + 1);
+}
+
+static void BuildTree(Bvh3D* bvh) {
+	size_t n = bvh->primitiveBounds.size();
+	bvh->nodes.clear();
+	bvh->slotIds.resize(n);
+	for (size_t i = 0; i < n; ++i) {
+		bvh->slotIds[i] = (uint32_t)i;
+	}
+	if (n == 0) {
+		return;
+	}
+
+	ScratchBuffer<Vec3> centroids(n);
+	BvhBuilder builder;
+	builder.bvh = bvh;
+	builder.centroids = centroids.Data();
+	for (size_t i = 0; i < n; ++i) {
+		builder.centroids[i] = (bvh->primitiveBounds[i].min + bvh->primitiveBounds[i].max) * 0.5f;
+	}
+	bvh->nodes.reserve(n * 2);
+	BuildNode(builder, 0, (uint32_t)n, 0);
+}
+
+//Children always come after their parent, so one backwards pass is bottom-up
+static void RefitTree(Bvh3D* bvh) {
+	for (size_t i = bvh->nodes.size(); i-- > 0;) {
+		BvhNode& node = bvh->nodes[i];
+		Bounds bounds = EmptyBounds();
+		if (node.count > 0) {
+			for (uint32_t slot = node.leftOrFirst; slot < node.leftOrFirst + node.count; ++slot) {
+				Grow(bounds, bvh->primitiveBounds[bvh->slotIds[slot]]);
+			}
+		}
+		else {
+			const BvhNode& left = bvh->nodes[i + 1];
+			const BvhNode& right = bvh->nodes[node.leftOrFirst];
+			bounds.min = Min(left.boundsMin, right.boundsMin);
+			bounds.max = Max(left.boundsMax, right.boundsMax);
+		}
+		node.boundsMin = bounds.min;
+		node.boundsMax = bounds.max;
+	}
+}
+
+static void SetBoxes(Bvh3D* bvh, const Vec3* boxMin, const Vec3* boxMax, size_t n) {
+	bvh->spheres = false;
+	bvh->centers.clear();
+	bvh->radii.clear();
+	bvh->primitiveBounds.resize(n);
+	for (size_t i = 0; i < n; ++i) {
+		bvh->primitiveBounds[i] = { boxMin[i], boxMax[i] };
+	}
+}
+
+static void SetSpheres(Bvh3D* bvh, const Vec3* centers, const float* radii, size_t n) {
+	bvh->spheres = true;
+	bvh->centers.assign(centers, centers + n);
+	bvh->radii.assign(radii, radii + n);
+	bvh->primitiveBounds.resize(n);
+	for (size_t i = 0; i < n; ++i) {
+		Vec3 r = { radii[i], radii[i], radii[i] };
+		bvh->primitiveBounds[i] = { centers[i] - r, centers[i] + r };
+	}
+}
+
+
+//Intersection tests
+static float MinFloat(float a, float b) {
+	return a < b ? a : b;
+}
+
+static float MaxFloat(float a, float b) {
+	return a > b ? a : b;
+}
+
+//Narrows [tNear, tFar] to one slab; false when the ray never enters it. A
+//ray parallel to the slab (infinite inverse) is inside it for every t or for
+//none. That is tested directly, as an origin on one of the planes would give
+//0 * inf = NaN, and grazing a face would then hit or miss depending on the axis.
+static bool ClipSlab(float boxMin, float boxMax, float origin, float inverse, float& tNear, float& tFar) {
+	if (inverse == kInfinity || inverse == -kInfinity) {
+		return origin >= boxMin && origin <= boxMax;
+	}
+	float t1 = (boxMin - origin) * inverse;
+	float t2 = (boxMax - origin) * inverse;
+	tNear = MaxFloat(tNear, t1 < t2 ? t1 : t2);
+	tFar = MinFloat(tFar, t1 < t2 ? t2 : t1);
+	return true;
+}
+
+//Slab test; returns the entry distance (0 when the origin is inside) or
+//infinity when the box is missed or further than maxDistance
+static float RayBoxEntry(Vec3 origin, Vec3 inverseDirection, Vec3 boxMin, Vec3 boxMax, float maxDistance) {
+	float tNear = 0.0f;
+	float tFar = maxDistance;
+	if (!ClipSlab(boxMin.x, boxMax.x, origin.x, inverseDirection.x, tNear, tFar)
+		|| !ClipSlab(boxMin.y, boxMax.y, origin.y, inverseDirection.y, tNear, tFar)
+		|| !ClipSlab(boxMin.z, boxMax.z, origin.z, inverseDirection.z, tNear, tFar)) {
+		return kInfinity;
+	}
+	return tNear <= tFar ? tNear : kInfinity;
+}
+
+//unitDirection must be normalized; returns 0 when the origin is inside
+static float RaySphereEntry(Vec3 origin, Vec3 unitDirection, Vec3 center, float radius, float maxDistance) {
+	Vec3 offset = origin - center;
+	float b = Dot(offset, unitDirection);
+	float c = Dot(offset, offset) - radius * radius;
+	if (c > 0.0f && b > 0.0f) {
+		return kInfinity;
+	}
+	float discriminant = b * b - c;
+	if (discriminant < 0.0f) {
+		return kInfinity;
+	}
+	float t = -b - Sqrt(discriminant);
+	t = t > 0.0f ? t : 0.0f;
+	return t <= maxDistance ? t : kInfinity;
+}
+
+static float RayPrimitiveEntry(const Bvh3D* bvh, uint32_t id, Vec3 origin, Vec3 unitDirection, Vec3 inverseDirection, float maxDistance) {
+	if (bvh->spheres) {
+		return RaySphereEntry(origin, unitDirection, bvh->centers[id], bvh->radii[id], maxDistance);
+	}
+	const Bounds& b = bvh->primitiveBounds[id];
+	return RayBoxEntry(origin, inverseDirection, b.min, b.max, maxDistance);
+}
+
+static float DistanceSquaredToBox(Vec3 p, Vec3 boxMin, Vec3 boxMax) {
+	Vec3 closest = Min(Max(p, boxMin), boxMax);
+	return MagnitudeSquared(p - closest);
+}
+
+static bool BoxesOverlap(Vec3 aMin, Vec3 aMax, Vec3 bMin, Vec3 bMax) {
+	return aMin.x <= bMax.x && aMax.x >= bMin.x && aMin.y <= bMax.y && aMax.y >= bMin.y && aMin.z <= bMax.z && aMax.z >= bMin.z;
+}
+
+static Vec3 InverseDirection(Vec3 d) {
+	return { 1.0f / d.x, 1.0f / d.y, 1.0f / d.z };
+}
+
+//Results are written up to capacity; the return value is the full count
+static void WriteResult(int* out, size_t capacity, size_t& count, int value) {
+	if (out != nullptr && count < capacity) {
+		out[count] = value;
+	}
+	++count;
+}
+
+
+//Traversal
+//Closest hit along one ray, front to back: the nearer child is visited first
+//and the farther one is pushed only when it is hit before the best distance
+static void TraceRay(const Bvh3D* bvh, Vec3 origin, Vec3 unitDirection, RayHit& best) {
+	Vec3 inverse = InverseDirection(unitDirection);
+	const BvhNode* nodes = bvh->nodes.data();
+	if (RayBoxEntry(origin, inverse, nodes[0].boundsMin, nodes[0].boundsMax, best.distance) == kInfinity) {
+		return;
+	}
+
+	uint32_t stack[kStackSize];
+	int top = 0;
+	uint32_t index = 0;
+	for (;;) {
+		const BvhNode& node = nodes[index];
+		if (node.count > 0) {
+			for (uint32_t slot = node.leftOrFirst; slot < node.leftOrFirst + node.count; ++slot) {
+				uint32_t id = bvh->slotIds[slot];
+				float t = RayPrimitiveEntry(bvh, id, origin, unitDirection, inverse, best.distance);
+				if (t < best.distance || (t == best.distance && best.id < 0)) {
+					best.id = (int)id;
+					best.distance = t;
+				}
+			}
+			if (top == 0) {
+				return;
+			}
+			index = stack[--top];
+			continue;
+		}
+
+		uint32_t closer = index + 1;
+		uint32_t farther = node.leftOrFirst;
+		float tCloser = RayBoxEntry(origin, inverse, nodes[closer].boundsMin, nodes[closer].boundsMax, best.distance);
+		float tFarther = RayBoxEntry(origin, inverse, nodes[farther].boundsMin, nodes[farther].boundsMax, best.distance);
+		if (tFarther < tCloser) {
+			std::swap(closer, farther);
+			std::swap(tCloser, tFarther);
+		}
+		if (tCloser == kInfinity) {
+			if (top == 0) {
+				return;
+			}
+			index = stack[--top];
+			continue;
+		}
+		if (tFarther != kInfinity) {
+			stack[top++] = farther;
+		}
+		index = closer;
+	}
+}
+
+//Up to kPacketSize rays share one walk down the tree: a node is entered when
+//any ray in the packet can still hit it. Coherent rays (same origin, similar
+//directions) touch almost the same nodes, so each node is loaded and each
+//traversal decision made once per packet instead of once per ray. The box
+//tests themselves still run lane by lane through RayBoxEntry.
+struct RayPacket {
+	Vec3 origin[kPacketSize];
+	Vec3 direction[kPacketSize];
+	Vec3 inverse[kPacketSize];
+	RayHit best[kPacketSize];
+};
+
+//Closest entry of any ray in the packet that can still improve its hit
+static float PacketEntry(const RayPacket& packet, const BvhNode& node) {
+	float entry = kInfinity;
+	for (int lane = 0; lane < kPacketSize; ++lane) {
+		entry = MinFloat(entry, RayBoxEntry(packet.origin[lane], packet.inverse[lane], node.boundsMin, node.boundsMax, packet.best[lane].distance));
+	}
+	return entry;
+}
+
+//Packets only pay off when the rays head the same way; otherwise every ray
+//would drag the others through its nodes
+static bool PacketIsCoherent(const RayPacket& packet) {
+	int signs = -1;
+	for (int lane = 0; lane < kPacketSize; ++lane) {
+		if (packet.best[lane].distance < 0.0f) {
+			continue;
+		}
+		Vec3 d = packet.direction[lane];
+		int laneSigns = (d.x < 0.0f ? 1 : 0) | (d.y < 0.0f ? 2 : 0) | (d.z < 0.0f ? 4 : 0);
+		if (signs >= 0 && laneSigns != signs) {
+			return false;
+		}
+		signs = laneSigns;
+	}
+	return true;
+}
+
+static void TracePacket(const Bvh3D* bvh, RayPacket& packet) {
+	if (!PacketIsCoherent(packet)) {
+		for (int lane = 0; lane < kPacketSize; ++lane) {
+			if (packet.best[lane].distance >= 0.0f) {
+				TraceRay(bvh, packet.origin[lane], packet.direction[lane], packet.best[lane]);
+			}
+		}
+		return;
+	}
+
+	//Same front to back walk as TraceRay, with the packet's closest entry
+	const BvhNode* nodes = bvh->nodes.data();
+	if (PacketEntry(packet, nodes[0]) == kInfinity) {
+		return;
+	}
+	uint32_t stack[kStackSize];
+	int top = 0;
+	uint32_t index = 0;
+	for (;;) {
+		const BvhNode& node = nodes[index];
+		if (node.count > 0) {
+			for (uint32_t slot = node.leftOrFirst; slot < node.leftOrFirst + node.count; ++slot) {
+				uint32_t id = bvh->slotIds[slot];
+				for (int lane = 0; lane < kPacketSize; ++lane) {
+					RayHit& best = packet.best[lane];
+					float t = RayPrimitiveEntry(bvh, id, packet.origin[lane], packet.direction[lane], packet.inverse[lane], best.distance);
+					if (t < best.distance || (t == best.distance && best.id < 0)) {
+						best.id = (int)id;
+						best.distance = t;
+					}
+				}
+			}
+			if (top == 0) {
+				return;
+			}
+			index = stack[--top];
+			continue;
+		}
+
+		uint32_t closer = index + 1;
+		uint32_t farther = node.leftOrFirst;
+		float tCloser = PacketEntry(packet, nodes[closer]);
+		float tFarther = PacketEntry(packet, nodes[farther]);
+		if (tFarther < tCloser) {
+			std::swap(closer, farther);
+			std::swap(tCloser, tFarther);
+		}
+		if (tCloser == kInfinity) {
+			if (top == 0) {
+				return;
+			}
+			index = stack[--top];
+			continue;
+		}
+		if (tFarther != kInfinity) {
+			stack[top++] = farther;
+		}
+		index = closer;
+	}
+}
+
+
+Bvh3D* Bvh3DCreate() {
+	VECTORMATH_STATS(1);
+	Bvh3D* bvh = new Bvh3D();
+	bvh->spheres = false;
+	return bvh;
+}
+
+void Bvh3DDestroy(Bvh3D* bvh) {
+	VECTORMATH_STATS(1);
+	delete bvh;
+}
+
+void Bvh3DBuild(Bvh3D* bvh, const Vec3* boxMin, const Vec3* boxMax, size_t n) {
+	VECTORMATH_STATS(n);
+	if (bvh == nullptr) {
+		return;
+	}
+	SetBoxes(bvh, boxMin, boxMax, n);
+	BuildTree(bvh);
+}
+
+void Bvh3DBuildSpheres(Bvh3D* bvh, const Vec3* centers, const float* radii, size_t n) {
+	VECTORMATH_STATS(n);
+	if (bvh == nullptr) {
+		return;
+	}
+	SetSpheres(bvh, centers, radii, n);
+	BuildTree(bvh);
+}
+
+void Bvh3DRefit(Bvh3D* bvh, const Vec3* boxMin, const Vec3* boxMax) {
+	VECTORMATH_STATS(1);
+	if (bvh == nullptr) {
+		return;
+	}
+	SetBoxes(bvh, boxMin, boxMax, bvh->primitiveBounds.size());
+	RefitTree(bvh);
+}
+
+void Bvh3DRefitSpheres(Bvh3D* bvh, const Vec3* centers, const float* radii) {
+	VECTORMATH_STATS(1);
+	if (bvh == nullptr) {
+		return;
+	}
+	SetSpheres(bvh, centers, radii, bvh->primitiveBounds.size());
+	RefitTree(bvh);
+}
+
+size_t Bvh3DCount(const Bvh3D* bvh) {
+	VECTORMATH_STATS(1);
+	return bvh != nullptr ? bvh->primitiveBounds.size() : 0;
+}
+
+size_t Bvh3DNodeCount(const Bvh3D* bvh) {
+	VECTORMATH_STATS(1);
+	return bvh != nullptr ? bvh->nodes.size() : 0;
+}
+
+int Bvh3DRaycast(const Bvh3D* bvh, Vec3 origin, Vec3 direction, float maxDistance, RayHit* hit) {
+	VECTORMATH_STATS(1);
+	RayHit best = { -1, maxDistance };
+	float length = Magnitude(direction);
+	if (bvh != nullptr && !bvh->nodes.empty() && length >= kEpsilon && maxDistance >= 0.0f) {
+		TraceRay(bvh, origin, direction / length, best);
+	}
+	if (hit != nullptr) {
+		*hit = best;
+	}
+	return best.id >= 0 ? 1 : 0;
+}
+
+void Bvh3DRaycastBatch(const Bvh3D* bvh, const Vec3* origins, const Vec3* directions, size_t n, float maxDistance, RayHit* hits) {
+	VECTORMATH_STATS(n);
+	bool empty = bvh == nullptr || bvh->nodes.empty() || !(maxDistance >= 0.0f);
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		for (size_t first = begin; first < end; first += kPacketSize) {
+			size_t count = end - first < (size_t)kPacketSize ? end - first : (size_t)kPacketSize;
+			//Unused lanes and zero length directions get a negative best
+			//distance, so they never hit anything
+			RayPacket packet;
+			for (int lane = 0; lane < kPacketSize; ++lane) {
+				size_t i = first + lane;
+				float length = (size_t)lane < count ? Magnitude(directions[i]) : 0.0f;
+				bool active = !empty && length >= kEpsilon;
+				packet.origin[lane] = active ? origins[i] : Vec3{ 0.0f, 0.0f, 0.0f };
+				packet.direction[lane] = active ? directions[i] / length : Vec3{ 1.0f, 0.0f, 0.0f };
+				packet.inverse[lane] = InverseDirection(packet.direction[lane]);
+				packet.best[lane] = { -1, active ? maxDistance : -1.0f };
+			}
+			if (!empty) {
+				TracePacket(bvh, packet);
+			}
+			for (size_t lane = 0; lane < count; ++lane) {
+				hits[first + lane] = packet.best[lane].id >= 0 ? packet.best[lane] : RayHit{ -1, maxDistance };
+			}
+		}
+	});
+}
+
+size_t Bvh3DOverlapSphere(const Bvh3D* bvh, Vec3 center, float radius, int* outIds, size_t capacity) {
+	VECTORMATH_STATS(1);
+	if (bvh == nullptr || bvh->nodes.empty() || !(radius >= 0.0f)) {
+		return 0;
+	}
+	const BvhNode* nodes = bvh->nodes.data();
+	float radiusSquared = radius * radius;
+	size_t count = 0;
+	uint32_t stack[kStackSize];
+	int top = 0;
+	stack[top++] = 0;
+	while (top > 0) {
+		uint32_t index = stack[--top];
+		const BvhNode& node = nodes[index];
+		if (DistanceSquaredToBox(center, node.boundsMin, node.boundsMax) > radiusSquared) {
+			continue;
+		}
+		if (node.count == 0) {
+			stack[top++] = node.leftOrFirst;
+			stack[top++] = index + 1;
+			continue;
+		}
+		for (uint32_t slot = node.leftOrFirst; slot < node.leftOrFirst + node.count; ++slot) {
+			uint32_t id = bvh->slotIds[slot];
+			bool overlaps;
+			if (bvh->spheres) {
+				float reach = radius + bvh->radii[id];
+				overlaps = MagnitudeSquared(bvh->centers[id] - center) <= reach * reach;
+			}
+			else {
+				overlaps = DistanceSquaredToBox(center, bvh->primitiveBounds[id].min, bvh->primitiveBounds[id].max) <= radiusSquared;
+			}
+			if (overlaps) {
+				WriteResult(outIds, capacity, count, (int)id);
+			}
+		}
+	}
+	return count;
+}
+
+size_t Bvh3DOverlapAABB(const Bvh3D* bvh, Vec3 boxMin, Vec3 boxMax, int* outIds, size_t capacity) {
+	VECTORMATH_STATS(1);
+	if (bvh == nullptr || bvh->nodes.empty()) {
+		return 0;
+	}
+	const BvhNode* nodes = bvh->nodes.data();
+	size_t count = 0;
+	uint32_t stack[kStackSize];
+	int top = 0;
+	stack[top++] = 0;
+	while (top > 0) {
+		uint32_t index = stack[--top];
+		const BvhNode& node = nodes[index];
+		if (!BoxesOverlap(boxMin, boxMax, node.boundsMin, node.boundsMax)) {
+			continue;
+		}
+		if (node.count == 0) {
+			stack[top++] = node.leftOrFirst;
+			stack[top++] = index + 1;
+			continue;
+		}
+		for (uint32_t slot = node.leftOrFirst; slot < node.leftOrFirst + node.count; ++slot) {
+			uint32_t id = bvh->slotIds[slot];
+			bool overlaps;
+			if (bvh->spheres) {
+				float r = bvh->radii[id];
+				overlaps = DistanceSquaredToBox(bvh->centers[id], boxMin, boxMax) <= r * r;
+			}
+			else {
+				overlaps = BoxesOverlap(boxMin, boxMax, bvh->primitiveBounds[id].min, bvh->primitiveBounds[id].max);
+			}
+			if (overlaps) {
+				WriteResult(outIds, capacity, count, (int)id);
+			}
+		}
+	}
+	return count;
+}
@@ -0,0 +1,374 @@
+//Always include the pch.h first in every cpp
+#include "pch.h"
+
+//Then include own items
+#include "VectorMath.h"
+#include "VectorMathArena.h"
+#include "VectorMathKernels.h"
+#include "VectorMathStats.h"
+#include "VectorMathThreads.h"
+#include <algorithm>
+#include <vector>
+
+//Cubic splines over Vec2 / Vec3.
+//Every curve type is turned into cubic Bezier segments of four control points
+//(Hermite: p0, p0 + m0 / 3, p1 - m1 / 3, p1; uniform Catmull-Rom: the Hermite
+//form with tangents (next - previous) / 2), so one pair of kernels evaluates
+//them all. Samples are located in their segment first, then each run of
+//samples in the same segment goes through the kernel in one call.
+//Curve objects keep the segments and a table of the arc length at
+//samplesPerSegment evenly spaced parameters per segment. A distance along the
+//curve is found in the table by binary search and interpolated linearly
+//between its entries, which is close to constant speed without integrating
+//at sample time.
+
+using namespace vmath;
+
+//Samples located per pass of SampleRange (segment and local u on the stack)
+static const size_t kCurveBlock = 256;
+
+static const size_t kDefaultSamplesPerSegment = 32;
+
+template <typename V>
+struct CurveData {
+	int type;
+	size_t segments;
+	size_t samplesPerSegment;
+	std::vector<V> points;
+	std::vector<V> controls;  //4 per segment
+	std::vector<float> lengths; //arc length at each table entry, segments * samplesPerSegment + 1
+};
+
+struct Curve2D : CurveData<Vec2> {};
+struct Curve3D : CurveData<Vec3> {};
+
+static inline void EvaluateSegment(const VectorKernels& kernels, const Vec2* controls, const float* u, Vec2* out, size_t n) {
+	kernels.bezier2((const float*)controls, u, (float*)out, n);
+}
+
+static inline void EvaluateSegment(const VectorKernels& kernels, const Vec3* controls, const float* u, Vec3* out, size_t n) {
+	kernels.bezier3((const float*)controls, u, (float*)out, n);
+}
+
+//Segments of a curve of pointCount points, 0 when the count does not fit the type
+static size_t SegmentCount(int type, size_t pointCount) {
+	switch (type) {
+	case VECTORMATH_CURVE_BEZIER:
+		return pointCount >= 4 && (pointCount - 1) % 3 == 0 ? (pointCount - 1) / 3 : 0;
+	case VECTORMATH_CURVE_CATMULL_ROM:
+		return pointCount >= 2 ? pointCount - 1 : 0;
+	case VECTORMATH_CURVE_HERMITE:
+		return pointCount >= 4 && pointCount % 2 == 0 ? pointCount / 2 - 1 : 0;
+	default:
+		return 0;
+	}
+}
+
+template <typename V>
+static void BuildControls(int type, const V* points, size_t pointCount, size_t segments, V* controls) {
+	for (size_t s = 0; s < segments; ++s) {
+		V* c = controls + s * 4;
+		if (type == VECTORMATH_CURVE_BEZIER) {
+			c[0] = points[s * 3];
+			c[1] = points[s * 3 + 1];
+			c[2] = points[s * 3 + 2];
+			c[3] = points[s * 3 + 3];
+		}
+		else if (type == VECTORMATH_CURVE_HERMITE) {
+			V p0 = points[s * 2];
+			V p1 = points[s * 2 + 2];
+			c[0] = p0;
+			c[1] = p0 + points[s * 2 + 1] / 3.0f;
+			c[2] = p1 - points[s * 2 + 3] / 3.0f;
+			c[3] = p1;
+		}
+		else {
+			//The missing neighbours of the end points are mirrored through them
+			V p1 = points[s];
+			V p2 = points[s + 1];
+			V p0 = s > 0 ? points[s - 1] : p1 * 2.0f - p2;
+			V p3 = s + 2 < pointCount ? points[s + 2] : p2 * 2.0f - p1;
+			c[0] = p1;
+			c[1] = p1 + (p2 - p0) / 6.0f;
+			c[2] = p2 - (p3 - p1) / 6.0f;
+			c[3] = p2;
+		}
+	}
+}
+
+//Segment holding t (clamped to [0, 1], NaN to 0) and the parameter within it;
+//t = 1 is the end of the last segment
+static inline size_t SegmentAt(float t, size_t segments, float& local) {
+	float clamped = t > 0.0f ? (t < 1.0f ? t : 1.0f) : 0.0f;
+	float u = clamped * (float)segments;
+	size_t segment = (size_t)u;
+	if (segment >= segments) {
+		segment = segments - 1;
+	}
+	local = u - (float)segment;
+	return segment;
+}
+
+//out[i] for i in [begin, end), with locate(i, local) giving the segment of
+//sample i; runs of samples in the same segment share one kernel call
+template <typename V, typename Locate>
+static void SampleRange(const V* controls, size_t begin, size_t end, V* out, const Locate& locate) {
+	const VectorKernels& kernels = ActiveKernels();
+	size_t segment[kCurveBlock];
+	float local[kCurveBlock];
+	for (size_t first = begin; first < end; first += kCurveBlock) {
+		size_t count = std::min(kCurveBlock, end - first);
+		for (size_t i = 0; i < count; ++i) {
+			segment[i] = locate(first + i, local[i]);
+		}
+		size_t i = 0;
+		while (i < count) {
+			size_t runEnd = i + 1;
+			while (runEnd < count && segment[runEnd] == segment[i]) {
+				++runEnd;
+			}
+			EvaluateSegment(kernels, controls + segment[i] * 4, local + i, out + first + i, runEnd - i);
+			i = runEnd;
+		}
+	}
+}
+
+template <typename V>
+static int EvaluateCurves(int type, const V* points, size_t pointsPerCurve, size_t curveCount, const float* t, size_t tCount, V* out) {
+	size_t segments = SegmentCount(type, pointsPerCurve);
+	if (segments == 0) {
+		return 0;
+	}
+	//One index per output, so one long curve splits across the pool as well as many short ones
+	ParallelRange(curveCount * tCount, [&](size_t begin, size_t end) {
+		ScratchBuffer<V> controls(segments * 4);
+		size_t index = begin;
+		while (index < end) {
+			size_t curve = index / tCount;
+			size_t curveStart = curve * tCount;
+			size_t curveEnd = std::min(end, curveStart + tCount);
+			BuildControls(type, points + curve * pointsPerCurve, pointsPerCurve, segments, controls.Data());
+			SampleRange(controls.Data(), index, curveEnd, out, [&](size_t i, float& local) {
+				return SegmentAt(t[i - curveStart], segments, local);
+			});
+			index = curveEnd;
+		}
+	});
+	return 1;
+}
+
+//Rebuilds the segments and the arc-length table from curve.points
+template <typename V>
+static void RebuildCurve(CurveData<V>& curve) {
+	size_t samples = curve.samplesPerSegment;
+	curve.controls.resize(curve.segments * 4);
+	BuildControls(curve.type, curve.points.data(), curve.points.size(), curve.segments, curve.controls.data());
+
+	//Chord lengths between samplesPerSegment + 1 points of each segment; the
+	//total is kept in double so long rails do not lose the short chords
+	ScratchBuffer<float> u(samples + 1);
+	ScratchBuffer<V> positions(samples + 1);
+	for (size_t k = 0; k <= samples; ++k) {
+		u[k] = (float)k / (float)samples;
+	}
+	const VectorKernels& kernels = ActiveKernels();
+	curve.lengths.resize(curve.segments * samples + 1);
+	curve.lengths[0] = 0.0f;
+	double total = 0.0;
+	for (size_t s = 0; s < curve.segments; ++s) {
+		EvaluateSegment(kernels, &curve.controls[s * 4], u.Data(), positions.Data(), samples + 1);
+		for (size_t k = 1; k <= samples; ++k) {
+			total += Magnitude(positions[k] - positions[k - 1]);
+			curve.lengths[s * samples + k] = (float)total;
+		}
+	}
+}
+
+template <typename V>
+static void InitCurve(CurveData<V>* curve, int type, const V* points, size_t pointCount, size_t samplesPerSegment) {
+	curve->type = type;
+	curve->segments = SegmentCount(type, pointCount);
+	curve->samplesPerSegment = samplesPerSegment > 0 ? samplesPerSegment : kDefaultSamplesPerSegment;
+	curve->points.assign(points, points + pointCount);
+	RebuildCurve(*curve);
+}
+
+//Segment and local parameter at a distance along the curve (clamped to
+//[0, length], NaN to 0), interpolated between the arc-length table entries.
+//hint is the entry found for the previous sample: sorted distances usually
+//land in it or a few entries later, which skips the binary search. The entry
+//is the one with lengths[entry] <= distance < lengths[entry + 1] either way.
+template <typename V>
+static inline size_t SegmentAtDistance(const CurveData<V>& curve, float distance, size_t& hint, float& local) {
+	const std::vector<float>& lengths = curve.lengths;
+	size_t samples = curve.samplesPerSegment;
+	size_t last = lengths.size() - 1;
+	size_t entry = 0;
+	float fraction = 0.0f;
+	if (distance >= lengths[last]) {
+		entry = last - 1;
+		fraction = 1.0f;
+	}
+	else if (distance > 0.0f) {
+		entry = hint;
+		while (entry < hint + 4 && lengths[entry + 1] <= distance) {
+			++entry;
+		}
+		if (!(lengths[entry] <= distance && distance < lengths[entry + 1])) {
+			entry = (size_t)(std::upper_bound(lengths.begin(), lengths.end(), distance) - lengths.begin()) - 1;
+		}
+		float span = lengths[entry + 1] - lengths[entry];
+		fraction = span > 0.0f ? (distance - lengths[entry]) / span : 0.0f;
+	}
+	hint = entry;
+	size_t segment = entry / samples;
+	local = ((float)(entry % samples) + fraction) / (float)samples;
+	return segment;
+}
+
+template <typename V>
+static void SampleCurve(const CurveData<V>& curve, const float* t, V* out, size_t n) {
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		SampleRange(curve.controls.data(), begin, end, out, [&](size_t i, float& local) {
+			return SegmentAt(t[i], curve.segments, local);
+		});
+	});
+}
+
+template <typename V>
+static void SampleCurveDistance(const CurveData<V>& curve, const float* distances, V* out, size_t n) {
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		size_t hint = 0;
+		SampleRange(curve.controls.data(), begin, end, out, [&](size_t i, float& local) {
+			return SegmentAtDistance(curve, distances[i], hint, local);
+		});
+	});
+}
+
+template <typename V>
+static void ParameterAtDistance(const CurveData<V>& curve, const float* distances, float* outT, size_t n) {
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		size_t hint = 0;
+		for (size_t i = begin; i < end; ++i) {
+			float local;
+			size_t segment = SegmentAtDistance(curve, distances[i], hint, local);
+			outT[i] = ((float)segment + local) / (float)curve.segments;
+		}
+	});
+}
+
+int VectorCurveEvaluate2D(int type, const Vec2* points, size_t pointsPerCurve, size_t curveCount, const float* t, size_t tCount, Vec2* out) {
+	VECTORMATH_STATS(curveCount * tCount);
+	return EvaluateCurves(type, points, pointsPerCurve, curveCount, t, tCount, out);
+}
+
+int VectorCurveEvaluate3D(int type, const Vec3* points, size_t pointsPerCurve, size_t curveCount, const float* t, size_t tCount, Vec3* out) {
+	VECTORMATH_STATS(curveCount * tCount);
+	return EvaluateCurves(type, points, pointsPerCurve, curveCount, t, tCount, out);
+}
+
+Curve2D* Curve2DCreate(int type, const Vec2* points, size_t pointCount, size_t samplesPerSegment) {
+	VECTORMATH_STATS(pointCount);
+	if (points == nullptr || SegmentCount(type, pointCount) == 0) {
+		return nullptr;
+	}
+	Curve2D* curve = new Curve2D();
+	InitCurve(curve, type, points, pointCount, samplesPerSegment);
+	return curve;
+}
+
+void Curve2DDestroy(Curve2D* curve) {
+	VECTORMATH_STATS(1);
+	delete curve;
+}
+
+void Curve2DUpdate(Curve2D* curve, const Vec2* points) {
+	VECTORMATH_STATS(curve != nullptr ? curve->points.size() : 0);
+	if (curve == nullptr || points == nullptr) {
+		return;
+	}
+	std::copy(points, points + curve->points.size(), curve->points.begin());
+	RebuildCurve(*curve);
+}
+
+float Curve2DLength(const Curve2D* curve) {
+	VECTORMATH_STATS(1);
+	return curve != nullptr ? curve->lengths.back() : 0.0f;
+}
+
+void Curve2DSample(const Curve2D* curve, const float* t, Vec2* out, size_t n) {
+	VECTORMATH_STATS(n);
+	if (curve == nullptr) {
+		return;
+	}
+	SampleCurve(*curve, t, out, n);
+}
+
+void Curve2DSampleDistance(const Curve2D* curve, const float* distances, Vec2* out, size_t n) {
+	VECTORMATH_STATS(n);
+	if (curve == nullptr) {
+		return;
+	}
+	SampleCurveDistance(*curve, distances, out, n);
+}
+
+void Curve2DParameterAtDistance(const Curve2D* curve, const float* distances, float* outT, size_t n) {
+	VECTORMATH_STATS(n);
+	if (curve == nullptr) {
+		return;
+	}
+	ParameterAtDistance(*curve, distances, outT, n);
+}
+
+Curve3D* Curve3DCreate(int type, const Vec3* points, size_t pointCount, size_t samplesPerSegment) {
+	VECTORMATH_STATS(pointCount);
+	if (points == nullptr || SegmentCount(type, pointCount) == 0) {
+		return nullptr;
+	}
+	Curve3D* curve = new Curve3D();
+	InitCurve(curve, type, points, pointCount, samplesPerSegment);
+	return curve;
+}
+
+void Curve3DDestroy(Curve3D* curve) {
+	VECTORMATH_STATS(1);
+	delete curve;
+}
+
+void Curve3DUpdate(Curve3D* curve, const Vec3* points) {
+	VECTORMATH_STATS(curve != nullptr ? curve->points.size() : 0);
+	if (curve == nullptr || points == nullptr) {
+		return;
+	}
+	std::copy(points, points + curve->points.size(), curve->points.begin());
+	RebuildCurve(*curve);
+}
+
+float Curve3DLength(const Curve3D* curve) {
+	VECTORMATH_STATS(1);
+	return curve != nullptr ? curve->lengths.back() : 0.0f;
+}
+
+void Curve3DSample(const Curve3D* curve, const float* t, Vec3* out, size_t n) {
+	VECTORMATH_STATS(n);
+	if (curve == nullptr) {
+		return;
+	}
+	SampleCurve(*curve, t, out, n);
+}
+
+void Curve3DSampleDistance(const Curve3D* curve, const float* distances, Vec3* out, size_t n) {
+	VECTORMATH_STATS(n);
+	if (curve == nullptr) {
+		return;
+	}
+	SampleCurveDistance(*curve, distances, out, n);
+}
+
+void Curve3DParameterAtDistance(const Curve3D* curve, const float* distances, float* outT, size_t n) {
+	VECTORMATH_STATS(n);
+	if (curve == nullptr) {
+		return;
+	}
+	ParameterAtDistance(*curve, distances, outT, n);
+}
@@ -0,0 +1,193 @@
+//Always include the pch.h first in every cpp
+#include "pch.h"
+
+//Then include own items
+#include "VectorMath.h"
+#include "VectorMathKernels.h"
+#include "VectorMathStats.h"
+#include <atomic>
+
+#if defined(VECTORMATH_X86)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+//Picks the kernel table used by the batch functions. Detection runs once while
+//the library is being loaded (see g_loadTimeSelection below), so the hot paths
+//only pay for one pointer load.
+
+#if defined(VECTORMATH_X86)
+
+static void Cpuid(int leaf, int subLeaf, unsigned int regs[4]) {
+#if defined(_MSC_VER)
+	int info[4];
+	__cpuidex(info, leaf, subLeaf);
+	for (int i = 0; i < 4; ++i) {
+		regs[i] = (unsigned int)info[i];
+	}
+#else
+	__cpuid_count(leaf, subLeaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+//XCR0 tells us whether the OS saves the YMM registers on a context switch.
+//Without that AVX instructions are unusable even if the CPU has them.
+static unsigned long long ReadXcr0() {
+#if defined(_MSC_VER)
+	return _xgetbv(0);
+#else
+	unsigned int eax, edx;
+	__asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+	return ((unsigned long long)edx << 32) | eax;
+#endif
+}
+
+static bool CpuHasSse41() {
+	unsigned int regs[4];
+	Cpuid(0, 0, regs);
+	if (regs[0] < 1) {
+		return false;
+	}
+	Cpuid(1, 0, regs);
+	return (regs[2] & (1u << 19)) != 0;
+}
+
+static bool CpuHasAvx2() {
+	unsigned int regs[4];
+	Cpuid(0, 0, regs);
+	unsigned int maxLeaf = regs[0];
+	if (maxLeaf < 7) {
+		return false;
+	}
+
+	Cpuid(1, 0, regs);
+	bool osxsave = (regs[2] & (1u << 27)) != 0;
+	bool avx = (regs[2] & (1u << 28)) != 0;
+	bool f16c = (regs[2] & (1u << 29)) != 0;
+	if (!osxsave || !avx || !f16c) {
+		return false;
+	}
+	if ((ReadXcr0() & 0x6) != 0x6) {
+		return false;
+	}
+
+	Cpuid(7, 0, regs);
+	return (regs[1] & (1u << 5)) != 0;
+}
+
+#endif
+
+static const VectorKernels* KernelsForLevel(int level) {
+	switch (level) {
+	case VECTORMATH_SIMD_SCALAR:
+		return GetScalarKernels();
+#if defined(VECTORMATH_X86)
+	case VECTORMATH_SIMD_SSE41:
+		return CpuHasSse41() ? GetSse41Kernels() : nullptr;
+	case VECTORMATH_SIMD_AVX2:
+		return CpuHasAvx2() ? GetAvx2Kernels() : nullptr;
+#endif
+#if defined(VECTORMATH_NEON)
+	case VECTORMATH_SIMD_NEON:
+		return GetNeonKernels();
+#endif
+	default:
+		return nullptr;
+	}
+}
+
+static int DetectBestLevel() {
+	const int preferred[] = { VECTORMATH_SIMD_AVX2, VECTORMATH_SIMD_NEON, VECTORMATH_SIMD_SSE41 };
+	for (int level : preferred) {
+		if (KernelsForLevel(level) != nullptr) {
+			return level;
+		}
+	}
+	return VECTORMATH_SIMD_SCALAR;
+}
+
+static std::atomic<const VectorKernels*> g_activeKernels{ nullptr };
+static std::atomic<int> g_activeLevel{ VECTORMATH_SIMD_SCALAR };
+
+static const VectorKernels* SelectBestKernels() {
+	int level = DetectBestLevel();
+	const VectorKernels* kernels = KernelsForLevel(level);
+	g_activeLevel.store(level, std::memory_order_relaxed);
+	g_activeKernels.store(kernels, std::memory_order_release);
+	return kernels;
+}
+
+const VectorKernels& ActiveKernels() {
+	const VectorKernels* kernels = g_activeKernels.load(std::memory_order_acquire);
+	if (kernels == nullptr) {
+		//Only reached if a batch function runs before static initialisation
+		kernels = SelectBestKernels();
+	}
+	return *kernels;
+}
+
+//Runs during DLL / shared object load
+static const VectorKernels* g_loadTimeSelection = SelectBestKernels();
+
+
+int VectorMathGetSimdLevel() {
+	VECTORMATH_STATS(1);
+	ActiveKernels();
+	return g_activeLevel.load(std::memory_order_relaxed);
+}
+
+const char* VectorMathGetSimdName() {
+	VECTORMATH_STATS(1);
+	return ActiveKernels().name;
+}
+
+int VectorMathIsSimdLevelSupported(int level) {
+	VECTORMATH_STATS(1);
+	return KernelsForLevel(level) != nullptr ? 1 : 0;
+}
+
+int VectorMathSetSimdLevel(int level) {
+	VECTORMATH_STATS(1);
+	if (level == VECTORMATH_SIMD_BEST) {
+		SelectBestKernels();
+		return 1;
+	}
+	const VectorKernels* kernels = KernelsForLevel(level);
+	if (kernels == nullptr) {
+		return 0;
+	}
+	g_activeLevel.store(level, std::memory_order_relaxed);
+	g_activeKernels.store(kernels, std::memory_order_release);
+	return 1;
+}
+
+int VectorMathIsDeterministic() {
+	VECTORMATH_STATS(1);
+#if defined(VECTORMATH_DETERMINISTIC)
+	return 1;
+#else
+	return 0;
+#endif
+}
+
+
+static std::atomic<int> g_precision{ VECTORMATH_PRECISION_EXACT };
+
+int ActivePrecision() {
+	return g_precision.load(std::memory_order_relaxed);
+}
+
+void VectorMathSetPrecision(int precision) {
+	VECTORMATH_STATS(1);
+	if (precision == VECTORMATH_PRECISION_EXACT || precision == VECTORMATH_PRECISION_FAST) {
+		g_precision.store(precision, std::memory_order_relaxed);
+	}
+}
+
+int VectorMathGetPrecision() {
+	VECTORMATH_STATS(1);
+	return ActivePrecision();
+}
@@ -0,0 +1,201 @@
+#pragma once
+
+#ifndef VECTOR_MATH_FIXED_H
+#define VECTOR_MATH_FIXED_H
+
+#include <cstdint>
+#include "VectorMathInline.h"
+
+//Q16.16 fixed-point scalar for lockstep simulation. Every operation is plain
+//integer maths, so results are bit-identical on every compiler and CPU no
+//matter how floats are handled. Vec2T<Fixed> / Vec3T<Fixed> get the whole
+//VectorMathInline.h API (operators, Dot, Normalize, Lerp, Reflect,
+//ClampMagnitude, ...) through the templates.
+//
+//Range is -32768 to 32767.99998 with a step of 1 / 65536. Results outside
+//the range wrap around; conversions from floating point saturate instead and
+//turn NaN into zero. Products grow fastest, so MagnitudeSquared and Dot
+//overflow once a length passes ~181; Magnitude and Normalize sum in 64 bits
+//and work for any vector in range. A vector in range can still be longer
+//than 32767.99998 (up to ~46341 in 2D, ~56756 in 3D): Magnitude saturates
+//there (and ClampMagnitude sees that length), Normalize stays exact.
+//Multiply, divide and sqrt round to nearest. Dividing by zero gives zero.
+
+namespace vmath {
+
+//Rounded Q16.16 raw value of v, clamped to the int32 range, NaN gives zero
+constexpr int32_t FixedRawFromDouble(double v) {
+    return v != v ? 0
+        : v * 65536.0 >= 2147483647.0 ? INT32_MAX
+        : v * 65536.0 <= -2147483648.0 ? INT32_MIN
+        : (int32_t)(v * 65536.0 + (v < 0.0 ? -0.5 : 0.5));
+}
+
+struct Fixed {
+    int32_t raw;
+
+    Fixed() = default;
+    constexpr explicit Fixed(int v) : raw((int32_t)((uint32_t)v << 16)) {}
+    //For constants; use FromFloat for run time values
+    constexpr explicit Fixed(double v) : raw(FixedRawFromDouble(v)) {}
+
+    static constexpr Fixed FromRaw(int32_t raw) {
+        Fixed f = Fixed(0);
+        f.raw = raw;
+        return f;
+    }
+
+    static constexpr Fixed FromFloat(float v) {
+        return Fixed((double)v);
+    }
+
+    constexpr float ToFloat() const {
+        return (float)raw * (1.0f / 65536.0f);
+    }
+};
+
+//Two's complement wrap of a 64-bit intermediate
+constexpr int32_t WrapFixed(int64_t v) {
+    return (int32_t)(uint32_t)(uint64_t)v;
+}
+
+constexpr Fixed operator+(Fixed a, Fixed b) {
+    return Fixed::FromRaw((int32_t)((uint32_t)a.raw + (uint32_t)b.raw));
+}
+
+constexpr Fixed operator-(Fixed a, Fixed b) {
+    return Fixed::FromRaw((int32_t)((uint32_t)a.raw - (uint32_t)b.raw));
+}
+
+constexpr Fixed operator-(Fixed a) {
+    return Fixed::FromRaw((int32_t)(0u - (uint32_t)a.raw));
+}
+
+constexpr Fixed operator*(Fixed a, Fixed b) {
+    return Fixed::FromRaw(WrapFixed(((int64_t)a.raw * b.raw + 0x8000) >> 16));
+}
+
+//Raw a / b rounded to nearest; b may be wider than 32 bits
+constexpr int32_t DivideRaw(int32_t a, int64_t b) {
+    if (b == 0) {
+        return 0;
+    }
+    int64_t numerator = (int64_t)a * 65536;
+    int64_t half = (b < 0 ? -b : b) / 2;
+    numerator += (numerator < 0) == (b < 0) ? half : -half;
+    return WrapFixed(numerator / b);
+}
+
+constexpr Fixed operator/(Fixed a, Fixed b) {
+    return Fixed::FromRaw(DivideRaw(a.raw, b.raw));
+}
+
+constexpr Fixed& operator+=(Fixed& a, Fixed b) { return a = a + b; }
+constexpr Fixed& operator-=(Fixed& a, Fixed b) { return a = a - b; }
+constexpr Fixed& operator*=(Fixed& a, Fixed b) { return a = a * b; }
+constexpr Fixed& operator/=(Fixed& a, Fixed b) { return a = a / b; }
+
+constexpr bool operator==(Fixed a, Fixed b) { return a.raw == b.raw; }
+constexpr bool operator!=(Fixed a, Fixed b) { return a.raw != b.raw; }
+constexpr bool operator<(Fixed a, Fixed b) { return a.raw < b.raw; }
+constexpr bool operator>(Fixed a, Fixed b) { return a.raw > b.raw; }
+constexpr bool operator<=(Fixed a, Fixed b) { return a.raw <= b.raw; }
+constexpr bool operator>=(Fixed a, Fixed b) { return a.raw >= b.raw; }
+
+
+//Square Root
+//Integer sqrt rounded to nearest, bit by bit
+inline uint64_t SqrtRounded(uint64_t v) {
+    uint64_t root = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+    while (bit > v) {
+        bit >>= 2;
+    }
+    uint64_t rest = v;
+    while (bit != 0) {
+        if (rest >= root + bit) {
+            rest -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    //v - root^2 > root means v is past (root + 0.5)^2
+    return rest > root ? root + 1 : root;
+}
+
+//Negative values give zero
+inline Fixed Sqrt(Fixed v) {
+    if (v.raw <= 0) {
+        return Fixed::FromRaw(0);
+    }
+    return Fixed::FromRaw((int32_t)SqrtRounded((uint64_t)v.raw << 16));
+}
+
+//Q32.32 sum of squares straight into the sqrt, so long vectors do not
+//overflow the way MagnitudeSquared does. The raw length can pass INT32_MAX.
+inline int64_t MagnitudeRaw(Vec2T<Fixed> v) {
+    uint64_t sq = (uint64_t)((int64_t)v.x.raw * v.x.raw) + (uint64_t)((int64_t)v.y.raw * v.y.raw);
+    return (int64_t)SqrtRounded(sq);
+}
+
+inline int64_t MagnitudeRaw(Vec3T<Fixed> v) {
+    uint64_t sq = (uint64_t)((int64_t)v.x.raw * v.x.raw) + (uint64_t)((int64_t)v.y.raw * v.y.raw)
+        + (uint64_t)((int64_t)v.z.raw * v.z.raw);
+    return (int64_t)SqrtRounded(sq);
+}
+
+inline Fixed Magnitude(Vec2T<Fixed> v) {
+    int64_t m = MagnitudeRaw(v);
+    return Fixed::FromRaw(m > INT32_MAX ? INT32_MAX : (int32_t)m);
+}
+
+inline Fixed Magnitude(Vec3T<Fixed> v) {
+    int64_t m = MagnitudeRaw(v);
+    return Fixed::FromRaw(m > INT32_MAX ? INT32_MAX : (int32_t)m);
+}
+
+//Divides by the unsaturated length, so vectors longer than the range still
+//come out unit length
+inline Vec2T<Fixed> Normalize(Vec2T<Fixed> v) {
+    int64_t m = MagnitudeRaw(v);
+    if (m < Epsilon<Fixed>().raw) {
+        return { Fixed(0), Fixed(0) };
+    }
+    return { Fixed::FromRaw(DivideRaw(v.x.raw, m)), Fixed::FromRaw(DivideRaw(v.y.raw, m)) };
+}
+
+inline Vec3T<Fixed> Normalize(Vec3T<Fixed> v) {
+    int64_t m = MagnitudeRaw(v);
+    if (m < Epsilon<Fixed>().raw) {
+        return { Fixed(0), Fixed(0), Fixed(0) };
+    }
+    return { Fixed::FromRaw(DivideRaw(v.x.raw, m)), Fixed::FromRaw(DivideRaw(v.y.raw, m)), Fixed::FromRaw(DivideRaw(v.z.raw, m)) };
+}
+
+
+//Types & Conversion
+using FixedVec2 = Vec2T<Fixed>;
+using FixedVec3 = Vec3T<Fixed>;
+
+inline FixedVec2 ToFixed(Vec2T<float> v) {
+    return { Fixed::FromFloat(v.x), Fixed::FromFloat(v.y) };
+}
+
+inline FixedVec3 ToFixed(Vec3T<float> v) {
+    return { Fixed::FromFloat(v.x), Fixed::FromFloat(v.y), Fixed::FromFloat(v.z) };
+}
+
+inline Vec2T<float> ToFloat(FixedVec2 v) {
+    return { v.x.ToFloat(), v.y.ToFloat() };
+}
+
+inline Vec3T<float> ToFloat(FixedVec3 v) {
+    return { v.x.ToFloat(), v.y.ToFloat(), v.z.ToFloat() };
+}
+
+} // namespace vmath
+
+#endif
@@ -0,0 +1,174 @@
+#pragma once
+
+#ifndef VECTOR_MATH_HALF_H
+#define VECTOR_MATH_HALF_H
+
+#include <cstdint>
+#include <cstring>
+#include "VectorMathInline.h"
+
+//16-bit storage formats for bulk data and network snapshots. They hold bits
+//only - no arithmetic - so Vec2T<Half> cannot be used with the vector
+//operators by accident; convert to float, do the maths, convert back.
+//  Half:     IEEE 754 binary16, 1 sign / 5 exponent / 10 mantissa bits,
+//            about 3 decimal digits up to 65504.
+//  BFloat16: the top half of a float, 1 / 8 / 7 bits, float's full range
+//            with about 2 decimal digits.
+//Conversions from float round to nearest even, the same as the F16C / NEON
+//instructions the batch kernels use, so every instruction set agrees bit for
+//bit. NaN stays NaN (quiet); float overflow becomes infinity.
+
+namespace vmath {
+
+struct Half {
+    uint16_t bits;
+};
+
+struct BFloat16 {
+    uint16_t bits;
+};
+
+inline uint32_t FloatBits(float v) {
+    uint32_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    return bits;
+}
+
+inline float FloatFromBits(uint32_t bits) {
+    float v;
+    std::memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+
+//Half
+inline Half HalfFromFloat(float v) {
+    uint32_t bits = FloatBits(v);
+    uint16_t sign = (uint16_t)((bits >> 16) & 0x8000u);
+    uint32_t abs = bits & 0x7fffffffu;
+
+    if (abs >= 0x7f800000u) {
+        //Inf, or NaN with the quiet bit set and the top of the payload kept
+        uint16_t nan = abs > 0x7f800000u ? (uint16_t)(0x0200u | ((abs >> 13) & 0x03ffu)) : 0;
+        return { (uint16_t)(sign | 0x7c00u | nan) };
+    }
+    if (abs >= 0x477ff000u) {
+        //65520 and above round to infinity
+        return { (uint16_t)(sign | 0x7c00u) };
+    }
+
+    uint32_t exponent = abs >> 23;
+    if (exponent < 113) {
+        //Below the smallest normal half: subnormal or zero
+        if (exponent < 102) {
+            return { sign };
+        }
+        uint32_t mantissa = (abs & 0x007fffffu) | 0x00800000u;
+        uint32_t shift = 126 - exponent;
+        uint32_t result = mantissa >> shift;
+        uint32_t rest = mantissa & ((1u << shift) - 1);
+        uint32_t halfway = 1u << (shift - 1);
+        if (rest > halfway || (rest == halfway && (result & 1))) {
+            ++result;
+        }
+        return { (uint16_t)(sign | result) };
+    }
+
+    //Rebias the exponent (127 -> 15) and round the 13 dropped mantissa bits;
+    //a carry out of the mantissa correctly bumps the exponent
+    uint32_t result = (abs >> 13) - (112u << 10);
+    uint32_t rest = abs & 0x1fffu;
+    if (rest > 0x1000u || (rest == 0x1000u && (result & 1))) {
+        ++result;
+    }
+    return { (uint16_t)(sign | result) };
+}
+
+//Exact: every half is representable as a float
+inline float HalfToFloat(Half h) {
+    uint32_t sign = (uint32_t)(h.bits & 0x8000u) << 16;
+    uint32_t exponent = (h.bits >> 10) & 0x1fu;
+    uint32_t mantissa = h.bits & 0x03ffu;
+
+    if (exponent == 0x1f) {
+        uint32_t nan = mantissa != 0 ? (0x00400000u | (mantissa << 13)) : 0;
+        return FloatFromBits(sign | 0x7f800000u | nan);
+    }
+    if (exponent == 0) {
+        if (mantissa == 0) {
+            return FloatFromBits(sign);
+        }
+        //Subnormal half, normal as a float
+        exponent = 113;
+        while ((mantissa & 0x0400u) == 0) {
+            mantissa <<= 1;
+            --exponent;
+        }
+        return FloatFromBits(sign | (exponent << 23) | ((mantissa & 0x03ffu) << 13));
+    }
+    return FloatFromBits(sign | ((exponent + 112) << 23) | (mantissa << 13));
+}
+
+
+//BFloat16
+inline BFloat16 BFloat16FromFloat(float v) {
+    uint32_t bits = FloatBits(v);
+    if ((bits & 0x7fffffffu) > 0x7f800000u) {
+        return { (uint16_t)((bits | 0x00400000u) >> 16) };
+    }
+    uint32_t lsb = (bits >> 16) & 1;
+    return { (uint16_t)((bits + 0x7fffu + lsb) >> 16) };
+}
+
+inline float BFloat16ToFloat(BFloat16 b) {
+    return FloatFromBits((uint32_t)b.bits << 16);
+}
+
+
+//Vector Conversion
+inline Vec2T<Half> ToHalf(Vec2T<float> v) {
+    return { HalfFromFloat(v.x), HalfFromFloat(v.y) };
+}
+
+inline Vec3T<Half> ToHalf(Vec3T<float> v) {
+    return { HalfFromFloat(v.x), HalfFromFloat(v.y), HalfFromFloat(v.z) };
+}
+
+inline Vec2T<BFloat16> ToBFloat16(Vec2T<float> v) {
+    return { BFloat16FromFloat(v.x), BFloat16FromFloat(v.y) };
+}
+
+inline Vec3T<BFloat16> ToBFloat16(Vec3T<float> v) {
+    return { BFloat16FromFloat(v.x), BFloat16FromFloat(v.y), BFloat16FromFloat(v.z) };
+}
+
+inline Vec2T<float> ToFloat(Vec2T<Half> v) {
+    return { HalfToFloat(v.x), HalfToFloat(v.y) };
+}
+
+inline Vec3T<float> ToFloat(Vec3T<Half> v) {
+    return { HalfToFloat(v.x), HalfToFloat(v.y), HalfToFloat(v.z) };
+}
+
+inline Vec2T<float> ToFloat(Vec2T<BFloat16> v) {
+    return { BFloat16ToFloat(v.x), BFloat16ToFloat(v.y) };
+}
+
+inline Vec3T<float> ToFloat(Vec3T<BFloat16> v) {
+    return { BFloat16ToFloat(v.x), BFloat16ToFloat(v.y), BFloat16ToFloat(v.z) };
+}
+
+//float <-> double, for large-world positions (narrowing rounds to nearest)
+template <typename To, typename From>
+constexpr Vec2T<To> ConvertVector(Vec2T<From> v) {
+    return { (To)v.x, (To)v.y };
+}
+
+template <typename To, typename From>
+constexpr Vec3T<To> ConvertVector(Vec3T<From> v) {
+    return { (To)v.x, (To)v.y, (To)v.z };
+}
+
+} // namespace vmath
+
+#endif
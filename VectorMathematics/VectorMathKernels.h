@@ -0,0 +1,152 @@
+#pragma once
+
+#ifndef VECTOR_MATH_KERNELS_H
+#define VECTOR_MATH_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+
+//Internal header - not part of the exported API.
+//The batch functions in VectorMathBatch.cpp forward their hot loops to a table
+//of kernels. One table exists per instruction set and the best one the CPU
+//supports is picked once when the library is loaded (see VectorMathDispatch.cpp).
+//Every kernel works on flat float streams, so the same kernel serves the SoA
+//Batch functions (one call per component) and the packed AoS Array functions
+//(one call over n * 2 or n * 3 floats).
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+#define VECTORMATH_X86 1
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define VECTORMATH_NEON 1
+#endif
+
+//GCC and Clang only allow intrinsics for an instruction set inside functions
+//compiled for it. MSVC allows them everywhere.
+#if defined(_MSC_VER) && !defined(__clang__)
+#define VECTORMATH_TARGET(isa)
+#else
+#define VECTORMATH_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+//Accumulators of the reduction kernels: float i of a call goes to lane
+//i % kReduceLanes. 24 floats are a whole number of Vec2s and Vec3s, so lane %
+//components is the component, and fill three AVX or six SSE / NEON registers.
+static const size_t kReduceLanes = 24;
+
+struct VectorKernels {
+	const char* name;
+
+	void (*add)(const float* a, const float* b, float* out, size_t n);
+	void (*subtract)(const float* a, const float* b, float* out, size_t n);
+	void (*scale)(const float* v, float scale, float* out, size_t n);
+	void (*clamp)(const float* v, float minVal, float maxVal, float* out, size_t n);
+
+	void (*dot2)(const float* ax, const float* ay, const float* bx, const float* by, float* out, size_t n);
+	void (*dot3)(const float* ax, const float* ay, const float* az, const float* bx, const float* by, const float* bz, float* out, size_t n);
+
+	void (*magnitude2)(const float* x, const float* y, float* out, size_t n);
+	void (*magnitude3)(const float* x, const float* y, const float* z, float* out, size_t n);
+
+	void (*normalize2)(const float* x, const float* y, float* outX, float* outY, size_t n);
+	void (*normalize3)(const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ, size_t n);
+	void (*normalizeFast2)(const float* x, const float* y, float* outX, float* outY, size_t n);
+	void (*normalizeFast3)(const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ, size_t n);
+
+	void (*reflect2)(const float* vx, const float* vy, const float* nx, const float* ny, float* outX, float* outY, size_t n);
+	void (*reflect3)(const float* vx, const float* vy, const float* vz, const float* nx, const float* ny, const float* nz, float* outX, float* outY, float* outZ, size_t n);
+
+	void (*clampMagnitude2)(const float* x, const float* y, float maxLength, float* outX, float* outY, size_t n);
+	void (*clampMagnitude3)(const float* x, const float* y, const float* z, float maxLength, float* outX, float* outY, float* outZ, size_t n);
+
+	//n packed xyz points times a column-major 4x4 matrix, with w as the
+	//implicit fourth component (1 for points, 0 for directions)
+	void (*transform3)(const float* m, float w, const float* in, float* out, size_t n);
+
+	//Semi-implicit Euler: v += a * dt, then p += v * dt.
+	//Position Verlet: p' = p + (p - prev) + a * dt * dt, then prev = p.
+	//Both update p and v / prev in place over flat float streams; a may be
+	//nullptr for no acceleration.
+	void (*integrateEuler)(float* p, float* v, const float* a, float dt, size_t n);
+	void (*integrateVerlet)(float* p, float* prev, const float* a, float dt, size_t n);
+
+	//Collision response in place (see VectorReflectResponse2DBatch in VectorMath.h). mask is
+	//one byte per contact or nullptr for all; normalize is 0 when the normals
+	//are already unit length.
+	void (*reflectResponse2)(float* vx, float* vy, const float* nx, const float* ny, const unsigned char* mask, float restitution, float friction, int normalize, size_t n);
+	void (*reflectResponse3)(float* vx, float* vy, float* vz, const float* nx, const float* ny, const float* nz, const unsigned char* mask, float restitution, float friction, int normalize, size_t n);
+
+	//Fused single pass operations. Every result is rounded exactly like the
+	//separate operations would round it (no FMA).
+	//scaleAdd: out = a + b * scale. mulAdd: out = a * b + c.
+	//lerpClamp: out = clamp(a + t * (b - a), minVal, maxVal).
+	void (*scaleAdd)(const float* a, const float* b, float scale, float* out, size_t n);
+	void (*mulAdd)(const float* a, const float* b, const float* c, float* out, size_t n);
+	void (*lerpClamp)(const float* a, const float* b, float t, float minVal, float maxVal, float* out, size_t n);
+
+	//Length clamped to [minLength, maxLength] with one sqrt; vectors shorter
+	//than 0.0001f become zero
+	void (*clampMagnitudeRange2)(const float* x, const float* y, float minLength, float maxLength, float* outX, float* outY, size_t n);
+	void (*clampMagnitudeRange3)(const float* x, const float* y, const float* z, float minLength, float maxLength, float* outX, float* outY, float* outZ, size_t n);
+
+	//float <-> 16-bit storage formats (see VectorMathHalf.h), round to nearest
+	//even; every instruction set gives the same bits as the scalar versions
+	void (*floatToHalf)(const float* in, uint16_t* out, size_t n);
+	void (*halfToFloat)(const uint16_t* in, float* out, size_t n);
+	void (*floatToBFloat16)(const float* in, uint16_t* out, size_t n);
+	void (*bfloat16ToFloat)(const uint16_t* in, float* out, size_t n);
+
+	//Packed 4-float elements (Vec4 / Vec3A arrays), one register per element.
+	//components is 4 for Vec4, or 3 for Vec3A where the pad lane is ignored
+	//and written as 0. out may alias the input.
+	void (*dot4)(const float* a, const float* b, int components, float* out, size_t n);
+	void (*magnitude4)(const float* v, int components, float* out, size_t n);
+	void (*normalize4)(const float* v, int components, float* out, size_t n);
+	void (*cross3A)(const float* a, const float* b, float* out, size_t n);
+
+	//Reductions into kReduceLanes accumulators (see above), updated in place.
+	//Every lane takes its floats in order with the same operations on every
+	//instruction set, so the lanes come out bit for bit the same.
+	//sumKahan keeps a compensation per lane (the sum is lanes - compensation).
+	//minMax skips NaN. minMaxIndex keeps the first index of each lane's min
+	//and max, counting in[0] as first, and skips NaN.
+	void (*sum)(const float* in, float* lanes, size_t n);
+	void (*sumKahan)(const float* in, float* lanes, float* compensation, size_t n);
+	void (*dotSum)(const float* a, const float* b, float* lanes, size_t n);
+	void (*minMax)(const float* in, float* minLanes, float* maxLanes, size_t n);
+	void (*minMaxIndex)(const float* in, uint32_t first, float* minLanes, uint32_t* minIndex, float* maxLanes, uint32_t* maxIndex, size_t n);
+
+	//Dot products of n packed Vec2 / Vec3 pairs, summed x, y, z in that order.
+	//a == b gives the squared lengths.
+	void (*dotPacked2)(const float* a, const float* b, float* out, size_t n);
+	void (*dotPacked3)(const float* a, const float* b, float* out, size_t n);
+
+	//One cubic Bezier segment (controls = 4 packed Vec2 / Vec3) at n local
+	//parameters u in [0, 1], written as packed Vec2 / Vec3. Weights and sums
+	//are formed in the same order everywhere, and u = 0 / 1 give the end
+	//points exactly.
+	void (*bezier2)(const float* controls, const float* u, float* out, size_t n);
+	void (*bezier3)(const float* controls, const float* u, float* out, size_t n);
+};
+
+//Each getter returns nullptr when the instruction set is not available for the
+//architecture being compiled. The scalar table always exists and is also used
+//by the SIMD kernels to finish the tail of an array.
+const VectorKernels* GetScalarKernels();
+const VectorKernels* GetSse41Kernels();
+const VectorKernels* GetAvx2Kernels();
+const VectorKernels* GetNeonKernels();
+
+//The kernel table currently selected for this CPU.
+const VectorKernels& ActiveKernels();
+
+//The global normalize precision (VECTORMATH_PRECISION_EXACT or _FAST).
+int ActivePrecision();
+
+//Component-wise min / max of count packed floats holding vectors of the given
+//number of components, NaN skipped (VectorMathReduce.cpp). Exports that need
+//bounds call this rather than VectorBounds*Array so the call is counted once.
+void BoundsComponents(const float* in, size_t count, size_t components, float* outMin, float* outMax);
+
+#endif
@@ -0,0 +1,885 @@
+//Always include the pch.h first in every cpp
+#include "pch.h"
+
+//Then include own items
+#include "VectorMathKernels.h"
+
+#ifdef VECTORMATH_X86
+
+#include <immintrin.h>
+
+//8-wide AVX2 kernels, the same algorithms as VectorMathKernelsSse41.cpp.
+//No FMA is used so the results stay identical to the scalar kernels.
+//F16C (present on every AVX2 CPU, checked at dispatch) converts halves.
+//Whatever does not fill a full register is finished by the scalar kernels.
+
+#define AVX2 VECTORMATH_TARGET("avx2,f16c")
+
+static const float kEpsilon = 0.0001f;
+
+//Returns v / m, or zero where m < kEpsilon (NaN magnitudes keep the divide,
+//exactly like the scalar "if (m < 0.0001f)" check).
+AVX2 static inline __m256 SafeDivide(__m256 v, __m256 m) {
+	__m256 keep = _mm256_cmp_ps(m, _mm256_set1_ps(kEpsilon), _CMP_NLT_UQ);
+	return _mm256_and_ps(keep, _mm256_div_ps(v, m));
+}
+
+AVX2 static void Add(const float* a, const float* b, float* out, size_t n) {
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		_mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+	}
+	GetScalarKernels()->add(a + i, b + i, out + i, n - i);
+}
+
+AVX2 static void Subtract(const float* a, const float* b, float* out, size_t n) {
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		_mm256_storeu_ps(out + i, _mm256_sub_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+	}
+	GetScalarKernels()->subtract(a + i, b + i, out + i, n - i);
+}
+
+AVX2 static void Scale(const float* v, float scale, float* out, size_t n) {
+	__m256 s = _mm256_set1_ps(scale);
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		_mm256_storeu_ps(out + i, _mm256_mul_ps(s, _mm256_loadu_ps(v + i)));
+	}
+	GetScalarKernels()->scale(v + i, scale, out + i, n - i);
+}
+
+AVX2 static void Clamp(const float* v, float minVal, float maxVal, float* out, size_t n) {
+	__m256 lo = _mm256_set1_ps(minVal);
+	__m256 hi = _mm256_set1_ps(maxVal);
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m256 c = _mm256_loadu_ps(v + i);
+		__m256 r = _mm256_blendv_ps(c, lo, _mm256_cmp_ps(c, lo, _CMP_LT_OQ));
+		r = _mm256_blendv_ps(r, hi, _mm256_cmp_ps(c, hi, _CMP_GT_OQ));
+		_mm256_storeu_ps(out + i, r);
+	}
+	GetScalarKernels()->clamp(v + i, minVal, maxVal, out + i, n - i);
+}
+
+AVX2 static void Dot2(const float* ax, const float* ay, const float* bx, const float* by, float* out, size_t n) {
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m256 x = _mm256_mul_ps(_mm256_loadu_ps(ax + i), _mm256_loadu_ps(bx + i));
+		__m256 y = _mm256_mul_ps(_mm256_loadu_ps(ay + i), _mm256_loadu_ps(by + i));
+		_mm256_storeu_ps(out + i, _mm256_add_ps(x, y));
+	}
+	GetScalarKernels()->dot2(ax + i, ay + i, bx + i, by + i, out + i, n - i);
+}
+
+AVX2 static void Dot3(const float* ax, const float* ay, const float* az, const float* bx, const float* by, const float* bz, float* out, size_t n) {
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m256 x = _mm256_mul_ps(_mm256_loadu_ps(ax + i), _mm256_loadu_ps(bx + i));
+		__m256 y = _mm256_mul_ps(_mm256_loadu_ps(ay + i), _mm256_loadu_ps(by + i));
+		__m256 z = _mm256_mul_ps(_mm256_loadu_ps(az + i), _mm256_loadu_ps(bz + i));
+		_mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_add_ps(x, y), z));
+	}
+	GetScalarKernels()->dot3(ax + i, ay + i, az + i, bx + i, by + i, bz + i, out + i, n - i);
+}
+
+AVX2 static void Magnitude2(const float* x, const float* y, float* out, size_t n) {
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m256 vx = _mm256_loadu_ps(x + i);
+		__m256 vy = _mm256_loadu_ps(y + i);
+		__m256 sq = _mm256_add_ps(_mm256_mul_ps(vx, vx), _mm256_mul_ps(vy, vy));
+		_mm256_storeu_ps(out + i, _mm256_sqrt_ps(sq));
+	}
+	GetScalarKernels()->magnitude2(x + i, y + i, out + i, n - i);
+}
+
+AVX2 static void Magnitude3(const float* x, const float* y, const float* z, float* out, size_t n) {
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m256 vx = _mm256_loadu_ps(x + i);
+		__m256 vy = _mm256_loadu_ps(y + i);
+		__m256 vz = _mm256_loadu_ps(z + i);
+		__m256 sq = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(vx, vx), _mm256_mul_ps(vy, vy)), _mm256_mul_ps(vz, vz));
+		_mm256_storeu_ps(out + i, _mm256_sqrt_ps(sq));
+	}
+	GetScalarKernels()->magnitude3(x + i, y + i, z + i, out + i, n - i);
+}
+
+AVX2 static void Normalize2(const float* x, const float* y, float* outX, float* outY, size_t n) {
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m256 vx = _mm256_loadu_ps(x + i);
+		__m256 vy = _mm256_loadu_ps(y + i);
+		__m256 m = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(vx, vx), _mm256_mul_ps(vy, vy)));
+		_mm256_storeu_ps(outX + i, SafeDivide(vx, m));
+		_mm256_storeu_ps(outY + i, SafeDivide(vy, m));
+	}
+	GetScalarKernels()->normalize2(x + i, y + i, outX + i, outY + i, n - i);
+}
+
+AVX2 static void Normalize3(const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ, size_t n) {
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m256 vx = _mm256_loadu_ps(x + i);
+		__m256 vy = _mm256_loadu_ps(y + i);
+		__m256 vz = _mm256_loadu_ps(z + i);
+		__m256 sq = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(vx, vx), _mm256_mul_ps(vy, vy)), _mm256_mul_ps(vz, vz));
+		__m256 m = _mm256_sqrt_ps(sq);
+		_mm256_storeu_ps(outX + i, SafeDivide(vx, m));
+		_mm256_storeu_ps(outY + i, SafeDivide(vy, m));
+		_mm256_storeu_ps(outZ + i, SafeDivide(vz, m));
+	}
+	GetScalarKernels()->normalize3(x + i, y + i, z + i, outX + i, outY + i, outZ + i, n - i);
+}
+
+//rsqrt estimate plus one Newton-Raphson step, same order as
+//vmath::ReciprocalSqrtFast so every instruction set gives the same answer
+//(an exact 1 / sqrt in deterministic builds)
+AVX2 static inline __m256 ReciprocalSqrtFast(__m256 sq) {
+#if defined(VECTORMATH_DETERMINISTIC)
+	return _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(sq));
+#else
+	__m256 y = _mm256_rsqrt_ps(sq);
+	__m256 halfSq = _mm256_mul_ps(_mm256_set1_ps(0.5f), sq);
+	return _mm256_mul_ps(y, _mm256_sub_ps(_mm256_set1_ps(1.5f), _mm256_mul_ps(_mm256_mul_ps(halfSq, y), y)));
+#endif
+}
+
+//Zero where the squared length is below kEpsilon squared
+AVX2 static inline __m256 FastScaleMask(__m256 sq) {
+	return _mm256_cmp_ps(sq, _mm256_set1_ps(kEpsilon * kEpsilon), _CMP_NLT_UQ);
+}
+
+AVX2 static void NormalizeFast2(const float* x, const float* y, float* outX, float* outY, size_t n) {
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m256 vx = _mm256_loadu_ps(x + i);
+		__m256 vy = _mm256_loadu_ps(y + i);
+		__m256 sq = _mm256_add_ps(_mm256_mul_ps(vx, vx), _mm256_mul_ps(vy, vy));
+		__m256 inv = _mm256_and_ps(FastScaleMask(sq), ReciprocalSqrtFast(sq));
+		_mm256_storeu_ps(outX + i, _mm256_mul_ps(vx, inv));
+		_mm256_storeu_ps(outY + i, _mm256_mul_ps(vy, inv));
+	}
+	GetScalarKernels()->normalizeFast2(x + i, y + i, outX + i, outY + i, n - i);
+}
+
+AVX2 static void NormalizeFast3(const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ, size_t n) {
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m256 vx = _mm256_loadu_ps(x + i);
+		__m256 vy = _mm256_loadu_ps(y + i);
+		__m256 vz = _mm256_loadu_ps(z + i);
+		__m256 sq = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(vx, vx), _mm256_mul_ps(vy, vy)), _mm256_mul_ps(vz, vz));
+		__m256 inv = _mm256_and_ps(FastScaleMask(sq), ReciprocalSqrtFast(sq));
+		_mm256_storeu_ps(outX + i, _mm256_mul_ps(vx, inv));
+		_mm256_storeu_ps(outY + i, _mm256_mul_ps(vy, inv));
+		_mm256_storeu_ps(outZ + i, _mm256_mul_ps(vz, inv));
+	}
+	GetScalarKernels()->normalizeFast3(x + i, y + i, z + i, outX + i, outY + i, outZ + i, n - i);
+}
+
+AVX2 static void Reflect2(const float* vx, const float* vy, const float* nx, const float* ny, float* outX, float* outY, size_t n) {
+	__m256 two = _mm256_set1_ps(2.0f);
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m256 x = _mm256_loadu_ps(vx + i);
+		__m256 y = _mm256_loadu_ps(vy + i);
+		__m256 normalX = _mm256_loadu_ps(nx + i);
+		__m256 normalY = _mm256_loadu_ps(ny + i);
+		__m256 m = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(normalX, normalX), _mm256_mul_ps(normalY, normalY)));
+		normalX = SafeDivide(normalX, m);
+		normalY = SafeDivide(normalY, m);
+		__m256 d = _mm256_mul_ps(two, _mm256_add_ps(_mm256_mul_ps(x, normalX), _mm256_mul_ps(y, normalY)));
+		_mm256_storeu_ps(outX + i, _mm256_sub_ps(x, _mm256_mul_ps(d, normalX)));
+		_mm256_storeu_ps(outY + i, _mm256_sub_ps(y, _mm256_mul_ps(d, normalY)));
+	}
+	GetScalarKernels()->reflect2(vx + i, vy + i, nx + i, ny + i, outX + i, outY + i, n - i);
+}
+
+AVX2 static void Reflect3(const float* vx, const float* vy, const float* vz, const float* nx, const float* ny, const float* nz, float* outX, float* outY, float* outZ, size_t n) {
+	__m256 two = _mm256_set1_ps(2.0f);
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m256 x = _mm256_loadu_ps(vx + i);
+		__m256 y = _mm256_loadu_ps(vy + i);
+		__m256 z = _mm256_loadu_ps(vz + i);
+		__m256 normalX = _mm256_loadu_ps(nx + i);
+		__m256 normalY = _mm256_loadu_ps(ny + i);
+		__m256 normalZ = _mm256_loadu_ps(nz + i);
+		__m256 sq = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(normalX, normalX), _mm256_mul_ps(normalY, normalY)), _mm256_mul_ps(normalZ, normalZ));
+		__m256 m = _mm256_sqrt_ps(sq);
+		normalX = SafeDivide(normalX, m);
+		normalY = SafeDivide(normalY, m);
+		normalZ = SafeDivide(normalZ, m);
+		__m256 dot = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, normalX), _mm256_mul_ps(y, normalY)), _mm256_mul_ps(z, normalZ));
+		__m256 d = _mm256_mul_ps(two, dot);
+		_mm256_storeu_ps(outX + i, _mm256_sub_ps(x, _mm256_mul_ps(d, normalX)));
+		_mm256_storeu_ps(outY + i, _mm256_sub_ps(y, _mm256_mul_ps(d, normalY)));
+		_mm256_storeu_ps(outZ + i, _mm256_sub_ps(z, _mm256_mul_ps(d, normalZ)));
+	}
+	GetScalarKernels()->reflect3(vx + i, vy + i, vz + i, nx + i, ny + i, nz + i, outX + i, outY + i, outZ + i, n - i);
+}
+
+AVX2 static void ClampMagnitude2(const float* x, const float* y, float maxLength, float* outX, float* outY, size_t n) {
+	__m256 eps = _mm256_set1_ps(kEpsilon);
+	__m256 maxLen = _mm256_set1_ps(maxLength);
+	__m256 zero = _mm256_setzero_ps();
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m256 vx = _mm256_loadu_ps(x + i);
+		__m256 vy = _mm256_loadu_ps(y + i);
+		__m256 m = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(vx, vx), _mm256_mul_ps(vy, vy)));
+		__m256 tooShort = _mm256_cmp_ps(m, eps, _CMP_LT_OQ);
+		__m256 tooLong = _mm256_cmp_ps(m, maxLen, _CMP_GT_OQ);
+		__m256 rx = _mm256_blendv_ps(vx, _mm256_mul_ps(_mm256_div_ps(vx, m), maxLen), tooLong);
+		__m256 ry = _mm256_blendv_ps(vy, _mm256_mul_ps(_mm256_div_ps(vy, m), maxLen), tooLong);
+		_mm256_storeu_ps(outX + i, _mm256_blendv_ps(rx, zero, tooShort));
+		_mm256_storeu_ps(outY + i, _mm256_blendv_ps(ry, zero, tooShort));
+	}
+	GetScalarKernels()->clampMagnitude2(x + i, y + i, maxLength, outX + i, outY + i, n - i);
+}
+
+AVX2 static void ClampMagnitude3(const float* x, const float* y, const float* z, float maxLength, float* outX, float* outY, float* outZ, size_t n) {
+	__m256 eps = _mm256_set1_ps(kEpsilon);
+	__m256 maxLen = _mm256_set1_ps(maxLength);
+	__m256 zero = _mm256_setzero_ps();
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m256 vx = _mm256_loadu_ps(x + i);
+		__m256 vy = _mm256_loadu_ps(y + i);
+		__m256 vz = _mm256_loadu_ps(z + i);
+		__m256 sq = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(vx, vx), _mm256_mul_ps(vy, vy)), _mm256_mul_ps(vz, vz));
+		__m256 m = _mm256_sqrt_ps(sq);
+		__m256 tooShort = _mm256_cmp_ps(m, eps, _CMP_LT_OQ);
+		__m256 tooLong = _mm256_cmp_ps(m, maxLen, _CMP_GT_OQ);
+		__m256 rx = _mm256_blendv_ps(vx, _mm256_mul_ps(_mm256_div_ps(vx, m), maxLen), tooLong);
+		__m256 ry = _mm256_blendv_ps(vy, _mm256_mul_ps(_mm256_div_ps(vy, m), maxLen), tooLong);
+		__m256 rz = _mm256_blendv_ps(vz, _mm256_mul_ps(_mm256_div_ps(vz, m), maxLen), tooLong);
+		_mm256_storeu_ps(outX + i, _mm256_blendv_ps(rx, zero, tooShort));
+		_mm256_storeu_ps(outY + i, _mm256_blendv_ps(ry, zero, tooShort));
+		_mm256_storeu_ps(outZ + i, _mm256_blendv_ps(rz, zero, tooShort));
+	}
+	GetScalarKernels()->clampMagnitude3(x + i, y + i, z + i, maxLength, outX + i, outY + i, outZ + i, n - i);
+}
+
+//8 packed xyz points per iteration, the SSE4.1 shuffle scheme with points 0-3
+//in the low 128-bit lane and points 4-7 in the high lane.
+//All 8 points are read before any is written, so in-place calls are safe.
+AVX2 static void Transform3(const float* m, float w, const float* in, float* out, size_t n) {
+	__m256 m0 = _mm256_set1_ps(m[0]), m1 = _mm256_set1_ps(m[1]), m2 = _mm256_set1_ps(m[2]);
+	__m256 m4 = _mm256_set1_ps(m[4]), m5 = _mm256_set1_ps(m[5]), m6 = _mm256_set1_ps(m[6]);
+	__m256 m8 = _mm256_set1_ps(m[8]), m9 = _mm256_set1_ps(m[9]), m10 = _mm256_set1_ps(m[10]);
+	__m256 tx = _mm256_set1_ps(m[12] * w), ty = _mm256_set1_ps(m[13] * w), tz = _mm256_set1_ps(m[14] * w);
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		const float* p = in + i * 3;
+		__m256 a = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p)), _mm_loadu_ps(p + 12), 1);
+		__m256 b = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 4)), _mm_loadu_ps(p + 16), 1);
+		__m256 c = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(p + 8)), _mm_loadu_ps(p + 20), 1);
+		__m256 xy = _mm256_shuffle_ps(b, c, _MM_SHUFFLE(2, 1, 3, 2));
+		__m256 yz = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 2, 1));
+		__m256 x = _mm256_shuffle_ps(a, xy, _MM_SHUFFLE(2, 0, 3, 0));
+		__m256 y = _mm256_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+		__m256 z = _mm256_shuffle_ps(yz, c, _MM_SHUFFLE(3, 0, 3, 1));
+
+		__m256 ox = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m0, x), _mm256_mul_ps(m4, y)), _mm256_mul_ps(m8, z)), tx);
+		__m256 oy = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m1, x), _mm256_mul_ps(m5, y)), _mm256_mul_ps(m9, z)), ty);
+		__m256 oz = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m2, x), _mm256_mul_ps(m6, y)), _mm256_mul_ps(m10, z)), tz);
+
+		__m256 rxy = _mm256_shuffle_ps(ox, oy, _MM_SHUFFLE(2, 0, 2, 0));
+		__m256 ryz = _mm256_shuffle_ps(oy, oz, _MM_SHUFFLE(3, 1, 3, 1));
+		__m256 rzx = _mm256_shuffle_ps(oz, ox, _MM_SHUFFLE(3, 1, 2, 0));
+		__m256 r0 = _mm256_shuffle_ps(rxy, rzx, _MM_SHUFFLE(2, 0, 2, 0));
+		__m256 r1 = _mm256_shuffle_ps(ryz, rxy, _MM_SHUFFLE(3, 1, 2, 0));
+		__m256 r2 = _mm256_shuffle_ps(rzx, ryz, _MM_SHUFFLE(3, 1, 3, 1));
+		float* q = out + i * 3;
+		_mm_storeu_ps(q, _mm256_castps256_ps128(r0));
+		_mm_storeu_ps(q + 4, _mm256_castps256_ps128(r1));
+		_mm_storeu_ps(q + 8, _mm256_castps256_ps128(r2));
+		_mm_storeu_ps(q + 12, _mm256_extractf128_ps(r0, 1));
+		_mm_storeu_ps(q + 16, _mm256_extractf128_ps(r1, 1));
+		_mm_storeu_ps(q + 20, _mm256_extractf128_ps(r2, 1));
+	}
+	GetScalarKernels()->transform3(m, w, in + i * 3, out + i * 3, n - i);
+}
+
+AVX2 static void IntegrateEuler(float* p, float* v, const float* a, float dt, size_t n) {
+	__m256 step = _mm256_set1_ps(dt);
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m256 acc = a != nullptr ? _mm256_loadu_ps(a + i) : _mm256_setzero_ps();
+		__m256 vel = _mm256_add_ps(_mm256_loadu_ps(v + i), _mm256_mul_ps(acc, step));
+		_mm256_storeu_ps(v + i, vel);
+		_mm256_storeu_ps(p + i, _mm256_add_ps(_mm256_loadu_ps(p + i), _mm256_mul_ps(vel, step)));
+	}
+	GetScalarKernels()->integrateEuler(p + i, v + i, a != nullptr ? a + i : nullptr, dt, n - i);
+}
+
+AVX2 static void IntegrateVerlet(float* p, float* prev, const float* a, float dt, size_t n) {
+	__m256 step2 = _mm256_set1_ps(dt * dt);
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m256 acc = a != nullptr ? _mm256_loadu_ps(a + i) : _mm256_setzero_ps();
+		__m256 current = _mm256_loadu_ps(p + i);
+		__m256 next = _mm256_add_ps(_mm256_add_ps(current, _mm256_sub_ps(current, _mm256_loadu_ps(prev + i))), _mm256_mul_ps(acc, step2));
+		_mm256_storeu_ps(p + i, next);
+		_mm256_storeu_ps(prev + i, current);
+	}
+	GetScalarKernels()->integrateVerlet(p + i, prev + i, a != nullptr ? a + i : nullptr, dt, n - i);
+}
+
+//All bits set in lanes whose contact byte is non-zero
+AVX2 static inline __m256 LoadMask(const unsigned char* mask) {
+	__m256i lanes = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)mask));
+	return _mm256_castsi256_ps(_mm256_cmpgt_epi32(lanes, _mm256_setzero_si256()));
+}
+
+//Inactive lanes (masked out or zero length normal) keep their velocity
+AVX2 static void ReflectResponse2(float* vx, float* vy, const float* nx, const float* ny, const unsigned char* mask, float restitution, float friction, int normalize, size_t n) {
+	__m256 eps = _mm256_set1_ps(kEpsilon);
+	__m256 rest = _mm256_set1_ps(restitution);
+	__m256 tangentScale = _mm256_set1_ps(1.0f - friction);
+	__m256 all = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m256 active = mask != nullptr ? LoadMask(mask + i) : all;
+		__m256 x = _mm256_loadu_ps(vx + i);
+		__m256 y = _mm256_loadu_ps(vy + i);
+		__m256 normalX = _mm256_loadu_ps(nx + i);
+		__m256 normalY = _mm256_loadu_ps(ny + i);
+		if (normalize) {
+			__m256 m = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(normalX, normalX), _mm256_mul_ps(normalY, normalY)));
+			active = _mm256_andnot_ps(_mm256_cmp_ps(m, eps, _CMP_LT_OQ), active);
+			normalX = _mm256_div_ps(normalX, m);
+			normalY = _mm256_div_ps(normalY, m);
+		}
+		__m256 d = _mm256_add_ps(_mm256_mul_ps(x, normalX), _mm256_mul_ps(y, normalY));
+		__m256 partX = _mm256_mul_ps(d, normalX);
+		__m256 partY = _mm256_mul_ps(d, normalY);
+		__m256 rx = _mm256_sub_ps(_mm256_mul_ps(tangentScale, _mm256_sub_ps(x, partX)), _mm256_mul_ps(rest, partX));
+		__m256 ry = _mm256_sub_ps(_mm256_mul_ps(tangentScale, _mm256_sub_ps(y, partY)), _mm256_mul_ps(rest, partY));
+		_mm256_storeu_ps(vx + i, _mm256_blendv_ps(x, rx, active));
+		_mm256_storeu_ps(vy + i, _mm256_blendv_ps(y, ry, active));
+	}
+	GetScalarKernels()->reflectResponse2(vx + i, vy + i, nx + i, ny + i, mask != nullptr ? mask + i : nullptr, restitution, friction, normalize, n - i);
+}
+
+AVX2 static void ReflectResponse3(float* vx, float* vy, float* vz, const float* nx, const float* ny, const float* nz, const unsigned char* mask, float restitution, float friction, int normalize, size_t n) {
+	__m256 eps = _mm256_set1_ps(kEpsilon);
+	__m256 rest = _mm256_set1_ps(restitution);
+	__m256 tangentScale = _mm256_set1_ps(1.0f - friction);
+	__m256 all = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m256 active = mask != nullptr ? LoadMask(mask + i) : all;
+		__m256 x = _mm256_loadu_ps(vx + i);
+		__m256 y = _mm256_loadu_ps(vy + i);
+		__m256 z = _mm256_loadu_ps(vz + i);
+		__m256 normalX = _mm256_loadu_ps(nx + i);
+		__m256 normalY = _mm256_loadu_ps(ny + i);
+		__m256 normalZ = _mm256_loadu_ps(nz + i);
+		if (normalize) {
+			__m256 sq = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(normalX, normalX), _mm256_mul_ps(normalY, normalY)), _mm256_mul_ps(normalZ, normalZ));
+			__m256 m = _mm256_sqrt_ps(sq);
+			active = _mm256_andnot_ps(_mm256_cmp_ps(m, eps, _CMP_LT_OQ), active);
+			normalX = _mm256_div_ps(normalX, m);
+			normalY = _mm256_div_ps(normalY, m);
+			normalZ = _mm256_div_ps(normalZ, m);
+		}
+		__m256 d = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, normalX), _mm256_mul_ps(y, normalY)), _mm256_mul_ps(z, normalZ));
+		__m256 partX = _mm256_mul_ps(d, normalX);
+		__m256 partY = _mm256_mul_ps(d, normalY);
+		__m256 partZ = _mm256_mul_ps(d, normalZ);
+		__m256 rx = _mm256_sub_ps(_mm256_mul_ps(tangentScale, _mm256_sub_ps(x, partX)), _mm256_mul_ps(rest, partX));
+		__m256 ry = _mm256_sub_ps(_mm256_mul_ps(tangentScale, _mm256_sub_ps(y, partY)), _mm256_mul_ps(rest, partY));
+		__m256 rz = _mm256_sub_ps(_mm256_mul_ps(tangentScale, _mm256_sub_ps(z, partZ)), _mm256_mul_ps(rest, partZ));
+		_mm256_storeu_ps(vx + i, _mm256_blendv_ps(x, rx, active));
+		_mm256_storeu_ps(vy + i, _mm256_blendv_ps(y, ry, active));
+		_mm256_storeu_ps(vz + i, _mm256_blendv_ps(z, rz, active));
+	}
+	GetScalarKernels()->reflectResponse3(vx + i, vy + i, vz + i, nx + i, ny + i, nz + i, mask != nullptr ? mask + i : nullptr, restitution, friction, normalize, n - i);
+}
+
+AVX2 static void ScaleAdd(const float* a, const float* b, float scale, float* out, size_t n) {
+	__m256 s = _mm256_set1_ps(scale);
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		_mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_loadu_ps(a + i), _mm256_mul_ps(_mm256_loadu_ps(b + i), s)));
+	}
+	GetScalarKernels()->scaleAdd(a + i, b + i, scale, out + i, n - i);
+}
+
+AVX2 static void MulAdd(const float* a, const float* b, const float* c, float* out, size_t n) {
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		_mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)), _mm256_loadu_ps(c + i)));
+	}
+	GetScalarKernels()->mulAdd(a + i, b + i, c + i, out + i, n - i);
+}
+
+AVX2 static void LerpClamp(const float* a, const float* b, float t, float minVal, float maxVal, float* out, size_t n) {
+	__m256 weight = _mm256_set1_ps(t);
+	__m256 lo = _mm256_set1_ps(minVal);
+	__m256 hi = _mm256_set1_ps(maxVal);
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m256 va = _mm256_loadu_ps(a + i);
+		__m256 v = _mm256_add_ps(va, _mm256_mul_ps(weight, _mm256_sub_ps(_mm256_loadu_ps(b + i), va)));
+		__m256 r = _mm256_blendv_ps(v, lo, _mm256_cmp_ps(v, lo, _CMP_LT_OQ));
+		_mm256_storeu_ps(out + i, _mm256_blendv_ps(r, hi, _mm256_cmp_ps(v, hi, _CMP_GT_OQ)));
+	}
+	GetScalarKernels()->lerpClamp(a + i, b + i, t, minVal, maxVal, out + i, n - i);
+}
+
+//Lanes longer than maxLength scale to maxLength, lanes shorter than minLength
+//to minLength (maxLength wins if they overlap), zero length lanes become zero
+AVX2 static inline __m256 RangeTarget(__m256 m, __m256 minLen, __m256 maxLen, __m256& change) {
+	__m256 tooLong = _mm256_cmp_ps(m, maxLen, _CMP_GT_OQ);
+	__m256 tooShort = _mm256_cmp_ps(m, minLen, _CMP_LT_OQ);
+	change = _mm256_or_ps(tooLong, tooShort);
+	return _mm256_blendv_ps(minLen, maxLen, tooLong);
+}
+
+AVX2 static void ClampMagnitudeRange2(const float* x, const float* y, float minLength, float maxLength, float* outX, float* outY, size_t n) {
+	__m256 eps = _mm256_set1_ps(kEpsilon);
+	__m256 minLen = _mm256_set1_ps(minLength);
+	__m256 maxLen = _mm256_set1_ps(maxLength);
+	__m256 zeroes = _mm256_setzero_ps();
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m256 vx = _mm256_loadu_ps(x + i);
+		__m256 vy = _mm256_loadu_ps(y + i);
+		__m256 m = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(vx, vx), _mm256_mul_ps(vy, vy)));
+		__m256 change;
+		__m256 target = RangeTarget(m, minLen, maxLen, change);
+		__m256 zeroLength = _mm256_cmp_ps(m, eps, _CMP_LT_OQ);
+		__m256 rx = _mm256_blendv_ps(vx, _mm256_mul_ps(_mm256_div_ps(vx, m), target), change);
+		__m256 ry = _mm256_blendv_ps(vy, _mm256_mul_ps(_mm256_div_ps(vy, m), target), change);
+		_mm256_storeu_ps(outX + i, _mm256_blendv_ps(rx, zeroes, zeroLength));
+		_mm256_storeu_ps(outY + i, _mm256_blendv_ps(ry, zeroes, zeroLength));
+	}
+	GetScalarKernels()->clampMagnitudeRange2(x + i, y + i, minLength, maxLength, outX + i, outY + i, n - i);
+}
+
+AVX2 static void ClampMagnitudeRange3(const float* x, const float* y, const float* z, float minLength, float maxLength, float* outX, float* outY, float* outZ, size_t n) {
+	__m256 eps = _mm256_set1_ps(kEpsilon);
+	__m256 minLen = _mm256_set1_ps(minLength);
+	__m256 maxLen = _mm256_set1_ps(maxLength);
+	__m256 zeroes = _mm256_setzero_ps();
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m256 vx = _mm256_loadu_ps(x + i);
+		__m256 vy = _mm256_loadu_ps(y + i);
+		__m256 vz = _mm256_loadu_ps(z + i);
+		__m256 m = _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(vx, vx), _mm256_mul_ps(vy, vy)), _mm256_mul_ps(vz, vz)));
+		__m256 change;
+		__m256 target = RangeTarget(m, minLen, maxLen, change);
+		__m256 zeroLength = _mm256_cmp_ps(m, eps, _CMP_LT_OQ);
+		__m256 rx = _mm256_blendv_ps(vx, _mm256_mul_ps(_mm256_div_ps(vx, m), target), change);
+		__m256 ry = _mm256_blendv_ps(vy, _mm256_mul_ps(_mm256_div_ps(vy, m), target), change);
+		__m256 rz = _mm256_blendv_ps(vz, _mm256_mul_ps(_mm256_div_ps(vz, m), target), change);
+		_mm256_storeu_ps(outX + i, _mm256_blendv_ps(rx, zeroes, zeroLength));
+		_mm256_storeu_ps(outY + i, _mm256_blendv_ps(ry, zeroes, zeroLength));
+		_mm256_storeu_ps(outZ + i, _mm256_blendv_ps(rz, zeroes, zeroLength));
+	}
+	GetScalarKernels()->clampMagnitudeRange3(x + i, y + i, z + i, minLength, maxLength, outX + i, outY + i, outZ + i, n - i);
+}
+
+//F16C conversions, round to nearest even like vmath::HalfFromFloat
+AVX2 static void FloatToHalf(const float* in, uint16_t* out, size_t n) {
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT);
+		_mm_storeu_si128((__m128i*)(out + i), h);
+	}
+	GetScalarKernels()->floatToHalf(in + i, out + i, n - i);
+}
+
+AVX2 static void HalfToFloat(const uint16_t* in, float* out, size_t n) {
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		_mm256_storeu_ps(out + i, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(in + i))));
+	}
+	GetScalarKernels()->halfToFloat(in + i, out + i, n - i);
+}
+
+//Round to nearest even on the top 16 bits; NaN only gets its quiet bit set
+AVX2 static inline __m256i RoundToBFloat16(__m256 v) {
+	__m256i bits = _mm256_castps_si256(v);
+	__m256i lsb = _mm256_and_si256(_mm256_srli_epi32(bits, 16), _mm256_set1_epi32(1));
+	__m256i rounded = _mm256_add_epi32(bits, _mm256_add_epi32(_mm256_set1_epi32(0x7fff), lsb));
+	__m256i nan = _mm256_cmpgt_epi32(_mm256_and_si256(bits, _mm256_set1_epi32(0x7fffffff)), _mm256_set1_epi32(0x7f800000));
+	__m256i quiet = _mm256_or_si256(bits, _mm256_set1_epi32(0x00400000));
+	return _mm256_srli_epi32(_mm256_blendv_epi8(rounded, quiet, nan), 16);
+}
+
+AVX2 static void FloatToBFloat16(const float* in, uint16_t* out, size_t n) {
+	size_t i = 0;
+	for (; i + 16 <= n; i += 16) {
+		__m256i lo = RoundToBFloat16(_mm256_loadu_ps(in + i));
+		__m256i hi = RoundToBFloat16(_mm256_loadu_ps(in + i + 8));
+		//packus works per 128-bit lane, the permute puts the quarters back in order
+		__m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(lo, hi), 0xd8);
+		_mm256_storeu_si256((__m256i*)(out + i), packed);
+	}
+	GetScalarKernels()->floatToBFloat16(in + i, out + i, n - i);
+}
+
+AVX2 static void BFloat16ToFloat(const uint16_t* in, float* out, size_t n) {
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m256i wide = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(in + i)));
+		_mm256_storeu_ps(out + i, _mm256_castsi256_ps(_mm256_slli_epi32(wide, 16)));
+	}
+	GetScalarKernels()->bfloat16ToFloat(in + i, out + i, n - i);
+}
+
+//Packed 4-float elements (Vec4 / Vec3A): two elements per register, eight
+//transposed within each 128-bit lane into x / y / z / w. The lanes end up
+//holding elements 0 2 4 6 | 1 3 5 7, which the transpose back undoes.
+AVX2 static inline void Transpose8(__m256& x, __m256& y, __m256& z, __m256& w) {
+	__m256 t0 = _mm256_unpacklo_ps(x, y);
+	__m256 t1 = _mm256_unpacklo_ps(z, w);
+	__m256 t2 = _mm256_unpackhi_ps(x, y);
+	__m256 t3 = _mm256_unpackhi_ps(z, w);
+	x = _mm256_shuffle_ps(t0, t1, 0x44);
+	y = _mm256_shuffle_ps(t0, t1, 0xee);
+	z = _mm256_shuffle_ps(t2, t3, 0x44);
+	w = _mm256_shuffle_ps(t2, t3, 0xee);
+}
+
+AVX2 static inline void Load8(const float* p, __m256& x, __m256& y, __m256& z, __m256& w) {
+	x = _mm256_loadu_ps(p);
+	y = _mm256_loadu_ps(p + 8);
+	z = _mm256_loadu_ps(p + 16);
+	w = _mm256_loadu_ps(p + 24);
+	Transpose8(x, y, z, w);
+}
+
+//Element order 0 2 4 6 1 3 5 7 back to 0..7 for per-element results
+AVX2 static inline __m256 ElementOrder(__m256 v) {
+	return _mm256_permutevar8x32_ps(v, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+}
+
+AVX2 static inline __m256 SquaredLength4(__m256 x, __m256 y, __m256 z, __m256 w, int components) {
+	__m256 sq = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)), _mm256_mul_ps(z, z));
+	return components == 4 ? _mm256_add_ps(sq, _mm256_mul_ps(w, w)) : sq;
+}
+
+AVX2 static void Dot4(const float* a, const float* b, int components, float* out, size_t n) {
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m256 ax, ay, az, aw, bx, by, bz, bw;
+		Load8(a + i * 4, ax, ay, az, aw);
+		Load8(b + i * 4, bx, by, bz, bw);
+		__m256 d = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ax, bx), _mm256_mul_ps(ay, by)), _mm256_mul_ps(az, bz));
+		if (components == 4) {
+			d = _mm256_add_ps(d, _mm256_mul_ps(aw, bw));
+		}
+		_mm256_storeu_ps(out + i, ElementOrder(d));
+	}
+	GetScalarKernels()->dot4(a + i * 4, b + i * 4, components, out + i, n - i);
+}
+
+AVX2 static void Magnitude4(const float* v, int components, float* out, size_t n) {
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m256 x, y, z, w;
+		Load8(v + i * 4, x, y, z, w);
+		_mm256_storeu_ps(out + i, ElementOrder(_mm256_sqrt_ps(SquaredLength4(x, y, z, w, components))));
+	}
+	GetScalarKernels()->magnitude4(v + i * 4, components, out + i, n - i);
+}
+
+AVX2 static void Normalize4(const float* v, int components, float* out, size_t n) {
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m256 x, y, z, w;
+		Load8(v + i * 4, x, y, z, w);
+		__m256 m = _mm256_sqrt_ps(SquaredLength4(x, y, z, w, components));
+		x = SafeDivide(x, m);
+		y = SafeDivide(y, m);
+		z = SafeDivide(z, m);
+		w = components == 4 ? SafeDivide(w, m) : _mm256_setzero_ps();
+		Transpose8(x, y, z, w);
+		_mm256_storeu_ps(out + i * 4, x);
+		_mm256_storeu_ps(out + i * 4 + 8, y);
+		_mm256_storeu_ps(out + i * 4 + 16, z);
+		_mm256_storeu_ps(out + i * 4 + 24, w);
+	}
+	GetScalarKernels()->normalize4(v + i * 4, components, out + i * 4, n - i);
+}
+
+//a.yzx * b.zxy - a.zxy * b.yzx, two elements per register
+AVX2 static void Cross3A(const float* a, const float* b, float* out, size_t n) {
+	size_t i = 0;
+	for (; i + 2 <= n; i += 2) {
+		__m256 va = _mm256_loadu_ps(a + i * 4);
+		__m256 vb = _mm256_loadu_ps(b + i * 4);
+		__m256 left = _mm256_mul_ps(_mm256_permute_ps(va, _MM_SHUFFLE(3, 0, 2, 1)), _mm256_permute_ps(vb, _MM_SHUFFLE(3, 1, 0, 2)));
+		__m256 right = _mm256_mul_ps(_mm256_permute_ps(va, _MM_SHUFFLE(3, 1, 0, 2)), _mm256_permute_ps(vb, _MM_SHUFFLE(3, 0, 2, 1)));
+		_mm256_storeu_ps(out + i * 4, _mm256_blend_ps(_mm256_sub_ps(left, right), _mm256_setzero_ps(), 0x88));
+	}
+	GetScalarKernels()->cross3A(a + i * 4, b + i * 4, out + i * 4, n - i);
+}
+
+//Reductions: the kReduceLanes accumulators live in three registers for the
+//whole call, one group of 24 floats per iteration
+AVX2 static void Sum(const float* in, float* lanes, size_t n) {
+	__m256 acc[3];
+	for (int r = 0; r < 3; ++r) {
+		acc[r] = _mm256_loadu_ps(lanes + r * 8);
+	}
+	size_t i = 0;
+	for (; i + kReduceLanes <= n; i += kReduceLanes) {
+		for (int r = 0; r < 3; ++r) {
+			acc[r] = _mm256_add_ps(acc[r], _mm256_loadu_ps(in + i + r * 8));
+		}
+	}
+	for (int r = 0; r < 3; ++r) {
+		_mm256_storeu_ps(lanes + r * 8, acc[r]);
+	}
+	GetScalarKernels()->sum(in + i, lanes, n - i);
+}
+
+AVX2 static void SumKahan(const float* in, float* lanes, float* compensation, size_t n) {
+	__m256 acc[3];
+	__m256 comp[3];
+	for (int r = 0; r < 3; ++r) {
+		acc[r] = _mm256_loadu_ps(lanes + r * 8);
+		comp[r] = _mm256_loadu_ps(compensation + r * 8);
+	}
+	size_t i = 0;
+	for (; i + kReduceLanes <= n; i += kReduceLanes) {
+		for (int r = 0; r < 3; ++r) {
+			__m256 y = _mm256_sub_ps(_mm256_loadu_ps(in + i + r * 8), comp[r]);
+			__m256 t = _mm256_add_ps(acc[r], y);
+			comp[r] = _mm256_sub_ps(_mm256_sub_ps(t, acc[r]), y);
+			acc[r] = t;
+		}
+	}
+	for (int r = 0; r < 3; ++r) {
+		_mm256_storeu_ps(lanes + r * 8, acc[r]);
+		_mm256_storeu_ps(compensation + r * 8, comp[r]);
+	}
+	GetScalarKernels()->sumKahan(in + i, lanes, compensation, n - i);
+}
+
+AVX2 static void DotSum(const float* a, const float* b, float* lanes, size_t n) {
+	__m256 acc[3];
+	for (int r = 0; r < 3; ++r) {
+		acc[r] = _mm256_loadu_ps(lanes + r * 8);
+	}
+	size_t i = 0;
+	for (; i + kReduceLanes <= n; i += kReduceLanes) {
+		for (int r = 0; r < 3; ++r) {
+			acc[r] = _mm256_add_ps(acc[r], _mm256_mul_ps(_mm256_loadu_ps(a + i + r * 8), _mm256_loadu_ps(b + i + r * 8)));
+		}
+	}
+	for (int r = 0; r < 3; ++r) {
+		_mm256_storeu_ps(lanes + r * 8, acc[r]);
+	}
+	GetScalarKernels()->dotSum(a + i, b + i, lanes, n - i);
+}
+
+//vminps(x, m) is x < m ? x : m, so NaN inputs leave the lane alone
+AVX2 static void MinMax(const float* in, float* minLanes, float* maxLanes, size_t n) {
+	__m256 lo[3];
+	__m256 hi[3];
+	for (int r = 0; r < 3; ++r) {
+		lo[r] = _mm256_loadu_ps(minLanes + r * 8);
+		hi[r] = _mm256_loadu_ps(maxLanes + r * 8);
+	}
+	size_t i = 0;
+	for (; i + kReduceLanes <= n; i += kReduceLanes) {
+		for (int r = 0; r < 3; ++r) {
+			__m256 x = _mm256_loadu_ps(in + i + r * 8);
+			lo[r] = _mm256_min_ps(x, lo[r]);
+			hi[r] = _mm256_max_ps(x, hi[r]);
+		}
+	}
+	for (int r = 0; r < 3; ++r) {
+		_mm256_storeu_ps(minLanes + r * 8, lo[r]);
+		_mm256_storeu_ps(maxLanes + r * 8, hi[r]);
+	}
+	GetScalarKernels()->minMax(in + i, minLanes, maxLanes, n - i);
+}
+
+AVX2 static void MinMaxIndex(const float* in, uint32_t first, float* minLanes, uint32_t* minIndex, float* maxLanes, uint32_t* maxIndex, size_t n) {
+	__m256 lo[3];
+	__m256 hi[3];
+	__m256i loIndex[3];
+	__m256i hiIndex[3];
+	__m256i index[3];
+	for (int r = 0; r < 3; ++r) {
+		lo[r] = _mm256_loadu_ps(minLanes + r * 8);
+		hi[r] = _mm256_loadu_ps(maxLanes + r * 8);
+		loIndex[r] = _mm256_loadu_si256((const __m256i*)(minIndex + r * 8));
+		hiIndex[r] = _mm256_loadu_si256((const __m256i*)(maxIndex + r * 8));
+		index[r] = _mm256_add_epi32(_mm256_set1_epi32((int)first + r * 8), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+	}
+	__m256i step = _mm256_set1_epi32((int)kReduceLanes);
+	size_t i = 0;
+	for (; i + kReduceLanes <= n; i += kReduceLanes) {
+		for (int r = 0; r < 3; ++r) {
+			__m256 x = _mm256_loadu_ps(in + i + r * 8);
+			__m256 less = _mm256_cmp_ps(x, lo[r], _CMP_LT_OQ);
+			__m256 greater = _mm256_cmp_ps(x, hi[r], _CMP_GT_OQ);
+			lo[r] = _mm256_blendv_ps(lo[r], x, less);
+			hi[r] = _mm256_blendv_ps(hi[r], x, greater);
+			loIndex[r] = _mm256_blendv_epi8(loIndex[r], index[r], _mm256_castps_si256(less));
+			hiIndex[r] = _mm256_blendv_epi8(hiIndex[r], index[r], _mm256_castps_si256(greater));
+			index[r] = _mm256_add_epi32(index[r], step);
+		}
+	}
+	for (int r = 0; r < 3; ++r) {
+		_mm256_storeu_ps(minLanes + r * 8, lo[r]);
+		_mm256_storeu_ps(maxLanes + r * 8, hi[r]);
+		_mm256_storeu_si256((__m256i*)(minIndex + r * 8), loIndex[r]);
+		_mm256_storeu_si256((__m256i*)(maxIndex + r * 8), hiIndex[r]);
+	}
+	GetScalarKernels()->minMaxIndex(in + i, first + (uint32_t)i, minLanes, minIndex, maxLanes, maxIndex, n - i);
+}
+
+//hadd works within each 128-bit half, giving vectors 0 1 4 5 | 2 3 6 7;
+//the 64-bit permute puts them back in order
+AVX2 static void DotPacked2(const float* a, const float* b, float* out, size_t n) {
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m256 low = _mm256_mul_ps(_mm256_loadu_ps(a + i * 2), _mm256_loadu_ps(b + i * 2));
+		__m256 high = _mm256_mul_ps(_mm256_loadu_ps(a + i * 2 + 8), _mm256_loadu_ps(b + i * 2 + 8));
+		__m256 sums = _mm256_hadd_ps(low, high);
+		_mm256_storeu_ps(out + i, _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(sums), _MM_SHUFFLE(3, 1, 2, 0))));
+	}
+	GetScalarKernels()->dotPacked2(a + i * 2, b + i * 2, out + i, n - i);
+}
+
+//Four floats at in and four at in + 12 as the low and high halves
+AVX2 static inline __m256 LoadHalves(const float* in) {
+	return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(in)), _mm_loadu_ps(in + 12), 1);
+}
+
+//Eight packed xyz vectors: each 128-bit half of the loads holds four, which
+//the in-lane shuffles of VectorMathKernelsSse41.cpp split by component. The
+//products of packed vectors are packed too, so they are split after the
+//multiply.
+AVX2 static void DotPacked3(const float* a, const float* b, float* out, size_t n) {
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		//Low halves: vectors 0-3, high halves: vectors 4-7
+		__m256 x0y0z0x1 = _mm256_mul_ps(LoadHalves(a + i * 3), LoadHalves(b + i * 3));
+		__m256 y1z1x2y2 = _mm256_mul_ps(LoadHalves(a + i * 3 + 4), LoadHalves(b + i * 3 + 4));
+		__m256 z2x3y3z3 = _mm256_mul_ps(LoadHalves(a + i * 3 + 8), LoadHalves(b + i * 3 + 8));
+		__m256 x2y2x3y3 = _mm256_shuffle_ps(y1z1x2y2, z2x3y3z3, _MM_SHUFFLE(2, 1, 3, 2));
+		__m256 y0z0y1z1 = _mm256_shuffle_ps(x0y0z0x1, y1z1x2y2, _MM_SHUFFLE(1, 0, 2, 1));
+		__m256 x = _mm256_shuffle_ps(x0y0z0x1, x2y2x3y3, _MM_SHUFFLE(2, 0, 3, 0));
+		__m256 y = _mm256_shuffle_ps(y0z0y1z1, x2y2x3y3, _MM_SHUFFLE(3, 1, 2, 0));
+		__m256 z = _mm256_shuffle_ps(y0z0y1z1, z2x3y3z3, _MM_SHUFFLE(3, 0, 3, 1));
+		_mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_add_ps(x, y), z));
+	}
+	GetScalarKernels()->dotPacked3(a + i * 3, b + i * 3, out + i, n - i);
+}
+
+AVX2 static inline void BezierWeights(__m256 u, __m256& w0, __m256& w1, __m256& w2, __m256& w3) {
+	__m256 three = _mm256_set1_ps(3.0f);
+	__m256 s = _mm256_sub_ps(_mm256_set1_ps(1.0f), u);
+	__m256 s2 = _mm256_mul_ps(s, s);
+	__m256 u2 = _mm256_mul_ps(u, u);
+	w0 = _mm256_mul_ps(s2, s);
+	w1 = _mm256_mul_ps(_mm256_mul_ps(three, s2), u);
+	w2 = _mm256_mul_ps(_mm256_mul_ps(three, s), u2);
+	w3 = _mm256_mul_ps(u2, u);
+}
+
+//One component of the segment from its four broadcast control values
+AVX2 static inline __m256 BezierSum(__m256 w0, __m256 w1, __m256 w2, __m256 w3, const __m256* c) {
+	return _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(w0, c[0]), _mm256_mul_ps(w1, c[1])), _mm256_mul_ps(w2, c[2])), _mm256_mul_ps(w3, c[3]));
+}
+
+//unpack works within each 128-bit half (vectors 0 1 4 5 and 2 3 6 7), so the
+//halves are swapped back into order before the stores
+AVX2 static void Bezier2(const float* controls, const float* u, float* out, size_t n) {
+	__m256 cx[4], cy[4];
+	for (int k = 0; k < 4; ++k) {
+		cx[k] = _mm256_set1_ps(controls[k * 2]);
+		cy[k] = _mm256_set1_ps(controls[k * 2 + 1]);
+	}
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m256 w0, w1, w2, w3;
+		BezierWeights(_mm256_loadu_ps(u + i), w0, w1, w2, w3);
+		__m256 x = BezierSum(w0, w1, w2, w3, cx);
+		__m256 y = BezierSum(w0, w1, w2, w3, cy);
+		__m256 lo = _mm256_unpacklo_ps(x, y);
+		__m256 hi = _mm256_unpackhi_ps(x, y);
+		_mm256_storeu_ps(out + i * 2, _mm256_permute2f128_ps(lo, hi, 0x20));
+		_mm256_storeu_ps(out + i * 2 + 8, _mm256_permute2f128_ps(lo, hi, 0x31));
+	}
+	GetScalarKernels()->bezier2(controls, u + i, out + i * 2, n - i);
+}
+
+//Eight vectors: the Transform3 store shuffles, each 128-bit half writing four
+AVX2 static void Bezier3(const float* controls, const float* u, float* out, size_t n) {
+	__m256 cx[4], cy[4], cz[4];
+	for (int k = 0; k < 4; ++k) {
+		cx[k] = _mm256_set1_ps(controls[k * 3]);
+		cy[k] = _mm256_set1_ps(controls[k * 3 + 1]);
+		cz[k] = _mm256_set1_ps(controls[k * 3 + 2]);
+	}
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m256 w0, w1, w2, w3;
+		BezierWeights(_mm256_loadu_ps(u + i), w0, w1, w2, w3);
+		__m256 x = BezierSum(w0, w1, w2, w3, cx);
+		__m256 y = BezierSum(w0, w1, w2, w3, cy);
+		__m256 z = BezierSum(w0, w1, w2, w3, cz);
+		__m256 rxy = _mm256_shuffle_ps(x, y, _MM_SHUFFLE(2, 0, 2, 0));
+		__m256 ryz = _mm256_shuffle_ps(y, z, _MM_SHUFFLE(3, 1, 3, 1));
+		__m256 rzx = _mm256_shuffle_ps(z, x, _MM_SHUFFLE(3, 1, 2, 0));
+		__m256 r0 = _mm256_shuffle_ps(rxy, rzx, _MM_SHUFFLE(2, 0, 2, 0));
+		__m256 r1 = _mm256_shuffle_ps(ryz, rxy, _MM_SHUFFLE(3, 1, 2, 0));
+		__m256 r2 = _mm256_shuffle_ps(rzx, ryz, _MM_SHUFFLE(3, 1, 3, 1));
+		float* q = out + i * 3;
+		_mm_storeu_ps(q, _mm256_castps256_ps128(r0));
+		_mm_storeu_ps(q + 4, _mm256_castps256_ps128(r1));
+		_mm_storeu_ps(q + 8, _mm256_castps256_ps128(r2));
+		_mm_storeu_ps(q + 12, _mm256_extractf128_ps(r0, 1));
+		_mm_storeu_ps(q + 16, _mm256_extractf128_ps(r1, 1));
+		_mm_storeu_ps(q + 20, _mm256_extractf128_ps(r2, 1));
+	}
+	GetScalarKernels()->bezier3(controls, u + i, out + i * 3, n - i);
+}
+
+static const VectorKernels kAvx2Kernels = {
+	"AVX2",
+	Add, Subtract, Scale, Clamp,
+	Dot2, Dot3,
+	Magnitude2, Magnitude3,
+	Normalize2, Normalize3,
+	NormalizeFast2, NormalizeFast3,
+	Reflect2, Reflect3,
+	ClampMagnitude2, ClampMagnitude3,
+	Transform3,
+	IntegrateEuler, IntegrateVerlet,
+	ReflectResponse2, ReflectResponse3,
+	ScaleAdd, MulAdd, LerpClamp,
+	ClampMagnitudeRange2, ClampMagnitudeRange3,
+	FloatToHalf, HalfToFloat, FloatToBFloat16, BFloat16ToFloat,
+	Dot4, Magnitude4, Normalize4, Cross3A,
+	Sum, SumKahan, DotSum, MinMax, MinMaxIndex,
+	DotPacked2, DotPacked3,
+	Bezier2, Bezier3
+};
+
+const VectorKernels* GetAvx2Kernels() {
+	return &kAvx2Kernels;
+}
+
+#else
+
+const VectorKernels* GetAvx2Kernels() {
+	return nullptr;
+}
+
+#endif
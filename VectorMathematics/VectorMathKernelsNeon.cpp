@@ -0,0 +1,792 @@
+//Always include the pch.h first in every cpp
+#include "pch.h"
+
+//Then include own items
+#include "VectorMathKernels.h"
+
+#ifdef VECTORMATH_NEON
+
+#include <arm_neon.h>
+
+//4-wide NEON kernels for AArch64, the same algorithms as VectorMathKernelsSse41.cpp.
+//NEON is part of the AArch64 baseline so no runtime check is needed.
+//Whatever does not fill a full register is finished by the scalar kernels.
+
+static const float kEpsilon = 0.0001f;
+
+static inline float32x4_t Select(uint32x4_t mask, float32x4_t a, float32x4_t b) {
+	return vbslq_f32(mask, a, b);
+}
+
+//Returns v / m, or zero where m < kEpsilon (NaN magnitudes keep the divide,
+//exactly like the scalar "if (m < 0.0001f)" check).
+static inline float32x4_t SafeDivide(float32x4_t v, float32x4_t m) {
+	uint32x4_t tooShort = vcltq_f32(m, vdupq_n_f32(kEpsilon));
+	return Select(tooShort, vdupq_n_f32(0.0f), vdivq_f32(v, m));
+}
+
+static void Add(const float* a, const float* b, float* out, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		vst1q_f32(out + i, vaddq_f32(vld1q_f32(a + i), vld1q_f32(b + i)));
+	}
+	GetScalarKernels()->add(a + i, b + i, out + i, n - i);
+}
+
+static void Subtract(const float* a, const float* b, float* out, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		vst1q_f32(out + i, vsubq_f32(vld1q_f32(a + i), vld1q_f32(b + i)));
+	}
+	GetScalarKernels()->subtract(a + i, b + i, out + i, n - i);
+}
+
+static void Scale(const float* v, float scale, float* out, size_t n) {
+	float32x4_t s = vdupq_n_f32(scale);
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		vst1q_f32(out + i, vmulq_f32(s, vld1q_f32(v + i)));
+	}
+	GetScalarKernels()->scale(v + i, scale, out + i, n - i);
+}
+
+static void Clamp(const float* v, float minVal, float maxVal, float* out, size_t n) {
+	float32x4_t lo = vdupq_n_f32(minVal);
+	float32x4_t hi = vdupq_n_f32(maxVal);
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		float32x4_t c = vld1q_f32(v + i);
+		float32x4_t r = Select(vcltq_f32(c, lo), lo, c);
+		r = Select(vcgtq_f32(c, hi), hi, r);
+		vst1q_f32(out + i, r);
+	}
+	GetScalarKernels()->clamp(v + i, minVal, maxVal, out + i, n - i);
+}
+
+static void Dot2(const float* ax, const float* ay, const float* bx, const float* by, float* out, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		float32x4_t x = vmulq_f32(vld1q_f32(ax + i), vld1q_f32(bx + i));
+		float32x4_t y = vmulq_f32(vld1q_f32(ay + i), vld1q_f32(by + i));
+		vst1q_f32(out + i, vaddq_f32(x, y));
+	}
+	GetScalarKernels()->dot2(ax + i, ay + i, bx + i, by + i, out + i, n - i);
+}
+
+static void Dot3(const float* ax, const float* ay, const float* az, const float* bx, const float* by, const float* bz, float* out, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		float32x4_t x = vmulq_f32(vld1q_f32(ax + i), vld1q_f32(bx + i));
+		float32x4_t y = vmulq_f32(vld1q_f32(ay + i), vld1q_f32(by + i));
+		float32x4_t z = vmulq_f32(vld1q_f32(az + i), vld1q_f32(bz + i));
+		vst1q_f32(out + i, vaddq_f32(vaddq_f32(x, y), z));
+	}
+	GetScalarKernels()->dot3(ax + i, ay + i, az + i, bx + i, by + i, bz + i, out + i, n - i);
+}
+
+static inline float32x4_t LengthSquared2(float32x4_t x, float32x4_t y) {
+	return vaddq_f32(vmulq_f32(x, x), vmulq_f32(y, y));
+}
+
+static inline float32x4_t LengthSquared3(float32x4_t x, float32x4_t y, float32x4_t z) {
+	return vaddq_f32(vaddq_f32(vmulq_f32(x, x), vmulq_f32(y, y)), vmulq_f32(z, z));
+}
+
+static void Magnitude2(const float* x, const float* y, float* out, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		vst1q_f32(out + i, vsqrtq_f32(LengthSquared2(vld1q_f32(x + i), vld1q_f32(y + i))));
+	}
+	GetScalarKernels()->magnitude2(x + i, y + i, out + i, n - i);
+}
+
+static void Magnitude3(const float* x, const float* y, const float* z, float* out, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		vst1q_f32(out + i, vsqrtq_f32(LengthSquared3(vld1q_f32(x + i), vld1q_f32(y + i), vld1q_f32(z + i))));
+	}
+	GetScalarKernels()->magnitude3(x + i, y + i, z + i, out + i, n - i);
+}
+
+static void Normalize2(const float* x, const float* y, float* outX, float* outY, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		float32x4_t vx = vld1q_f32(x + i);
+		float32x4_t vy = vld1q_f32(y + i);
+		float32x4_t m = vsqrtq_f32(LengthSquared2(vx, vy));
+		vst1q_f32(outX + i, SafeDivide(vx, m));
+		vst1q_f32(outY + i, SafeDivide(vy, m));
+	}
+	GetScalarKernels()->normalize2(x + i, y + i, outX + i, outY + i, n - i);
+}
+
+static void Normalize3(const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		float32x4_t vx = vld1q_f32(x + i);
+		float32x4_t vy = vld1q_f32(y + i);
+		float32x4_t vz = vld1q_f32(z + i);
+		float32x4_t m = vsqrtq_f32(LengthSquared3(vx, vy, vz));
+		vst1q_f32(outX + i, SafeDivide(vx, m));
+		vst1q_f32(outY + i, SafeDivide(vy, m));
+		vst1q_f32(outZ + i, SafeDivide(vz, m));
+	}
+	GetScalarKernels()->normalize3(x + i, y + i, z + i, outX + i, outY + i, outZ + i, n - i);
+}
+
+//Estimate plus two Newton-Raphson steps, same as vmath::ReciprocalSqrtFast
+//(an exact 1 / sqrt in deterministic builds)
+static inline float32x4_t ReciprocalSqrtFast(float32x4_t sq) {
+#if defined(VECTORMATH_DETERMINISTIC)
+	return vdivq_f32(vdupq_n_f32(1.0f), vsqrtq_f32(sq));
+#else
+	float32x4_t y = vrsqrteq_f32(sq);
+	y = vmulq_f32(y, vrsqrtsq_f32(vmulq_f32(sq, y), y));
+	y = vmulq_f32(y, vrsqrtsq_f32(vmulq_f32(sq, y), y));
+	return y;
+#endif
+}
+
+//Multiplier for the fast normalize, zero where the squared length is below kEpsilon squared
+static inline float32x4_t FastScale(float32x4_t sq) {
+	uint32x4_t tooShort = vcltq_f32(sq, vdupq_n_f32(kEpsilon * kEpsilon));
+	return Select(tooShort, vdupq_n_f32(0.0f), ReciprocalSqrtFast(sq));
+}
+
+static void NormalizeFast2(const float* x, const float* y, float* outX, float* outY, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		float32x4_t vx = vld1q_f32(x + i);
+		float32x4_t vy = vld1q_f32(y + i);
+		float32x4_t inv = FastScale(LengthSquared2(vx, vy));
+		vst1q_f32(outX + i, vmulq_f32(vx, inv));
+		vst1q_f32(outY + i, vmulq_f32(vy, inv));
+	}
+	GetScalarKernels()->normalizeFast2(x + i, y + i, outX + i, outY + i, n - i);
+}
+
+static void NormalizeFast3(const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		float32x4_t vx = vld1q_f32(x + i);
+		float32x4_t vy = vld1q_f32(y + i);
+		float32x4_t vz = vld1q_f32(z + i);
+		float32x4_t inv = FastScale(LengthSquared3(vx, vy, vz));
+		vst1q_f32(outX + i, vmulq_f32(vx, inv));
+		vst1q_f32(outY + i, vmulq_f32(vy, inv));
+		vst1q_f32(outZ + i, vmulq_f32(vz, inv));
+	}
+	GetScalarKernels()->normalizeFast3(x + i, y + i, z + i, outX + i, outY + i, outZ + i, n - i);
+}
+
+static void Reflect2(const float* vx, const float* vy, const float* nx, const float* ny, float* outX, float* outY, size_t n) {
+	float32x4_t two = vdupq_n_f32(2.0f);
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		float32x4_t x = vld1q_f32(vx + i);
+		float32x4_t y = vld1q_f32(vy + i);
+		float32x4_t normalX = vld1q_f32(nx + i);
+		float32x4_t normalY = vld1q_f32(ny + i);
+		float32x4_t m = vsqrtq_f32(LengthSquared2(normalX, normalY));
+		normalX = SafeDivide(normalX, m);
+		normalY = SafeDivide(normalY, m);
+		float32x4_t d = vmulq_f32(two, vaddq_f32(vmulq_f32(x, normalX), vmulq_f32(y, normalY)));
+		vst1q_f32(outX + i, vsubq_f32(x, vmulq_f32(d, normalX)));
+		vst1q_f32(outY + i, vsubq_f32(y, vmulq_f32(d, normalY)));
+	}
+	GetScalarKernels()->reflect2(vx + i, vy + i, nx + i, ny + i, outX + i, outY + i, n - i);
+}
+
+static void Reflect3(const float* vx, const float* vy, const float* vz, const float* nx, const float* ny, const float* nz, float* outX, float* outY, float* outZ, size_t n) {
+	float32x4_t two = vdupq_n_f32(2.0f);
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		float32x4_t x = vld1q_f32(vx + i);
+		float32x4_t y = vld1q_f32(vy + i);
+		float32x4_t z = vld1q_f32(vz + i);
+		float32x4_t normalX = vld1q_f32(nx + i);
+		float32x4_t normalY = vld1q_f32(ny + i);
+		float32x4_t normalZ = vld1q_f32(nz + i);
+		float32x4_t m = vsqrtq_f32(LengthSquared3(normalX, normalY, normalZ));
+		normalX = SafeDivide(normalX, m);
+		normalY = SafeDivide(normalY, m);
+		normalZ = SafeDivide(normalZ, m);
+		float32x4_t dot = vaddq_f32(vaddq_f32(vmulq_f32(x, normalX), vmulq_f32(y, normalY)), vmulq_f32(z, normalZ));
+		float32x4_t d = vmulq_f32(two, dot);
+		vst1q_f32(outX + i, vsubq_f32(x, vmulq_f32(d, normalX)));
+		vst1q_f32(outY + i, vsubq_f32(y, vmulq_f32(d, normalY)));
+		vst1q_f32(outZ + i, vsubq_f32(z, vmulq_f32(d, normalZ)));
+	}
+	GetScalarKernels()->reflect3(vx + i, vy + i, vz + i, nx + i, ny + i, nz + i, outX + i, outY + i, outZ + i, n - i);
+}
+
+static void ClampMagnitude2(const float* x, const float* y, float maxLength, float* outX, float* outY, size_t n) {
+	float32x4_t eps = vdupq_n_f32(kEpsilon);
+	float32x4_t maxLen = vdupq_n_f32(maxLength);
+	float32x4_t zero = vdupq_n_f32(0.0f);
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		float32x4_t vx = vld1q_f32(x + i);
+		float32x4_t vy = vld1q_f32(y + i);
+		float32x4_t m = vsqrtq_f32(LengthSquared2(vx, vy));
+		uint32x4_t tooShort = vcltq_f32(m, eps);
+		uint32x4_t tooLong = vcgtq_f32(m, maxLen);
+		float32x4_t rx = Select(tooLong, vmulq_f32(vdivq_f32(vx, m), maxLen), vx);
+		float32x4_t ry = Select(tooLong, vmulq_f32(vdivq_f32(vy, m), maxLen), vy);
+		vst1q_f32(outX + i, Select(tooShort, zero, rx));
+		vst1q_f32(outY + i, Select(tooShort, zero, ry));
+	}
+	GetScalarKernels()->clampMagnitude2(x + i, y + i, maxLength, outX + i, outY + i, n - i);
+}
+
+static void ClampMagnitude3(const float* x, const float* y, const float* z, float maxLength, float* outX, float* outY, float* outZ, size_t n) {
+	float32x4_t eps = vdupq_n_f32(kEpsilon);
+	float32x4_t maxLen = vdupq_n_f32(maxLength);
+	float32x4_t zero = vdupq_n_f32(0.0f);
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		float32x4_t vx = vld1q_f32(x + i);
+		float32x4_t vy = vld1q_f32(y + i);
+		float32x4_t vz = vld1q_f32(z + i);
+		float32x4_t m = vsqrtq_f32(LengthSquared3(vx, vy, vz));
+		uint32x4_t tooShort = vcltq_f32(m, eps);
+		uint32x4_t tooLong = vcgtq_f32(m, maxLen);
+		float32x4_t rx = Select(tooLong, vmulq_f32(vdivq_f32(vx, m), maxLen), vx);
+		float32x4_t ry = Select(tooLong, vmulq_f32(vdivq_f32(vy, m), maxLen), vy);
+		float32x4_t rz = Select(tooLong, vmulq_f32(vdivq_f32(vz, m), maxLen), vz);
+		vst1q_f32(outX + i, Select(tooShort, zero, rx));
+		vst1q_f32(outY + i, Select(tooShort, zero, ry));
+		vst1q_f32(outZ + i, Select(tooShort, zero, rz));
+	}
+	GetScalarKernels()->clampMagnitude3(x + i, y + i, z + i, maxLength, outX + i, outY + i, outZ + i, n - i);
+}
+
+//4 packed xyz points per iteration. vld3q / vst3q de-interleave and
+//re-interleave the components, so no shuffles are needed.
+static void Transform3(const float* m, float w, const float* in, float* out, size_t n) {
+	float32x4_t m0 = vdupq_n_f32(m[0]), m1 = vdupq_n_f32(m[1]), m2 = vdupq_n_f32(m[2]);
+	float32x4_t m4 = vdupq_n_f32(m[4]), m5 = vdupq_n_f32(m[5]), m6 = vdupq_n_f32(m[6]);
+	float32x4_t m8 = vdupq_n_f32(m[8]), m9 = vdupq_n_f32(m[9]), m10 = vdupq_n_f32(m[10]);
+	float32x4_t tx = vdupq_n_f32(m[12] * w), ty = vdupq_n_f32(m[13] * w), tz = vdupq_n_f32(m[14] * w);
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		float32x4x3_t p = vld3q_f32(in + i * 3);
+		float32x4_t x = p.val[0];
+		float32x4_t y = p.val[1];
+		float32x4_t z = p.val[2];
+		float32x4x3_t r;
+		r.val[0] = vaddq_f32(vaddq_f32(vaddq_f32(vmulq_f32(m0, x), vmulq_f32(m4, y)), vmulq_f32(m8, z)), tx);
+		r.val[1] = vaddq_f32(vaddq_f32(vaddq_f32(vmulq_f32(m1, x), vmulq_f32(m5, y)), vmulq_f32(m9, z)), ty);
+		r.val[2] = vaddq_f32(vaddq_f32(vaddq_f32(vmulq_f32(m2, x), vmulq_f32(m6, y)), vmulq_f32(m10, z)), tz);
+		vst3q_f32(out + i * 3, r);
+	}
+	GetScalarKernels()->transform3(m, w, in + i * 3, out + i * 3, n - i);
+}
+
+static void IntegrateEuler(float* p, float* v, const float* a, float dt, size_t n) {
+	float32x4_t step = vdupq_n_f32(dt);
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		float32x4_t acc = a != nullptr ? vld1q_f32(a + i) : vdupq_n_f32(0.0f);
+		float32x4_t vel = vaddq_f32(vld1q_f32(v + i), vmulq_f32(acc, step));
+		vst1q_f32(v + i, vel);
+		vst1q_f32(p + i, vaddq_f32(vld1q_f32(p + i), vmulq_f32(vel, step)));
+	}
+	GetScalarKernels()->integrateEuler(p + i, v + i, a != nullptr ? a + i : nullptr, dt, n - i);
+}
+
+static void IntegrateVerlet(float* p, float* prev, const float* a, float dt, size_t n) {
+	float32x4_t step2 = vdupq_n_f32(dt * dt);
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		float32x4_t acc = a != nullptr ? vld1q_f32(a + i) : vdupq_n_f32(0.0f);
+		float32x4_t current = vld1q_f32(p + i);
+		float32x4_t next = vaddq_f32(vaddq_f32(current, vsubq_f32(current, vld1q_f32(prev + i))), vmulq_f32(acc, step2));
+		vst1q_f32(p + i, next);
+		vst1q_f32(prev + i, current);
+	}
+	GetScalarKernels()->integrateVerlet(p + i, prev + i, a != nullptr ? a + i : nullptr, dt, n - i);
+}
+
+//All bits set in lanes whose contact byte is non-zero
+static inline uint32x4_t LoadMask(const unsigned char* mask) {
+	const uint32_t lanes[4] = {
+		mask[0] != 0 ? 0xFFFFFFFFu : 0u, mask[1] != 0 ? 0xFFFFFFFFu : 0u,
+		mask[2] != 0 ? 0xFFFFFFFFu : 0u, mask[3] != 0 ? 0xFFFFFFFFu : 0u
+	};
+	return vld1q_u32(lanes);
+}
+
+//Inactive lanes (masked out or zero length normal) keep their velocity
+static void ReflectResponse2(float* vx, float* vy, const float* nx, const float* ny, const unsigned char* mask, float restitution, float friction, int normalize, size_t n) {
+	float32x4_t eps = vdupq_n_f32(kEpsilon);
+	float32x4_t rest = vdupq_n_f32(restitution);
+	float32x4_t tangentScale = vdupq_n_f32(1.0f - friction);
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		uint32x4_t active = mask != nullptr ? LoadMask(mask + i) : vdupq_n_u32(0xFFFFFFFFu);
+		float32x4_t x = vld1q_f32(vx + i);
+		float32x4_t y = vld1q_f32(vy + i);
+		float32x4_t normalX = vld1q_f32(nx + i);
+		float32x4_t normalY = vld1q_f32(ny + i);
+		if (normalize) {
+			float32x4_t m = vsqrtq_f32(vaddq_f32(vmulq_f32(normalX, normalX), vmulq_f32(normalY, normalY)));
+			active = vbicq_u32(active, vcltq_f32(m, eps));
+			normalX = vdivq_f32(normalX, m);
+			normalY = vdivq_f32(normalY, m);
+		}
+		float32x4_t d = vaddq_f32(vmulq_f32(x, normalX), vmulq_f32(y, normalY));
+		float32x4_t partX = vmulq_f32(d, normalX);
+		float32x4_t partY = vmulq_f32(d, normalY);
+		float32x4_t rx = vsubq_f32(vmulq_f32(tangentScale, vsubq_f32(x, partX)), vmulq_f32(rest, partX));
+		float32x4_t ry = vsubq_f32(vmulq_f32(tangentScale, vsubq_f32(y, partY)), vmulq_f32(rest, partY));
+		vst1q_f32(vx + i, Select(active, rx, x));
+		vst1q_f32(vy + i, Select(active, ry, y));
+	}
+	GetScalarKernels()->reflectResponse2(vx + i, vy + i, nx + i, ny + i, mask != nullptr ? mask + i : nullptr, restitution, friction, normalize, n - i);
+}
+
+static void ReflectResponse3(float* vx, float* vy, float* vz, const float* nx, const float* ny, const float* nz, const unsigned char* mask, float restitution, float friction, int normalize, size_t n) {
+	float32x4_t eps = vdupq_n_f32(kEpsilon);
+	float32x4_t rest = vdupq_n_f32(restitution);
+	float32x4_t tangentScale = vdupq_n_f32(1.0f - friction);
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		uint32x4_t active = mask != nullptr ? LoadMask(mask + i) : vdupq_n_u32(0xFFFFFFFFu);
+		float32x4_t x = vld1q_f32(vx + i);
+		float32x4_t y = vld1q_f32(vy + i);
+		float32x4_t z = vld1q_f32(vz + i);
+		float32x4_t normalX = vld1q_f32(nx + i);
+		float32x4_t normalY = vld1q_f32(ny + i);
+		float32x4_t normalZ = vld1q_f32(nz + i);
+		if (normalize) {
+			float32x4_t sq = vaddq_f32(vaddq_f32(vmulq_f32(normalX, normalX), vmulq_f32(normalY, normalY)), vmulq_f32(normalZ, normalZ));
+			float32x4_t m = vsqrtq_f32(sq);
+			active = vbicq_u32(active, vcltq_f32(m, eps));
+			normalX = vdivq_f32(normalX, m);
+			normalY = vdivq_f32(normalY, m);
+			normalZ = vdivq_f32(normalZ, m);
+		}
+		float32x4_t d = vaddq_f32(vaddq_f32(vmulq_f32(x, normalX), vmulq_f32(y, normalY)), vmulq_f32(z, normalZ));
+		float32x4_t partX = vmulq_f32(d, normalX);
+		float32x4_t partY = vmulq_f32(d, normalY);
+		float32x4_t partZ = vmulq_f32(d, normalZ);
+		float32x4_t rx = vsubq_f32(vmulq_f32(tangentScale, vsubq_f32(x, partX)), vmulq_f32(rest, partX));
+		float32x4_t ry = vsubq_f32(vmulq_f32(tangentScale, vsubq_f32(y, partY)), vmulq_f32(rest, partY));
+		float32x4_t rz = vsubq_f32(vmulq_f32(tangentScale, vsubq_f32(z, partZ)), vmulq_f32(rest, partZ));
+		vst1q_f32(vx + i, Select(active, rx, x));
+		vst1q_f32(vy + i, Select(active, ry, y));
+		vst1q_f32(vz + i, Select(active, rz, z));
+	}
+	GetScalarKernels()->reflectResponse3(vx + i, vy + i, vz + i, nx + i, ny + i, nz + i, mask != nullptr ? mask + i : nullptr, restitution, friction, normalize, n - i);
+}
+
+static void ScaleAdd(const float* a, const float* b, float scale, float* out, size_t n) {
+	float32x4_t s = vdupq_n_f32(scale);
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		vst1q_f32(out + i, vaddq_f32(vld1q_f32(a + i), vmulq_f32(vld1q_f32(b + i), s)));
+	}
+	GetScalarKernels()->scaleAdd(a + i, b + i, scale, out + i, n - i);
+}
+
+static void MulAdd(const float* a, const float* b, const float* c, float* out, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		vst1q_f32(out + i, vaddq_f32(vmulq_f32(vld1q_f32(a + i), vld1q_f32(b + i)), vld1q_f32(c + i)));
+	}
+	GetScalarKernels()->mulAdd(a + i, b + i, c + i, out + i, n - i);
+}
+
+static void LerpClamp(const float* a, const float* b, float t, float minVal, float maxVal, float* out, size_t n) {
+	float32x4_t weight = vdupq_n_f32(t);
+	float32x4_t lo = vdupq_n_f32(minVal);
+	float32x4_t hi = vdupq_n_f32(maxVal);
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		float32x4_t va = vld1q_f32(a + i);
+		float32x4_t v = vaddq_f32(va, vmulq_f32(weight, vsubq_f32(vld1q_f32(b + i), va)));
+		float32x4_t r = Select(vcltq_f32(v, lo), lo, v);
+		vst1q_f32(out + i, Select(vcgtq_f32(v, hi), hi, r));
+	}
+	GetScalarKernels()->lerpClamp(a + i, b + i, t, minVal, maxVal, out + i, n - i);
+}
+
+//Lanes longer than maxLength scale to maxLength, lanes shorter than minLength
+//to minLength (maxLength wins if they overlap), zero length lanes become zero
+static inline float32x4_t RangeTarget(float32x4_t m, float32x4_t minLen, float32x4_t maxLen, uint32x4_t& change) {
+	uint32x4_t tooLong = vcgtq_f32(m, maxLen);
+	uint32x4_t tooShort = vcltq_f32(m, minLen);
+	change = vorrq_u32(tooLong, tooShort);
+	return Select(tooLong, maxLen, minLen);
+}
+
+static void ClampMagnitudeRange2(const float* x, const float* y, float minLength, float maxLength, float* outX, float* outY, size_t n) {
+	float32x4_t eps = vdupq_n_f32(kEpsilon);
+	float32x4_t minLen = vdupq_n_f32(minLength);
+	float32x4_t maxLen = vdupq_n_f32(maxLength);
+	float32x4_t zeroes = vdupq_n_f32(0.0f);
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		float32x4_t vx = vld1q_f32(x + i);
+		float32x4_t vy = vld1q_f32(y + i);
+		float32x4_t m = vsqrtq_f32(vaddq_f32(vmulq_f32(vx, vx), vmulq_f32(vy, vy)));
+		uint32x4_t change;
+		float32x4_t target = RangeTarget(m, minLen, maxLen, change);
+		uint32x4_t zeroLength = vcltq_f32(m, eps);
+		float32x4_t rx = Select(change, vmulq_f32(vdivq_f32(vx, m), target), vx);
+		float32x4_t ry = Select(change, vmulq_f32(vdivq_f32(vy, m), target), vy);
+		vst1q_f32(outX + i, Select(zeroLength, zeroes, rx));
+		vst1q_f32(outY + i, Select(zeroLength, zeroes, ry));
+	}
+	GetScalarKernels()->clampMagnitudeRange2(x + i, y + i, minLength, maxLength, outX + i, outY + i, n - i);
+}
+
+static void ClampMagnitudeRange3(const float* x, const float* y, const float* z, float minLength, float maxLength, float* outX, float* outY, float* outZ, size_t n) {
+	float32x4_t eps = vdupq_n_f32(kEpsilon);
+	float32x4_t minLen = vdupq_n_f32(minLength);
+	float32x4_t maxLen = vdupq_n_f32(maxLength);
+	float32x4_t zeroes = vdupq_n_f32(0.0f);
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		float32x4_t vx = vld1q_f32(x + i);
+		float32x4_t vy = vld1q_f32(y + i);
+		float32x4_t vz = vld1q_f32(z + i);
+		float32x4_t m = vsqrtq_f32(vaddq_f32(vaddq_f32(vmulq_f32(vx, vx), vmulq_f32(vy, vy)), vmulq_f32(vz, vz)));
+		uint32x4_t change;
+		float32x4_t target = RangeTarget(m, minLen, maxLen, change);
+		uint32x4_t zeroLength = vcltq_f32(m, eps);
+		float32x4_t rx = Select(change, vmulq_f32(vdivq_f32(vx, m), target), vx);
+		float32x4_t ry = Select(change, vmulq_f32(vdivq_f32(vy, m), target), vy);
+		float32x4_t rz = Select(change, vmulq_f32(vdivq_f32(vz, m), target), vz);
+		vst1q_f32(outX + i, Select(zeroLength, zeroes, rx));
+		vst1q_f32(outY + i, Select(zeroLength, zeroes, ry));
+		vst1q_f32(outZ + i, Select(zeroLength, zeroes, rz));
+	}
+	GetScalarKernels()->clampMagnitudeRange3(x + i, y + i, z + i, minLength, maxLength, outX + i, outY + i, outZ + i, n - i);
+}
+
+//AArch64 always has the half conversions, round to nearest even like
+//vmath::HalfFromFloat
+static void FloatToHalf(const float* in, uint16_t* out, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		vst1_u16(out + i, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(in + i))));
+	}
+	GetScalarKernels()->floatToHalf(in + i, out + i, n - i);
+}
+
+static void HalfToFloat(const uint16_t* in, float* out, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		vst1q_f32(out + i, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(in + i))));
+	}
+	GetScalarKernels()->halfToFloat(in + i, out + i, n - i);
+}
+
+//Round to nearest even on the top 16 bits; NaN only gets its quiet bit set
+static void FloatToBFloat16(const float* in, uint16_t* out, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		uint32x4_t bits = vreinterpretq_u32_f32(vld1q_f32(in + i));
+		uint32x4_t lsb = vandq_u32(vshrq_n_u32(bits, 16), vdupq_n_u32(1));
+		uint32x4_t rounded = vaddq_u32(bits, vaddq_u32(vdupq_n_u32(0x7fff), lsb));
+		uint32x4_t nan = vcgtq_u32(vandq_u32(bits, vdupq_n_u32(0x7fffffff)), vdupq_n_u32(0x7f800000));
+		uint32x4_t quiet = vorrq_u32(bits, vdupq_n_u32(0x00400000));
+		vst1_u16(out + i, vshrn_n_u32(vbslq_u32(nan, quiet, rounded), 16));
+	}
+	GetScalarKernels()->floatToBFloat16(in + i, out + i, n - i);
+}
+
+static void BFloat16ToFloat(const uint16_t* in, float* out, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		vst1q_f32(out + i, vreinterpretq_f32_u32(vshll_n_u16(vld1_u16(in + i), 16)));
+	}
+	GetScalarKernels()->bfloat16ToFloat(in + i, out + i, n - i);
+}
+
+//Packed 4-float elements (Vec4 / Vec3A): vld4q splits four elements into
+//x / y / z / w registers and vst4q interleaves them back
+static inline float32x4_t SquaredLength4(float32x4x4_t v, int components) {
+	float32x4_t sq = vaddq_f32(vaddq_f32(vmulq_f32(v.val[0], v.val[0]), vmulq_f32(v.val[1], v.val[1])), vmulq_f32(v.val[2], v.val[2]));
+	return components == 4 ? vaddq_f32(sq, vmulq_f32(v.val[3], v.val[3])) : sq;
+}
+
+static void Dot4(const float* a, const float* b, int components, float* out, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		float32x4x4_t va = vld4q_f32(a + i * 4);
+		float32x4x4_t vb = vld4q_f32(b + i * 4);
+		float32x4_t d = vaddq_f32(vaddq_f32(vmulq_f32(va.val[0], vb.val[0]), vmulq_f32(va.val[1], vb.val[1])), vmulq_f32(va.val[2], vb.val[2]));
+		if (components == 4) {
+			d = vaddq_f32(d, vmulq_f32(va.val[3], vb.val[3]));
+		}
+		vst1q_f32(out + i, d);
+	}
+	GetScalarKernels()->dot4(a + i * 4, b + i * 4, components, out + i, n - i);
+}
+
+static void Magnitude4(const float* v, int components, float* out, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		vst1q_f32(out + i, vsqrtq_f32(SquaredLength4(vld4q_f32(v + i * 4), components)));
+	}
+	GetScalarKernels()->magnitude4(v + i * 4, components, out + i, n - i);
+}
+
+static void Normalize4(const float* v, int components, float* out, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		float32x4x4_t e = vld4q_f32(v + i * 4);
+		float32x4_t m = vsqrtq_f32(SquaredLength4(e, components));
+		e.val[0] = SafeDivide(e.val[0], m);
+		e.val[1] = SafeDivide(e.val[1], m);
+		e.val[2] = SafeDivide(e.val[2], m);
+		e.val[3] = components == 4 ? SafeDivide(e.val[3], m) : vdupq_n_f32(0.0f);
+		vst4q_f32(out + i * 4, e);
+	}
+	GetScalarKernels()->normalize4(v + i * 4, components, out + i * 4, n - i);
+}
+
+static void Cross3A(const float* a, const float* b, float* out, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		float32x4x4_t va = vld4q_f32(a + i * 4);
+		float32x4x4_t vb = vld4q_f32(b + i * 4);
+		float32x4x4_t c;
+		c.val[0] = vsubq_f32(vmulq_f32(va.val[1], vb.val[2]), vmulq_f32(va.val[2], vb.val[1]));
+		c.val[1] = vsubq_f32(vmulq_f32(va.val[2], vb.val[0]), vmulq_f32(va.val[0], vb.val[2]));
+		c.val[2] = vsubq_f32(vmulq_f32(va.val[0], vb.val[1]), vmulq_f32(va.val[1], vb.val[0]));
+		c.val[3] = vdupq_n_f32(0.0f);
+		vst4q_f32(out + i * 4, c);
+	}
+	GetScalarKernels()->cross3A(a + i * 4, b + i * 4, out + i * 4, n - i);
+}
+
+//Reductions: the kReduceLanes accumulators live in six registers for the
+//whole call, one group of 24 floats per iteration
+static void Sum(const float* in, float* lanes, size_t n) {
+	float32x4_t acc[6];
+	for (int r = 0; r < 6; ++r) {
+		acc[r] = vld1q_f32(lanes + r * 4);
+	}
+	size_t i = 0;
+	for (; i + kReduceLanes <= n; i += kReduceLanes) {
+		for (int r = 0; r < 6; ++r) {
+			acc[r] = vaddq_f32(acc[r], vld1q_f32(in + i + r * 4));
+		}
+	}
+	for (int r = 0; r < 6; ++r) {
+		vst1q_f32(lanes + r * 4, acc[r]);
+	}
+	GetScalarKernels()->sum(in + i, lanes, n - i);
+}
+
+static void SumKahan(const float* in, float* lanes, float* compensation, size_t n) {
+	float32x4_t acc[6];
+	float32x4_t comp[6];
+	for (int r = 0; r < 6; ++r) {
+		acc[r] = vld1q_f32(lanes + r * 4);
+		comp[r] = vld1q_f32(compensation + r * 4);
+	}
+	size_t i = 0;
+	for (; i + kReduceLanes <= n; i += kReduceLanes) {
+		for (int r = 0; r < 6; ++r) {
+			float32x4_t y = vsubq_f32(vld1q_f32(in + i + r * 4), comp[r]);
+			float32x4_t t = vaddq_f32(acc[r], y);
+			comp[r] = vsubq_f32(vsubq_f32(t, acc[r]), y);
+			acc[r] = t;
+		}
+	}
+	for (int r = 0; r < 6; ++r) {
+		vst1q_f32(lanes + r * 4, acc[r]);
+		vst1q_f32(compensation + r * 4, comp[r]);
+	}
+	GetScalarKernels()->sumKahan(in + i, lanes, compensation, n - i);
+}
+
+static void DotSum(const float* a, const float* b, float* lanes, size_t n) {
+	float32x4_t acc[6];
+	for (int r = 0; r < 6; ++r) {
+		acc[r] = vld1q_f32(lanes + r * 4);
+	}
+	size_t i = 0;
+	for (; i + kReduceLanes <= n; i += kReduceLanes) {
+		for (int r = 0; r < 6; ++r) {
+			acc[r] = vaddq_f32(acc[r], vmulq_f32(vld1q_f32(a + i + r * 4), vld1q_f32(b + i + r * 4)));
+		}
+	}
+	for (int r = 0; r < 6; ++r) {
+		vst1q_f32(lanes + r * 4, acc[r]);
+	}
+	GetScalarKernels()->dotSum(a + i, b + i, lanes, n - i);
+}
+
+//vminq would return NaN for a NaN input, so select like the scalar x < m ? x : m
+static void MinMax(const float* in, float* minLanes, float* maxLanes, size_t n) {
+	float32x4_t lo[6];
+	float32x4_t hi[6];
+	for (int r = 0; r < 6; ++r) {
+		lo[r] = vld1q_f32(minLanes + r * 4);
+		hi[r] = vld1q_f32(maxLanes + r * 4);
+	}
+	size_t i = 0;
+	for (; i + kReduceLanes <= n; i += kReduceLanes) {
+		for (int r = 0; r < 6; ++r) {
+			float32x4_t x = vld1q_f32(in + i + r * 4);
+			lo[r] = Select(vcltq_f32(x, lo[r]), x, lo[r]);
+			hi[r] = Select(vcgtq_f32(x, hi[r]), x, hi[r]);
+		}
+	}
+	for (int r = 0; r < 6; ++r) {
+		vst1q_f32(minLanes + r * 4, lo[r]);
+		vst1q_f32(maxLanes + r * 4, hi[r]);
+	}
+	GetScalarKernels()->minMax(in + i, minLanes, maxLanes, n - i);
+}
+
+static void MinMaxIndex(const float* in, uint32_t first, float* minLanes, uint32_t* minIndex, float* maxLanes, uint32_t* maxIndex, size_t n) {
+	static const uint32_t kOffsets[4] = { 0, 1, 2, 3 };
+	float32x4_t lo[6];
+	float32x4_t hi[6];
+	uint32x4_t loIndex[6];
+	uint32x4_t hiIndex[6];
+	uint32x4_t index[6];
+	for (int r = 0; r < 6; ++r) {
+		lo[r] = vld1q_f32(minLanes + r * 4);
+		hi[r] = vld1q_f32(maxLanes + r * 4);
+		loIndex[r] = vld1q_u32(minIndex + r * 4);
+		hiIndex[r] = vld1q_u32(maxIndex + r * 4);
+		index[r] = vaddq_u32(vdupq_n_u32(first + (uint32_t)r * 4), vld1q_u32(kOffsets));
+	}
+	uint32x4_t step = vdupq_n_u32((uint32_t)kReduceLanes);
+	size_t i = 0;
+	for (; i + kReduceLanes <= n; i += kReduceLanes) {
+		for (int r = 0; r < 6; ++r) {
+			float32x4_t x = vld1q_f32(in + i + r * 4);
+			uint32x4_t less = vcltq_f32(x, lo[r]);
+			uint32x4_t greater = vcgtq_f32(x, hi[r]);
+			lo[r] = Select(less, x, lo[r]);
+			hi[r] = Select(greater, x, hi[r]);
+			loIndex[r] = vbslq_u32(less, index[r], loIndex[r]);
+			hiIndex[r] = vbslq_u32(greater, index[r], hiIndex[r]);
+			index[r] = vaddq_u32(index[r], step);
+		}
+	}
+	for (int r = 0; r < 6; ++r) {
+		vst1q_f32(minLanes + r * 4, lo[r]);
+		vst1q_f32(maxLanes + r * 4, hi[r]);
+		vst1q_u32(minIndex + r * 4, loIndex[r]);
+		vst1q_u32(maxIndex + r * 4, hiIndex[r]);
+	}
+	GetScalarKernels()->minMaxIndex(in + i, first + (uint32_t)i, minLanes, minIndex, maxLanes, maxIndex, n - i);
+}
+
+static void DotPacked2(const float* a, const float* b, float* out, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		float32x4x2_t va = vld2q_f32(a + i * 2);
+		float32x4x2_t vb = vld2q_f32(b + i * 2);
+		vst1q_f32(out + i, vaddq_f32(vmulq_f32(va.val[0], vb.val[0]), vmulq_f32(va.val[1], vb.val[1])));
+	}
+	GetScalarKernels()->dotPacked2(a + i * 2, b + i * 2, out + i, n - i);
+}
+
+static void DotPacked3(const float* a, const float* b, float* out, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		float32x4x3_t va = vld3q_f32(a + i * 3);
+		float32x4x3_t vb = vld3q_f32(b + i * 3);
+		float32x4_t xy = vaddq_f32(vmulq_f32(va.val[0], vb.val[0]), vmulq_f32(va.val[1], vb.val[1]));
+		vst1q_f32(out + i, vaddq_f32(xy, vmulq_f32(va.val[2], vb.val[2])));
+	}
+	GetScalarKernels()->dotPacked3(a + i * 3, b + i * 3, out + i, n - i);
+}
+
+static inline void BezierWeights(float32x4_t u, float32x4_t& w0, float32x4_t& w1, float32x4_t& w2, float32x4_t& w3) {
+	float32x4_t three = vdupq_n_f32(3.0f);
+	float32x4_t s = vsubq_f32(vdupq_n_f32(1.0f), u);
+	float32x4_t s2 = vmulq_f32(s, s);
+	float32x4_t u2 = vmulq_f32(u, u);
+	w0 = vmulq_f32(s2, s);
+	w1 = vmulq_f32(vmulq_f32(three, s2), u);
+	w2 = vmulq_f32(vmulq_f32(three, s), u2);
+	w3 = vmulq_f32(u2, u);
+}
+
+//One component of the segment from its four broadcast control values
+static inline float32x4_t BezierSum(float32x4_t w0, float32x4_t w1, float32x4_t w2, float32x4_t w3, const float32x4_t* c) {
+	return vaddq_f32(vaddq_f32(vaddq_f32(vmulq_f32(w0, c[0]), vmulq_f32(w1, c[1])), vmulq_f32(w2, c[2])), vmulq_f32(w3, c[3]));
+}
+
+static void Bezier2(const float* controls, const float* u, float* out, size_t n) {
+	float32x4_t cx[4], cy[4];
+	for (int k = 0; k < 4; ++k) {
+		cx[k] = vdupq_n_f32(controls[k * 2]);
+		cy[k] = vdupq_n_f32(controls[k * 2 + 1]);
+	}
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		float32x4_t w0, w1, w2, w3;
+		BezierWeights(vld1q_f32(u + i), w0, w1, w2, w3);
+		float32x4x2_t r;
+		r.val[0] = BezierSum(w0, w1, w2, w3, cx);
+		r.val[1] = BezierSum(w0, w1, w2, w3, cy);
+		vst2q_f32(out + i * 2, r);
+	}
+	GetScalarKernels()->bezier2(controls, u + i, out + i * 2, n - i);
+}
+
+static void Bezier3(const float* controls, const float* u, float* out, size_t n) {
+	float32x4_t cx[4], cy[4], cz[4];
+	for (int k = 0; k < 4; ++k) {
+		cx[k] = vdupq_n_f32(controls[k * 3]);
+		cy[k] = vdupq_n_f32(controls[k * 3 + 1]);
+		cz[k] = vdupq_n_f32(controls[k * 3 + 2]);
+	}
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		float32x4_t w0, w1, w2, w3;
+		BezierWeights(vld1q_f32(u + i), w0, w1, w2, w3);
+		float32x4x3_t r;
+		r.val[0] = BezierSum(w0, w1, w2, w3, cx);
+		r.val[1] = BezierSum(w0, w1, w2, w3, cy);
+		r.val[2] = BezierSum(w0, w1, w2, w3, cz);
+		vst3q_f32(out + i * 3, r);
+	}
+	GetScalarKernels()->bezier3(controls, u + i, out + i * 3, n - i);
+}
+
+static const VectorKernels kNeonKernels = {
+	"NEON",
+	Add, Subtract, Scale, Clamp,
+	Dot2, Dot3,
+	Magnitude2, Magnitude3,
+	Normalize2, Normalize3,
+	NormalizeFast2, NormalizeFast3,
+	Reflect2, Reflect3,
+	ClampMagnitude2, ClampMagnitude3,
+	Transform3,
+	IntegrateEuler, IntegrateVerlet,
+	ReflectResponse2, ReflectResponse3,
+	ScaleAdd, MulAdd, LerpClamp,
+	ClampMagnitudeRange2, ClampMagnitudeRange3,
+	FloatToHalf, HalfToFloat, FloatToBFloat16, BFloat16ToFloat,
+	Dot4, Magnitude4, Normalize4, Cross3A,
+	Sum, SumKahan, DotSum, MinMax, MinMaxIndex,
+	DotPacked2, DotPacked3,
+	Bezier2, Bezier3
+};
+
+const VectorKernels* GetNeonKernels() {
+	return &kNeonKernels;
+}
+
+#else
+
+const VectorKernels* GetNeonKernels() {
+	return nullptr;
+}
+
+#endif
@@ -0,0 +1,513 @@
+//Always include the pch.h first in every cpp
+#include "pch.h"
+
+//Then include own items
+#include "VectorMathKernels.h"
+#include "VectorMathInline.h"
+#include "VectorMathHalf.h"
+#include <cmath>
+
+//Portable kernels. These define the reference results for every other
+//instruction set and must keep the exact operation order of VectorMath.cpp.
+
+static const float kEpsilon = 0.0001f;
+
+static void Add(const float* a, const float* b, float* out, size_t n) {
+	for (size_t i = 0; i < n; ++i) {
+		out[i] = a[i] + b[i];
+	}
+}
+
+static void Subtract(const float* a, const float* b, float* out, size_t n) {
+	for (size_t i = 0; i < n; ++i) {
+		out[i] = a[i] - b[i];
+	}
+}
+
+static void Scale(const float* v, float scale, float* out, size_t n) {
+	for (size_t i = 0; i < n; ++i) {
+		out[i] = scale * v[i];
+	}
+}
+
+static void Clamp(const float* v, float minVal, float maxVal, float* out, size_t n) {
+	for (size_t i = 0; i < n; ++i) {
+		float c = v[i];
+		c = v[i] < minVal ? minVal : c;
+		c = v[i] > maxVal ? maxVal : c;
+		out[i] = c;
+	}
+}
+
+static void Dot2(const float* ax, const float* ay, const float* bx, const float* by, float* out, size_t n) {
+	for (size_t i = 0; i < n; ++i) {
+		out[i] = ax[i] * bx[i] + ay[i] * by[i];
+	}
+}
+
+static void Dot3(const float* ax, const float* ay, const float* az, const float* bx, const float* by, const float* bz, float* out, size_t n) {
+	for (size_t i = 0; i < n; ++i) {
+		out[i] = ax[i] * bx[i] + ay[i] * by[i] + az[i] * bz[i];
+	}
+}
+
+static void Magnitude2(const float* x, const float* y, float* out, size_t n) {
+	for (size_t i = 0; i < n; ++i) {
+		out[i] = vmath::Sqrt(x[i] * x[i] + y[i] * y[i]);
+	}
+}
+
+static void Magnitude3(const float* x, const float* y, const float* z, float* out, size_t n) {
+	for (size_t i = 0; i < n; ++i) {
+		out[i] = vmath::Sqrt(x[i] * x[i] + y[i] * y[i] + z[i] * z[i]);
+	}
+}
+
+static void Normalize2(const float* x, const float* y, float* outX, float* outY, size_t n) {
+	for (size_t i = 0; i < n; ++i) {
+		float vx = x[i];
+		float vy = y[i];
+		float m = vmath::Sqrt(vx * vx + vy * vy);
+		bool zero = m < kEpsilon;
+		outX[i] = zero ? 0.0f : vx / m;
+		outY[i] = zero ? 0.0f : vy / m;
+	}
+}
+
+static void Normalize3(const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ, size_t n) {
+	for (size_t i = 0; i < n; ++i) {
+		float vx = x[i];
+		float vy = y[i];
+		float vz = z[i];
+		float m = vmath::Sqrt(vx * vx + vy * vy + vz * vz);
+		bool zero = m < kEpsilon;
+		outX[i] = zero ? 0.0f : vx / m;
+		outY[i] = zero ? 0.0f : vy / m;
+		outZ[i] = zero ? 0.0f : vz / m;
+	}
+}
+
+static void NormalizeFast2(const float* x, const float* y, float* outX, float* outY, size_t n) {
+	for (size_t i = 0; i < n; ++i) {
+		vmath::Vec2T<float> v = vmath::NormalizeFast(vmath::Vec2T<float>{ x[i], y[i] });
+		outX[i] = v.x;
+		outY[i] = v.y;
+	}
+}
+
+static void NormalizeFast3(const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ, size_t n) {
+	for (size_t i = 0; i < n; ++i) {
+		vmath::Vec3T<float> v = vmath::NormalizeFast(vmath::Vec3T<float>{ x[i], y[i], z[i] });
+		outX[i] = v.x;
+		outY[i] = v.y;
+		outZ[i] = v.z;
+	}
+}
+
+static void Reflect2(const float* vx, const float* vy, const float* nx, const float* ny, float* outX, float* outY, size_t n) {
+	for (size_t i = 0; i < n; ++i) {
+		float x = vx[i];
+		float y = vy[i];
+		float normalX = nx[i];
+		float normalY = ny[i];
+		float m = vmath::Sqrt(normalX * normalX + normalY * normalY);
+		bool zero = m < kEpsilon;
+		normalX = zero ? 0.0f : normalX / m;
+		normalY = zero ? 0.0f : normalY / m;
+		float d = 2.0f * (x * normalX + y * normalY);
+		outX[i] = x - d * normalX;
+		outY[i] = y - d * normalY;
+	}
+}
+
+static void Reflect3(const float* vx, const float* vy, const float* vz, const float* nx, const float* ny, const float* nz, float* outX, float* outY, float* outZ, size_t n) {
+	for (size_t i = 0; i < n; ++i) {
+		float x = vx[i];
+		float y = vy[i];
+		float z = vz[i];
+		float normalX = nx[i];
+		float normalY = ny[i];
+		float normalZ = nz[i];
+		float m = vmath::Sqrt(normalX * normalX + normalY * normalY + normalZ * normalZ);
+		bool zero = m < kEpsilon;
+		normalX = zero ? 0.0f : normalX / m;
+		normalY = zero ? 0.0f : normalY / m;
+		normalZ = zero ? 0.0f : normalZ / m;
+		float d = 2.0f * (x * normalX + y * normalY + z * normalZ);
+		outX[i] = x - d * normalX;
+		outY[i] = y - d * normalY;
+		outZ[i] = z - d * normalZ;
+	}
+}
+
+static void ClampMagnitude2(const float* x, const float* y, float maxLength, float* outX, float* outY, size_t n) {
+	for (size_t i = 0; i < n; ++i) {
+		float vx = x[i];
+		float vy = y[i];
+		float m = vmath::Sqrt(vx * vx + vy * vy);
+		if (m < kEpsilon) {
+			vx = 0.0f;
+			vy = 0.0f;
+		}
+		else if (m > maxLength) {
+			vx = (vx / m) * maxLength;
+			vy = (vy / m) * maxLength;
+		}
+		outX[i] = vx;
+		outY[i] = vy;
+	}
+}
+
+static void ClampMagnitude3(const float* x, const float* y, const float* z, float maxLength, float* outX, float* outY, float* outZ, size_t n) {
+	for (size_t i = 0; i < n; ++i) {
+		float vx = x[i];
+		float vy = y[i];
+		float vz = z[i];
+		float m = vmath::Sqrt(vx * vx + vy * vy + vz * vz);
+		if (m < kEpsilon) {
+			vx = 0.0f;
+			vy = 0.0f;
+			vz = 0.0f;
+		}
+		else if (m > maxLength) {
+			vx = (vx / m) * maxLength;
+			vy = (vy / m) * maxLength;
+			vz = (vz / m) * maxLength;
+		}
+		outX[i] = vx;
+		outY[i] = vy;
+		outZ[i] = vz;
+	}
+}
+
+static void Transform3(const float* m, float w, const float* in, float* out, size_t n) {
+	for (size_t i = 0; i < n; ++i) {
+		float x = in[i * 3];
+		float y = in[i * 3 + 1];
+		float z = in[i * 3 + 2];
+		out[i * 3] = m[0] * x + m[4] * y + m[8] * z + m[12] * w;
+		out[i * 3 + 1] = m[1] * x + m[5] * y + m[9] * z + m[13] * w;
+		out[i * 3 + 2] = m[2] * x + m[6] * y + m[10] * z + m[14] * w;
+	}
+}
+
+static void IntegrateEuler(float* p, float* v, const float* a, float dt, size_t n) {
+	for (size_t i = 0; i < n; ++i) {
+		float acc = a != nullptr ? a[i] : 0.0f;
+		float vel = v[i] + acc * dt;
+		v[i] = vel;
+		p[i] = p[i] + vel * dt;
+	}
+}
+
+static void IntegrateVerlet(float* p, float* prev, const float* a, float dt, size_t n) {
+	float dt2 = dt * dt;
+	for (size_t i = 0; i < n; ++i) {
+		float acc = a != nullptr ? a[i] : 0.0f;
+		float current = p[i];
+		p[i] = current + (current - prev[i]) + acc * dt2;
+		prev[i] = current;
+	}
+}
+
+static void ReflectResponse2(float* vx, float* vy, const float* nx, const float* ny, const unsigned char* mask, float restitution, float friction, int normalize, size_t n) {
+	for (size_t i = 0; i < n; ++i) {
+		if (mask != nullptr && mask[i] == 0) {
+			continue;
+		}
+		vmath::Vec2T<float> normal = { nx[i], ny[i] };
+		if (normalize) {
+			float m = vmath::Sqrt(normal.x * normal.x + normal.y * normal.y);
+			if (m < kEpsilon) {
+				continue;
+			}
+			normal = { normal.x / m, normal.y / m };
+		}
+		vmath::Vec2T<float> v = vmath::ReflectResponse(vmath::Vec2T<float>{ vx[i], vy[i] }, normal, restitution, friction);
+		vx[i] = v.x;
+		vy[i] = v.y;
+	}
+}
+
+static void ReflectResponse3(float* vx, float* vy, float* vz, const float* nx, const float* ny, const float* nz, const unsigned char* mask, float restitution, float friction, int normalize, size_t n) {
+	for (size_t i = 0; i < n; ++i) {
+		if (mask != nullptr && mask[i] == 0) {
+			continue;
+		}
+		vmath::Vec3T<float> normal = { nx[i], ny[i], nz[i] };
+		if (normalize) {
+			float m = vmath::Sqrt(normal.x * normal.x + normal.y * normal.y + normal.z * normal.z);
+			if (m < kEpsilon) {
+				continue;
+			}
+			normal = { normal.x / m, normal.y / m, normal.z / m };
+		}
+		vmath::Vec3T<float> v = vmath::ReflectResponse(vmath::Vec3T<float>{ vx[i], vy[i], vz[i] }, normal, restitution, friction);
+		vx[i] = v.x;
+		vy[i] = v.y;
+		vz[i] = v.z;
+	}
+}
+
+//Fused operations: one pass, each result rounded exactly like the separate
+//operations (multiply, then add)
+static void ScaleAdd(const float* a, const float* b, float scale, float* out, size_t n) {
+	for (size_t i = 0; i < n; ++i) {
+		out[i] = a[i] + b[i] * scale;
+	}
+}
+
+static void MulAdd(const float* a, const float* b, const float* c, float* out, size_t n) {
+	for (size_t i = 0; i < n; ++i) {
+		out[i] = a[i] * b[i] + c[i];
+	}
+}
+
+static void LerpClamp(const float* a, const float* b, float t, float minVal, float maxVal, float* out, size_t n) {
+	for (size_t i = 0; i < n; ++i) {
+		float v = a[i] + t * (b[i] - a[i]);
+		float c = v < minVal ? minVal : v;
+		out[i] = v > maxVal ? maxVal : c;
+	}
+}
+
+static void ClampMagnitudeRange2(const float* x, const float* y, float minLength, float maxLength, float* outX, float* outY, size_t n) {
+	for (size_t i = 0; i < n; ++i) {
+		float vx = x[i];
+		float vy = y[i];
+		float m = vmath::Sqrt(vx * vx + vy * vy);
+		if (m < kEpsilon) {
+			vx = 0.0f;
+			vy = 0.0f;
+		}
+		else if (m > maxLength) {
+			vx = (vx / m) * maxLength;
+			vy = (vy / m) * maxLength;
+		}
+		else if (m < minLength) {
+			vx = (vx / m) * minLength;
+			vy = (vy / m) * minLength;
+		}
+		outX[i] = vx;
+		outY[i] = vy;
+	}
+}
+
+static void ClampMagnitudeRange3(const float* x, const float* y, const float* z, float minLength, float maxLength, float* outX, float* outY, float* outZ, size_t n) {
+	for (size_t i = 0; i < n; ++i) {
+		float vx = x[i];
+		float vy = y[i];
+		float vz = z[i];
+		float m = vmath::Sqrt(vx * vx + vy * vy + vz * vz);
+		if (m < kEpsilon) {
+			vx = 0.0f;
+			vy = 0.0f;
+			vz = 0.0f;
+		}
+		else if (m > maxLength) {
+			vx = (vx / m) * maxLength;
+			vy = (vy / m) * maxLength;
+			vz = (vz / m) * maxLength;
+		}
+		else if (m < minLength) {
+			vx = (vx / m) * minLength;
+			vy = (vy / m) * minLength;
+			vz = (vz / m) * minLength;
+		}
+		outX[i] = vx;
+		outY[i] = vy;
+		outZ[i] = vz;
+	}
+}
+
+//Precision conversion, one value at a time through VectorMathHalf.h
+static void FloatToHalf(const float* in, uint16_t* out, size_t n) {
+	for (size_t i = 0; i < n; ++i) {
+		out[i] = vmath::HalfFromFloat(in[i]).bits;
+	}
+}
+
+static void HalfToFloat(const uint16_t* in, float* out, size_t n) {
+	for (size_t i = 0; i < n; ++i) {
+		out[i] = vmath::HalfToFloat(vmath::Half{ in[i] });
+	}
+}
+
+static void FloatToBFloat16(const float* in, uint16_t* out, size_t n) {
+	for (size_t i = 0; i < n; ++i) {
+		out[i] = vmath::BFloat16FromFloat(in[i]).bits;
+	}
+}
+
+static void BFloat16ToFloat(const uint16_t* in, float* out, size_t n) {
+	for (size_t i = 0; i < n; ++i) {
+		out[i] = vmath::BFloat16ToFloat(vmath::BFloat16{ in[i] });
+	}
+}
+
+//Packed 4-float elements (Vec4 / Vec3A)
+static void Dot4(const float* a, const float* b, int components, float* out, size_t n) {
+	for (size_t i = 0; i < n; ++i, a += 4, b += 4) {
+		float d = a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+		out[i] = components == 4 ? d + a[3] * b[3] : d;
+	}
+}
+
+static void Magnitude4(const float* v, int components, float* out, size_t n) {
+	for (size_t i = 0; i < n; ++i, v += 4) {
+		float sq = v[0] * v[0] + v[1] * v[1] + v[2] * v[2];
+		out[i] = vmath::Sqrt(components == 4 ? sq + v[3] * v[3] : sq);
+	}
+}
+
+static void Normalize4(const float* v, int components, float* out, size_t n) {
+	for (size_t i = 0; i < n; ++i, v += 4, out += 4) {
+		float vx = v[0];
+		float vy = v[1];
+		float vz = v[2];
+		float vw = components == 4 ? v[3] : 0.0f;
+		float m = vmath::Sqrt(components == 4 ? vx * vx + vy * vy + vz * vz + vw * vw : vx * vx + vy * vy + vz * vz);
+		bool zero = m < kEpsilon;
+		out[0] = zero ? 0.0f : vx / m;
+		out[1] = zero ? 0.0f : vy / m;
+		out[2] = zero ? 0.0f : vz / m;
+		out[3] = zero ? 0.0f : vw / m;
+	}
+}
+
+static void Cross3A(const float* a, const float* b, float* out, size_t n) {
+	for (size_t i = 0; i < n; ++i, a += 4, b += 4, out += 4) {
+		vmath::Vec3T<float> c = vmath::Cross(vmath::Vec3T<float>{ a[0], a[1], a[2] }, vmath::Vec3T<float>{ b[0], b[1], b[2] });
+		out[0] = c.x;
+		out[1] = c.y;
+		out[2] = c.z;
+		out[3] = 0.0f;
+	}
+}
+
+//Reductions, one group of kReduceLanes floats at a time. Each call starts at
+//lane 0, so a SIMD kernel can hand its tail over from any whole group.
+static inline size_t GroupCount(size_t i, size_t n) {
+	return n - i < kReduceLanes ? n - i : kReduceLanes;
+}
+
+static void Sum(const float* in, float* lanes, size_t n) {
+	for (size_t i = 0; i < n; i += kReduceLanes) {
+		for (size_t lane = 0; lane < GroupCount(i, n); ++lane) {
+			lanes[lane] += in[i + lane];
+		}
+	}
+}
+
+static void SumKahan(const float* in, float* lanes, float* compensation, size_t n) {
+	for (size_t i = 0; i < n; i += kReduceLanes) {
+		for (size_t lane = 0; lane < GroupCount(i, n); ++lane) {
+			float y = in[i + lane] - compensation[lane];
+			float t = lanes[lane] + y;
+			compensation[lane] = (t - lanes[lane]) - y;
+			lanes[lane] = t;
+		}
+	}
+}
+
+static void DotSum(const float* a, const float* b, float* lanes, size_t n) {
+	for (size_t i = 0; i < n; i += kReduceLanes) {
+		for (size_t lane = 0; lane < GroupCount(i, n); ++lane) {
+			lanes[lane] += a[i + lane] * b[i + lane];
+		}
+	}
+}
+
+//x < m ? x : m keeps m when x is NaN, like the SSE / AVX min instructions
+static void MinMax(const float* in, float* minLanes, float* maxLanes, size_t n) {
+	for (size_t i = 0; i < n; i += kReduceLanes) {
+		for (size_t lane = 0; lane < GroupCount(i, n); ++lane) {
+			float x = in[i + lane];
+			minLanes[lane] = x < minLanes[lane] ? x : minLanes[lane];
+			maxLanes[lane] = x > maxLanes[lane] ? x : maxLanes[lane];
+		}
+	}
+}
+
+static void MinMaxIndex(const float* in, uint32_t first, float* minLanes, uint32_t* minIndex, float* maxLanes, uint32_t* maxIndex, size_t n) {
+	for (size_t i = 0; i < n; i += kReduceLanes) {
+		for (size_t lane = 0; lane < GroupCount(i, n); ++lane) {
+			float x = in[i + lane];
+			if (x < minLanes[lane]) {
+				minLanes[lane] = x;
+				minIndex[lane] = first + (uint32_t)(i + lane);
+			}
+			if (x > maxLanes[lane]) {
+				maxLanes[lane] = x;
+				maxIndex[lane] = first + (uint32_t)(i + lane);
+			}
+		}
+	}
+}
+
+static void DotPacked2(const float* a, const float* b, float* out, size_t n) {
+	for (size_t i = 0; i < n; ++i) {
+		out[i] = a[i * 2] * b[i * 2] + a[i * 2 + 1] * b[i * 2 + 1];
+	}
+}
+
+static void DotPacked3(const float* a, const float* b, float* out, size_t n) {
+	for (size_t i = 0; i < n; ++i) {
+		out[i] = a[i * 3] * b[i * 3] + a[i * 3 + 1] * b[i * 3 + 1] + a[i * 3 + 2] * b[i * 3 + 2];
+	}
+}
+
+//Bernstein weights (1 - u)^3, 3 (1 - u)^2 u, 3 (1 - u) u^2 and u^3
+static inline void BezierWeights(float u, float& w0, float& w1, float& w2, float& w3) {
+	float s = 1.0f - u;
+	float s2 = s * s;
+	float u2 = u * u;
+	w0 = s2 * s;
+	w1 = 3.0f * s2 * u;
+	w2 = 3.0f * s * u2;
+	w3 = u2 * u;
+}
+
+static void Bezier2(const float* c, const float* u, float* out, size_t n) {
+	for (size_t i = 0; i < n; ++i) {
+		float w0, w1, w2, w3;
+		BezierWeights(u[i], w0, w1, w2, w3);
+		out[i * 2] = w0 * c[0] + w1 * c[2] + w2 * c[4] + w3 * c[6];
+		out[i * 2 + 1] = w0 * c[1] + w1 * c[3] + w2 * c[5] + w3 * c[7];
+	}
+}
+
+static void Bezier3(const float* c, const float* u, float* out, size_t n) {
+	for (size_t i = 0; i < n; ++i) {
+		float w0, w1, w2, w3;
+		BezierWeights(u[i], w0, w1, w2, w3);
+		out[i * 3] = w0 * c[0] + w1 * c[3] + w2 * c[6] + w3 * c[9];
+		out[i * 3 + 1] = w0 * c[1] + w1 * c[4] + w2 * c[7] + w3 * c[10];
+		out[i * 3 + 2] = w0 * c[2] + w1 * c[5] + w2 * c[8] + w3 * c[11];
+	}
+}
+
+static const VectorKernels kScalarKernels = {
+	"Scalar",
+	Add, Subtract, Scale, Clamp,
+	Dot2, Dot3,
+	Magnitude2, Magnitude3,
+	Normalize2, Normalize3,
+	NormalizeFast2, NormalizeFast3,
+	Reflect2, Reflect3,
+	ClampMagnitude2, ClampMagnitude3,
+	Transform3,
+	IntegrateEuler, IntegrateVerlet,
+	ReflectResponse2, ReflectResponse3,
+	ScaleAdd, MulAdd, LerpClamp,
+	ClampMagnitudeRange2, ClampMagnitudeRange3,
+	FloatToHalf, HalfToFloat, FloatToBFloat16, BFloat16ToFloat,
+	Dot4, Magnitude4, Normalize4, Cross3A,
+	Sum, SumKahan, DotSum, MinMax, MinMaxIndex,
+	DotPacked2, DotPacked3,
+	Bezier2, Bezier3
+};
+
+const VectorKernels* GetScalarKernels() {
+	return &kScalarKernels;
+}
@@ -0,0 +1,847 @@
+//Always include the pch.h first in every cpp
+#include "pch.h"
+
+//Then include own items
+#include "VectorMathKernels.h"
+
+#ifdef VECTORMATH_X86
+
+#include <immintrin.h>
+#include <cstring>
+
+//4-wide SSE4.1 kernels. sqrt and divide are the IEEE correctly rounded
+//instructions and no FMA is used, so results match the scalar kernels.
+//Whatever does not fill a full register is finished by the scalar kernels.
+
+#define SSE41 VECTORMATH_TARGET("sse4.1")
+
+static const float kEpsilon = 0.0001f;
+
+//Returns v / m, or zero where m < kEpsilon (NaN magnitudes keep the divide,
+//exactly like the scalar "if (m < 0.0001f)" check).
+SSE41 static inline __m128 SafeDivide(__m128 v, __m128 m) {
+	__m128 keep = _mm_cmpnlt_ps(m, _mm_set1_ps(kEpsilon));
+	return _mm_and_ps(keep, _mm_div_ps(v, m));
+}
+
+SSE41 static void Add(const float* a, const float* b, float* out, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		_mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+	}
+	GetScalarKernels()->add(a + i, b + i, out + i, n - i);
+}
+
+SSE41 static void Subtract(const float* a, const float* b, float* out, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		_mm_storeu_ps(out + i, _mm_sub_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+	}
+	GetScalarKernels()->subtract(a + i, b + i, out + i, n - i);
+}
+
+SSE41 static void Scale(const float* v, float scale, float* out, size_t n) {
+	__m128 s = _mm_set1_ps(scale);
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		_mm_storeu_ps(out + i, _mm_mul_ps(s, _mm_loadu_ps(v + i)));
+	}
+	GetScalarKernels()->scale(v + i, scale, out + i, n - i);
+}
+
+SSE41 static void Clamp(const float* v, float minVal, float maxVal, float* out, size_t n) {
+	__m128 lo = _mm_set1_ps(minVal);
+	__m128 hi = _mm_set1_ps(maxVal);
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m128 c = _mm_loadu_ps(v + i);
+		__m128 r = _mm_blendv_ps(c, lo, _mm_cmplt_ps(c, lo));
+		r = _mm_blendv_ps(r, hi, _mm_cmpgt_ps(c, hi));
+		_mm_storeu_ps(out + i, r);
+	}
+	GetScalarKernels()->clamp(v + i, minVal, maxVal, out + i, n - i);
+}
+
+SSE41 static void Dot2(const float* ax, const float* ay, const float* bx, const float* by, float* out, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m128 x = _mm_mul_ps(_mm_loadu_ps(ax + i), _mm_loadu_ps(bx + i));
+		__m128 y = _mm_mul_ps(_mm_loadu_ps(ay + i), _mm_loadu_ps(by + i));
+		_mm_storeu_ps(out + i, _mm_add_ps(x, y));
+	}
+	GetScalarKernels()->dot2(ax + i, ay + i, bx + i, by + i, out + i, n - i);
+}
+
+SSE41 static void Dot3(const float* ax, const float* ay, const float* az, const float* bx, const float* by, const float* bz, float* out, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m128 x = _mm_mul_ps(_mm_loadu_ps(ax + i), _mm_loadu_ps(bx + i));
+		__m128 y = _mm_mul_ps(_mm_loadu_ps(ay + i), _mm_loadu_ps(by + i));
+		__m128 z = _mm_mul_ps(_mm_loadu_ps(az + i), _mm_loadu_ps(bz + i));
+		_mm_storeu_ps(out + i, _mm_add_ps(_mm_add_ps(x, y), z));
+	}
+	GetScalarKernels()->dot3(ax + i, ay + i, az + i, bx + i, by + i, bz + i, out + i, n - i);
+}
+
+SSE41 static void Magnitude2(const float* x, const float* y, float* out, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m128 vx = _mm_loadu_ps(x + i);
+		__m128 vy = _mm_loadu_ps(y + i);
+		__m128 sq = _mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy));
+		_mm_storeu_ps(out + i, _mm_sqrt_ps(sq));
+	}
+	GetScalarKernels()->magnitude2(x + i, y + i, out + i, n - i);
+}
+
+SSE41 static void Magnitude3(const float* x, const float* y, const float* z, float* out, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m128 vx = _mm_loadu_ps(x + i);
+		__m128 vy = _mm_loadu_ps(y + i);
+		__m128 vz = _mm_loadu_ps(z + i);
+		__m128 sq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)), _mm_mul_ps(vz, vz));
+		_mm_storeu_ps(out + i, _mm_sqrt_ps(sq));
+	}
+	GetScalarKernels()->magnitude3(x + i, y + i, z + i, out + i, n - i);
+}
+
+SSE41 static void Normalize2(const float* x, const float* y, float* outX, float* outY, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m128 vx = _mm_loadu_ps(x + i);
+		__m128 vy = _mm_loadu_ps(y + i);
+		__m128 m = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)));
+		_mm_storeu_ps(outX + i, SafeDivide(vx, m));
+		_mm_storeu_ps(outY + i, SafeDivide(vy, m));
+	}
+	GetScalarKernels()->normalize2(x + i, y + i, outX + i, outY + i, n - i);
+}
+
+SSE41 static void Normalize3(const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m128 vx = _mm_loadu_ps(x + i);
+		__m128 vy = _mm_loadu_ps(y + i);
+		__m128 vz = _mm_loadu_ps(z + i);
+		__m128 sq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)), _mm_mul_ps(vz, vz));
+		__m128 m = _mm_sqrt_ps(sq);
+		_mm_storeu_ps(outX + i, SafeDivide(vx, m));
+		_mm_storeu_ps(outY + i, SafeDivide(vy, m));
+		_mm_storeu_ps(outZ + i, SafeDivide(vz, m));
+	}
+	GetScalarKernels()->normalize3(x + i, y + i, z + i, outX + i, outY + i, outZ + i, n - i);
+}
+
+//rsqrt estimate plus one Newton-Raphson step, same order as
+//vmath::ReciprocalSqrtFast so every instruction set gives the same answer
+//(an exact 1 / sqrt in deterministic builds)
+SSE41 static inline __m128 ReciprocalSqrtFast(__m128 sq) {
+#if defined(VECTORMATH_DETERMINISTIC)
+	return _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(sq));
+#else
+	__m128 y = _mm_rsqrt_ps(sq);
+	__m128 halfSq = _mm_mul_ps(_mm_set1_ps(0.5f), sq);
+	return _mm_mul_ps(y, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(_mm_mul_ps(halfSq, y), y)));
+#endif
+}
+
+//Zero where the squared length is below kEpsilon squared
+SSE41 static inline __m128 FastScaleMask(__m128 sq) {
+	return _mm_cmpnlt_ps(sq, _mm_set1_ps(kEpsilon * kEpsilon));
+}
+
+SSE41 static void NormalizeFast2(const float* x, const float* y, float* outX, float* outY, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m128 vx = _mm_loadu_ps(x + i);
+		__m128 vy = _mm_loadu_ps(y + i);
+		__m128 sq = _mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy));
+		__m128 inv = _mm_and_ps(FastScaleMask(sq), ReciprocalSqrtFast(sq));
+		_mm_storeu_ps(outX + i, _mm_mul_ps(vx, inv));
+		_mm_storeu_ps(outY + i, _mm_mul_ps(vy, inv));
+	}
+	GetScalarKernels()->normalizeFast2(x + i, y + i, outX + i, outY + i, n - i);
+}
+
+SSE41 static void NormalizeFast3(const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m128 vx = _mm_loadu_ps(x + i);
+		__m128 vy = _mm_loadu_ps(y + i);
+		__m128 vz = _mm_loadu_ps(z + i);
+		__m128 sq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)), _mm_mul_ps(vz, vz));
+		__m128 inv = _mm_and_ps(FastScaleMask(sq), ReciprocalSqrtFast(sq));
+		_mm_storeu_ps(outX + i, _mm_mul_ps(vx, inv));
+		_mm_storeu_ps(outY + i, _mm_mul_ps(vy, inv));
+		_mm_storeu_ps(outZ + i, _mm_mul_ps(vz, inv));
+	}
+	GetScalarKernels()->normalizeFast3(x + i, y + i, z + i, outX + i, outY + i, outZ + i, n - i);
+}
+
+SSE41 static void Reflect2(const float* vx, const float* vy, const float* nx, const float* ny, float* outX, float* outY, size_t n) {
+	__m128 two = _mm_set1_ps(2.0f);
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m128 x = _mm_loadu_ps(vx + i);
+		__m128 y = _mm_loadu_ps(vy + i);
+		__m128 normalX = _mm_loadu_ps(nx + i);
+		__m128 normalY = _mm_loadu_ps(ny + i);
+		__m128 m = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(normalX, normalX), _mm_mul_ps(normalY, normalY)));
+		normalX = SafeDivide(normalX, m);
+		normalY = SafeDivide(normalY, m);
+		__m128 d = _mm_mul_ps(two, _mm_add_ps(_mm_mul_ps(x, normalX), _mm_mul_ps(y, normalY)));
+		_mm_storeu_ps(outX + i, _mm_sub_ps(x, _mm_mul_ps(d, normalX)));
+		_mm_storeu_ps(outY + i, _mm_sub_ps(y, _mm_mul_ps(d, normalY)));
+	}
+	GetScalarKernels()->reflect2(vx + i, vy + i, nx + i, ny + i, outX + i, outY + i, n - i);
+}
+
+SSE41 static void Reflect3(const float* vx, const float* vy, const float* vz, const float* nx, const float* ny, const float* nz, float* outX, float* outY, float* outZ, size_t n) {
+	__m128 two = _mm_set1_ps(2.0f);
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m128 x = _mm_loadu_ps(vx + i);
+		__m128 y = _mm_loadu_ps(vy + i);
+		__m128 z = _mm_loadu_ps(vz + i);
+		__m128 normalX = _mm_loadu_ps(nx + i);
+		__m128 normalY = _mm_loadu_ps(ny + i);
+		__m128 normalZ = _mm_loadu_ps(nz + i);
+		__m128 sq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(normalX, normalX), _mm_mul_ps(normalY, normalY)), _mm_mul_ps(normalZ, normalZ));
+		__m128 m = _mm_sqrt_ps(sq);
+		normalX = SafeDivide(normalX, m);
+		normalY = SafeDivide(normalY, m);
+		normalZ = SafeDivide(normalZ, m);
+		__m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, normalX), _mm_mul_ps(y, normalY)), _mm_mul_ps(z, normalZ));
+		__m128 d = _mm_mul_ps(two, dot);
+		_mm_storeu_ps(outX + i, _mm_sub_ps(x, _mm_mul_ps(d, normalX)));
+		_mm_storeu_ps(outY + i, _mm_sub_ps(y, _mm_mul_ps(d, normalY)));
+		_mm_storeu_ps(outZ + i, _mm_sub_ps(z, _mm_mul_ps(d, normalZ)));
+	}
+	GetScalarKernels()->reflect3(vx + i, vy + i, vz + i, nx + i, ny + i, nz + i, outX + i, outY + i, outZ + i, n - i);
+}
+
+SSE41 static void ClampMagnitude2(const float* x, const float* y, float maxLength, float* outX, float* outY, size_t n) {
+	__m128 eps = _mm_set1_ps(kEpsilon);
+	__m128 maxLen = _mm_set1_ps(maxLength);
+	__m128 zero = _mm_setzero_ps();
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m128 vx = _mm_loadu_ps(x + i);
+		__m128 vy = _mm_loadu_ps(y + i);
+		__m128 m = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)));
+		__m128 tooShort = _mm_cmplt_ps(m, eps);
+		__m128 tooLong = _mm_cmpgt_ps(m, maxLen);
+		__m128 rx = _mm_blendv_ps(vx, _mm_mul_ps(_mm_div_ps(vx, m), maxLen), tooLong);
+		__m128 ry = _mm_blendv_ps(vy, _mm_mul_ps(_mm_div_ps(vy, m), maxLen), tooLong);
+		_mm_storeu_ps(outX + i, _mm_blendv_ps(rx, zero, tooShort));
+		_mm_storeu_ps(outY + i, _mm_blendv_ps(ry, zero, tooShort));
+	}
+	GetScalarKernels()->clampMagnitude2(x + i, y + i, maxLength, outX + i, outY + i, n - i);
+}
+
+SSE41 static void ClampMagnitude3(const float* x, const float* y, const float* z, float maxLength, float* outX, float* outY, float* outZ, size_t n) {
+	__m128 eps = _mm_set1_ps(kEpsilon);
+	__m128 maxLen = _mm_set1_ps(maxLength);
+	__m128 zero = _mm_setzero_ps();
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m128 vx = _mm_loadu_ps(x + i);
+		__m128 vy = _mm_loadu_ps(y + i);
+		__m128 vz = _mm_loadu_ps(z + i);
+		__m128 sq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)), _mm_mul_ps(vz, vz));
+		__m128 m = _mm_sqrt_ps(sq);
+		__m128 tooShort = _mm_cmplt_ps(m, eps);
+		__m128 tooLong = _mm_cmpgt_ps(m, maxLen);
+		__m128 rx = _mm_blendv_ps(vx, _mm_mul_ps(_mm_div_ps(vx, m), maxLen), tooLong);
+		__m128 ry = _mm_blendv_ps(vy, _mm_mul_ps(_mm_div_ps(vy, m), maxLen), tooLong);
+		__m128 rz = _mm_blendv_ps(vz, _mm_mul_ps(_mm_div_ps(vz, m), maxLen), tooLong);
+		_mm_storeu_ps(outX + i, _mm_blendv_ps(rx, zero, tooShort));
+		_mm_storeu_ps(outY + i, _mm_blendv_ps(ry, zero, tooShort));
+		_mm_storeu_ps(outZ + i, _mm_blendv_ps(rz, zero, tooShort));
+	}
+	GetScalarKernels()->clampMagnitude3(x + i, y + i, z + i, maxLength, outX + i, outY + i, outZ + i, n - i);
+}
+
+//4 packed xyz points per iteration: 3 loads are shuffled into x/y/z registers,
+//transformed with the broadcast matrix and shuffled back before storing.
+//All 4 points are read before any is written, so in-place calls are safe.
+SSE41 static void Transform3(const float* m, float w, const float* in, float* out, size_t n) {
+	__m128 m0 = _mm_set1_ps(m[0]), m1 = _mm_set1_ps(m[1]), m2 = _mm_set1_ps(m[2]);
+	__m128 m4 = _mm_set1_ps(m[4]), m5 = _mm_set1_ps(m[5]), m6 = _mm_set1_ps(m[6]);
+	__m128 m8 = _mm_set1_ps(m[8]), m9 = _mm_set1_ps(m[9]), m10 = _mm_set1_ps(m[10]);
+	__m128 tx = _mm_set1_ps(m[12] * w), ty = _mm_set1_ps(m[13] * w), tz = _mm_set1_ps(m[14] * w);
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		const float* p = in + i * 3;
+		__m128 a = _mm_loadu_ps(p);     //x0 y0 z0 x1
+		__m128 b = _mm_loadu_ps(p + 4); //y1 z1 x2 y2
+		__m128 c = _mm_loadu_ps(p + 8); //z2 x3 y3 z3
+		__m128 xy = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 1, 3, 2));
+		__m128 yz = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 2, 1));
+		__m128 x = _mm_shuffle_ps(a, xy, _MM_SHUFFLE(2, 0, 3, 0));
+		__m128 y = _mm_shuffle_ps(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));
+		__m128 z = _mm_shuffle_ps(yz, c, _MM_SHUFFLE(3, 0, 3, 1));
+
+		__m128 ox = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m0, x), _mm_mul_ps(m4, y)), _mm_mul_ps(m8, z)), tx);
+		__m128 oy = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m1, x), _mm_mul_ps(m5, y)), _mm_mul_ps(m9, z)), ty);
+		__m128 oz = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m2, x), _mm_mul_ps(m6, y)), _mm_mul_ps(m10, z)), tz);
+
+		__m128 rxy = _mm_shuffle_ps(ox, oy, _MM_SHUFFLE(2, 0, 2, 0));
+		__m128 ryz = _mm_shuffle_ps(oy, oz, _MM_SHUFFLE(3, 1, 3, 1));
+		__m128 rzx = _mm_shuffle_ps(oz, ox, _MM_SHUFFLE(3, 1, 2, 0));
+		float* q = out + i * 3;
+		_mm_storeu_ps(q, _mm_shuffle_ps(rxy, rzx, _MM_SHUFFLE(2, 0, 2, 0)));
+		_mm_storeu_ps(q + 4, _mm_shuffle_ps(ryz, rxy, _MM_SHUFFLE(3, 1, 2, 0)));
+		_mm_storeu_ps(q + 8, _mm_shuffle_ps(rzx, ryz, _MM_SHUFFLE(3, 1, 3, 1)));
+	}
+	GetScalarKernels()->transform3(m, w, in + i * 3, out + i * 3, n - i);
+}
+
+SSE41 static void IntegrateEuler(float* p, float* v, const float* a, float dt, size_t n) {
+	__m128 step = _mm_set1_ps(dt);
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m128 acc = a != nullptr ? _mm_loadu_ps(a + i) : _mm_setzero_ps();
+		__m128 vel = _mm_add_ps(_mm_loadu_ps(v + i), _mm_mul_ps(acc, step));
+		_mm_storeu_ps(v + i, vel);
+		_mm_storeu_ps(p + i, _mm_add_ps(_mm_loadu_ps(p + i), _mm_mul_ps(vel, step)));
+	}
+	GetScalarKernels()->integrateEuler(p + i, v + i, a != nullptr ? a + i : nullptr, dt, n - i);
+}
+
+SSE41 static void IntegrateVerlet(float* p, float* prev, const float* a, float dt, size_t n) {
+	__m128 step2 = _mm_set1_ps(dt * dt);
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m128 acc = a != nullptr ? _mm_loadu_ps(a + i) : _mm_setzero_ps();
+		__m128 current = _mm_loadu_ps(p + i);
+		__m128 next = _mm_add_ps(_mm_add_ps(current, _mm_sub_ps(current, _mm_loadu_ps(prev + i))), _mm_mul_ps(acc, step2));
+		_mm_storeu_ps(p + i, next);
+		_mm_storeu_ps(prev + i, current);
+	}
+	GetScalarKernels()->integrateVerlet(p + i, prev + i, a != nullptr ? a + i : nullptr, dt, n - i);
+}
+
+//All bits set in lanes whose contact byte is non-zero
+SSE41 static inline __m128 LoadMask(const unsigned char* mask) {
+	int bytes;
+	memcpy(&bytes, mask, sizeof(bytes));
+	__m128i lanes = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(bytes));
+	return _mm_castsi128_ps(_mm_cmpgt_epi32(lanes, _mm_setzero_si128()));
+}
+
+//Inactive lanes (masked out or zero length normal) keep their velocity
+SSE41 static void ReflectResponse2(float* vx, float* vy, const float* nx, const float* ny, const unsigned char* mask, float restitution, float friction, int normalize, size_t n) {
+	__m128 eps = _mm_set1_ps(kEpsilon);
+	__m128 rest = _mm_set1_ps(restitution);
+	__m128 tangentScale = _mm_set1_ps(1.0f - friction);
+	__m128 all = _mm_castsi128_ps(_mm_set1_epi32(-1));
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m128 active = mask != nullptr ? LoadMask(mask + i) : all;
+		__m128 x = _mm_loadu_ps(vx + i);
+		__m128 y = _mm_loadu_ps(vy + i);
+		__m128 normalX = _mm_loadu_ps(nx + i);
+		__m128 normalY = _mm_loadu_ps(ny + i);
+		if (normalize) {
+			__m128 m = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(normalX, normalX), _mm_mul_ps(normalY, normalY)));
+			active = _mm_andnot_ps(_mm_cmplt_ps(m, eps), active);
+			normalX = _mm_div_ps(normalX, m);
+			normalY = _mm_div_ps(normalY, m);
+		}
+		__m128 d = _mm_add_ps(_mm_mul_ps(x, normalX), _mm_mul_ps(y, normalY));
+		__m128 partX = _mm_mul_ps(d, normalX);
+		__m128 partY = _mm_mul_ps(d, normalY);
+		__m128 rx = _mm_sub_ps(_mm_mul_ps(tangentScale, _mm_sub_ps(x, partX)), _mm_mul_ps(rest, partX));
+		__m128 ry = _mm_sub_ps(_mm_mul_ps(tangentScale, _mm_sub_ps(y, partY)), _mm_mul_ps(rest, partY));
+		_mm_storeu_ps(vx + i, _mm_blendv_ps(x, rx, active));
+		_mm_storeu_ps(vy + i, _mm_blendv_ps(y, ry, active));
+	}
+	GetScalarKernels()->reflectResponse2(vx + i, vy + i, nx + i, ny + i, mask != nullptr ? mask + i : nullptr, restitution, friction, normalize, n - i);
+}
+
+SSE41 static void ReflectResponse3(float* vx, float* vy, float* vz, const float* nx, const float* ny, const float* nz, const unsigned char* mask, float restitution, float friction, int normalize, size_t n) {
+	__m128 eps = _mm_set1_ps(kEpsilon);
+	__m128 rest = _mm_set1_ps(restitution);
+	__m128 tangentScale = _mm_set1_ps(1.0f - friction);
+	__m128 all = _mm_castsi128_ps(_mm_set1_epi32(-1));
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m128 active = mask != nullptr ? LoadMask(mask + i) : all;
+		__m128 x = _mm_loadu_ps(vx + i);
+		__m128 y = _mm_loadu_ps(vy + i);
+		__m128 z = _mm_loadu_ps(vz + i);
+		__m128 normalX = _mm_loadu_ps(nx + i);
+		__m128 normalY = _mm_loadu_ps(ny + i);
+		__m128 normalZ = _mm_loadu_ps(nz + i);
+		if (normalize) {
+			__m128 sq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(normalX, normalX), _mm_mul_ps(normalY, normalY)), _mm_mul_ps(normalZ, normalZ));
+			__m128 m = _mm_sqrt_ps(sq);
+			active = _mm_andnot_ps(_mm_cmplt_ps(m, eps), active);
+			normalX = _mm_div_ps(normalX, m);
+			normalY = _mm_div_ps(normalY, m);
+			normalZ = _mm_div_ps(normalZ, m);
+		}
+		__m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, normalX), _mm_mul_ps(y, normalY)), _mm_mul_ps(z, normalZ));
+		__m128 partX = _mm_mul_ps(d, normalX);
+		__m128 partY = _mm_mul_ps(d, normalY);
+		__m128 partZ = _mm_mul_ps(d, normalZ);
+		__m128 rx = _mm_sub_ps(_mm_mul_ps(tangentScale, _mm_sub_ps(x, partX)), _mm_mul_ps(rest, partX));
+		__m128 ry = _mm_sub_ps(_mm_mul_ps(tangentScale, _mm_sub_ps(y, partY)), _mm_mul_ps(rest, partY));
+		__m128 rz = _mm_sub_ps(_mm_mul_ps(tangentScale, _mm_sub_ps(z, partZ)), _mm_mul_ps(rest, partZ));
+		_mm_storeu_ps(vx + i, _mm_blendv_ps(x, rx, active));
+		_mm_storeu_ps(vy + i, _mm_blendv_ps(y, ry, active));
+		_mm_storeu_ps(vz + i, _mm_blendv_ps(z, rz, active));
+	}
+	GetScalarKernels()->reflectResponse3(vx + i, vy + i, vz + i, nx + i, ny + i, nz + i, mask != nullptr ? mask + i : nullptr, restitution, friction, normalize, n - i);
+}
+
+SSE41 static void ScaleAdd(const float* a, const float* b, float scale, float* out, size_t n) {
+	__m128 s = _mm_set1_ps(scale);
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		_mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(a + i), _mm_mul_ps(_mm_loadu_ps(b + i), s)));
+	}
+	GetScalarKernels()->scaleAdd(a + i, b + i, scale, out + i, n - i);
+}
+
+SSE41 static void MulAdd(const float* a, const float* b, const float* c, float* out, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		_mm_storeu_ps(out + i, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)), _mm_loadu_ps(c + i)));
+	}
+	GetScalarKernels()->mulAdd(a + i, b + i, c + i, out + i, n - i);
+}
+
+SSE41 static void LerpClamp(const float* a, const float* b, float t, float minVal, float maxVal, float* out, size_t n) {
+	__m128 weight = _mm_set1_ps(t);
+	__m128 lo = _mm_set1_ps(minVal);
+	__m128 hi = _mm_set1_ps(maxVal);
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m128 va = _mm_loadu_ps(a + i);
+		__m128 v = _mm_add_ps(va, _mm_mul_ps(weight, _mm_sub_ps(_mm_loadu_ps(b + i), va)));
+		__m128 r = _mm_blendv_ps(v, lo, _mm_cmplt_ps(v, lo));
+		_mm_storeu_ps(out + i, _mm_blendv_ps(r, hi, _mm_cmpgt_ps(v, hi)));
+	}
+	GetScalarKernels()->lerpClamp(a + i, b + i, t, minVal, maxVal, out + i, n - i);
+}
+
+//Lanes longer than maxLength scale to maxLength, lanes shorter than minLength
+//to minLength (maxLength wins if they overlap), zero length lanes become zero
+SSE41 static inline __m128 RangeTarget(__m128 m, __m128 minLen, __m128 maxLen, __m128& change) {
+	__m128 tooLong = _mm_cmpgt_ps(m, maxLen);
+	__m128 tooShort = _mm_cmplt_ps(m, minLen);
+	change = _mm_or_ps(tooLong, tooShort);
+	return _mm_blendv_ps(minLen, maxLen, tooLong);
+}
+
+SSE41 static void ClampMagnitudeRange2(const float* x, const float* y, float minLength, float maxLength, float* outX, float* outY, size_t n) {
+	__m128 eps = _mm_set1_ps(kEpsilon);
+	__m128 minLen = _mm_set1_ps(minLength);
+	__m128 maxLen = _mm_set1_ps(maxLength);
+	__m128 zeroes = _mm_setzero_ps();
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m128 vx = _mm_loadu_ps(x + i);
+		__m128 vy = _mm_loadu_ps(y + i);
+		__m128 m = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)));
+		__m128 change;
+		__m128 target = RangeTarget(m, minLen, maxLen, change);
+		__m128 zeroLength = _mm_cmplt_ps(m, eps);
+		__m128 rx = _mm_blendv_ps(vx, _mm_mul_ps(_mm_div_ps(vx, m), target), change);
+		__m128 ry = _mm_blendv_ps(vy, _mm_mul_ps(_mm_div_ps(vy, m), target), change);
+		_mm_storeu_ps(outX + i, _mm_blendv_ps(rx, zeroes, zeroLength));
+		_mm_storeu_ps(outY + i, _mm_blendv_ps(ry, zeroes, zeroLength));
+	}
+	GetScalarKernels()->clampMagnitudeRange2(x + i, y + i, minLength, maxLength, outX + i, outY + i, n - i);
+}
+
+SSE41 static void ClampMagnitudeRange3(const float* x, const float* y, const float* z, float minLength, float maxLength, float* outX, float* outY, float* outZ, size_t n) {
+	__m128 eps = _mm_set1_ps(kEpsilon);
+	__m128 minLen = _mm_set1_ps(minLength);
+	__m128 maxLen = _mm_set1_ps(maxLength);
+	__m128 zeroes = _mm_setzero_ps();
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m128 vx = _mm_loadu_ps(x + i);
+		__m128 vy = _mm_loadu_ps(y + i);
+		__m128 vz = _mm_loadu_ps(z + i);
+		__m128 m = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)), _mm_mul_ps(vz, vz)));
+		__m128 change;
+		__m128 target = RangeTarget(m, minLen, maxLen, change);
+		__m128 zeroLength = _mm_cmplt_ps(m, eps);
+		__m128 rx = _mm_blendv_ps(vx, _mm_mul_ps(_mm_div_ps(vx, m), target), change);
+		__m128 ry = _mm_blendv_ps(vy, _mm_mul_ps(_mm_div_ps(vy, m), target), change);
+		__m128 rz = _mm_blendv_ps(vz, _mm_mul_ps(_mm_div_ps(vz, m), target), change);
+		_mm_storeu_ps(outX + i, _mm_blendv_ps(rx, zeroes, zeroLength));
+		_mm_storeu_ps(outY + i, _mm_blendv_ps(ry, zeroes, zeroLength));
+		_mm_storeu_ps(outZ + i, _mm_blendv_ps(rz, zeroes, zeroLength));
+	}
+	GetScalarKernels()->clampMagnitudeRange3(x + i, y + i, z + i, minLength, maxLength, outX + i, outY + i, outZ + i, n - i);
+}
+
+//SSE4.1 has no half conversion instruction (that is F16C, used by the AVX2
+//table), so halves go through the scalar kernels here
+SSE41 static void FloatToHalf(const float* in, uint16_t* out, size_t n) {
+	GetScalarKernels()->floatToHalf(in, out, n);
+}
+
+SSE41 static void HalfToFloat(const uint16_t* in, float* out, size_t n) {
+	GetScalarKernels()->halfToFloat(in, out, n);
+}
+
+//Round to nearest even on the top 16 bits; NaN only gets its quiet bit set
+SSE41 static inline __m128i RoundToBFloat16(__m128 v) {
+	__m128i bits = _mm_castps_si128(v);
+	__m128i lsb = _mm_and_si128(_mm_srli_epi32(bits, 16), _mm_set1_epi32(1));
+	__m128i rounded = _mm_add_epi32(bits, _mm_add_epi32(_mm_set1_epi32(0x7fff), lsb));
+	__m128i nan = _mm_cmpgt_epi32(_mm_and_si128(bits, _mm_set1_epi32(0x7fffffff)), _mm_set1_epi32(0x7f800000));
+	__m128i quiet = _mm_or_si128(bits, _mm_set1_epi32(0x00400000));
+	return _mm_srli_epi32(_mm_blendv_epi8(rounded, quiet, nan), 16);
+}
+
+SSE41 static void FloatToBFloat16(const float* in, uint16_t* out, size_t n) {
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m128i lo = RoundToBFloat16(_mm_loadu_ps(in + i));
+		__m128i hi = RoundToBFloat16(_mm_loadu_ps(in + i + 4));
+		_mm_storeu_si128((__m128i*)(out + i), _mm_packus_epi32(lo, hi));
+	}
+	GetScalarKernels()->floatToBFloat16(in + i, out + i, n - i);
+}
+
+SSE41 static void BFloat16ToFloat(const uint16_t* in, float* out, size_t n) {
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m128i packed = _mm_loadu_si128((const __m128i*)(in + i));
+		__m128i lo = _mm_slli_epi32(_mm_cvtepu16_epi32(packed), 16);
+		__m128i hi = _mm_slli_epi32(_mm_cvtepu16_epi32(_mm_srli_si128(packed, 8)), 16);
+		_mm_storeu_ps(out + i, _mm_castsi128_ps(lo));
+		_mm_storeu_ps(out + i + 4, _mm_castsi128_ps(hi));
+	}
+	GetScalarKernels()->bfloat16ToFloat(in + i, out + i, n - i);
+}
+
+//Packed 4-float elements (Vec4 / Vec3A): each element is one load, four of
+//them are transposed into x / y / z / w registers and run like the SoA
+//kernels. Loads are unaligned because managed (C#) arrays are only 8-byte
+//aligned; on 16-byte aligned data they cost the same as aligned loads.
+SSE41 static inline void Load4(const float* p, __m128& x, __m128& y, __m128& z, __m128& w) {
+	x = _mm_loadu_ps(p);
+	y = _mm_loadu_ps(p + 4);
+	z = _mm_loadu_ps(p + 8);
+	w = _mm_loadu_ps(p + 12);
+	_MM_TRANSPOSE4_PS(x, y, z, w);
+}
+
+SSE41 static inline __m128 SquaredLength4(__m128 x, __m128 y, __m128 z, __m128 w, int components) {
+	__m128 sq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+	return components == 4 ? _mm_add_ps(sq, _mm_mul_ps(w, w)) : sq;
+}
+
+SSE41 static void Dot4(const float* a, const float* b, int components, float* out, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m128 ax, ay, az, aw, bx, by, bz, bw;
+		Load4(a + i * 4, ax, ay, az, aw);
+		Load4(b + i * 4, bx, by, bz, bw);
+		__m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)), _mm_mul_ps(az, bz));
+		if (components == 4) {
+			d = _mm_add_ps(d, _mm_mul_ps(aw, bw));
+		}
+		_mm_storeu_ps(out + i, d);
+	}
+	GetScalarKernels()->dot4(a + i * 4, b + i * 4, components, out + i, n - i);
+}
+
+SSE41 static void Magnitude4(const float* v, int components, float* out, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m128 x, y, z, w;
+		Load4(v + i * 4, x, y, z, w);
+		_mm_storeu_ps(out + i, _mm_sqrt_ps(SquaredLength4(x, y, z, w, components)));
+	}
+	GetScalarKernels()->magnitude4(v + i * 4, components, out + i, n - i);
+}
+
+SSE41 static void Normalize4(const float* v, int components, float* out, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m128 x, y, z, w;
+		Load4(v + i * 4, x, y, z, w);
+		__m128 m = _mm_sqrt_ps(SquaredLength4(x, y, z, w, components));
+		x = SafeDivide(x, m);
+		y = SafeDivide(y, m);
+		z = SafeDivide(z, m);
+		w = components == 4 ? SafeDivide(w, m) : _mm_setzero_ps();
+		_MM_TRANSPOSE4_PS(x, y, z, w);
+		_mm_storeu_ps(out + i * 4, x);
+		_mm_storeu_ps(out + i * 4 + 4, y);
+		_mm_storeu_ps(out + i * 4 + 8, z);
+		_mm_storeu_ps(out + i * 4 + 12, w);
+	}
+	GetScalarKernels()->normalize4(v + i * 4, components, out + i * 4, n - i);
+}
+
+//a.yzx * b.zxy - a.zxy * b.yzx, one element per register
+SSE41 static void Cross3A(const float* a, const float* b, float* out, size_t n) {
+	for (size_t i = 0; i < n; ++i) {
+		__m128 va = _mm_loadu_ps(a + i * 4);
+		__m128 vb = _mm_loadu_ps(b + i * 4);
+		__m128 left = _mm_mul_ps(_mm_shuffle_ps(va, va, _MM_SHUFFLE(3, 0, 2, 1)), _mm_shuffle_ps(vb, vb, _MM_SHUFFLE(3, 1, 0, 2)));
+		__m128 right = _mm_mul_ps(_mm_shuffle_ps(va, va, _MM_SHUFFLE(3, 1, 0, 2)), _mm_shuffle_ps(vb, vb, _MM_SHUFFLE(3, 0, 2, 1)));
+		_mm_storeu_ps(out + i * 4, _mm_blend_ps(_mm_sub_ps(left, right), _mm_setzero_ps(), 8));
+	}
+}
+
+//Reductions: the kReduceLanes accumulators live in six registers for the
+//whole call, one group of 24 floats per iteration
+SSE41 static void Sum(const float* in, float* lanes, size_t n) {
+	__m128 acc[6];
+	for (int r = 0; r < 6; ++r) {
+		acc[r] = _mm_loadu_ps(lanes + r * 4);
+	}
+	size_t i = 0;
+	for (; i + kReduceLanes <= n; i += kReduceLanes) {
+		for (int r = 0; r < 6; ++r) {
+			acc[r] = _mm_add_ps(acc[r], _mm_loadu_ps(in + i + r * 4));
+		}
+	}
+	for (int r = 0; r < 6; ++r) {
+		_mm_storeu_ps(lanes + r * 4, acc[r]);
+	}
+	GetScalarKernels()->sum(in + i, lanes, n - i);
+}
+
+SSE41 static void SumKahan(const float* in, float* lanes, float* compensation, size_t n) {
+	__m128 acc[6];
+	__m128 comp[6];
+	for (int r = 0; r < 6; ++r) {
+		acc[r] = _mm_loadu_ps(lanes + r * 4);
+		comp[r] = _mm_loadu_ps(compensation + r * 4);
+	}
+	size_t i = 0;
+	for (; i + kReduceLanes <= n; i += kReduceLanes) {
+		for (int r = 0; r < 6; ++r) {
+			__m128 y = _mm_sub_ps(_mm_loadu_ps(in + i + r * 4), comp[r]);
+			__m128 t = _mm_add_ps(acc[r], y);
+			comp[r] = _mm_sub_ps(_mm_sub_ps(t, acc[r]), y);
+			acc[r] = t;
+		}
+	}
+	for (int r = 0; r < 6; ++r) {
+		_mm_storeu_ps(lanes + r * 4, acc[r]);
+		_mm_storeu_ps(compensation + r * 4, comp[r]);
+	}
+	GetScalarKernels()->sumKahan(in + i, lanes, compensation, n - i);
+}
+
+SSE41 static void DotSum(const float* a, const float* b, float* lanes, size_t n) {
+	__m128 acc[6];
+	for (int r = 0; r < 6; ++r) {
+		acc[r] = _mm_loadu_ps(lanes + r * 4);
+	}
+	size_t i = 0;
+	for (; i + kReduceLanes <= n; i += kReduceLanes) {
+		for (int r = 0; r < 6; ++r) {
+			acc[r] = _mm_add_ps(acc[r], _mm_mul_ps(_mm_loadu_ps(a + i + r * 4), _mm_loadu_ps(b + i + r * 4)));
+		}
+	}
+	for (int r = 0; r < 6; ++r) {
+		_mm_storeu_ps(lanes + r * 4, acc[r]);
+	}
+	GetScalarKernels()->dotSum(a + i, b + i, lanes, n - i);
+}
+
+//minps(x, m) is x < m ? x : m, so NaN inputs leave the lane alone
+SSE41 static void MinMax(const float* in, float* minLanes, float* maxLanes, size_t n) {
+	__m128 lo[6];
+	__m128 hi[6];
+	for (int r = 0; r < 6; ++r) {
+		lo[r] = _mm_loadu_ps(minLanes + r * 4);
+		hi[r] = _mm_loadu_ps(maxLanes + r * 4);
+	}
+	size_t i = 0;
+	for (; i + kReduceLanes <= n; i += kReduceLanes) {
+		for (int r = 0; r < 6; ++r) {
+			__m128 x = _mm_loadu_ps(in + i + r * 4);
+			lo[r] = _mm_min_ps(x, lo[r]);
+			hi[r] = _mm_max_ps(x, hi[r]);
+		}
+	}
+	for (int r = 0; r < 6; ++r) {
+		_mm_storeu_ps(minLanes + r * 4, lo[r]);
+		_mm_storeu_ps(maxLanes + r * 4, hi[r]);
+	}
+	GetScalarKernels()->minMax(in + i, minLanes, maxLanes, n - i);
+}
+
+SSE41 static void MinMaxIndex(const float* in, uint32_t first, float* minLanes, uint32_t* minIndex, float* maxLanes, uint32_t* maxIndex, size_t n) {
+	__m128 lo[6];
+	__m128 hi[6];
+	__m128i loIndex[6];
+	__m128i hiIndex[6];
+	__m128i index[6];
+	for (int r = 0; r < 6; ++r) {
+		lo[r] = _mm_loadu_ps(minLanes + r * 4);
+		hi[r] = _mm_loadu_ps(maxLanes + r * 4);
+		loIndex[r] = _mm_loadu_si128((const __m128i*)(minIndex + r * 4));
+		hiIndex[r] = _mm_loadu_si128((const __m128i*)(maxIndex + r * 4));
+		index[r] = _mm_add_epi32(_mm_set1_epi32((int)first + r * 4), _mm_setr_epi32(0, 1, 2, 3));
+	}
+	__m128i step = _mm_set1_epi32((int)kReduceLanes);
+	size_t i = 0;
+	for (; i + kReduceLanes <= n; i += kReduceLanes) {
+		for (int r = 0; r < 6; ++r) {
+			__m128 x = _mm_loadu_ps(in + i + r * 4);
+			__m128 less = _mm_cmplt_ps(x, lo[r]);
+			__m128 greater = _mm_cmpgt_ps(x, hi[r]);
+			lo[r] = _mm_blendv_ps(lo[r], x, less);
+			hi[r] = _mm_blendv_ps(hi[r], x, greater);
+			loIndex[r] = _mm_castps_si128(_mm_blendv_ps(_mm_castsi128_ps(loIndex[r]), _mm_castsi128_ps(index[r]), less));
+			hiIndex[r] = _mm_castps_si128(_mm_blendv_ps(_mm_castsi128_ps(hiIndex[r]), _mm_castsi128_ps(index[r]), greater));
+			index[r] = _mm_add_epi32(index[r], step);
+		}
+	}
+	for (int r = 0; r < 6; ++r) {
+		_mm_storeu_ps(minLanes + r * 4, lo[r]);
+		_mm_storeu_ps(maxLanes + r * 4, hi[r]);
+		_mm_storeu_si128((__m128i*)(minIndex + r * 4), loIndex[r]);
+		_mm_storeu_si128((__m128i*)(maxIndex + r * 4), hiIndex[r]);
+	}
+	GetScalarKernels()->minMaxIndex(in + i, first + (uint32_t)i, minLanes, minIndex, maxLanes, maxIndex, n - i);
+}
+
+//hadd of the products gives ax * bx + ay * by for four vectors at once
+SSE41 static void DotPacked2(const float* a, const float* b, float* out, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m128 low = _mm_mul_ps(_mm_loadu_ps(a + i * 2), _mm_loadu_ps(b + i * 2));
+		__m128 high = _mm_mul_ps(_mm_loadu_ps(a + i * 2 + 4), _mm_loadu_ps(b + i * 2 + 4));
+		_mm_storeu_ps(out + i, _mm_hadd_ps(low, high));
+	}
+	GetScalarKernels()->dotPacked2(a + i * 2, b + i * 2, out + i, n - i);
+}
+
+//Four packed xyz vectors (three registers) to one register per component
+SSE41 static inline void Split3x4(__m128 x0y0z0x1, __m128 y1z1x2y2, __m128 z2x3y3z3, __m128& x, __m128& y, __m128& z) {
+	__m128 x2y2x3y3 = _mm_shuffle_ps(y1z1x2y2, z2x3y3z3, _MM_SHUFFLE(2, 1, 3, 2));
+	__m128 y0z0y1z1 = _mm_shuffle_ps(x0y0z0x1, y1z1x2y2, _MM_SHUFFLE(1, 0, 2, 1));
+	x = _mm_shuffle_ps(x0y0z0x1, x2y2x3y3, _MM_SHUFFLE(2, 0, 3, 0));
+	y = _mm_shuffle_ps(y0z0y1z1, x2y2x3y3, _MM_SHUFFLE(3, 1, 2, 0));
+	z = _mm_shuffle_ps(y0z0y1z1, z2x3y3z3, _MM_SHUFFLE(3, 0, 3, 1));
+}
+
+SSE41 static inline void Load3x4(const float* in, __m128& x, __m128& y, __m128& z) {
+	Split3x4(_mm_loadu_ps(in), _mm_loadu_ps(in + 4), _mm_loadu_ps(in + 8), x, y, z);
+}
+
+//The products of packed vectors are packed too, so they are split by
+//component after the multiply
+SSE41 static void DotPacked3(const float* a, const float* b, float* out, size_t n) {
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m128 p0 = _mm_mul_ps(_mm_loadu_ps(a + i * 3), _mm_loadu_ps(b + i * 3));
+		__m128 p1 = _mm_mul_ps(_mm_loadu_ps(a + i * 3 + 4), _mm_loadu_ps(b + i * 3 + 4));
+		__m128 p2 = _mm_mul_ps(_mm_loadu_ps(a + i * 3 + 8), _mm_loadu_ps(b + i * 3 + 8));
+		__m128 x, y, z;
+		Split3x4(p0, p1, p2, x, y, z);
+		_mm_storeu_ps(out + i, _mm_add_ps(_mm_add_ps(x, y), z));
+	}
+	GetScalarKernels()->dotPacked3(a + i * 3, b + i * 3, out + i, n - i);
+}
+
+SSE41 static inline void BezierWeights(__m128 u, __m128& w0, __m128& w1, __m128& w2, __m128& w3) {
+	__m128 three = _mm_set1_ps(3.0f);
+	__m128 s = _mm_sub_ps(_mm_set1_ps(1.0f), u);
+	__m128 s2 = _mm_mul_ps(s, s);
+	__m128 u2 = _mm_mul_ps(u, u);
+	w0 = _mm_mul_ps(s2, s);
+	w1 = _mm_mul_ps(_mm_mul_ps(three, s2), u);
+	w2 = _mm_mul_ps(_mm_mul_ps(three, s), u2);
+	w3 = _mm_mul_ps(u2, u);
+}
+
+//One component of the segment from its four broadcast control values
+SSE41 static inline __m128 BezierSum(__m128 w0, __m128 w1, __m128 w2, __m128 w3, const __m128* c) {
+	return _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(w0, c[0]), _mm_mul_ps(w1, c[1])), _mm_mul_ps(w2, c[2])), _mm_mul_ps(w3, c[3]));
+}
+
+SSE41 static void Bezier2(const float* controls, const float* u, float* out, size_t n) {
+	__m128 cx[4], cy[4];
+	for (int k = 0; k < 4; ++k) {
+		cx[k] = _mm_set1_ps(controls[k * 2]);
+		cy[k] = _mm_set1_ps(controls[k * 2 + 1]);
+	}
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m128 w0, w1, w2, w3;
+		BezierWeights(_mm_loadu_ps(u + i), w0, w1, w2, w3);
+		__m128 x = BezierSum(w0, w1, w2, w3, cx);
+		__m128 y = BezierSum(w0, w1, w2, w3, cy);
+		_mm_storeu_ps(out + i * 2, _mm_unpacklo_ps(x, y));
+		_mm_storeu_ps(out + i * 2 + 4, _mm_unpackhi_ps(x, y));
+	}
+	GetScalarKernels()->bezier2(controls, u + i, out + i * 2, n - i);
+}
+
+//One register per component back to four packed xyz vectors (Load3x4 reversed)
+SSE41 static inline void Store3x4(float* out, __m128 x, __m128 y, __m128 z) {
+	__m128 x0x2y0y2 = _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 0, 2, 0));
+	__m128 y1y3z1z3 = _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 1, 3, 1));
+	__m128 z0z2x1x3 = _mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 1, 2, 0));
+	_mm_storeu_ps(out, _mm_shuffle_ps(x0x2y0y2, z0z2x1x3, _MM_SHUFFLE(2, 0, 2, 0)));
+	_mm_storeu_ps(out + 4, _mm_shuffle_ps(y1y3z1z3, x0x2y0y2, _MM_SHUFFLE(3, 1, 2, 0)));
+	_mm_storeu_ps(out + 8, _mm_shuffle_ps(z0z2x1x3, y1y3z1z3, _MM_SHUFFLE(3, 1, 3, 1)));
+}
+
+SSE41 static void Bezier3(const float* controls, const float* u, float* out, size_t n) {
+	__m128 cx[4], cy[4], cz[4];
+	for (int k = 0; k < 4; ++k) {
+		cx[k] = _mm_set1_ps(controls[k * 3]);
+		cy[k] = _mm_set1_ps(controls[k * 3 + 1]);
+		cz[k] = _mm_set1_ps(controls[k * 3 + 2]);
+	}
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m128 w0, w1, w2, w3;
+		BezierWeights(_mm_loadu_ps(u + i), w0, w1, w2, w3);
+		Store3x4(out + i * 3, BezierSum(w0, w1, w2, w3, cx), BezierSum(w0, w1, w2, w3, cy), BezierSum(w0, w1, w2, w3, cz));
+	}
+	GetScalarKernels()->bezier3(controls, u + i, out + i * 3, n - i);
+}
+
+static const VectorKernels kSse41Kernels = {
+	"SSE4.1",
+	Add, Subtract, Scale, Clamp,
+	Dot2, Dot3,
+	Magnitude2, Magnitude3,
+	Normalize2, Normalize3,
+	NormalizeFast2, NormalizeFast3,
+	Reflect2, Reflect3,
+	ClampMagnitude2, ClampMagnitude3,
+	Transform3,
+	IntegrateEuler, IntegrateVerlet,
+	ReflectResponse2, ReflectResponse3,
+	ScaleAdd, MulAdd, LerpClamp,
+	ClampMagnitudeRange2, ClampMagnitudeRange3,
+	FloatToHalf, HalfToFloat, FloatToBFloat16, BFloat16ToFloat,
+	Dot4, Magnitude4, Normalize4, Cross3A,
+	Sum, SumKahan, DotSum, MinMax, MinMaxIndex,
+	DotPacked2, DotPacked3,
+	Bezier2, Bezier3
+};
+
+const VectorKernels* GetSse41Kernels() {
+	return &kSse41Kernels;
+}
+
+#else
+
+const VectorKernels* GetSse41Kernels() {
+	return nullptr;
+}
+
+#endif
@@ -0,0 +1,161 @@
+//Always include the pch.h first in every cpp
+#include "pch.h"
+
+//Then include own items
+#include "VectorMath.h"
+#include "VectorMathKernels.h"
+#include "VectorMathThreads.h"
+#include "VectorMathStats.h"
+
+//C exports for the matrix and quaternion types. Like VectorMath.cpp these are
+//thin wrappers over the inline layer (VectorMathMatrix.h); only the array
+//transforms go through the SIMD kernel table.
+
+using namespace vmath;
+
+
+//Mat3
+void Mat3Identity(Mat3* out) {
+	VECTORMATH_STATS(1);
+	*out = Identity3<float>();
+}
+
+void Mat3Multiply(const Mat3* a, const Mat3* b, Mat3* out) {
+	VECTORMATH_STATS(1);
+	*out = *a * *b;
+}
+
+Vec3 Mat3MultiplyVector(const Mat3* m, Vec3 v) {
+	VECTORMATH_STATS(1);
+	return *m * v;
+}
+
+void Mat3Transpose(const Mat3* m, Mat3* out) {
+	VECTORMATH_STATS(1);
+	*out = Transpose(*m);
+}
+
+float Mat3Determinant(const Mat3* m) {
+	VECTORMATH_STATS(1);
+	return Determinant(*m);
+}
+
+void Mat3Inverse(const Mat3* m, Mat3* out) {
+	VECTORMATH_STATS(1);
+	*out = Inverse(*m);
+}
+
+
+//Mat4
+void Mat4Identity(Mat4* out) {
+	VECTORMATH_STATS(1);
+	*out = Identity4<float>();
+}
+
+void Mat4Multiply(const Mat4* a, const Mat4* b, Mat4* out) {
+	VECTORMATH_STATS(1);
+	*out = *a * *b;
+}
+
+void Mat4Transpose(const Mat4* m, Mat4* out) {
+	VECTORMATH_STATS(1);
+	*out = Transpose(*m);
+}
+
+float Mat4Determinant(const Mat4* m) {
+	VECTORMATH_STATS(1);
+	return Determinant(*m);
+}
+
+void Mat4Inverse(const Mat4* m, Mat4* out) {
+	VECTORMATH_STATS(1);
+	*out = Inverse(*m);
+}
+
+Vec3 Mat4TransformPoint(const Mat4* m, Vec3 p) {
+	VECTORMATH_STATS(1);
+	return TransformPoint(*m, p);
+}
+
+Vec3 Mat4TransformDirection(const Mat4* m, Vec3 d) {
+	VECTORMATH_STATS(1);
+	return TransformDirection(*m, d);
+}
+
+void Mat4ComposeTRS(Vec3 translation, Quat rotation, Vec3 scale, Mat4* out) {
+	VECTORMATH_STATS(1);
+	*out = Compose(TransformT<float>{ translation, rotation, scale });
+}
+
+void Mat4DecomposeTRS(const Mat4* m, Vec3* translation, Quat* rotation, Vec3* scale) {
+	VECTORMATH_STATS(1);
+	TransformT<float> t = Decompose(*m);
+	*translation = t.translation;
+	*rotation = t.rotation;
+	*scale = t.scale;
+}
+
+
+//Quat
+Quat QuatIdentity() {
+	VECTORMATH_STATS(1);
+	return vmath::QuatIdentity<float>();
+}
+
+Quat QuatFromAxisAngle(Vec3 axis, float angle) {
+	VECTORMATH_STATS(1);
+	return vmath::QuatFromAxisAngle(axis, angle);
+}
+
+Quat QuatMultiply(Quat a, Quat b) {
+	VECTORMATH_STATS(1);
+	return a * b;
+}
+
+Quat QuatConjugate(Quat q) {
+	VECTORMATH_STATS(1);
+	return Conjugate(q);
+}
+
+Quat QuatInverse(Quat q) {
+	VECTORMATH_STATS(1);
+	return Inverse(q);
+}
+
+Quat QuatNormalize(Quat q) {
+	VECTORMATH_STATS(1);
+	return Normalize(q);
+}
+
+Vec3 QuatRotateVector(Quat q, Vec3 v) {
+	VECTORMATH_STATS(1);
+	return Rotate(q, v);
+}
+
+void QuatToMat3(Quat q, Mat3* out) {
+	VECTORMATH_STATS(1);
+	*out = ToMat3(q);
+}
+
+Quat QuatFromMat3(const Mat3* m) {
+	VECTORMATH_STATS(1);
+	return vmath::QuatFromMat3(*m);
+}
+
+
+//Array Transforms
+void Mat4TransformPoints(const Mat4* m, const Vec3* in, Vec3* out, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.transform3(m->m, 1.0f, &in[begin].x, &out[begin].x, end - begin);
+	});
+}
+
+void Mat4TransformDirections(const Mat4* m, const Vec3* in, Vec3* out, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.transform3(m->m, 0.0f, &in[begin].x, &out[begin].x, end - begin);
+	});
+}
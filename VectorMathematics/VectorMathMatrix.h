@@ -0,0 +1,376 @@
+#pragma once
+
+#ifndef VECTOR_MATH_MATRIX_H
+#define VECTOR_MATH_MATRIX_H
+
+#include <cmath>
+#include <limits>
+#include "VectorMathInline.h"
+
+//Header-only matrix and quaternion types, the same style as VectorMathInline.h:
+//plain aggregates with free inline functions.
+//
+//Matrices are column-major like OpenGL / GLSL: element (row, col) lives at
+//m[col * N + row], and a point is transformed as M * p. Composing is therefore
+//right to left - Parent * Child applies Child first.
+
+namespace vmath {
+
+template <typename T>
+struct Mat3T {
+    T m[9];
+};
+
+//16-byte aligned so each column is one SIMD register load
+template <typename T>
+struct alignas(16) Mat4T {
+    T m[16];
+};
+
+//Rotation quaternion, x/y/z is the vector part and w the scalar part
+template <typename T>
+struct QuatT {
+    T x;
+    T y;
+    T z;
+    T w;
+};
+
+//Translation / rotation / scale split out of a Mat4
+template <typename T>
+struct TransformT {
+    Vec3T<T> translation;
+    QuatT<T> rotation;
+    Vec3T<T> scale;
+};
+
+//Below this absolute determinant a matrix is treated as singular
+template <typename T>
+constexpr T DeterminantEpsilon() {
+    return std::numeric_limits<T>::min();
+}
+
+
+//Mat3
+template <typename T>
+constexpr Mat3T<T> Identity3() {
+    return { { T(1), T(0), T(0),
+               T(0), T(1), T(0),
+               T(0), T(0), T(1) } };
+}
+
+template <typename T>
+inline Mat3T<T> operator*(const Mat3T<T>& a, const Mat3T<T>& b) {
+    Mat3T<T> r;
+    for (int col = 0; col < 3; ++col) {
+        for (int row = 0; row < 3; ++row) {
+            r.m[col * 3 + row] = a.m[row] * b.m[col * 3]
+                               + a.m[3 + row] * b.m[col * 3 + 1]
+                               + a.m[6 + row] * b.m[col * 3 + 2];
+        }
+    }
+    return r;
+}
+
+template <typename T>
+constexpr Vec3T<T> operator*(const Mat3T<T>& m, Vec3T<T> v) {
+    return { m.m[0] * v.x + m.m[3] * v.y + m.m[6] * v.z,
+             m.m[1] * v.x + m.m[4] * v.y + m.m[7] * v.z,
+             m.m[2] * v.x + m.m[5] * v.y + m.m[8] * v.z };
+}
+
+template <typename T>
+constexpr Mat3T<T> Transpose(const Mat3T<T>& m) {
+    return { { m.m[0], m.m[3], m.m[6],
+               m.m[1], m.m[4], m.m[7],
+               m.m[2], m.m[5], m.m[8] } };
+}
+
+template <typename T>
+constexpr T Determinant(const Mat3T<T>& m) {
+    return m.m[0] * (m.m[4] * m.m[8] - m.m[7] * m.m[5])
+         - m.m[3] * (m.m[1] * m.m[8] - m.m[7] * m.m[2])
+         + m.m[6] * (m.m[1] * m.m[5] - m.m[4] * m.m[2]);
+}
+
+//Safe inverse: returns the zero matrix when the matrix is singular
+template <typename T>
+inline Mat3T<T> Inverse(const Mat3T<T>& m) {
+    T det = Determinant(m);
+    if (std::abs(det) < DeterminantEpsilon<T>()) {
+        return Mat3T<T>{};
+    }
+    T inv = T(1) / det;
+    return { { (m.m[4] * m.m[8] - m.m[7] * m.m[5]) * inv,
+               (m.m[7] * m.m[2] - m.m[1] * m.m[8]) * inv,
+               (m.m[1] * m.m[5] - m.m[4] * m.m[2]) * inv,
+               (m.m[6] * m.m[5] - m.m[3] * m.m[8]) * inv,
+               (m.m[0] * m.m[8] - m.m[6] * m.m[2]) * inv,
+               (m.m[3] * m.m[2] - m.m[0] * m.m[5]) * inv,
+               (m.m[3] * m.m[7] - m.m[6] * m.m[4]) * inv,
+               (m.m[6] * m.m[1] - m.m[0] * m.m[7]) * inv,
+               (m.m[0] * m.m[4] - m.m[3] * m.m[1]) * inv } };
+}
+
+
+//Mat4
+template <typename T>
+constexpr Mat4T<T> Identity4() {
+    return { { T(1), T(0), T(0), T(0),
+               T(0), T(1), T(0), T(0),
+               T(0), T(0), T(1), T(0),
+               T(0), T(0), T(0), T(1) } };
+}
+
+template <typename T>
+inline Mat4T<T> operator*(const Mat4T<T>& a, const Mat4T<T>& b) {
+    Mat4T<T> r;
+    for (int col = 0; col < 4; ++col) {
+        for (int row = 0; row < 4; ++row) {
+            r.m[col * 4 + row] = a.m[row] * b.m[col * 4]
+                               + a.m[4 + row] * b.m[col * 4 + 1]
+                               + a.m[8 + row] * b.m[col * 4 + 2]
+                               + a.m[12 + row] * b.m[col * 4 + 3];
+        }
+    }
+    return r;
+}
+
+template <typename T>
+constexpr Mat4T<T> Transpose(const Mat4T<T>& m) {
+    return { { m.m[0], m.m[4], m.m[8], m.m[12],
+               m.m[1], m.m[5], m.m[9], m.m[13],
+               m.m[2], m.m[6], m.m[10], m.m[14],
+               m.m[3], m.m[7], m.m[11], m.m[15] } };
+}
+
+//Mat4 determinant and inverse use the 2x2 sub-determinant expansion. The
+//formulas are written for row-major storage, but inverse(transpose(M)) is
+//transpose(inverse(M)), so applying them to column-major data is the same.
+template <typename T>
+constexpr T Determinant(const Mat4T<T>& m) {
+    return (m.m[0] * m.m[5] - m.m[4] * m.m[1]) * (m.m[10] * m.m[15] - m.m[14] * m.m[11])
+         - (m.m[0] * m.m[6] - m.m[4] * m.m[2]) * (m.m[9] * m.m[15] - m.m[13] * m.m[11])
+         + (m.m[0] * m.m[7] - m.m[4] * m.m[3]) * (m.m[9] * m.m[14] - m.m[13] * m.m[10])
+         + (m.m[1] * m.m[6] - m.m[5] * m.m[2]) * (m.m[8] * m.m[15] - m.m[12] * m.m[11])
+         - (m.m[1] * m.m[7] - m.m[5] * m.m[3]) * (m.m[8] * m.m[14] - m.m[12] * m.m[10])
+         + (m.m[2] * m.m[7] - m.m[6] * m.m[3]) * (m.m[8] * m.m[13] - m.m[12] * m.m[9]);
+}
+
+//Safe inverse: returns the zero matrix when the matrix is singular
+template <typename T>
+inline Mat4T<T> Inverse(const Mat4T<T>& m) {
+    const T* a = m.m;
+    T s0 = a[0] * a[5] - a[4] * a[1];
+    T s1 = a[0] * a[6] - a[4] * a[2];
+    T s2 = a[0] * a[7] - a[4] * a[3];
+    T s3 = a[1] * a[6] - a[5] * a[2];
+    T s4 = a[1] * a[7] - a[5] * a[3];
+    T s5 = a[2] * a[7] - a[6] * a[3];
+
+    T c5 = a[10] * a[15] - a[14] * a[11];
+    T c4 = a[9] * a[15] - a[13] * a[11];
+    T c3 = a[9] * a[14] - a[13] * a[10];
+    T c2 = a[8] * a[15] - a[12] * a[11];
+    T c1 = a[8] * a[14] - a[12] * a[10];
+    T c0 = a[8] * a[13] - a[12] * a[9];
+
+    T det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+    if (std::abs(det) < DeterminantEpsilon<T>()) {
+        return Mat4T<T>{};
+    }
+    T inv = T(1) / det;
+
+    Mat4T<T> r;
+    r.m[0] = (a[5] * c5 - a[6] * c4 + a[7] * c3) * inv;
+    r.m[1] = (-a[1] * c5 + a[2] * c4 - a[3] * c3) * inv;
+    r.m[2] = (a[13] * s5 - a[14] * s4 + a[15] * s3) * inv;
+    r.m[3] = (-a[9] * s5 + a[10] * s4 - a[11] * s3) * inv;
+
+    r.m[4] = (-a[4] * c5 + a[6] * c2 - a[7] * c1) * inv;
+    r.m[5] = (a[0] * c5 - a[2] * c2 + a[3] * c1) * inv;
+    r.m[6] = (-a[12] * s5 + a[14] * s2 - a[15] * s1) * inv;
+    r.m[7] = (a[8] * s5 - a[10] * s2 + a[11] * s1) * inv;
+
+    r.m[8] = (a[4] * c4 - a[5] * c2 + a[7] * c0) * inv;
+    r.m[9] = (-a[0] * c4 + a[1] * c2 - a[3] * c0) * inv;
+    r.m[10] = (a[12] * s4 - a[13] * s2 + a[15] * s0) * inv;
+    r.m[11] = (-a[8] * s4 + a[9] * s2 - a[11] * s0) * inv;
+
+    r.m[12] = (-a[4] * c3 + a[5] * c1 - a[6] * c0) * inv;
+    r.m[13] = (a[0] * c3 - a[1] * c1 + a[2] * c0) * inv;
+    r.m[14] = (-a[12] * s3 + a[13] * s1 - a[14] * s0) * inv;
+    r.m[15] = (a[8] * s3 - a[9] * s1 + a[10] * s0) * inv;
+    return r;
+}
+
+//Point: w = 1, so the translation applies. No perspective divide - use this
+//for affine (model / view) matrices.
+template <typename T>
+constexpr Vec3T<T> TransformPoint(const Mat4T<T>& m, Vec3T<T> p) {
+    return { m.m[0] * p.x + m.m[4] * p.y + m.m[8] * p.z + m.m[12],
+             m.m[1] * p.x + m.m[5] * p.y + m.m[9] * p.z + m.m[13],
+             m.m[2] * p.x + m.m[6] * p.y + m.m[10] * p.z + m.m[14] };
+}
+
+//Direction: w = 0, so only rotation and scale apply
+template <typename T>
+constexpr Vec3T<T> TransformDirection(const Mat4T<T>& m, Vec3T<T> d) {
+    return { m.m[0] * d.x + m.m[4] * d.y + m.m[8] * d.z,
+             m.m[1] * d.x + m.m[5] * d.y + m.m[9] * d.z,
+             m.m[2] * d.x + m.m[6] * d.y + m.m[10] * d.z };
+}
+
+
+//Quaternions
+template <typename T>
+constexpr QuatT<T> QuatIdentity() {
+    return { T(0), T(0), T(0), T(1) };
+}
+
+//Hamilton product: a * b rotates by b first, then by a
+template <typename T>
+constexpr QuatT<T> operator*(QuatT<T> a, QuatT<T> b) {
+    return { a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+             a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+             a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+             a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z };
+}
+
+template <typename T>
+constexpr T Dot(QuatT<T> a, QuatT<T> b) {
+    return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+}
+
+template <typename T>
+constexpr QuatT<T> Conjugate(QuatT<T> q) {
+    return { -q.x, -q.y, -q.z, q.w };
+}
+
+//Safe normalize: returns the identity rotation when the length is below Epsilon
+template <typename T>
+inline QuatT<T> Normalize(QuatT<T> q) {
+    T m = Sqrt(Dot(q, q));
+    if (m < Epsilon<T>()) {
+        return QuatIdentity<T>();
+    }
+    return { q.x / m, q.y / m, q.z / m, q.w / m };
+}
+
+//Safe inverse: returns the identity rotation for a zero quaternion
+template <typename T>
+inline QuatT<T> Inverse(QuatT<T> q) {
+    T sq = Dot(q, q);
+    if (sq < Epsilon<T>() * Epsilon<T>()) {
+        return QuatIdentity<T>();
+    }
+    return { -q.x / sq, -q.y / sq, -q.z / sq, q.w / sq };
+}
+
+//Rotation of angle radians around axis (normalized here, zero axis gives identity)
+template <typename T>
+inline QuatT<T> QuatFromAxisAngle(Vec3T<T> axis, Scalar<T> angle) {
+    axis = Normalize(axis);
+    if (axis == Vec3T<T>{ T(0), T(0), T(0) }) {
+        return QuatIdentity<T>();
+    }
+    T s = Sin(angle * T(0.5));
+    return { axis.x * s, axis.y * s, axis.z * s, Cos(angle * T(0.5)) };
+}
+
+//v' = v + w * t + cross(q.xyz, t) with t = 2 * cross(q.xyz, v), for unit q
+template <typename T>
+constexpr Vec3T<T> Rotate(QuatT<T> q, Vec3T<T> v) {
+    return v + Cross(Vec3T<T>{ q.x, q.y, q.z }, Cross(Vec3T<T>{ q.x, q.y, q.z }, v) * T(2))
+             + Cross(Vec3T<T>{ q.x, q.y, q.z }, v) * (T(2) * q.w);
+}
+
+template <typename T>
+constexpr Mat3T<T> ToMat3(QuatT<T> q) {
+    return { { T(1) - T(2) * (q.y * q.y + q.z * q.z),
+               T(2) * (q.x * q.y + q.w * q.z),
+               T(2) * (q.x * q.z - q.w * q.y),
+               T(2) * (q.x * q.y - q.w * q.z),
+               T(1) - T(2) * (q.x * q.x + q.z * q.z),
+               T(2) * (q.y * q.z + q.w * q.x),
+               T(2) * (q.x * q.z + q.w * q.y),
+               T(2) * (q.y * q.z - q.w * q.x),
+               T(1) - T(2) * (q.x * q.x + q.y * q.y) } };
+}
+
+//Expects a pure rotation matrix. Picks the largest of w/x/y/z to divide by,
+//which keeps the result accurate near 180 degree rotations.
+template <typename T>
+inline QuatT<T> QuatFromMat3(const Mat3T<T>& m) {
+    //(row, col) -> m[col * 3 + row]
+    T r00 = m.m[0], r10 = m.m[1], r20 = m.m[2];
+    T r01 = m.m[3], r11 = m.m[4], r21 = m.m[5];
+    T r02 = m.m[6], r12 = m.m[7], r22 = m.m[8];
+    T trace = r00 + r11 + r22;
+    QuatT<T> q;
+    if (trace > T(0)) {
+        T s = Sqrt(trace + T(1)) * T(2);
+        q = { (r21 - r12) / s, (r02 - r20) / s, (r10 - r01) / s, T(0.25) * s };
+    }
+    else if (r00 > r11 && r00 > r22) {
+        T s = Sqrt(T(1) + r00 - r11 - r22) * T(2);
+        q = { T(0.25) * s, (r01 + r10) / s, (r02 + r20) / s, (r21 - r12) / s };
+    }
+    else if (r11 > r22) {
+        T s = Sqrt(T(1) + r11 - r00 - r22) * T(2);
+        q = { (r01 + r10) / s, T(0.25) * s, (r12 + r21) / s, (r02 - r20) / s };
+    }
+    else {
+        T s = Sqrt(T(1) + r22 - r00 - r11) * T(2);
+        q = { (r02 + r20) / s, (r12 + r21) / s, T(0.25) * s, (r10 - r01) / s };
+    }
+    return Normalize(q);
+}
+
+
+//TRS
+//M = Translate * Rotate * Scale, so scale is applied first
+template <typename T>
+inline Mat4T<T> Compose(const TransformT<T>& t) {
+    Mat3T<T> r = ToMat3(t.rotation);
+    return { { r.m[0] * t.scale.x, r.m[1] * t.scale.x, r.m[2] * t.scale.x, T(0),
+               r.m[3] * t.scale.y, r.m[4] * t.scale.y, r.m[5] * t.scale.y, T(0),
+               r.m[6] * t.scale.z, r.m[7] * t.scale.z, r.m[8] * t.scale.z, T(0),
+               t.translation.x, t.translation.y, t.translation.z, T(1) } };
+}
+
+//Inverse of Compose for affine matrices without shear. A mirrored matrix
+//(negative determinant) comes back with a negative scale.x. When an axis scale
+//is below Epsilon the rotation cannot be recovered and is the identity.
+template <typename T>
+inline TransformT<T> Decompose(const Mat4T<T>& m) {
+    TransformT<T> t;
+    t.translation = { m.m[12], m.m[13], m.m[14] };
+
+    Vec3T<T> c0 = { m.m[0], m.m[1], m.m[2] };
+    Vec3T<T> c1 = { m.m[4], m.m[5], m.m[6] };
+    Vec3T<T> c2 = { m.m[8], m.m[9], m.m[10] };
+    t.scale = { Magnitude(c0), Magnitude(c1), Magnitude(c2) };
+    if (Dot(Cross(c0, c1), c2) < T(0)) {
+        t.scale.x = -t.scale.x;
+    }
+
+    if (std::abs(t.scale.x) < Epsilon<T>() || t.scale.y < Epsilon<T>() || t.scale.z < Epsilon<T>()) {
+        t.rotation = QuatIdentity<T>();
+        return t;
+    }
+
+    c0 = c0 / std::abs(t.scale.x);
+    if (t.scale.x < T(0)) {
+        c0 = -c0;
+    }
+    c1 = c1 / t.scale.y;
+    c2 = c2 / t.scale.z;
+    Mat3T<T> r = { { c0.x, c0.y, c0.z, c1.x, c1.y, c1.z, c2.x, c2.y, c2.z } };
+    t.rotation = QuatFromMat3(r);
+    return t;
+}
+
+} // namespace vmath
+
+#endif
@@ -0,0 +1,100 @@
+//Always include the pch.h first in every cpp
+#include "pch.h"
+
+//Then include own items
+#include "VectorMath.h"
+#include "VectorMathAos.h"
+#include "VectorMathKernels.h"
+#include "VectorMathThreads.h"
+#include "VectorMathStats.h"
+
+//Whole-array physics steps. Integration is component-wise, so a packed
+//Vec2/Vec3 array runs through the kernels as one flat stream of 2n / 3n floats
+//and positions and velocities are updated in a single pass.
+//
+//Collision response needs the dot product of each velocity with its normal,
+//so the packed arrays are split into SoA blocks first (VectorMathAos.h).
+
+
+//Integration
+void IntegrateBodies2D(Vec2* positions, Vec2* velocities, const Vec2* accelerations, size_t n, float dt) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.integrateEuler(&positions[begin].x, &velocities[begin].x, accelerations != nullptr ? &accelerations[begin].x : nullptr, dt, (end - begin) * 2);
+	});
+}
+
+void IntegrateBodies(Vec3* positions, Vec3* velocities, const Vec3* accelerations, size_t n, float dt) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.integrateEuler(&positions[begin].x, &velocities[begin].x, accelerations != nullptr ? &accelerations[begin].x : nullptr, dt, (end - begin) * 3);
+	});
+}
+
+void IntegrateBodiesVerlet2D(Vec2* positions, Vec2* previousPositions, const Vec2* accelerations, size_t n, float dt) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.integrateVerlet(&positions[begin].x, &previousPositions[begin].x, accelerations != nullptr ? &accelerations[begin].x : nullptr, dt, (end - begin) * 2);
+	});
+}
+
+void IntegrateBodiesVerlet(Vec3* positions, Vec3* previousPositions, const Vec3* accelerations, size_t n, float dt) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.integrateVerlet(&positions[begin].x, &previousPositions[begin].x, accelerations != nullptr ? &accelerations[begin].x : nullptr, dt, (end - begin) * 3);
+	});
+}
+
+
+//Collision Response
+static int NormalizeNormals(int flags) {
+	return (flags & VECTORMATH_REFLECT_UNIT_NORMALS) != 0 ? 0 : 1;
+}
+
+void VectorReflectResponse2DBatch(float* vx, float* vy, const float* nx, const float* ny, const unsigned char* mask, size_t n, float restitution, float friction, int flags) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.reflectResponse2(vx + begin, vy + begin, nx + begin, ny + begin, mask != nullptr ? mask + begin : nullptr, restitution, friction, NormalizeNormals(flags), end - begin);
+	});
+}
+
+void VectorReflectResponseBatch(float* vx, float* vy, float* vz, const float* nx, const float* ny, const float* nz, const unsigned char* mask, size_t n, float restitution, float friction, int flags) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.reflectResponse3(vx + begin, vy + begin, vz + begin, nx + begin, ny + begin, nz + begin, mask != nullptr ? mask + begin : nullptr, restitution, friction, NormalizeNormals(flags), end - begin);
+	});
+}
+
+void VectorReflectResponse2DArray(Vec2* velocities, const Vec2* normals, const unsigned char* mask, size_t n, float restitution, float friction, int flags) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& kernels = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		AosColumns c(4);
+		ForEachAosBlock(begin, end, [&](size_t first, size_t count) {
+			Split(velocities + first, count, c[0], c[1]);
+			Split(normals + first, count, c[2], c[3]);
+			kernels.reflectResponse2(c[0], c[1], c[2], c[3], mask != nullptr ? mask + first : nullptr, restitution, friction, NormalizeNormals(flags), count);
+			Join(c[0], c[1], count, velocities + first);
+		});
+	});
+}
+
+void VectorReflectResponseArray(Vec3* velocities, const Vec3* normals, const unsigned char* mask, size_t n, float restitution, float friction, int flags) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& kernels = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		AosColumns c(6);
+		ForEachAosBlock(begin, end, [&](size_t first, size_t count) {
+			Split(velocities + first, count, c[0], c[1], c[2]);
+			Split(normals + first, count, c[3], c[4], c[5]);
+			kernels.reflectResponse3(c[0], c[1], c[2], c[3], c[4], c[5], mask != nullptr ? mask + first : nullptr, restitution, friction, NormalizeNormals(flags), count);
+			Join(c[0], c[1], c[2], count, velocities + first);
+		});
+	});
+}
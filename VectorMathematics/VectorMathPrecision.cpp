@@ -0,0 +1,223 @@
+//Always include the pch.h first in every cpp
+#include "pch.h"
+
+//Then include own items
+#include "VectorMath.h"
+#include "VectorMathHalf.h"
+#include "VectorMathKernels.h"
+#include "VectorMathThreads.h"
+#include "VectorMathStats.h"
+
+using namespace vmath;
+
+//Double and 16-bit variants of the vector types. The inline layer is
+//templated on the scalar type, so the double functions are the same
+//templates as the float ones in VectorMath.cpp instantiated for double.
+//The flat conversions forward to the SIMD kernels (F16C / NEON for halves)
+//and are split across the thread pool like the batch functions.
+
+//Half and BFloat16 are single uint16_t structs, so arrays of them are
+//uint16_t arrays for the kernels
+static_assert(sizeof(Half) == sizeof(uint16_t), "Half must be 16 bits");
+static_assert(sizeof(BFloat16) == sizeof(uint16_t), "BFloat16 must be 16 bits");
+static_assert(sizeof(Vec2h) == 2 * sizeof(Half), "Vec2h must be packed");
+
+
+//Double Precision - Vec2
+
+Vec2d VectorAdd2DDouble(Vec2d a, Vec2d b) {
+	VECTORMATH_STATS(1);
+	return a + b;
+}
+
+Vec2d VectorSubtract2DDouble(Vec2d a, Vec2d b) {
+	VECTORMATH_STATS(1);
+	return a - b;
+}
+
+Vec2d VectorScale2DDouble(Vec2d v, double scale) {
+	VECTORMATH_STATS(1);
+	return v * scale;
+}
+
+Vec2d VectorDivide2DDouble(Vec2d v, double scalar) {
+	VECTORMATH_STATS(1);
+	return v / scalar;
+}
+
+double VectorMagnitude2DDouble(Vec2d v) {
+	VECTORMATH_STATS(1);
+	return Magnitude(v);
+}
+
+Vec2d VectorNormalize2DDouble(Vec2d v) {
+	VECTORMATH_STATS(1);
+	return Normalize(v);
+}
+
+double VectorDot2DDouble(Vec2d a, Vec2d b) {
+	VECTORMATH_STATS(1);
+	return Dot(a, b);
+}
+
+double VectorCross2DDouble(Vec2d a, Vec2d b) {
+	VECTORMATH_STATS(1);
+	return Cross(a, b);
+}
+
+Vec2d VectorLerp2DDouble(Vec2d a, Vec2d b, double t) {
+	VECTORMATH_STATS(1);
+	return Lerp(a, b, t);
+}
+
+Vec2d VectorReflect2DDouble(Vec2d v, Vec2d normal) {
+	VECTORMATH_STATS(1);
+	return Reflect(v, normal);
+}
+
+Vec2d VectorClampMagnitude2DDouble(Vec2d v, double maxLength) {
+	VECTORMATH_STATS(1);
+	return ClampMagnitude(v, maxLength);
+}
+
+
+//Double Precision - Vec3
+
+Vec3d VectorAddDouble(Vec3d a, Vec3d b) {
+	VECTORMATH_STATS(1);
+	return a + b;
+}
+
+Vec3d VectorSubtractDouble(Vec3d a, Vec3d b) {
+	VECTORMATH_STATS(1);
+	return a - b;
+}
+
+Vec3d VectorScaleDouble(Vec3d v, double scale) {
+	VECTORMATH_STATS(1);
+	return v * scale;
+}
+
+Vec3d VectorDivideDouble(Vec3d v, double scalar) {
+	VECTORMATH_STATS(1);
+	return v / scalar;
+}
+
+double VectorMagnitudeDouble(Vec3d v) {
+	VECTORMATH_STATS(1);
+	return Magnitude(v);
+}
+
+Vec3d VectorNormalizeDouble(Vec3d v) {
+	VECTORMATH_STATS(1);
+	return Normalize(v);
+}
+
+double VectorDotDouble(Vec3d a, Vec3d b) {
+	VECTORMATH_STATS(1);
+	return Dot(a, b);
+}
+
+Vec3d VectorCrossDouble(Vec3d a, Vec3d b) {
+	VECTORMATH_STATS(1);
+	return Cross(a, b);
+}
+
+Vec3d VectorLerpDouble(Vec3d a, Vec3d b, double t) {
+	VECTORMATH_STATS(1);
+	return Lerp(a, b, t);
+}
+
+Vec3d VectorReflectDouble(Vec3d v, Vec3d normal) {
+	VECTORMATH_STATS(1);
+	return Reflect(v, normal);
+}
+
+Vec3d VectorClampMagnitudeDouble(Vec3d v, double maxLength) {
+	VECTORMATH_STATS(1);
+	return ClampMagnitude(v, maxLength);
+}
+
+
+//Precision Conversion
+
+void ConvertFloatToHalf(const float* in, Half* out, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.floatToHalf(in + begin, &out[begin].bits, end - begin);
+	});
+}
+
+void ConvertHalfToFloat(const Half* in, float* out, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.halfToFloat(&in[begin].bits, out + begin, end - begin);
+	});
+}
+
+void ConvertFloatToBFloat16(const float* in, BFloat16* out, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.floatToBFloat16(in + begin, &out[begin].bits, end - begin);
+	});
+}
+
+void ConvertBFloat16ToFloat(const BFloat16* in, float* out, size_t n) {
+	VECTORMATH_STATS(n);
+	const VectorKernels& k = ActiveKernels();
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		k.bfloat16ToFloat(&in[begin].bits, out + begin, end - begin);
+	});
+}
+
+//Plain loops: the compiler already vectorizes these to cvtps2pd / cvtpd2ps
+void ConvertFloatToDouble(const float* in, double* out, size_t n) {
+	VECTORMATH_STATS(n);
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			out[i] = (double)in[i];
+		}
+	});
+}
+
+void ConvertDoubleToFloat(const double* in, float* out, size_t n) {
+	VECTORMATH_STATS(n);
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			out[i] = (float)in[i];
+		}
+	});
+}
+
+Vec2h VectorToHalf2D(Vec2 v) {
+	VECTORMATH_STATS(1);
+	return ToHalf(v);
+}
+
+Vec2 VectorFromHalf2D(Vec2h v) {
+	VECTORMATH_STATS(1);
+	return ToFloat(v);
+}
+
+Vec2d VectorToDouble2D(Vec2 v) {
+	VECTORMATH_STATS(1);
+	return ConvertVector<double>(v);
+}
+
+Vec2 VectorFromDouble2D(Vec2d v) {
+	VECTORMATH_STATS(1);
+	return ConvertVector<float>(v);
+}
+
+Vec3d VectorToDouble(Vec3 v) {
+	VECTORMATH_STATS(1);
+	return ConvertVector<double>(v);
+}
+
+Vec3 VectorFromDouble(Vec3d v) {
+	VECTORMATH_STATS(1);
+	return ConvertVector<float>(v);
+}
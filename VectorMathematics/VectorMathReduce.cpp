@@ -0,0 +1,302 @@
+//Always include the pch.h first in every cpp
+#include "pch.h"
+
+//Then include own items
+#include "VectorMath.h"
+#include "VectorMathArena.h"
+#include "VectorMathKernels.h"
+#include "VectorMathStats.h"
+#include "VectorMathThreads.h"
+#include <cstdint>
+#include <limits>
+
+//Reductions over packed Vec2 / Vec3 arrays.
+//The arrays are read as flat float streams in fixed blocks of kReduceBlock
+//floats. Each block is reduced by the active kernels into kReduceLanes lane
+//accumulators (lane % components is the component), the blocks run in
+//parallel, and the block results are combined in block order. Nothing depends
+//on the thread count or instruction set, so the results are bit-identical
+//everywhere. Each lane adds at most kReduceBlock / kReduceLanes floats, and
+//the lanes and blocks are then added pairwise (or in double for Kahan sums).
+//A pass is one read of the array with a few register operations per load, so
+//large arrays run at memory bandwidth.
+
+using namespace vmath;
+
+//256 groups of 24 floats, 24 KB: a block stays in L1 while its lanes are combined
+static const size_t kReduceBlock = 256 * kReduceLanes;
+
+//Vectors per block of the magnitude scan (their squared lengths fill 8 KB)
+static const size_t kMagnitudeBlock = 2048;
+
+static const float kInfinity = std::numeric_limits<float>::infinity();
+
+static inline size_t BlockCount(size_t n, size_t block) {
+	return (n + block - 1) / block;
+}
+
+static inline size_t BlockSize(size_t b, size_t n, size_t block) {
+	return b * block + block <= n ? block : n - b * block;
+}
+
+//values[0], values[stride], ... (count of them) added pairwise: neighbours
+//first, then pairs of pairs, so the rounding error grows with log(count)
+static float PairwiseSum(const float* values, size_t count, size_t stride) {
+	if (count == 1) {
+		return values[0];
+	}
+	size_t half = count / 2;
+	return PairwiseSum(values, half, stride) + PairwiseSum(values + half * stride, count - half, stride);
+}
+
+//Per-component sums of a flat stream (of products a[i] * b[i] when b is not
+//nullptr), components interleaved, returned in double.
+static void SumComponents(const float* a, const float* b, size_t count, size_t components, int mode, double* out) {
+	for (size_t c = 0; c < components; ++c) {
+		out[c] = 0.0;
+	}
+	if (count == 0) {
+		return;
+	}
+	const VectorKernels& kernels = ActiveKernels();
+	bool kahan = mode == VECTORMATH_SUM_KAHAN;
+	size_t blocks = BlockCount(count, kReduceBlock);
+	ScratchBuffer<float> lanes(blocks * kReduceLanes);
+	ScratchBuffer<float> compensation(kahan ? blocks * kReduceLanes : 1);
+
+	ParallelBlocks(count, blocks, [&](size_t firstBlock, size_t endBlock) {
+		//Kahan dot totals sum the products rounded to float, like dotSum
+		ScratchBuffer<float> products(kahan && b != nullptr ? kReduceBlock : 1);
+		for (size_t block = firstBlock; block < endBlock; ++block) {
+			float* blockLanes = &lanes[block * kReduceLanes];
+			size_t offset = block * kReduceBlock;
+			size_t size = BlockSize(block, count, kReduceBlock);
+			for (size_t lane = 0; lane < kReduceLanes; ++lane) {
+				blockLanes[lane] = 0.0f;
+			}
+			if (kahan) {
+				float* blockCompensation = &compensation[block * kReduceLanes];
+				for (size_t lane = 0; lane < kReduceLanes; ++lane) {
+					blockCompensation[lane] = 0.0f;
+				}
+				const float* values = a + offset;
+				if (b != nullptr) {
+					for (size_t i = 0; i < size; ++i) {
+						products[i] = a[offset + i] * b[offset + i];
+					}
+					values = products.Data();
+				}
+				kernels.sumKahan(values, blockLanes, blockCompensation, size);
+			}
+			else if (b != nullptr) {
+				kernels.dotSum(a + offset, b + offset, blockLanes, size);
+			}
+			else {
+				kernels.sum(a + offset, blockLanes, size);
+			}
+		}
+	});
+
+	if (kahan) {
+		//Each lane holds its sum minus the compensation; double keeps the
+		//total as accurate as the lanes
+		for (size_t block = 0; block < blocks; ++block) {
+			for (size_t lane = 0; lane < kReduceLanes; ++lane) {
+				size_t i = block * kReduceLanes + lane;
+				out[lane % components] += (double)lanes[i] - (double)compensation[i];
+			}
+		}
+		return;
+	}
+
+	float laneTotals[kReduceLanes];
+	for (size_t lane = 0; lane < kReduceLanes; ++lane) {
+		laneTotals[lane] = PairwiseSum(&lanes[lane], blocks, kReduceLanes);
+	}
+	for (size_t c = 0; c < components; ++c) {
+		out[c] = PairwiseSum(laneTotals + c, kReduceLanes / components, components);
+	}
+}
+
+//Component-wise min / max of a flat stream, NaN skipped
+void BoundsComponents(const float* in, size_t count, size_t components, float* outMin, float* outMax) {
+	size_t blocks = BlockCount(count, kReduceBlock);
+	ScratchBuffer<float> minLanes(blocks * kReduceLanes + 1);
+	ScratchBuffer<float> maxLanes(blocks * kReduceLanes + 1);
+	const VectorKernels& kernels = ActiveKernels();
+	ParallelBlocks(count, blocks, [&](size_t firstBlock, size_t endBlock) {
+		for (size_t block = firstBlock; block < endBlock; ++block) {
+			float* lo = &minLanes[block * kReduceLanes];
+			float* hi = &maxLanes[block * kReduceLanes];
+			for (size_t lane = 0; lane < kReduceLanes; ++lane) {
+				lo[lane] = kInfinity;
+				hi[lane] = -kInfinity;
+			}
+			kernels.minMax(in + block * kReduceBlock, lo, hi, BlockSize(block, count, kReduceBlock));
+		}
+	});
+	for (size_t c = 0; c < components; ++c) {
+		outMin[c] = kInfinity;
+		outMax[c] = -kInfinity;
+	}
+	for (size_t i = 0; i < blocks * kReduceLanes; ++i) {
+		size_t c = i % components;
+		outMin[c] = minLanes[i] < outMin[c] ? minLanes[i] : outMin[c];
+		outMax[c] = maxLanes[i] > outMax[c] ? maxLanes[i] : outMax[c];
+	}
+}
+
+//Candidate for the shortest / longest vector; index SIZE_MAX when there is none
+struct MagnitudeCandidate {
+	float value;
+	size_t index;
+};
+
+//Smaller value wins for the min (larger for the max), ties go to the lower index
+static inline void KeepMin(MagnitudeCandidate& best, float value, size_t index) {
+	if (index != SIZE_MAX && (value < best.value || (value == best.value && index < best.index))) {
+		best.value = value;
+		best.index = index;
+	}
+}
+
+static inline void KeepMax(MagnitudeCandidate& best, float value, size_t index) {
+	if (index != SIZE_MAX && (value > best.value || (value == best.value && index < best.index))) {
+		best.value = value;
+		best.index = index;
+	}
+}
+
+//Squared lengths per block into an L1 sized buffer, then the index scan
+static void MagnitudeRange(const float* in, size_t n, size_t components, VectorMathMagnitudeRange* out) {
+	const VectorKernels& kernels = ActiveKernels();
+	size_t blocks = BlockCount(n, kMagnitudeBlock);
+	ScratchBuffer<MagnitudeCandidate> blockMin(blocks + 1);
+	ScratchBuffer<MagnitudeCandidate> blockMax(blocks + 1);
+
+	ParallelBlocks(n * components, blocks, [&](size_t firstBlock, size_t endBlock) {
+		ScratchBuffer<float> lengths(kMagnitudeBlock);
+		float minLanes[kReduceLanes];
+		float maxLanes[kReduceLanes];
+		uint32_t minIndex[kReduceLanes];
+		uint32_t maxIndex[kReduceLanes];
+		for (size_t block = firstBlock; block < endBlock; ++block) {
+			size_t size = BlockSize(block, n, kMagnitudeBlock);
+			const float* vectors = in + block * kMagnitudeBlock * components;
+			if (components == 2) {
+				kernels.dotPacked2(vectors, vectors, lengths.Data(), size);
+			}
+			else {
+				kernels.dotPacked3(vectors, vectors, lengths.Data(), size);
+			}
+			//Squared lengths are never negative, so -1 loses to any of them
+			for (size_t lane = 0; lane < kReduceLanes; ++lane) {
+				minLanes[lane] = kInfinity;
+				maxLanes[lane] = -1.0f;
+				minIndex[lane] = UINT32_MAX;
+				maxIndex[lane] = UINT32_MAX;
+			}
+			kernels.minMaxIndex(lengths.Data(), 0, minLanes, minIndex, maxLanes, maxIndex, size);
+
+			MagnitudeCandidate lo = { kInfinity, SIZE_MAX };
+			MagnitudeCandidate hi = { -1.0f, SIZE_MAX };
+			for (size_t lane = 0; lane < kReduceLanes; ++lane) {
+				KeepMin(lo, minLanes[lane], minIndex[lane] != UINT32_MAX ? block * kMagnitudeBlock + minIndex[lane] : SIZE_MAX);
+				KeepMax(hi, maxLanes[lane], maxIndex[lane] != UINT32_MAX ? block * kMagnitudeBlock + maxIndex[lane] : SIZE_MAX);
+			}
+			blockMin[block] = lo;
+			blockMax[block] = hi;
+		}
+	});
+
+	MagnitudeCandidate lo = { kInfinity, SIZE_MAX };
+	MagnitudeCandidate hi = { -1.0f, SIZE_MAX };
+	for (size_t block = 0; block < blocks; ++block) {
+		KeepMin(lo, blockMin[block].value, blockMin[block].index);
+		KeepMax(hi, blockMax[block].value, blockMax[block].index);
+	}
+	//Only infinitely long vectors: the first one is both
+	if (lo.index == SIZE_MAX && hi.index != SIZE_MAX) {
+		lo = hi;
+	}
+	out->minMagnitude = lo.index != SIZE_MAX ? Sqrt(lo.value) : 0.0f;
+	out->maxMagnitude = hi.index != SIZE_MAX ? Sqrt(hi.value) : 0.0f;
+	out->minIndex = lo.index;
+	out->maxIndex = hi.index;
+}
+
+void VectorBounds2DArray(const Vec2* v, size_t n, Vec2* outMin, Vec2* outMax) {
+	VECTORMATH_STATS(n);
+	float lo[2];
+	float hi[2];
+	BoundsComponents((const float*)v, n * 2, 2, lo, hi);
+	*outMin = { lo[0], lo[1] };
+	*outMax = { hi[0], hi[1] };
+}
+
+void VectorBoundsArray(const Vec3* v, size_t n, Vec3* outMin, Vec3* outMax) {
+	VECTORMATH_STATS(n);
+	float lo[3];
+	float hi[3];
+	BoundsComponents((const float*)v, n * 3, 3, lo, hi);
+	*outMin = { lo[0], lo[1], lo[2] };
+	*outMax = { hi[0], hi[1], hi[2] };
+}
+
+Vec2 VectorSum2DArray(const Vec2* v, size_t n, int mode) {
+	VECTORMATH_STATS(n);
+	double sum[2];
+	SumComponents((const float*)v, nullptr, n * 2, 2, mode, sum);
+	return { (float)sum[0], (float)sum[1] };
+}
+
+Vec3 VectorSumArray(const Vec3* v, size_t n, int mode) {
+	VECTORMATH_STATS(n);
+	double sum[3];
+	SumComponents((const float*)v, nullptr, n * 3, 3, mode, sum);
+	return { (float)sum[0], (float)sum[1], (float)sum[2] };
+}
+
+Vec2 VectorCentroid2DArray(const Vec2* v, size_t n) {
+	VECTORMATH_STATS(n);
+	if (n == 0) {
+		return { 0.0f, 0.0f };
+	}
+	double sum[2];
+	SumComponents((const float*)v, nullptr, n * 2, 2, VECTORMATH_SUM_KAHAN, sum);
+	return { (float)(sum[0] / (double)n), (float)(sum[1] / (double)n) };
+}
+
+Vec3 VectorCentroidArray(const Vec3* v, size_t n) {
+	VECTORMATH_STATS(n);
+	if (n == 0) {
+		return { 0.0f, 0.0f, 0.0f };
+	}
+	double sum[3];
+	SumComponents((const float*)v, nullptr, n * 3, 3, VECTORMATH_SUM_KAHAN, sum);
+	return { (float)(sum[0] / (double)n), (float)(sum[1] / (double)n), (float)(sum[2] / (double)n) };
+}
+
+float VectorDotTotal2DArray(const Vec2* a, const Vec2* b, size_t n, int mode) {
+	VECTORMATH_STATS(n);
+	double sum;
+	SumComponents((const float*)a, (const float*)b, n * 2, 1, mode, &sum);
+	return (float)sum;
+}
+
+float VectorDotTotalArray(const Vec3* a, const Vec3* b, size_t n, int mode) {
+	VECTORMATH_STATS(n);
+	double sum;
+	SumComponents((const float*)a, (const float*)b, n * 3, 1, mode, &sum);
+	return (float)sum;
+}
+
+void VectorMagnitudeRange2DArray(const Vec2* v, size_t n, VectorMathMagnitudeRange* out) {
+	VECTORMATH_STATS(n);
+	MagnitudeRange((const float*)v, n, 2, out);
+}
+
+void VectorMagnitudeRangeArray(const Vec3* v, size_t n, VectorMathMagnitudeRange* out) {
+	VECTORMATH_STATS(n);
+	MagnitudeRange((const float*)v, n, 3, out);
+}
@@ -0,0 +1,860 @@
+//Always include the pch.h first in every cpp
+#include "pch.h"
+
+//Then include own items
+#include "VectorMath.h"
+#include "VectorMathArena.h"
+#include "VectorMathStats.h"
+#include "VectorMathThreads.h"
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#if !defined(VECTORMATH_NO_THREADS)
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#endif
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+//Chunked, columnar snapshot files.
+//
+//  FileHeader, channel descriptors, padding to 64 bytes
+//  Chunk 0: ChunkHeader, one ColumnHeader per channel, the columns
+//  Chunk 1 ...
+//  Chunk index (one file offset per chunk), Footer
+//
+//Every chunk holds framesPerChunk frames (the last one may hold fewer) and
+//stores each channel as one column, every column 64-byte aligned. A raw column
+//is the frames' floats back to back, so a frame can be used in place from the
+//mapping. A delta column starts with the first frame quantized to int32
+//(value / step, rounded), followed by the change of every value from the
+//previous frame as int8, int16 or int32, the smallest that holds every change
+//in the column. Decoding adds the changes up again, so the values come back
+//exactly as quantized and there is no drift over a chunk.
+//
+//The index and footer are written on close. A file without them (the writer
+//never closed) is read by walking the chunk headers up to the last complete
+//chunk. All fields are little-endian, like every platform the library runs on.
+
+using namespace vmath;
+
+static const char kFileMagic[8] = { 'V', 'M', 'S', 'N', 'A', 'P', 'S', 'H' };
+static const char kFooterMagic[8] = { 'V', 'M', 'S', 'N', 'A', 'P', 'I', 'X' };
+static const uint32_t kChunkMagic = 0x4b43534du; //"MSCK"
+static const uint32_t kSnapshotVersion = 1;
+static const uint32_t kDefaultFramesPerChunk = 64;
+static const size_t kSnapshotAlignment = 64;
+
+struct SnapshotFileHeader {
+	char magic[8];
+	uint32_t version;
+	uint32_t channelCount;
+	uint32_t framesPerChunk;
+	uint32_t headerSize; //up to the first chunk
+	uint64_t reserved[3];
+};
+
+struct SnapshotChunkHeader {
+	uint32_t magic;
+	uint32_t frameCount;
+	uint64_t firstFrame;
+	uint64_t size; //whole chunk, headers and padding included
+	uint64_t reserved;
+};
+
+struct SnapshotColumnHeader {
+	uint64_t offset; //from the start of the chunk
+	uint32_t width;  //0 = raw floats, else bytes per delta
+	uint32_t reserved;
+};
+
+struct SnapshotFooter {
+	uint64_t indexOffset;
+	uint64_t chunkCount;
+	uint64_t frameCount;
+	char magic[8];
+};
+
+static_assert(sizeof(SnapshotFileHeader) == 48, "snapshot file header layout");
+static_assert(sizeof(SnapshotChunkHeader) == 32, "snapshot chunk header layout");
+static_assert(sizeof(SnapshotColumnHeader) == 16, "snapshot column header layout");
+static_assert(sizeof(SnapshotFooter) == 32, "snapshot footer layout");
+static_assert(sizeof(VectorMathSnapshotChannel) == 48, "snapshot channel layout");
+
+static inline size_t AlignSize(size_t size) {
+	return (size + kSnapshotAlignment - 1) & ~(kSnapshotAlignment - 1);
+}
+
+static inline size_t FrameFloats(const VectorMathSnapshotChannel& channel) {
+	return (size_t)channel.count * channel.components;
+}
+
+static inline size_t ChunkHeaderSize(size_t channelCount) {
+	return AlignSize(sizeof(SnapshotChunkHeader) + channelCount * sizeof(SnapshotColumnHeader));
+}
+
+static inline size_t FileHeaderSize(size_t channelCount) {
+	return AlignSize(sizeof(SnapshotFileHeader) + channelCount * sizeof(VectorMathSnapshotChannel));
+}
+
+static bool IsValidChannel(const VectorMathSnapshotChannel& channel) {
+	if (channel.components < 1 || channel.components > 4 || channel.count == 0) {
+		return false;
+	}
+	if (channel.encoding == VECTORMATH_SNAPSHOT_RAW) {
+		return true;
+	}
+	//The step must be a positive finite number
+	return channel.encoding == VECTORMATH_SNAPSHOT_DELTA && channel.step > 0.0f && channel.step <= 3.4e38f;
+}
+
+//Rounded to the nearest multiple of step (halves away from zero), saturated
+//to the int32 range; NaN becomes 0. Done in double, so every compiler and CPU
+//agrees.
+static inline uint32_t Quantize(float value, double inverseStep) {
+	double scaled = (double)value * inverseStep;
+	if (!(scaled == scaled)) {
+		return 0;
+	}
+	if (scaled >= 2147483647.0) {
+		return 0x7fffffffu;
+	}
+	if (scaled <= -2147483648.0) {
+		return 0x80000000u;
+	}
+	double rounded = scaled >= 0.0 ? std::floor(scaled + 0.5) : std::ceil(scaled - 0.5);
+	return (uint32_t)(int32_t)rounded;
+}
+
+static inline float Dequantize(uint32_t q, double step) {
+	return (float)((double)(int32_t)q * step);
+}
+
+
+//Writer
+//The calling thread copies each frame into the open chunk. Full chunks are
+//handed to the writer thread, which encodes them and writes them to the file,
+//so a frame never waits on the disk unless kMaxPendingChunks are queued.
+
+static const size_t kMaxPendingChunks = 8;
+
+struct SnapshotChunk {
+	uint64_t firstFrame;
+	uint32_t frameCount;
+	std::vector<float> values; //channel columns, framesPerChunk frames each
+};
+
+struct SnapshotWriter {
+	FILE* file;
+	std::vector<VectorMathSnapshotChannel> channels;
+	std::vector<size_t> frameStart;  //offset of each channel in current
+	std::vector<size_t> columnStart; //offset of each channel column in a chunk
+	uint32_t framesPerChunk;
+	size_t frameFloats;              //all channels
+
+	std::vector<float> current;      //the frame being written
+	std::unique_ptr<SnapshotChunk> open;
+	uint64_t frameCount;
+
+	//Owned by whichever thread writes the chunks
+	uint64_t fileOffset;
+	std::vector<uint64_t> chunkOffsets;
+	std::vector<uint8_t> encoded;
+	std::vector<uint32_t> quantized;
+	bool failed;
+
+#if !defined(VECTORMATH_NO_THREADS)
+	std::mutex lock; //guards everything below and failed
+	std::condition_variable wake;
+	std::condition_variable drained;
+	std::deque<std::unique_ptr<SnapshotChunk>> pending;
+	std::vector<std::unique_ptr<SnapshotChunk>> spare;
+	bool stopping;
+	std::thread thread;
+#endif
+};
+
+static bool WriteBytes(SnapshotWriter* writer, const void* data, size_t size) {
+	if (size > 0 && fwrite(data, 1, size, writer->file) != size) {
+		return false;
+	}
+	writer->fileOffset += size;
+	return true;
+}
+
+template <typename T>
+static void StoreDeltas(uint8_t* out, const uint32_t* previous, const uint32_t* next, size_t count) {
+	T* deltas = (T*)out;
+	for (size_t i = 0; i < count; ++i) {
+		deltas[i] = (T)(int32_t)(next[i] - previous[i]);
+	}
+}
+
+//Bytes per change needed for every change in the column
+static uint32_t DeltaWidth(const uint32_t* quantized, size_t frameFloats, uint32_t frameCount) {
+	uint32_t width = 1;
+	for (size_t i = frameFloats; i < (size_t)frameCount * frameFloats; ++i) {
+		int32_t delta = (int32_t)(quantized[i] - quantized[i - frameFloats]);
+		if (delta < -32768 || delta > 32767) {
+			return 4;
+		}
+		if (delta < -128 || delta > 127) {
+			width = 2;
+		}
+	}
+	return width;
+}
+
+//Encodes one chunk into writer->encoded
+static void EncodeChunk(SnapshotWriter* writer, const SnapshotChunk& chunk) {
+	size_t channelCount = writer->channels.size();
+	std::vector<SnapshotColumnHeader> columns(channelCount);
+
+	//Lay out the columns first, quantizing the delta ones to size them
+	size_t size = ChunkHeaderSize(channelCount);
+	size_t quantizedFloats = 0;
+	for (size_t c = 0; c < channelCount; ++c) {
+		if (writer->channels[c].encoding == VECTORMATH_SNAPSHOT_DELTA) {
+			quantizedFloats += (size_t)chunk.frameCount * FrameFloats(writer->channels[c]);
+		}
+	}
+	writer->quantized.resize(quantizedFloats);
+
+	size_t quantizedStart = 0;
+	for (size_t c = 0; c < channelCount; ++c) {
+		const VectorMathSnapshotChannel& channel = writer->channels[c];
+		size_t frameFloats = FrameFloats(channel);
+		size_t columnFloats = (size_t)chunk.frameCount * frameFloats;
+		const float* values = chunk.values.data() + writer->columnStart[c];
+
+		columns[c].offset = size;
+		columns[c].reserved = 0;
+		if (channel.encoding == VECTORMATH_SNAPSHOT_RAW) {
+			columns[c].width = 0;
+			size += AlignSize(columnFloats * sizeof(float));
+			continue;
+		}
+
+		uint32_t* quantized = writer->quantized.data() + quantizedStart;
+		double inverseStep = 1.0 / (double)channel.step;
+		for (size_t i = 0; i < columnFloats; ++i) {
+			quantized[i] = Quantize(values[i], inverseStep);
+		}
+		columns[c].width = DeltaWidth(quantized, frameFloats, chunk.frameCount);
+		size += AlignSize(frameFloats * sizeof(uint32_t) + (columnFloats - frameFloats) * columns[c].width);
+		quantizedStart += columnFloats;
+	}
+
+	writer->encoded.assign(size, 0);
+	uint8_t* out = writer->encoded.data();
+
+	SnapshotChunkHeader header = {};
+	header.magic = kChunkMagic;
+	header.frameCount = chunk.frameCount;
+	header.firstFrame = chunk.firstFrame;
+	header.size = size;
+	memcpy(out, &header, sizeof(header));
+	memcpy(out + sizeof(header), columns.data(), channelCount * sizeof(SnapshotColumnHeader));
+
+	quantizedStart = 0;
+	for (size_t c = 0; c < channelCount; ++c) {
+		size_t frameFloats = FrameFloats(writer->channels[c]);
+		size_t columnFloats = (size_t)chunk.frameCount * frameFloats;
+		uint8_t* column = out + columns[c].offset;
+
+		if (columns[c].width == 0) {
+			memcpy(column, chunk.values.data() + writer->columnStart[c], columnFloats * sizeof(float));
+			continue;
+		}
+
+		const uint32_t* quantized = writer->quantized.data() + quantizedStart;
+		memcpy(column, quantized, frameFloats * sizeof(uint32_t));
+		uint8_t* deltas = column + frameFloats * sizeof(uint32_t);
+		for (uint32_t f = 1; f < chunk.frameCount; ++f) {
+			const uint32_t* previous = quantized + (f - 1) * frameFloats;
+			uint8_t* frameDeltas = deltas + (f - 1) * frameFloats * columns[c].width;
+			if (columns[c].width == 1) {
+				StoreDeltas<int8_t>(frameDeltas, previous, previous + frameFloats, frameFloats);
+			}
+			else if (columns[c].width == 2) {
+				StoreDeltas<int16_t>(frameDeltas, previous, previous + frameFloats, frameFloats);
+			}
+			else {
+				StoreDeltas<int32_t>(frameDeltas, previous, previous + frameFloats, frameFloats);
+			}
+		}
+		quantizedStart += columnFloats;
+	}
+}
+
+//Runs on the writer thread (or the caller without threads)
+static bool WriteChunk(SnapshotWriter* writer, const SnapshotChunk& chunk) {
+	EncodeChunk(writer, chunk);
+	uint64_t offset = writer->fileOffset;
+	if (!WriteBytes(writer, writer->encoded.data(), writer->encoded.size())) {
+		return false;
+	}
+	writer->chunkOffsets.push_back(offset);
+	return true;
+}
+
+#if !defined(VECTORMATH_NO_THREADS)
+
+static void WriterThread(SnapshotWriter* writer) {
+	std::unique_lock<std::mutex> guard(writer->lock);
+	for (;;) {
+		writer->wake.wait(guard, [writer]() { return writer->stopping || !writer->pending.empty(); });
+		if (writer->pending.empty()) {
+			return;
+		}
+		std::unique_ptr<SnapshotChunk> chunk = std::move(writer->pending.front());
+		bool failed = writer->failed;
+		guard.unlock();
+
+		//After a failure the remaining chunks are dropped
+		bool written = !failed && WriteChunk(writer, *chunk);
+
+		guard.lock();
+		writer->failed = writer->failed || !written;
+		writer->pending.pop_front();
+		writer->spare.push_back(std::move(chunk));
+		writer->drained.notify_all();
+	}
+}
+
+#endif
+
+static std::unique_ptr<SnapshotChunk> NewChunk(SnapshotWriter* writer) {
+#if !defined(VECTORMATH_NO_THREADS)
+	{
+		std::lock_guard<std::mutex> guard(writer->lock);
+		if (!writer->spare.empty()) {
+			std::unique_ptr<SnapshotChunk> chunk = std::move(writer->spare.back());
+			writer->spare.pop_back();
+			return chunk;
+		}
+	}
+#endif
+	std::unique_ptr<SnapshotChunk> chunk(new SnapshotChunk());
+	chunk->values.resize(writer->framesPerChunk * writer->frameFloats);
+	return chunk;
+}
+
+//Hands the open chunk over to be written
+static void SubmitChunk(SnapshotWriter* writer) {
+	std::unique_ptr<SnapshotChunk> chunk = std::move(writer->open);
+#if defined(VECTORMATH_NO_THREADS)
+	writer->failed = writer->failed || !WriteChunk(writer, *chunk);
+#else
+	std::unique_lock<std::mutex> guard(writer->lock);
+	writer->drained.wait(guard, [writer]() { return writer->pending.size() < kMaxPendingChunks; });
+	writer->pending.push_back(std::move(chunk));
+	writer->wake.notify_one();
+#endif
+}
+
+static bool HasFailed(SnapshotWriter* writer) {
+#if !defined(VECTORMATH_NO_THREADS)
+	std::lock_guard<std::mutex> guard(writer->lock);
+#endif
+	return writer->failed;
+}
+
+
+SnapshotWriter* SnapshotWriterCreate(const char* path, const VectorMathSnapshotChannel* channels, size_t channelCount, uint32_t framesPerChunk) {
+	VECTORMATH_STATS(channelCount);
+	if (path == nullptr || channels == nullptr || channelCount == 0 || channelCount > 0xffff) {
+		return nullptr;
+	}
+	for (size_t c = 0; c < channelCount; ++c) {
+		if (!IsValidChannel(channels[c])) {
+			return nullptr;
+		}
+	}
+	FILE* file = fopen(path, "wb");
+	if (file == nullptr) {
+		return nullptr;
+	}
+
+	SnapshotWriter* writer = new SnapshotWriter();
+	writer->file = file;
+	writer->channels.assign(channels, channels + channelCount);
+	writer->framesPerChunk = framesPerChunk > 0 ? framesPerChunk : kDefaultFramesPerChunk;
+	writer->frameFloats = 0;
+	for (VectorMathSnapshotChannel& channel : writer->channels) {
+		//Names are always terminated in the file
+		channel.name[sizeof(channel.name) - 1] = '\0';
+		writer->frameStart.push_back(writer->frameFloats);
+		writer->columnStart.push_back(writer->frameFloats * writer->framesPerChunk);
+		writer->frameFloats += FrameFloats(channel);
+	}
+	writer->current.assign(writer->frameFloats, 0.0f);
+	writer->frameCount = 0;
+	writer->fileOffset = 0;
+	writer->failed = false;
+
+	std::vector<uint8_t> header(FileHeaderSize(channelCount), 0);
+	SnapshotFileHeader fileHeader = {};
+	memcpy(fileHeader.magic, kFileMagic, sizeof(kFileMagic));
+	fileHeader.version = kSnapshotVersion;
+	fileHeader.channelCount = (uint32_t)channelCount;
+	fileHeader.framesPerChunk = writer->framesPerChunk;
+	fileHeader.headerSize = (uint32_t)header.size();
+	memcpy(header.data(), &fileHeader, sizeof(fileHeader));
+	memcpy(header.data() + sizeof(fileHeader), writer->channels.data(), channelCount * sizeof(VectorMathSnapshotChannel));
+	if (!WriteBytes(writer, header.data(), header.size())) {
+		fclose(file);
+		delete writer;
+		return nullptr;
+	}
+
+	writer->open = NewChunk(writer);
+#if !defined(VECTORMATH_NO_THREADS)
+	writer->stopping = false;
+	writer->thread = std::thread(WriterThread, writer);
+#endif
+	return writer;
+}
+
+int SnapshotWriterWrite(SnapshotWriter* writer, size_t channel, const float* values) {
+	VECTORMATH_STATS(1);
+	if (writer == nullptr || values == nullptr || channel >= writer->channels.size()) {
+		return 0;
+	}
+	memcpy(writer->current.data() + writer->frameStart[channel], values, FrameFloats(writer->channels[channel]) * sizeof(float));
+	return HasFailed(writer) ? 0 : 1;
+}
+
+int SnapshotWriterEndFrame(SnapshotWriter* writer) {
+	VECTORMATH_STATS(1);
+	if (writer == nullptr) {
+		return 0;
+	}
+	SnapshotChunk& chunk = *writer->open;
+	if (writer->frameCount % writer->framesPerChunk == 0) {
+		chunk.firstFrame = writer->frameCount;
+		chunk.frameCount = 0;
+	}
+	for (size_t c = 0; c < writer->channels.size(); ++c) {
+		size_t frameFloats = FrameFloats(writer->channels[c]);
+		memcpy(chunk.values.data() + writer->columnStart[c] + chunk.frameCount * frameFloats,
+			writer->current.data() + writer->frameStart[c], frameFloats * sizeof(float));
+	}
+	++chunk.frameCount;
+	++writer->frameCount;
+
+	if (chunk.frameCount == writer->framesPerChunk) {
+		SubmitChunk(writer);
+		writer->open = NewChunk(writer);
+	}
+	return HasFailed(writer) ? 0 : 1;
+}
+
+uint64_t SnapshotWriterFrameCount(const SnapshotWriter* writer) {
+	VECTORMATH_STATS(1);
+	return writer != nullptr ? writer->frameCount : 0;
+}
+
+int SnapshotWriterClose(SnapshotWriter* writer) {
+	VECTORMATH_STATS(1);
+	if (writer == nullptr) {
+		return 0;
+	}
+	if (writer->frameCount % writer->framesPerChunk != 0) {
+		SubmitChunk(writer);
+	}
+#if !defined(VECTORMATH_NO_THREADS)
+	{
+		std::lock_guard<std::mutex> guard(writer->lock);
+		writer->stopping = true;
+		writer->wake.notify_one();
+	}
+	writer->thread.join();
+#endif
+
+	bool ok = !writer->failed;
+	if (ok) {
+		SnapshotFooter footer = {};
+		footer.indexOffset = writer->fileOffset;
+		footer.chunkCount = writer->chunkOffsets.size();
+		footer.frameCount = writer->frameCount;
+		memcpy(footer.magic, kFooterMagic, sizeof(kFooterMagic));
+		ok = WriteBytes(writer, writer->chunkOffsets.data(), writer->chunkOffsets.size() * sizeof(uint64_t)) &&
+			WriteBytes(writer, &footer, sizeof(footer));
+	}
+	ok = fclose(writer->file) == 0 && ok;
+	delete writer;
+	return ok ? 1 : 0;
+}
+
+
+//Reader
+//The whole file is mapped read-only. Open checks every chunk header once, so
+//the lookups below are plain arithmetic and cannot run off the mapping.
+
+struct SnapshotReader {
+	const uint8_t* data;
+	size_t size;
+#if defined(_WIN32)
+	HANDLE file;
+	HANDLE mapping;
+#endif
+	std::vector<VectorMathSnapshotChannel> channels;
+	uint32_t framesPerChunk;
+	uint64_t frameCount;
+	std::vector<uint64_t> chunkOffsets;
+};
+
+static bool MapFile(SnapshotReader* reader, const char* path) {
+#if defined(_WIN32)
+	reader->file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (reader->file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(reader->file, &size) || size.QuadPart == 0 || (uint64_t)size.QuadPart > (uint64_t)SIZE_MAX) {
+		CloseHandle(reader->file);
+		return false;
+	}
+	reader->mapping = CreateFileMappingA(reader->file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (reader->mapping == nullptr) {
+		CloseHandle(reader->file);
+		return false;
+	}
+	reader->data = (const uint8_t*)MapViewOfFile(reader->mapping, FILE_MAP_READ, 0, 0, 0);
+	if (reader->data == nullptr) {
+		CloseHandle(reader->mapping);
+		CloseHandle(reader->file);
+		return false;
+	}
+	reader->size = (size_t)size.QuadPart;
+	return true;
+#else
+	int file = open(path, O_RDONLY);
+	if (file < 0) {
+		return false;
+	}
+	struct stat info;
+	if (fstat(file, &info) != 0 || info.st_size <= 0 || (uint64_t)info.st_size > (uint64_t)SIZE_MAX) {
+		close(file);
+		return false;
+	}
+	void* data = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_SHARED, file, 0);
+	//The mapping keeps the file open
+	close(file);
+	if (data == MAP_FAILED) {
+		return false;
+	}
+	//Replays read front to back: ask for more read-ahead
+	madvise(data, (size_t)info.st_size, MADV_SEQUENTIAL);
+	reader->data = (const uint8_t*)data;
+	reader->size = (size_t)info.st_size;
+	return true;
+#endif
+}
+
+static void UnmapFile(SnapshotReader* reader) {
+#if defined(_WIN32)
+	UnmapViewOfFile(reader->data);
+	CloseHandle(reader->mapping);
+	CloseHandle(reader->file);
+#else
+	munmap((void*)reader->data, reader->size);
+#endif
+}
+
+//Checks the chunk at offset (the index-th one) and returns its size, or 0 when
+//it is not a complete, well-formed chunk
+static uint64_t CheckChunk(const SnapshotReader* reader, uint64_t offset, uint64_t index, uint64_t end) {
+	size_t channelCount = reader->channels.size();
+	if (offset % kSnapshotAlignment != 0 || offset > end || end - offset < ChunkHeaderSize(channelCount)) {
+		return 0;
+	}
+	SnapshotChunkHeader header;
+	memcpy(&header, reader->data + offset, sizeof(header));
+	if (header.magic != kChunkMagic || header.firstFrame != index * reader->framesPerChunk ||
+		header.frameCount == 0 || header.frameCount > reader->framesPerChunk ||
+		header.size > end - offset || header.size < ChunkHeaderSize(channelCount)) {
+		return 0;
+	}
+	const uint8_t* columns = reader->data + offset + sizeof(header);
+	for (size_t c = 0; c < channelCount; ++c) {
+		SnapshotColumnHeader column;
+		memcpy(&column, columns + c * sizeof(column), sizeof(column));
+		size_t frameFloats = FrameFloats(reader->channels[c]);
+		uint64_t columnSize;
+		if (reader->channels[c].encoding == VECTORMATH_SNAPSHOT_RAW) {
+			if (column.width != 0) {
+				return 0;
+			}
+			columnSize = (uint64_t)header.frameCount * frameFloats * sizeof(float);
+		}
+		else {
+			if (column.width != 1 && column.width != 2 && column.width != 4) {
+				return 0;
+			}
+			columnSize = frameFloats * sizeof(uint32_t) + (uint64_t)(header.frameCount - 1) * frameFloats * column.width;
+		}
+		if (column.offset % kSnapshotAlignment != 0 || column.offset > header.size || header.size - column.offset < columnSize) {
+			return 0;
+		}
+	}
+	return header.size;
+}
+
+//Closed file: the footer points at the index
+static bool ReadFooterIndex(SnapshotReader* reader, uint64_t headerSize) {
+	if (reader->size < headerSize + sizeof(SnapshotFooter)) {
+		return false;
+	}
+	SnapshotFooter footer;
+	memcpy(&footer, reader->data + reader->size - sizeof(footer), sizeof(footer));
+	uint64_t indexEnd = reader->size - sizeof(footer);
+	if (memcmp(footer.magic, kFooterMagic, sizeof(kFooterMagic)) != 0 || footer.indexOffset < headerSize ||
+		footer.indexOffset > indexEnd || (indexEnd - footer.indexOffset) % sizeof(uint64_t) != 0 ||
+		(indexEnd - footer.indexOffset) / sizeof(uint64_t) != footer.chunkCount) {
+		return false;
+	}
+	reader->chunkOffsets.resize((size_t)footer.chunkCount);
+	memcpy(reader->chunkOffsets.data(), reader->data + footer.indexOffset, (size_t)footer.chunkCount * sizeof(uint64_t));
+	//CheckChunk wants chunk i to start at frame i * framesPerChunk and
+	//FindColumn maps frames to chunks the same way, so only the last chunk
+	//can be short
+	uint64_t frames = 0;
+	for (size_t i = 0; i < reader->chunkOffsets.size(); ++i) {
+		if (CheckChunk(reader, reader->chunkOffsets[i], i, footer.indexOffset) == 0) {
+			return false;
+		}
+		SnapshotChunkHeader header;
+		memcpy(&header, reader->data + reader->chunkOffsets[i], sizeof(header));
+		if (i + 1 < reader->chunkOffsets.size() && header.frameCount != reader->framesPerChunk) {
+			return false;
+		}
+		frames += header.frameCount;
+	}
+	reader->frameCount = frames;
+	return frames == footer.frameCount;
+}
+
+static void ReadIndex(SnapshotReader* reader, uint64_t headerSize) {
+	if (ReadFooterIndex(reader, headerSize)) {
+		return;
+	}
+
+	//Unfinished (or damaged) file: walk the chunks while they are complete
+	reader->chunkOffsets.clear();
+	uint64_t offset = headerSize;
+	uint64_t frames = 0;
+	for (;;) {
+		uint64_t size = CheckChunk(reader, offset, reader->chunkOffsets.size(), reader->size);
+		if (size == 0) {
+			break;
+		}
+		SnapshotChunkHeader header;
+		memcpy(&header, reader->data + offset, sizeof(header));
+		reader->chunkOffsets.push_back(offset);
+		frames += header.frameCount;
+		offset += size;
+		if (header.frameCount < reader->framesPerChunk) {
+			break;
+		}
+	}
+	reader->frameCount = frames;
+}
+
+static bool ReadHeader(SnapshotReader* reader) {
+	SnapshotFileHeader header;
+	if (reader->size < sizeof(header)) {
+		return false;
+	}
+	memcpy(&header, reader->data, sizeof(header));
+	if (memcmp(header.magic, kFileMagic, sizeof(kFileMagic)) != 0 || header.version != kSnapshotVersion ||
+		header.channelCount == 0 || header.channelCount > 0xffff || header.framesPerChunk == 0 ||
+		header.headerSize != FileHeaderSize(header.channelCount) || header.headerSize > reader->size) {
+		return false;
+	}
+	reader->channels.resize(header.channelCount);
+	memcpy(reader->channels.data(), reader->data + sizeof(header), header.channelCount * sizeof(VectorMathSnapshotChannel));
+	for (const VectorMathSnapshotChannel& channel : reader->channels) {
+		if (!IsValidChannel(channel) || channel.name[sizeof(channel.name) - 1] != '\0') {
+			return false;
+		}
+	}
+	reader->framesPerChunk = header.framesPerChunk;
+	ReadIndex(reader, header.headerSize);
+	return true;
+}
+
+//Chunk header and column of channel in the chunk holding frame
+static const uint8_t* FindColumn(const SnapshotReader* reader, size_t channel, uint64_t frame, SnapshotChunkHeader& header, SnapshotColumnHeader& column) {
+	const uint8_t* chunk = reader->data + reader->chunkOffsets[(size_t)(frame / reader->framesPerChunk)];
+	memcpy(&header, chunk, sizeof(header));
+	memcpy(&column, chunk + sizeof(header) + channel * sizeof(column), sizeof(column));
+	return chunk + column.offset;
+}
+
+template <typename T>
+static void AddDeltas(uint32_t* values, const uint8_t* deltas, size_t begin, size_t end) {
+	const T* frameDeltas = (const T*)deltas;
+	for (size_t i = begin; i < end; ++i) {
+		values[i] += (uint32_t)(int32_t)frameDeltas[i];
+	}
+}
+
+//Frames [first, first + count) of a delta column, first and count within the
+//chunk. Every value is its own running sum, so the values are split across the
+//pool; each thread decodes its range through all the frames.
+static void DecodeDeltaColumn(const uint8_t* column, uint32_t width, size_t frameFloats, uint32_t first, uint32_t count, double step, float* out) {
+	ScratchBuffer<uint32_t> running(frameFloats);
+	uint32_t* values = running.Data();
+	memcpy(values, column, frameFloats * sizeof(uint32_t));
+	const uint8_t* deltas = column + frameFloats * sizeof(uint32_t);
+	size_t frameBytes = frameFloats * width;
+
+	auto decode = [&](size_t begin, size_t end) {
+		for (uint32_t f = 0; f < first + count; ++f) {
+			if (f > 0) {
+				const uint8_t* frameDeltas = deltas + (f - 1) * frameBytes;
+				if (width == 1) {
+					AddDeltas<int8_t>(values, frameDeltas, begin, end);
+				}
+				else if (width == 2) {
+					AddDeltas<int16_t>(values, frameDeltas, begin, end);
+				}
+				else {
+					AddDeltas<int32_t>(values, frameDeltas, begin, end);
+				}
+			}
+			if (f >= first) {
+				float* frameOut = out + (f - first) * frameFloats;
+				for (size_t i = begin; i < end; ++i) {
+					frameOut[i] = Dequantize(values[i], step);
+				}
+			}
+		}
+	};
+	if (ShouldRunParallel(frameFloats * (first + count)) && frameFloats >= 2 * kParallelGrain) {
+		RunParallel(frameFloats, kParallelGrain, [](void* context, size_t begin, size_t end) {
+			(*(const decltype(decode)*)context)(begin, end);
+		}, (void*)&decode);
+	}
+	else {
+		decode(0, frameFloats);
+	}
+}
+
+
+SnapshotReader* SnapshotReaderOpen(const char* path) {
+	VECTORMATH_STATS(1);
+	if (path == nullptr) {
+		return nullptr;
+	}
+	SnapshotReader* reader = new SnapshotReader();
+	if (!MapFile(reader, path)) {
+		delete reader;
+		return nullptr;
+	}
+	if (!ReadHeader(reader)) {
+		UnmapFile(reader);
+		delete reader;
+		return nullptr;
+	}
+	return reader;
+}
+
+void SnapshotReaderClose(SnapshotReader* reader) {
+	VECTORMATH_STATS(1);
+	if (reader == nullptr) {
+		return;
+	}
+	UnmapFile(reader);
+	delete reader;
+}
+
+uint64_t SnapshotReaderFrameCount(const SnapshotReader* reader) {
+	VECTORMATH_STATS(1);
+	return reader != nullptr ? reader->frameCount : 0;
+}
+
+size_t SnapshotReaderChannelCount(const SnapshotReader* reader) {
+	VECTORMATH_STATS(1);
+	return reader != nullptr ? reader->channels.size() : 0;
+}
+
+int SnapshotReaderGetChannel(const SnapshotReader* reader, size_t channel, VectorMathSnapshotChannel* out) {
+	VECTORMATH_STATS(1);
+	if (reader == nullptr || out == nullptr || channel >= reader->channels.size()) {
+		return 0;
+	}
+	*out = reader->channels[channel];
+	return 1;
+}
+
+int SnapshotReaderFindChannel(const SnapshotReader* reader, const char* name) {
+	VECTORMATH_STATS(1);
+	if (reader == nullptr || name == nullptr) {
+		return -1;
+	}
+	for (size_t c = 0; c < reader->channels.size(); ++c) {
+		if (strcmp(reader->channels[c].name, name) == 0) {
+			return (int)c;
+		}
+	}
+	return -1;
+}
+
+const float* SnapshotReaderFrameData(const SnapshotReader* reader, size_t channel, uint64_t frame) {
+	VECTORMATH_STATS(1);
+	if (reader == nullptr || channel >= reader->channels.size() || frame >= reader->frameCount ||
+		reader->channels[channel].encoding != VECTORMATH_SNAPSHOT_RAW) {
+		return nullptr;
+	}
+	SnapshotChunkHeader header;
+	SnapshotColumnHeader column;
+	const uint8_t* data = FindColumn(reader, channel, frame, header, column);
+	if (frame - header.firstFrame >= header.frameCount) {
+		return nullptr;
+	}
+	return (const float*)data + (size_t)(frame - header.firstFrame) * FrameFloats(reader->channels[channel]);
+}
+
+size_t SnapshotReaderRead(const SnapshotReader* reader, size_t channel, uint64_t firstFrame, size_t frameCount, float* out) {
+	VECTORMATH_STATS(frameCount);
+	if (reader == nullptr || out == nullptr || channel >= reader->channels.size() || firstFrame >= reader->frameCount) {
+		return 0;
+	}
+	const VectorMathSnapshotChannel& info = reader->channels[channel];
+	size_t frameFloats = FrameFloats(info);
+	uint64_t end = firstFrame + (frameCount < reader->frameCount - firstFrame ? frameCount : reader->frameCount - firstFrame);
+
+	uint64_t frame = firstFrame;
+	while (frame < end) {
+		SnapshotChunkHeader header;
+		SnapshotColumnHeader column;
+		const uint8_t* data = FindColumn(reader, channel, frame, header, column);
+		if (frame - header.firstFrame >= header.frameCount) {
+			break;
+		}
+		uint32_t first = (uint32_t)(frame - header.firstFrame);
+		uint32_t count = (uint32_t)((end - frame) < (uint64_t)(header.frameCount - first) ? end - frame : header.frameCount - first);
+		float* frameOut = out + (size_t)(frame - firstFrame) * frameFloats;
+
+		if (column.width == 0) {
+			memcpy(frameOut, data + (size_t)first * frameFloats * sizeof(float), (size_t)count * frameFloats * sizeof(float));
+		}
+		else {
+			DecodeDeltaColumn(data, column.width, frameFloats, first, count, (double)info.step, frameOut);
+		}
+		frame += count;
+	}
+	return (size_t)(frame - firstFrame);
+}
@@ -0,0 +1,323 @@
+//Always include the pch.h first in every cpp
+#include "pch.h"
+
+//Then include own items
+#include "VectorMath.h"
+#include "VectorMathArena.h"
+#include "VectorMathKernels.h"
+#include "VectorMathThreads.h"
+#include "VectorMathStats.h"
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+//Spatial sorting: Morton codes and a parallel LSD radix sort.
+//The sort works on fixed blocks of kSortBlock elements. Every pass counts the
+//digits of each block, turns the counts into each block's output offsets
+//(digit by digit, blocks in order) and scatters the blocks in parallel. The
+//blocks do not depend on the thread count, so the result is the same stable
+//order on any number of threads. Passes whose digit is the same for every
+//key (e.g. the top bits of 3D codes) are skipped.
+
+using namespace vmath;
+
+static const size_t kSortBlock = 16384;
+static const int kRadixBits = 8;
+static const int kBuckets = 1 << kRadixBits;
+static const int kRadixPasses = 32 / kRadixBits;
+
+static inline size_t BlockEnd(size_t block, size_t n) {
+	size_t end = (block + 1) * kSortBlock;
+	return end < n ? end : n;
+}
+
+
+//Morton Codes
+//Spreads the low bits of x so there is one (2D) or two (3D) zero bits between them
+static inline uint32_t SpreadBits2(uint32_t x) {
+	x &= 0x0000ffffu;
+	x = (x | (x << 8)) & 0x00ff00ffu;
+	x = (x | (x << 4)) & 0x0f0f0f0fu;
+	x = (x | (x << 2)) & 0x33333333u;
+	x = (x | (x << 1)) & 0x55555555u;
+	return x;
+}
+
+static inline uint32_t SpreadBits3(uint32_t x) {
+	x &= 0x000003ffu;
+	x = (x | (x << 16)) & 0x030000ffu;
+	x = (x | (x << 8)) & 0x0300f00fu;
+	x = (x | (x << 4)) & 0x030c30c3u;
+	x = (x | (x << 2)) & 0x09249249u;
+	return x;
+}
+
+//Cell of v along one axis, clamped to [0, maxCell]; NaN goes to cell 0
+static inline uint32_t Quantize(float v, float boundsMin, float scale, float maxCell) {
+	float t = (v - boundsMin) * scale;
+	if (!(t > 0.0f)) {
+		return 0;
+	}
+	return (uint32_t)(t < maxCell ? t : maxCell);
+}
+
+static inline float CellScale(float boundsMin, float boundsMax, float maxCell) {
+	float extent = boundsMax - boundsMin;
+	return extent > 0.0f ? maxCell / extent : 0.0f;
+}
+
+static void MortonCodes2D(const Vec2* positions, Vec2 boundsMin, Vec2 boundsMax, uint32_t* outCodes, size_t n) {
+	const float maxCell = 65535.0f;
+	Vec2 scale = { CellScale(boundsMin.x, boundsMax.x, maxCell), CellScale(boundsMin.y, boundsMax.y, maxCell) };
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			uint32_t x = Quantize(positions[i].x, boundsMin.x, scale.x, maxCell);
+			uint32_t y = Quantize(positions[i].y, boundsMin.y, scale.y, maxCell);
+			outCodes[i] = SpreadBits2(x) | (SpreadBits2(y) << 1);
+		}
+	});
+}
+
+static void MortonCodes3D(const Vec3* positions, Vec3 boundsMin, Vec3 boundsMax, uint32_t* outCodes, size_t n) {
+	const float maxCell = 1023.0f;
+	Vec3 scale = { CellScale(boundsMin.x, boundsMax.x, maxCell), CellScale(boundsMin.y, boundsMax.y, maxCell), CellScale(boundsMin.z, boundsMax.z, maxCell) };
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			uint32_t x = Quantize(positions[i].x, boundsMin.x, scale.x, maxCell);
+			uint32_t y = Quantize(positions[i].y, boundsMin.y, scale.y, maxCell);
+			uint32_t z = Quantize(positions[i].z, boundsMin.z, scale.z, maxCell);
+			outCodes[i] = SpreadBits3(x) | (SpreadBits3(y) << 1) | (SpreadBits3(z) << 2);
+		}
+	});
+}
+
+
+//Radix Sort
+//Keys and indices move together as one (key << 32 | index) item, so a pass
+//writes one output stream per digit instead of two. The first pass reads the
+//caller's keys (the index is the position) and the last one writes only the
+//index into the permutation.
+static inline uint32_t SortKey(uint32_t key) { return key; }
+static inline uint32_t SortKey(uint64_t item) { return (uint32_t)(item >> 32); }
+
+//What a pass stores for the element read at position i
+static inline uint64_t SortItem(uint32_t key, size_t i, const uint64_t*) { return ((uint64_t)key << 32) | i; }
+static inline uint64_t SortItem(uint64_t item, size_t, const uint64_t*) { return item; }
+static inline uint32_t SortItem(uint64_t item, size_t, const uint32_t*) { return (uint32_t)item; }
+static inline uint32_t SortItem(uint32_t, size_t i, const uint32_t*) { return (uint32_t)i; }
+
+//The block loops take everything by value, so the stores into dst cannot
+//force the compiler to reload a lambda's captures
+template <typename Src>
+static void CountDigits(const Src* src, size_t begin, size_t end, int shift, uint32_t* counts) {
+	memset(counts, 0, kBuckets * sizeof(uint32_t));
+	for (size_t i = begin; i < end; ++i) {
+		++counts[(SortKey(src[i]) >> shift) & (kBuckets - 1)];
+	}
+}
+
+template <typename Src, typename Dst>
+static void ScatterBlock(const Src* src, size_t begin, size_t end, int shift, const uint32_t* offsets, Dst* dst) {
+	uint32_t next[kBuckets];
+	memcpy(next, offsets, sizeof(next));
+	for (size_t i = begin; i < end; ++i) {
+		Src item = src[i];
+		dst[next[(SortKey(item) >> shift) & (kBuckets - 1)]++] = SortItem(item, i, dst);
+	}
+}
+
+//One stable counting sort pass on the digit at shift. offsets holds
+//kBuckets counters per block.
+template <typename Src, typename Dst>
+static void RadixPass(const Src* src, Dst* dst, size_t n, int shift, uint32_t* offsets) {
+	size_t blocks = (n + kSortBlock - 1) / kSortBlock;
+	ParallelBlocks(n, blocks, [&](size_t firstBlock, size_t endBlock) {
+		for (size_t b = firstBlock; b < endBlock; ++b) {
+			CountDigits(src, b * kSortBlock, BlockEnd(b, n), shift, &offsets[b * kBuckets]);
+		}
+	});
+
+	//Digit major, block minor, so equal keys keep their order
+	uint32_t total = 0;
+	for (int d = 0; d < kBuckets; ++d) {
+		for (size_t b = 0; b < blocks; ++b) {
+			uint32_t count = offsets[b * kBuckets + d];
+			offsets[b * kBuckets + d] = total;
+			total += count;
+		}
+	}
+
+	ParallelBlocks(n, blocks, [&](size_t firstBlock, size_t endBlock) {
+		for (size_t b = firstBlock; b < endBlock; ++b) {
+			ScatterBlock(src, b * kSortBlock, BlockEnd(b, n), shift, &offsets[b * kBuckets], dst);
+		}
+	});
+}
+
+static void RadixSort(const uint32_t* keys, uint32_t* outPermutation, size_t n) {
+	if (n == 0) {
+		return;
+	}
+	size_t blocks = (n + kSortBlock - 1) / kSortBlock;
+
+	//Bits that differ between keys decide which passes are needed
+	ScratchBuffer<uint32_t> blockOr(blocks);
+	ScratchBuffer<uint32_t> blockAnd(blocks);
+	ParallelBlocks(n, blocks, [&](size_t firstBlock, size_t endBlock) {
+		for (size_t b = firstBlock; b < endBlock; ++b) {
+			uint32_t anyBits = 0;
+			uint32_t allBits = 0xffffffffu;
+			for (size_t i = b * kSortBlock; i < BlockEnd(b, n); ++i) {
+				anyBits |= keys[i];
+				allBits &= keys[i];
+			}
+			blockOr[b] = anyBits;
+			blockAnd[b] = allBits;
+		}
+	});
+	uint32_t anyBits = 0;
+	uint32_t allBits = 0xffffffffu;
+	for (size_t b = 0; b < blocks; ++b) {
+		anyBits |= blockOr[b];
+		allBits &= blockAnd[b];
+	}
+	int shifts[kRadixPasses];
+	int passCount = 0;
+	for (int pass = 0; pass < kRadixPasses; ++pass) {
+		if ((((anyBits ^ allBits) >> (pass * kRadixBits)) & (kBuckets - 1)) != 0) {
+			shifts[passCount++] = pass * kRadixBits;
+		}
+	}
+	if (passCount == 0) {
+		for (size_t i = 0; i < n; ++i) {
+			outPermutation[i] = (uint32_t)i;
+		}
+		return;
+	}
+
+	ScratchBuffer<uint32_t> offsets(blocks * kBuckets);
+	if (passCount == 1) {
+		RadixPass(keys, outPermutation, n, shifts[0], offsets.Data());
+		return;
+	}
+	ScratchBuffer<uint64_t> itemsA(n);
+	ScratchBuffer<uint64_t> itemsB(passCount > 2 ? n : 0);
+	uint64_t* current = itemsA.Data();
+	uint64_t* other = itemsB.Data();
+	RadixPass(keys, current, n, shifts[0], offsets.Data());
+	for (int p = 1; p < passCount - 1; ++p) {
+		RadixPass((const uint64_t*)current, other, n, shifts[p], offsets.Data());
+		std::swap(current, other);
+	}
+	RadixPass((const uint64_t*)current, outPermutation, n, shifts[passCount - 1], offsets.Data());
+}
+
+
+//Reorder
+template <typename T>
+static void Gather(const T* in, const uint32_t* permutation, T* out, size_t n) {
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			out[i] = in[permutation[i]];
+		}
+	});
+}
+
+template <size_t Size>
+struct Bytes {
+	unsigned char bytes[Size];
+};
+
+void VectorMortonCodes2D(const Vec2* positions, Vec2 boundsMin, Vec2 boundsMax, uint32_t* outCodes, size_t n) {
+	VECTORMATH_STATS(n);
+	MortonCodes2D(positions, boundsMin, boundsMax, outCodes, n);
+}
+
+void VectorMortonCodes3D(const Vec3* positions, Vec3 boundsMin, Vec3 boundsMax, uint32_t* outCodes, size_t n) {
+	VECTORMATH_STATS(n);
+	MortonCodes3D(positions, boundsMin, boundsMax, outCodes, n);
+}
+
+void VectorRadixSortKeys(const uint32_t* keys, uint32_t* outPermutation, size_t n) {
+	VECTORMATH_STATS(n);
+	RadixSort(keys, outPermutation, n);
+}
+
+void VectorMortonSort2D(const Vec2* positions, uint32_t* outPermutation, Vec2* outPositions, size_t n) {
+	VECTORMATH_STATS(n);
+	if (n == 0) {
+		return;
+	}
+	float lo[2];
+	float hi[2];
+	BoundsComponents((const float*)positions, n * 2, 2, lo, hi);
+	Vec2 boundsMin = { lo[0], lo[1] };
+	Vec2 boundsMax = { hi[0], hi[1] };
+	ScratchBuffer<uint32_t> codes(n);
+	MortonCodes2D(positions, boundsMin, boundsMax, codes.Data(), n);
+	RadixSort(codes.Data(), outPermutation, n);
+	if (outPositions != nullptr) {
+		Gather(positions, outPermutation, outPositions, n);
+	}
+}
+
+void VectorMortonSort3D(const Vec3* positions, uint32_t* outPermutation, Vec3* outPositions, size_t n) {
+	VECTORMATH_STATS(n);
+	if (n == 0) {
+		return;
+	}
+	float lo[3];
+	float hi[3];
+	BoundsComponents((const float*)positions, n * 3, 3, lo, hi);
+	Vec3 boundsMin = { lo[0], lo[1], lo[2] };
+	Vec3 boundsMax = { hi[0], hi[1], hi[2] };
+	ScratchBuffer<uint32_t> codes(n);
+	MortonCodes3D(positions, boundsMin, boundsMax, codes.Data(), n);
+	RadixSort(codes.Data(), outPermutation, n);
+	if (outPositions != nullptr) {
+		Gather(positions, outPermutation, outPositions, n);
+	}
+}
+
+void VectorReorder2DArray(const Vec2* in, const uint32_t* permutation, Vec2* out, size_t n) {
+	VECTORMATH_STATS(n);
+	Gather(in, permutation, out, n);
+}
+
+void VectorReorderArray(const Vec3* in, const uint32_t* permutation, Vec3* out, size_t n) {
+	VECTORMATH_STATS(n);
+	Gather(in, permutation, out, n);
+}
+
+void VectorReorderFloatArray(const float* in, const uint32_t* permutation, float* out, size_t n) {
+	VECTORMATH_STATS(n);
+	Gather(in, permutation, out, n);
+}
+
+void VectorReorderElements(const void* in, size_t elementSize, const uint32_t* permutation, void* out, size_t n) {
+	VECTORMATH_STATS(n);
+	//Common sizes copy as one value instead of a memcpy call per element
+	switch (elementSize) {
+	case 4:
+		Gather((const Bytes<4>*)in, permutation, (Bytes<4>*)out, n);
+		return;
+	case 8:
+		Gather((const Bytes<8>*)in, permutation, (Bytes<8>*)out, n);
+		return;
+	case 12:
+		Gather((const Bytes<12>*)in, permutation, (Bytes<12>*)out, n);
+		return;
+	case 16:
+		Gather((const Bytes<16>*)in, permutation, (Bytes<16>*)out, n);
+		return;
+	default:
+		break;
+	}
+	const unsigned char* src = (const unsigned char*)in;
+	unsigned char* dst = (unsigned char*)out;
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			memcpy(dst + i * elementSize, src + (size_t)permutation[i] * elementSize, elementSize);
+		}
+	});
+}
@@ -0,0 +1,300 @@
+//Always include the pch.h first in every cpp
+#include "pch.h"
+
+//Then include own items
+#include "VectorMath.h"
+#include "VectorMathStats.h"
+#include <cstdint>
+#include <vector>
+
+//2D spatial hash grid for broad-phase queries.
+//Objects are identified by their index. Every object lives in one square cell
+//of cellSize; cells are hashed into a power-of-two bucket table sized for the
+//object count. The buckets are stored flat (counting sort): bucketStart[b] is
+//the first slot of bucket b in the slot arrays, so a cell lookup touches one
+//contiguous run of positions. Different cells can share a bucket, so each slot
+//also keeps its cell coordinates and queries skip slots from other cells.
+//
+//Updates that keep an object in its cell only rewrite its position. Objects
+//that change cell (and inserts) mark the grid dirty; the next query re-sorts
+//into the existing buffers, which is O(n) without allocating.
+
+using namespace vmath;
+
+struct GridCell {
+	int32_t x;
+	int32_t y;
+};
+
+struct SpatialGrid2D {
+	float cellSize;
+	float inverseCellSize;
+	uint32_t bucketMask;
+	bool dirty;
+
+	std::vector<Vec2> positions;      //by id
+	std::vector<uint32_t> bucketOf;   //by id
+	std::vector<uint32_t> slotOf;     //by id, valid while not dirty
+
+	std::vector<uint32_t> bucketStart; //bucket count + 1 offsets into the slots
+	std::vector<uint32_t> slotIds;
+	std::vector<Vec2> slotPositions;
+	std::vector<GridCell> slotCells;
+	std::vector<uint32_t> scratch;
+};
+
+//Far away positions are clamped so the cell coordinates stay in range
+static int32_t CellCoordinate(float value, float inverseCellSize) {
+	float cell = floorf(value * inverseCellSize);
+	if (!(cell > -1073741824.0f)) {
+		return -1073741824;
+	}
+	if (cell > 1073741824.0f) {
+		return 1073741824;
+	}
+	return (int32_t)cell;
+}
+
+static GridCell CellOf(const SpatialGrid2D* grid, Vec2 p) {
+	return { CellCoordinate(p.x, grid->inverseCellSize), CellCoordinate(p.y, grid->inverseCellSize) };
+}
+
+static uint32_t HashCell(GridCell cell, uint32_t mask) {
+	return (((uint32_t)cell.x * 73856093u) ^ ((uint32_t)cell.y * 19349663u)) & mask;
+}
+
+//Re-sorts every object into its bucket, growing the table when the object
+//count has outgrown it (about two buckets per object)
+static void Rebuild(SpatialGrid2D* grid) {
+	size_t n = grid->positions.size();
+	size_t bucketCount = 64;
+	while (bucketCount < n * 2) {
+		bucketCount *= 2;
+	}
+	grid->bucketMask = (uint32_t)bucketCount - 1;
+
+	grid->bucketOf.resize(n);
+	grid->slotOf.resize(n);
+	grid->slotIds.resize(n);
+	grid->slotPositions.resize(n);
+	grid->slotCells.resize(n);
+	grid->bucketStart.assign(bucketCount + 1, 0);
+
+	for (size_t id = 0; id < n; ++id) {
+		uint32_t bucket = HashCell(CellOf(grid, grid->positions[id]), grid->bucketMask);
+		grid->bucketOf[id] = bucket;
+		++grid->bucketStart[bucket + 1];
+	}
+	for (size_t b = 0; b < bucketCount; ++b) {
+		grid->bucketStart[b + 1] += grid->bucketStart[b];
+	}
+
+	grid->scratch.assign(grid->bucketStart.begin(), grid->bucketStart.end() - 1);
+	for (size_t id = 0; id < n; ++id) {
+		uint32_t slot = grid->scratch[grid->bucketOf[id]]++;
+		grid->slotOf[id] = slot;
+		grid->slotIds[slot] = (uint32_t)id;
+		grid->slotPositions[slot] = grid->positions[id];
+		grid->slotCells[slot] = CellOf(grid, grid->positions[id]);
+	}
+	grid->dirty = false;
+}
+
+static void BuildGrid(SpatialGrid2D* grid, const Vec2* positions, size_t n) {
+	grid->positions.assign(positions, positions + n);
+	Rebuild(grid);
+}
+
+static void EnsureBuilt(SpatialGrid2D* grid) {
+	if (grid->dirty) {
+		Rebuild(grid);
+	}
+}
+
+static void MoveObject(SpatialGrid2D* grid, size_t id, Vec2 position) {
+	grid->positions[id] = position;
+	if (grid->dirty) {
+		return;
+	}
+	GridCell cell = CellOf(grid, position);
+	uint32_t slot = grid->slotOf[id];
+	GridCell old = grid->slotCells[slot];
+	if (cell.x != old.x || cell.y != old.y) {
+		grid->dirty = true;
+		return;
+	}
+	grid->slotPositions[slot] = position;
+}
+
+//Calls visit(slot) for every object in the cells overlapping [minCell, maxCell].
+//A range covering more cells than there are objects scans every slot instead.
+template <typename Visit>
+static void ForEachInCells(const SpatialGrid2D* grid, GridCell minCell, GridCell maxCell, const Visit& visit) {
+	double cellCount = ((double)maxCell.x - minCell.x + 1.0) * ((double)maxCell.y - minCell.y + 1.0);
+	if (cellCount > (double)grid->slotIds.size()) {
+		for (size_t slot = 0; slot < grid->slotIds.size(); ++slot) {
+			GridCell c = grid->slotCells[slot];
+			if (c.x >= minCell.x && c.x <= maxCell.x && c.y >= minCell.y && c.y <= maxCell.y) {
+				visit(slot);
+			}
+		}
+		return;
+	}
+	for (int32_t y = minCell.y; y <= maxCell.y; ++y) {
+		for (int32_t x = minCell.x; x <= maxCell.x; ++x) {
+			uint32_t bucket = HashCell({ x, y }, grid->bucketMask);
+			for (uint32_t slot = grid->bucketStart[bucket]; slot < grid->bucketStart[bucket + 1]; ++slot) {
+				GridCell c = grid->slotCells[slot];
+				if (c.x == x && c.y == y) {
+					visit(slot);
+				}
+			}
+		}
+	}
+}
+
+//Results are written up to capacity; the return value is the full count, so a
+//caller can grow its buffer and query again
+static void WriteResult(int* out, size_t capacity, size_t& count, int value) {
+	if (out != nullptr && count < capacity) {
+		out[count] = value;
+	}
+	++count;
+}
+
+
+SpatialGrid2D* SpatialGrid2DCreate(float cellSize) {
+	VECTORMATH_STATS(1);
+	if (!(cellSize > 0.0f)) {
+		return nullptr;
+	}
+	SpatialGrid2D* grid = new SpatialGrid2D();
+	grid->cellSize = cellSize;
+	grid->inverseCellSize = 1.0f / cellSize;
+	grid->bucketMask = 0;
+	grid->dirty = true;
+	return grid;
+}
+
+void SpatialGrid2DDestroy(SpatialGrid2D* grid) {
+	VECTORMATH_STATS(1);
+	delete grid;
+}
+
+void SpatialGrid2DClear(SpatialGrid2D* grid) {
+	VECTORMATH_STATS(1);
+	if (grid == nullptr) {
+		return;
+	}
+	grid->positions.clear();
+	grid->dirty = true;
+}
+
+size_t SpatialGrid2DCount(const SpatialGrid2D* grid) {
+	VECTORMATH_STATS(1);
+	return grid != nullptr ? grid->positions.size() : 0;
+}
+
+void SpatialGrid2DBuild(SpatialGrid2D* grid, const Vec2* positions, size_t n) {
+	VECTORMATH_STATS(n);
+	if (grid == nullptr) {
+		return;
+	}
+	BuildGrid(grid, positions, n);
+}
+
+int SpatialGrid2DInsert(SpatialGrid2D* grid, Vec2 position) {
+	VECTORMATH_STATS(1);
+	if (grid == nullptr) {
+		return -1;
+	}
+	grid->positions.push_back(position);
+	grid->dirty = true;
+	return (int)(grid->positions.size() - 1);
+}
+
+void SpatialGrid2DMove(SpatialGrid2D* grid, int id, Vec2 position) {
+	VECTORMATH_STATS(1);
+	if (grid == nullptr || id < 0 || (size_t)id >= grid->positions.size()) {
+		return;
+	}
+	MoveObject(grid, (size_t)id, position);
+}
+
+void SpatialGrid2DUpdate(SpatialGrid2D* grid, const Vec2* positions, size_t n) {
+	VECTORMATH_STATS(n);
+	if (grid == nullptr) {
+		return;
+	}
+	if (n != grid->positions.size()) {
+		BuildGrid(grid, positions, n);
+		return;
+	}
+	for (size_t id = 0; id < n; ++id) {
+		MoveObject(grid, id, positions[id]);
+	}
+	//Re-sorted here rather than in the next query, so queries stay read-only
+	EnsureBuilt(grid);
+}
+
+size_t SpatialGrid2DQueryRadius(SpatialGrid2D* grid, Vec2 center, float radius, int* outIds, size_t capacity) {
+	VECTORMATH_STATS(1);
+	if (grid == nullptr || !(radius >= 0.0f)) {
+		return 0;
+	}
+	EnsureBuilt(grid);
+	GridCell minCell = CellOf(grid, { center.x - radius, center.y - radius });
+	GridCell maxCell = CellOf(grid, { center.x + radius, center.y + radius });
+	float radiusSquared = radius * radius;
+	size_t count = 0;
+	ForEachInCells(grid, minCell, maxCell, [&](size_t slot) {
+		if (MagnitudeSquared(grid->slotPositions[slot] - center) <= radiusSquared) {
+			WriteResult(outIds, capacity, count, (int)grid->slotIds[slot]);
+		}
+	});
+	return count;
+}
+
+size_t SpatialGrid2DQueryAABB(SpatialGrid2D* grid, Vec2 boxMin, Vec2 boxMax, int* outIds, size_t capacity) {
+	VECTORMATH_STATS(1);
+	if (grid == nullptr || !(boxMin.x <= boxMax.x) || !(boxMin.y <= boxMax.y)) {
+		return 0;
+	}
+	EnsureBuilt(grid);
+	size_t count = 0;
+	ForEachInCells(grid, CellOf(grid, boxMin), CellOf(grid, boxMax), [&](size_t slot) {
+		Vec2 p = grid->slotPositions[slot];
+		if (p.x >= boxMin.x && p.x <= boxMax.x && p.y >= boxMin.y && p.y <= boxMax.y) {
+			WriteResult(outIds, capacity, count, (int)grid->slotIds[slot]);
+		}
+	});
+	return count;
+}
+
+size_t SpatialGrid2DQueryPairs(SpatialGrid2D* grid, float distance, int* outPairs, size_t capacity) {
+	VECTORMATH_STATS(1);
+	if (grid == nullptr || !(distance >= 0.0f)) {
+		return 0;
+	}
+	EnsureBuilt(grid);
+	//Each pair is found from both ends; only the end with the lower id reports it
+	float distanceSquared = distance * distance;
+	size_t count = 0;
+	for (size_t slot = 0; slot < grid->slotIds.size(); ++slot) {
+		uint32_t id = grid->slotIds[slot];
+		Vec2 p = grid->slotPositions[slot];
+		GridCell minCell = CellOf(grid, { p.x - distance, p.y - distance });
+		GridCell maxCell = CellOf(grid, { p.x + distance, p.y + distance });
+		ForEachInCells(grid, minCell, maxCell, [&](size_t other) {
+			uint32_t otherId = grid->slotIds[other];
+			if (otherId > id && MagnitudeSquared(grid->slotPositions[other] - p) <= distanceSquared) {
+				if (outPairs != nullptr && count < capacity) {
+					outPairs[count * 2] = (int)id;
+					outPairs[count * 2 + 1] = (int)otherId;
+				}
+				++count;
+			}
+		});
+	}
+	return count;
+}
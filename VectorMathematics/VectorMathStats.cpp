@@ -0,0 +1,205 @@
+//Always include the pch.h first in every cpp
+#include "pch.h"
+
+//Then include own items
+#include "VectorMath.h"
+#include "VectorMathStats.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+//Per-function call counters.
+//Recording never locks or allocates, so it is safe inside the scalar exports.
+//Function names go into a fixed open-addressing table claimed with a
+//compare-exchange, and each thread takes a block of counters from a fixed pool
+//on its first call. The owner updates its block with plain relaxed loads and
+//stores (no locked instructions), so a hot function called from many threads
+//never shares a cache line. Blocks are never handed back, so threads that exit
+//keep their counts; once the pool runs out, later threads share one block
+//updated with atomic adds. Reset only records the current totals as a
+//baseline that later queries subtract, so it never races with a running call.
+
+#if defined(VECTORMATH_ENABLE_STATS)
+
+static const int kMaxFunctions = 512;
+static const int kMaxThreadBlocks = 64;
+
+//Zero-initialized with the rest of the static data, no constructor
+struct StatsCounters {
+	std::atomic<uint64_t> calls[kMaxFunctions];
+	std::atomic<uint64_t> elements[kMaxFunctions];
+	std::atomic<uint64_t> ticks[kMaxFunctions];
+};
+
+static std::atomic<const char*> g_names[kMaxFunctions];
+static StatsCounters g_blocks[kMaxThreadBlocks];
+static StatsCounters g_sharedBlock;
+static std::atomic<int> g_blocksTaken(0);
+
+//Guards the baseline only, taken by the query and reset functions
+static std::mutex g_baselineLock;
+static VectorMathFunctionStats g_baseline[kMaxFunctions];
+
+//A plain pointer, so the thread_local needs no constructor or destructor
+static thread_local StatsCounters* t_counters = nullptr;
+
+int StatsRegister(const char* name) {
+	//__func__ is one array per function, so its address identifies the name
+	size_t start = ((size_t)(uintptr_t)name >> 4) % kMaxFunctions;
+	for (int probe = 0; probe < kMaxFunctions; ++probe) {
+		int slot = (int)((start + probe) % kMaxFunctions);
+		const char* expected = nullptr;
+		if (g_names[slot].compare_exchange_strong(expected, name, std::memory_order_acq_rel) || expected == name) {
+			return slot;
+		}
+	}
+	return -1;
+}
+
+static inline void Add(std::atomic<uint64_t>& counter, uint64_t value) {
+	counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+static StatsCounters* ClaimBlock() {
+	if (g_blocksTaken.load(std::memory_order_relaxed) < kMaxThreadBlocks) {
+		int index = g_blocksTaken.fetch_add(1, std::memory_order_relaxed);
+		if (index < kMaxThreadBlocks) {
+			return &g_blocks[index];
+		}
+	}
+	return &g_sharedBlock;
+}
+
+void StatsRecord(int id, uint64_t elements, uint64_t ticks) {
+	if (id < 0) {
+		return;
+	}
+	if (t_counters == nullptr) {
+		t_counters = ClaimBlock();
+	}
+	StatsCounters& counters = *t_counters;
+	if (t_counters == &g_sharedBlock) {
+		counters.calls[id].fetch_add(1, std::memory_order_relaxed);
+		counters.elements[id].fetch_add(elements, std::memory_order_relaxed);
+		counters.ticks[id].fetch_add(ticks, std::memory_order_relaxed);
+		return;
+	}
+	Add(counters.calls[id], 1);
+	Add(counters.elements[id], elements);
+	Add(counters.ticks[id], ticks);
+}
+
+static void AddBlock(const StatsCounters& counters, int i, VectorMathFunctionStats& total) {
+	total.calls += counters.calls[i].load(std::memory_order_relaxed);
+	total.elements += counters.elements[i].load(std::memory_order_relaxed);
+	total.ticks += counters.ticks[i].load(std::memory_order_relaxed);
+}
+
+//Totals since the library was loaded for every slot, caller holds the baseline lock
+static void CollectTotals(VectorMathFunctionStats* totals) {
+	int blocks = std::min(g_blocksTaken.load(std::memory_order_relaxed), kMaxThreadBlocks);
+	for (int i = 0; i < kMaxFunctions; ++i) {
+		VectorMathFunctionStats& total = totals[i];
+		total = {};
+		for (int block = 0; block < blocks; ++block) {
+			AddBlock(g_blocks[block], i, total);
+		}
+		AddBlock(g_sharedBlock, i, total);
+	}
+}
+
+static std::vector<VectorMathFunctionStats> Snapshot() {
+	std::lock_guard<std::mutex> guard(g_baselineLock);
+	std::vector<VectorMathFunctionStats> totals(kMaxFunctions);
+	CollectTotals(totals.data());
+	std::vector<VectorMathFunctionStats> called;
+	for (int i = 0; i < kMaxFunctions; ++i) {
+		VectorMathFunctionStats stats = totals[i];
+		stats.calls -= g_baseline[i].calls;
+		stats.elements -= g_baseline[i].elements;
+		stats.ticks -= g_baseline[i].ticks;
+		const char* name = g_names[i].load(std::memory_order_acquire);
+		if (stats.calls > 0 && name != nullptr) {
+			//__func__ lives as long as the library
+			stats.name = name;
+			called.push_back(stats);
+		}
+	}
+	std::sort(called.begin(), called.end(), [](const VectorMathFunctionStats& a, const VectorMathFunctionStats& b) {
+		return a.ticks != b.ticks ? a.ticks > b.ticks : std::string(a.name) < std::string(b.name);
+	});
+	return called;
+}
+
+#else
+
+static std::vector<VectorMathFunctionStats> Snapshot() {
+	return {};
+}
+
+#endif
+
+
+int VectorMathStatsEnabled() {
+#if defined(VECTORMATH_ENABLE_STATS)
+	return 1;
+#else
+	return 0;
+#endif
+}
+
+size_t VectorMathGetStats(VectorMathFunctionStats* stats, size_t capacity) {
+	std::vector<VectorMathFunctionStats> called = Snapshot();
+	for (size_t i = 0; stats != nullptr && i < capacity && i < called.size(); ++i) {
+		stats[i] = called[i];
+	}
+	return called.size();
+}
+
+void VectorMathResetStats() {
+#if defined(VECTORMATH_ENABLE_STATS)
+	std::lock_guard<std::mutex> guard(g_baselineLock);
+	CollectTotals(g_baseline);
+#endif
+}
+
+static std::string StatsJson() {
+	std::vector<VectorMathFunctionStats> called = Snapshot();
+	std::string json = VectorMathStatsEnabled() ? "{\"enabled\":true,\"functions\":[" : "{\"enabled\":false,\"functions\":[";
+	char line[256];
+	for (size_t i = 0; i < called.size(); ++i) {
+		//Names are C identifiers, nothing to escape
+		snprintf(line, sizeof(line), "%s\n{\"name\":\"%s\",\"calls\":%llu,\"elements\":%llu,\"ticks\":%llu}",
+			i == 0 ? "" : ",", called[i].name, (unsigned long long)called[i].calls,
+			(unsigned long long)called[i].elements, (unsigned long long)called[i].ticks);
+		json += line;
+	}
+	json += "]}\n";
+	return json;
+}
+
+size_t VectorMathGetStatsJson(char* buffer, size_t capacity) {
+	std::string json = StatsJson();
+	if (buffer != nullptr && capacity > 0) {
+		size_t length = std::min(capacity - 1, json.size());
+		json.copy(buffer, length);
+		buffer[length] = '\0';
+	}
+	return json.size();
+}
+
+int VectorMathWriteStatsJson(const char* path) {
+	if (path == nullptr) {
+		return 0;
+	}
+	FILE* file = fopen(path, "wb");
+	if (file == nullptr) {
+		return 0;
+	}
+	std::string json = StatsJson();
+	bool written = fwrite(json.data(), 1, json.size(), file) == json.size();
+	return fclose(file) == 0 && written ? 1 : 0;
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#ifndef VECTOR_MATH_STATS_H
+#define VECTOR_MATH_STATS_H
+
+//Internal header - not part of the exported API.
+//Every exported function starts with VECTORMATH_STATS(elements). Built with
+//VECTORMATH_ENABLE_STATS it counts the call, the elements processed (n for
+//batch and array calls, 1 otherwise) and the time stamp counter ticks spent
+//in the call (see VectorMathStats.cpp). Without it the macro expands to
+//nothing, so normal builds pay nothing.
+
+#if defined(VECTORMATH_ENABLE_STATS)
+
+#include <atomic>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+//Returns the counter slot for name, taking a new one on first use
+//(-1 once every slot is taken; such functions are not counted). Lock-free,
+//and calling it again with the same name returns the same slot.
+int StatsRegister(const char* name);
+
+static const int kStatsUnregistered = -2;
+
+//Looks the slot up on a function's first call. Two threads racing here both
+//get the same slot from StatsRegister, so the plain store is harmless.
+inline int StatsId(std::atomic<int>& slot, const char* name) {
+	int id = slot.load(std::memory_order_relaxed);
+	if (id == kStatsUnregistered) {
+		id = StatsRegister(name);
+		slot.store(id, std::memory_order_relaxed);
+	}
+	return id;
+}
+
+//Adds one call to the calling thread's counters
+void StatsRecord(int id, uint64_t elements, uint64_t ticks);
+
+//x86: time stamp counter (constant rate, about the nominal clock).
+//ARM64: the generic timer. Elsewhere: nanoseconds.
+inline uint64_t StatsNow() {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+	return __rdtsc();
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+	return (uint64_t)_ReadStatusReg(ARM64_CNTVCT);
+#elif defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#elif defined(__aarch64__)
+	uint64_t ticks;
+	__asm__ volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+	return ticks;
+#else
+	return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+class StatsScope {
+public:
+	StatsScope(int id, uint64_t elements) : id(id), elements(elements), start(StatsNow()) {}
+
+	~StatsScope() {
+		StatsRecord(id, elements, StatsNow() - start);
+	}
+
+	StatsScope(const StatsScope&) = delete;
+	StatsScope& operator=(const StatsScope&) = delete;
+
+private:
+	int id;
+	uint64_t elements;
+	uint64_t start;
+};
+
+//The slot is constant-initialized, so unlike a function-local static with a
+//dynamic initializer there is no init guard to lock, and the scalar exports
+//stay free of blocking and allocation with stats on
+#define VECTORMATH_STATS(elements) \
+	static std::atomic<int> vmStatsId(kStatsUnregistered); \
+	StatsScope vmStatsScope(StatsId(vmStatsId, __func__), (uint64_t)(elements))
+
+#else
+
+#define VECTORMATH_STATS(elements) ((void)0)
+
+#endif
+
+#endif
@@ -0,0 +1,326 @@
+//Always include the pch.h first in every cpp
+#include "pch.h"
+
+//Then include own items
+#include "VectorMath.h"
+#include "VectorMathThreads.h"
+#include "VectorMathStats.h"
+#include <cfloat>
+#include <utility>
+
+//Swept (continuous) collision tests in 2D.
+//Stepping a shape and then checking for overlap misses thin colliders once the
+//step is longer than the collider is thick. These tests move the shape along
+//its whole motion instead and report the fraction of the step travelled
+//before first contact.
+//
+//A moving circle is reduced to a moving point against the other shape grown
+//by the radius: a segment becomes a capsule (a flat side plus two end
+//circles), a box becomes a rounded box (two grown boxes plus four corner
+//circles). Both are convex, so the earliest entry over the pieces is the
+//contact.
+
+using namespace vmath;
+
+static const SweepHit2D kNoHit = { 1.0f, { 0.0f, 0.0f } };
+
+//Narrows [enter, exit] to the part of the motion inside one slab of a box.
+//entered is set when this slab moved the entry time.
+static bool ClipSlab(float origin, float motion, float slabMin, float slabMax, float& enter, float& exit, bool& entered) {
+	if (motion == 0.0f) {
+		return origin >= slabMin && origin <= slabMax;
+	}
+	float inverse = 1.0f / motion;
+	float t0 = (slabMin - origin) * inverse;
+	float t1 = (slabMax - origin) * inverse;
+	if (t0 > t1) {
+		std::swap(t0, t1);
+	}
+	if (t0 > enter) {
+		enter = t0;
+		entered = true;
+	}
+	if (t1 < exit) {
+		exit = t1;
+	}
+	return enter <= exit;
+}
+
+//Earliest t in [0, 1] where origin + motion * t enters the box, and the normal
+//of the face it enters through. An origin inside the box is not an entry.
+static bool PointEntersBox(Vec2 origin, Vec2 motion, Vec2 boxMin, Vec2 boxMax, float& time, Vec2& normal) {
+	float enter = -FLT_MAX;
+	float exit = 1.0f;
+	bool enteredX = false;
+	bool enteredY = false;
+	if (!ClipSlab(origin.x, motion.x, boxMin.x, boxMax.x, enter, exit, enteredX)
+		|| !ClipSlab(origin.y, motion.y, boxMin.y, boxMax.y, enter, exit, enteredY)
+		|| enter < 0.0f) {
+		return false;
+	}
+	time = enter;
+	if (enteredY) {
+		normal = { 0.0f, motion.y > 0.0f ? -1.0f : 1.0f };
+	}
+	else {
+		normal = { motion.x > 0.0f ? -1.0f : 1.0f, 0.0f };
+	}
+	return true;
+}
+
+//Earliest t in [0, 1] where origin + motion * t reaches the circle, for an
+//origin outside it
+static bool PointEntersCircle(Vec2 origin, Vec2 motion, Vec2 center, float radius, float& time) {
+	Vec2 offset = origin - center;
+	float a = Dot(motion, motion);
+	float b = Dot(offset, motion);
+	float c = Dot(offset, offset) - radius * radius;
+	if (a == 0.0f || b >= 0.0f) {
+		//Not moving, or moving away
+		return false;
+	}
+	float discriminant = b * b - a * c;
+	if (discriminant < 0.0f) {
+		return false;
+	}
+	float t = (-b - Sqrt(discriminant)) / a;
+	if (t < 0.0f || t > 1.0f) {
+		return false;
+	}
+	time = t;
+	return true;
+}
+
+//Unit direction to push an overlapping shape out along: the offset from the
+//closest point, or the fallback when the centre sits on the other shape
+static Vec2 OutwardNormal(Vec2 offset, Vec2 fallback) {
+	Vec2 normal = Normalize(offset);
+	if (normal.x == 0.0f && normal.y == 0.0f) {
+		normal = Normalize(fallback);
+	}
+	if (normal.x == 0.0f && normal.y == 0.0f) {
+		normal = { 0.0f, 1.0f };
+	}
+	return normal;
+}
+
+//Normal of the box face nearest to a point inside the box
+static Vec2 NearestFaceNormal(Vec2 p, Vec2 boxMin, Vec2 boxMax) {
+	float left = p.x - boxMin.x;
+	float right = boxMax.x - p.x;
+	float bottom = p.y - boxMin.y;
+	float top = boxMax.y - p.y;
+	float nearest = left;
+	Vec2 normal = { -1.0f, 0.0f };
+	if (right < nearest) {
+		nearest = right;
+		normal = { 1.0f, 0.0f };
+	}
+	if (bottom < nearest) {
+		nearest = bottom;
+		normal = { 0.0f, -1.0f };
+	}
+	if (top < nearest) {
+		normal = { 0.0f, 1.0f };
+	}
+	return normal;
+}
+
+static Vec2 ClosestOnSegment(Vec2 p, Vec2 a, Vec2 b) {
+	Vec2 edge = b - a;
+	float lengthSquared = Dot(edge, edge);
+	float t = lengthSquared > 0.0f ? vmath::Clamp(Dot(p - a, edge) / lengthSquared, 0.0f, 1.0f) : 0.0f;
+	return a + edge * t;
+}
+
+static void KeepEarliest(SweepHit2D& best, bool& found, float time, Vec2 normal) {
+	if (!found || time < best.time) {
+		best.time = time;
+		best.normal = normal;
+		found = true;
+	}
+}
+
+
+static bool SweepCircleSegment(Vec2 center, float radius, Vec2 motion, Vec2 a, Vec2 b, SweepHit2D& hit) {
+	hit = kNoHit;
+	Vec2 edge = b - a;
+	//Side of the segment facing the circle (against the motion when the
+	//centre starts on the line); zero for a degenerate segment
+	Vec2 side = Normalize(Vec2{ -edge.y, edge.x });
+	float distance = Dot(center - a, side);
+	if (distance < 0.0f || (distance == 0.0f && Dot(motion, side) > 0.0f)) {
+		side = -side;
+		distance = -distance;
+	}
+
+	Vec2 closest = ClosestOnSegment(center, a, b);
+	if (MagnitudeSquared(center - closest) <= radius * radius) {
+		hit.time = 0.0f;
+		hit.normal = OutwardNormal(center - closest, MagnitudeSquared(side) > 0.0f ? side : -motion);
+		return true;
+	}
+
+	//Flat side: the line pushed out by the radius, only between the end points
+	float approach = Dot(motion, side);
+	if (approach < 0.0f) {
+		float t = (distance - radius) / -approach;
+		if (t >= 0.0f && t <= 1.0f) {
+			Vec2 contact = center + motion * t - side * radius;
+			float along = Dot(contact - a, edge);
+			if (along >= 0.0f && along <= Dot(edge, edge)) {
+				hit.time = t;
+				hit.normal = side;
+				return true;
+			}
+		}
+	}
+
+	//Round ends
+	bool found = false;
+	float t;
+	if (PointEntersCircle(center, motion, a, radius, t)) {
+		KeepEarliest(hit, found, t, OutwardNormal(center + motion * t - a, side));
+	}
+	if (PointEntersCircle(center, motion, b, radius, t)) {
+		KeepEarliest(hit, found, t, OutwardNormal(center + motion * t - b, side));
+	}
+	return found;
+}
+
+static bool SweepCircleBox(Vec2 center, float radius, Vec2 motion, Vec2 boxMin, Vec2 boxMax, SweepHit2D& hit) {
+	hit = kNoHit;
+	Vec2 closest = Max(boxMin, Min(center, boxMax));
+	if (MagnitudeSquared(center - closest) <= radius * radius) {
+		hit.time = 0.0f;
+		hit.normal = OutwardNormal(center - closest, NearestFaceNormal(center, boxMin, boxMax));
+		return true;
+	}
+
+	bool found = false;
+	float t;
+	Vec2 normal;
+	if (PointEntersBox(center, motion, boxMin - Vec2{ radius, 0.0f }, boxMax + Vec2{ radius, 0.0f }, t, normal)) {
+		KeepEarliest(hit, found, t, normal);
+	}
+	if (PointEntersBox(center, motion, boxMin - Vec2{ 0.0f, radius }, boxMax + Vec2{ 0.0f, radius }, t, normal)) {
+		KeepEarliest(hit, found, t, normal);
+	}
+	const Vec2 corners[4] = { boxMin, { boxMax.x, boxMin.y }, { boxMin.x, boxMax.y }, boxMax };
+	for (const Vec2& corner : corners) {
+		if (PointEntersCircle(center, motion, corner, radius, t)) {
+			KeepEarliest(hit, found, t, OutwardNormal(center + motion * t - corner, -motion));
+		}
+	}
+	return found;
+}
+
+static bool RayBox(Vec2 origin, Vec2 motion, Vec2 boxMin, Vec2 boxMax, SweepHit2D& hit) {
+	hit = kNoHit;
+	if (origin.x >= boxMin.x && origin.x <= boxMax.x && origin.y >= boxMin.y && origin.y <= boxMax.y) {
+		hit.time = 0.0f;
+		hit.normal = NearestFaceNormal(origin, boxMin, boxMax);
+		return true;
+	}
+	return PointEntersBox(origin, motion, boxMin, boxMax, hit.time, hit.normal);
+}
+
+//p0 + t * r meets q0 + u * s where both t and u are in [0, 1]
+static bool SegmentSegment(Vec2 p0, Vec2 p1, Vec2 q0, Vec2 q1, SweepHit2D& hit) {
+	hit = kNoHit;
+	Vec2 r = p1 - p0;
+	Vec2 s = q1 - q0;
+	float denominator = Cross(r, s);
+	if (denominator == 0.0f) {
+		//Parallel or degenerate
+		return false;
+	}
+	Vec2 offset = q0 - p0;
+	float t = Cross(offset, s) / denominator;
+	float u = Cross(offset, r) / denominator;
+	if (!(t >= 0.0f && t <= 1.0f && u >= 0.0f && u <= 1.0f)) {
+		return false;
+	}
+	Vec2 normal = OutwardNormal(Vec2{ -s.y, s.x }, -r);
+	if (Dot(normal, r) > 0.0f) {
+		normal = -normal;
+	}
+	hit.time = t;
+	hit.normal = normal;
+	return true;
+}
+
+
+//Single tests
+static int WriteHit(bool found, const SweepHit2D& result, SweepHit2D* hit) {
+	if (hit != nullptr) {
+		*hit = result;
+	}
+	return found ? 1 : 0;
+}
+
+int SweepCircleSegment2D(Vec2 center, float radius, Vec2 motion, Vec2 segmentStart, Vec2 segmentEnd, SweepHit2D* hit) {
+	VECTORMATH_STATS(1);
+	SweepHit2D result;
+	bool found = SweepCircleSegment(center, radius, motion, segmentStart, segmentEnd, result);
+	return WriteHit(found, result, hit);
+}
+
+int SweepCircleAABB2D(Vec2 center, float radius, Vec2 motion, Vec2 boxMin, Vec2 boxMax, SweepHit2D* hit) {
+	VECTORMATH_STATS(1);
+	SweepHit2D result;
+	bool found = SweepCircleBox(center, radius, motion, boxMin, boxMax, result);
+	return WriteHit(found, result, hit);
+}
+
+int RayAABB2D(Vec2 origin, Vec2 motion, Vec2 boxMin, Vec2 boxMax, SweepHit2D* hit) {
+	VECTORMATH_STATS(1);
+	SweepHit2D result;
+	bool found = RayBox(origin, motion, boxMin, boxMax, result);
+	return WriteHit(found, result, hit);
+}
+
+int SegmentIntersect2D(Vec2 start, Vec2 end, Vec2 otherStart, Vec2 otherEnd, SweepHit2D* hit) {
+	VECTORMATH_STATS(1);
+	SweepHit2D result;
+	bool found = SegmentSegment(start, end, otherStart, otherEnd, result);
+	return WriteHit(found, result, hit);
+}
+
+
+//Array tests
+void SweepCircleSegment2DArray(const Vec2* centers, const float* radii, const Vec2* motions, const Vec2* segmentStarts, const Vec2* segmentEnds, SweepHit2D* hits, size_t n) {
+	VECTORMATH_STATS(n);
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			SweepCircleSegment(centers[i], radii[i], motions[i], segmentStarts[i], segmentEnds[i], hits[i]);
+		}
+	});
+}
+
+void SweepCircleAABB2DArray(const Vec2* centers, const float* radii, const Vec2* motions, const Vec2* boxMin, const Vec2* boxMax, SweepHit2D* hits, size_t n) {
+	VECTORMATH_STATS(n);
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			SweepCircleBox(centers[i], radii[i], motions[i], boxMin[i], boxMax[i], hits[i]);
+		}
+	});
+}
+
+void RayAABB2DArray(const Vec2* origins, const Vec2* motions, const Vec2* boxMin, const Vec2* boxMax, SweepHit2D* hits, size_t n) {
+	VECTORMATH_STATS(n);
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			RayBox(origins[i], motions[i], boxMin[i], boxMax[i], hits[i]);
+		}
+	});
+}
+
+void SegmentIntersect2DArray(const Vec2* starts, const Vec2* ends, const Vec2* otherStarts, const Vec2* otherEnds, SweepHit2D* hits, size_t n) {
+	VECTORMATH_STATS(n);
+	ParallelRange(n, [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i) {
+			SegmentSegment(starts[i], ends[i], otherStarts[i], otherEnds[i], hits[i]);
+		}
+	});
+}
@@ -0,0 +1,398 @@
+//Always include the pch.h first in every cpp
+#include "pch.h"
+
+//Then include own items
+#include "VectorMath.h"
+#include "VectorMathThreads.h"
+#include "VectorMathStats.h"
+#include <atomic>
+
+#if !defined(VECTORMATH_NO_THREADS)
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+#endif
+
+//Work stealing thread pool behind the batch functions.
+//Workers are started on the first call that needs them and sleep on a
+//condition variable between jobs. A job is one RunParallel call: its chunks are
+//dealt out as one contiguous run per thread (the caller takes part as thread 0)
+//and a thread that finishes its run steals the back half of another thread's
+//remaining chunks. Only one job runs at a time; a second caller, or a nested
+//call from inside a task, simply runs its work on its own thread.
+
+static const size_t kDefaultThreshold = 65536;
+
+static std::atomic<int> g_requestedThreads{ 0 };
+static std::atomic<size_t> g_threshold{ kDefaultThreshold };
+static std::atomic<int> g_pinThreads{ 0 };
+
+static int ResolveThreadCount(int requested) {
+#if defined(VECTORMATH_NO_THREADS)
+	(void)requested;
+	return 1;
+#else
+	if (requested > 0) {
+		return requested;
+	}
+	static const int hardware = std::thread::hardware_concurrency() > 0 ? (int)std::thread::hardware_concurrency() : 1;
+	return hardware;
+#endif
+}
+
+
+#if defined(VECTORMATH_NO_THREADS)
+
+bool ShouldRunParallel(size_t) {
+	return false;
+}
+
+void RunParallel(size_t n, size_t, ParallelTask task, void* context) {
+	if (n > 0) {
+		task(context, 0, n);
+	}
+}
+
+static void StopWorkers() {
+}
+
+#else
+
+//One per thread taking part in a job. The padding keeps the hot fields of
+//neighbouring slots off the same cache line.
+struct WorkSlot {
+	std::mutex lock;
+	size_t next;
+	size_t end;
+	char padding[64];
+};
+
+struct ParallelJob {
+	ParallelTask task;
+	void* context;
+	size_t n;
+	size_t grain;
+	WorkSlot* slots;
+	int slotCount;
+};
+
+static std::mutex g_jobLock; //held for a whole job and while the pool is resized
+static std::vector<std::thread> g_workers;
+static int g_startedThreads = 0; //count the pool was last started for, 0 when stopped
+static std::unique_ptr<WorkSlot[]> g_slots;
+
+static std::mutex g_wakeLock; //guards everything below
+static std::condition_variable g_wake;
+static std::condition_variable g_done;
+static const ParallelJob* g_job = nullptr;
+static unsigned int g_generation = 0;
+static int g_busyWorkers = 0;
+static bool g_stopping = false;
+
+//Set on pool threads for their whole life and on a caller while its job runs
+static thread_local bool t_insideJob = false;
+
+static bool TakeChunk(WorkSlot& slot, size_t& chunk) {
+	std::lock_guard<std::mutex> guard(slot.lock);
+	if (slot.next == slot.end) {
+		return false;
+	}
+	chunk = slot.next++;
+	return true;
+}
+
+//Moves the back half of another thread's remaining chunks into our own slot
+static bool StealChunk(const ParallelJob& job, int self, size_t& chunk) {
+	for (int offset = 1; offset < job.slotCount; ++offset) {
+		WorkSlot& victim = job.slots[(self + offset) % job.slotCount];
+		size_t begin, end;
+		{
+			std::lock_guard<std::mutex> guard(victim.lock);
+			size_t remaining = victim.end - victim.next;
+			if (remaining == 0) {
+				continue;
+			}
+			end = victim.end;
+			begin = end - (remaining + 1) / 2;
+			victim.end = begin;
+		}
+		WorkSlot& own = job.slots[self];
+		{
+			std::lock_guard<std::mutex> guard(own.lock);
+			own.next = begin + 1;
+			own.end = end;
+		}
+		chunk = begin;
+		return true;
+	}
+	return false;
+}
+
+static void RunChunks(const ParallelJob& job, int self) {
+	size_t chunk;
+	while (TakeChunk(job.slots[self], chunk) || StealChunk(job, self, chunk)) {
+		size_t begin = chunk * job.grain;
+		size_t end = job.n - begin < job.grain ? job.n : begin + job.grain;
+		job.task(job.context, begin, end);
+	}
+}
+
+static void PinThread(std::thread& thread, int cpu) {
+#if defined(_WIN32)
+	if (cpu < (int)(sizeof(DWORD_PTR) * 8)) {
+		SetThreadAffinityMask((HANDLE)thread.native_handle(), (DWORD_PTR)1 << cpu);
+	}
+#elif defined(__linux__)
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	CPU_SET(cpu, &set);
+	pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+#else
+	(void)thread;
+	(void)cpu;
+#endif
+}
+
+//Windows DLL: while workers exist the pool holds its own reference to the
+//DLL. A FreeLibrary without VectorMathShutdownThreads then leaves the DLL
+//loaded under the sleeping workers instead of unmapping their code; the
+//reference is dropped once StopWorkers has joined them.
+#if defined(_WIN32) && !defined(VECTORMATH_STATIC)
+static HMODULE g_pinnedModule = nullptr;
+
+static void PinModule() {
+	if (g_pinnedModule == nullptr) {
+		GetModuleHandleExW(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS, (LPCWSTR)&PinModule, &g_pinnedModule);
+	}
+}
+
+static void UnpinModule() {
+	if (g_pinnedModule != nullptr) {
+		FreeLibrary(g_pinnedModule);
+		g_pinnedModule = nullptr;
+	}
+}
+#else
+static void PinModule() {
+}
+
+static void UnpinModule() {
+}
+#endif
+
+//seen is the generation at start up, so a job published before the thread
+//first waits is not missed
+static void WorkerMain(int index, unsigned int seen) {
+	t_insideJob = true;
+	for (;;) {
+		const ParallelJob* job;
+		{
+			std::unique_lock<std::mutex> lock(g_wakeLock);
+			g_wake.wait(lock, [&] { return g_stopping || g_generation != seen; });
+			if (g_stopping) {
+				return;
+			}
+			seen = g_generation;
+			job = g_job;
+		}
+		if (index < job->slotCount) {
+			RunChunks(*job, index);
+		}
+		{
+			std::lock_guard<std::mutex> guard(g_wakeLock);
+			if (--g_busyWorkers == 0) {
+				g_done.notify_one();
+			}
+		}
+	}
+}
+
+//Both of these expect g_jobLock to be held
+static void StopWorkers() {
+	g_startedThreads = 0;
+	if (g_workers.empty()) {
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> guard(g_wakeLock);
+		g_stopping = true;
+	}
+	g_wake.notify_all();
+	for (std::thread& worker : g_workers) {
+		worker.join();
+	}
+	g_workers.clear();
+	g_slots.reset();
+	g_stopping = false;
+	UnpinModule();
+}
+
+static bool StartWorkers() {
+	int threads = ResolveThreadCount(g_requestedThreads.load(std::memory_order_relaxed));
+	//Compared against the requested count rather than g_workers, which can be
+	//short after a failed thread creation and would otherwise respawn every call
+	if (threads == g_startedThreads) {
+		return !g_workers.empty();
+	}
+	StopWorkers();
+	g_startedThreads = threads;
+	if (threads <= 1) {
+		return false;
+	}
+
+	g_slots.reset(new WorkSlot[threads]);
+	bool pin = g_pinThreads.load(std::memory_order_relaxed) != 0;
+	unsigned int cpus = std::thread::hardware_concurrency();
+	unsigned int generation;
+	{
+		std::lock_guard<std::mutex> guard(g_wakeLock);
+		generation = g_generation;
+	}
+	for (int index = 1; index < threads; ++index) {
+		try {
+			g_workers.emplace_back(WorkerMain, index, generation);
+		}
+		catch (const std::system_error&) {
+			//Out of threads, run with what we have
+			break;
+		}
+		if (pin && cpus > 0) {
+			PinThread(g_workers.back(), (int)(index % cpus));
+		}
+	}
+	if (!g_workers.empty()) {
+		PinModule();
+	}
+	return !g_workers.empty();
+}
+
+bool ShouldRunParallel(size_t n) {
+	return n >= g_threshold.load(std::memory_order_relaxed) && n > kParallelGrain && !t_insideJob
+		&& ResolveThreadCount(g_requestedThreads.load(std::memory_order_relaxed)) > 1;
+}
+
+void RunParallel(size_t n, size_t grain, ParallelTask task, void* context) {
+	if (grain == 0) {
+		grain = kParallelGrain;
+	}
+	if (n == 0) {
+		return;
+	}
+	size_t chunkCount = (n + grain - 1) / grain;
+	if (t_insideJob || chunkCount < 2) {
+		task(context, 0, n);
+		return;
+	}
+	std::unique_lock<std::mutex> jobGuard(g_jobLock, std::try_to_lock);
+	if (!jobGuard.owns_lock() || !StartWorkers()) {
+		task(context, 0, n);
+		return;
+	}
+
+	int workerCount = (int)g_workers.size();
+	int slotCount = chunkCount < (size_t)workerCount + 1 ? (int)chunkCount : workerCount + 1;
+	for (int i = 0; i < slotCount; ++i) {
+		g_slots[i].next = chunkCount * i / slotCount;
+		g_slots[i].end = chunkCount * (i + 1) / slotCount;
+	}
+	ParallelJob job = { task, context, n, grain, g_slots.get(), slotCount };
+	{
+		std::lock_guard<std::mutex> guard(g_wakeLock);
+		g_job = &job;
+		g_busyWorkers = workerCount;
+		++g_generation;
+	}
+	g_wake.notify_all();
+
+	t_insideJob = true;
+	RunChunks(job, 0);
+	t_insideJob = false;
+
+	std::unique_lock<std::mutex> lock(g_wakeLock);
+	g_done.wait(lock, [] { return g_busyWorkers == 0; });
+	g_job = nullptr;
+}
+
+#endif
+
+//Library unload. A Windows DLL runs its static destructors under the loader
+//lock, which an exiting thread needs too, so joining would deadlock. With the
+//module pinned while workers exist, that only happens at process exit, where
+//the workers are already gone and are just detached. Elsewhere they are
+//joined, as a condition variable must not be destroyed while threads still
+//wait on it.
+struct PoolShutdown {
+	~PoolShutdown() {
+#if defined(_WIN32) && !defined(VECTORMATH_STATIC) && !defined(VECTORMATH_NO_THREADS)
+		for (std::thread& worker : g_workers) {
+			worker.detach();
+		}
+		g_workers.clear();
+#else
+#if !defined(VECTORMATH_NO_THREADS)
+		std::lock_guard<std::mutex> guard(g_jobLock);
+#endif
+		StopWorkers();
+#endif
+	}
+};
+static PoolShutdown g_poolShutdown;
+
+
+//Changing the pool waits for a running job; the workers are restarted lazily
+//by the next call that needs them. Ignored when called from inside a task.
+static void ResetPool() {
+#if !defined(VECTORMATH_NO_THREADS)
+	if (t_insideJob) {
+		return;
+	}
+	std::lock_guard<std::mutex> guard(g_jobLock);
+	StopWorkers();
+#endif
+}
+
+void VectorMathSetThreadCount(int count) {
+	VECTORMATH_STATS(1);
+	g_requestedThreads.store(count > 0 ? count : 0, std::memory_order_relaxed);
+	ResetPool();
+}
+
+int VectorMathGetThreadCount() {
+	VECTORMATH_STATS(1);
+	return ResolveThreadCount(g_requestedThreads.load(std::memory_order_relaxed));
+}
+
+void VectorMathSetParallelThreshold(size_t minElements) {
+	VECTORMATH_STATS(1);
+	g_threshold.store(minElements, std::memory_order_relaxed);
+}
+
+size_t VectorMathGetParallelThreshold() {
+	VECTORMATH_STATS(1);
+	return g_threshold.load(std::memory_order_relaxed);
+}
+
+void VectorMathSetThreadPinning(int enabled) {
+	VECTORMATH_STATS(1);
+	g_pinThreads.store(enabled != 0 ? 1 : 0, std::memory_order_relaxed);
+	ResetPool();
+}
+
+void VectorMathShutdownThreads() {
+	VECTORMATH_STATS(1);
+	ResetPool();
+}
+
+void VectorMathParallelFor(size_t n, size_t grain, VectorMathTask task, void* userData) {
+	VECTORMATH_STATS(n);
+	if (task == nullptr) {
+		return;
+	}
+	RunParallel(n, grain, task, userData);
+}
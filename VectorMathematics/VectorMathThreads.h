@@ -0,0 +1,57 @@
+#pragma once
+
+#ifndef VECTOR_MATH_THREADS_H
+#define VECTOR_MATH_THREADS_H
+
+#include <cstddef>
+
+//Internal header - not part of the exported API.
+//The library owns a pool of worker threads (see VectorMathThreads.cpp). Batch
+//and Array calls over at least the parallel threshold are cut into chunks of
+//kParallelGrain elements. Every thread starts on its own share of the chunks
+//and steals from the others once it runs out. Each element still goes through
+//the same kernel, so the results do not depend on the thread count.
+
+//Elements per chunk. 4096 floats is 16 KB per stream, so the inputs and
+//outputs of one chunk stay in L1/L2 while it runs.
+static const size_t kParallelGrain = 4096;
+
+typedef void (*ParallelTask)(void* context, size_t begin, size_t end);
+
+//True when a call over n elements should be split across the pool.
+bool ShouldRunParallel(size_t n);
+
+//Runs task over [0, n) in chunks of grain elements (0 = kParallelGrain).
+//Falls back to a single task(context, 0, n) on the calling thread when the
+//pool is disabled, already running another caller's job, or the call is made
+//from inside a task.
+void RunParallel(size_t n, size_t grain, ParallelTask task, void* context);
+
+//Runs body(begin, end) over [0, n), split across the pool above the threshold.
+template <typename Body>
+inline void ParallelRange(size_t n, const Body& body) {
+	if (!ShouldRunParallel(n)) {
+		body((size_t)0, n);
+		return;
+	}
+	RunParallel(n, kParallelGrain, [](void* context, size_t begin, size_t end) {
+		(*(const Body*)context)(begin, end);
+	}, (void*)&body);
+}
+
+//Runs body(firstBlock, endBlock) over [0, blocks), split across the pool
+//one block per chunk when the n elements they cover are above the threshold.
+//For work cut into fixed blocks (sorts, reductions), so the blocks and the
+//order their results are combined in never depend on the thread count.
+template <typename Body>
+inline void ParallelBlocks(size_t n, size_t blocks, const Body& body) {
+	if (!ShouldRunParallel(n)) {
+		body((size_t)0, blocks);
+		return;
+	}
+	RunParallel(blocks, 1, [](void* context, size_t begin, size_t end) {
+		(*(const Body*)context)(begin, end);
+	}, (void*)&body);
+}
+
+#endif
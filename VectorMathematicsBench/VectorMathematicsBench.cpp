@@ -0,0 +1,780 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <ctime>
+#include "VectorMath.h"
+#include "VectorMathArray.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+//Micro benchmarks for the exports in VectorMath.h, in the style of Google
+//Benchmark: every case runs until it has used --min-time seconds, and the
+//result is reported as ns per vector operation and vectors per second.
+//
+//Each operation is measured in up to four variants:
+//  loop    - the scalar C export called once per element (what C# does today)
+//  inline  - the same loop over the header-only vmath functions
+//  array   - one call to the packed AoS ...Array export
+//  batch   - one call to the SoA ...Batch export
+//  expr    - the same chain as a VecArray / VecSpan expression (one fused loop)
+//array and batch run once per instruction set the CPU supports, so the SIMD
+//kernels can be compared with the scalar kernels directly.
+//
+//Usage: VectorMathematicsBench [--filter=<text>] [--sizes=256,4096,...]
+//                              [--min-time=<seconds>] [--threads=<n, 0 = all CPUs>] [--json=<file>]
+//                              [--stats=<file>] [--quick]
+//--stats writes the per-function call counters of the whole run (library
+//built with VECTORMATH_ENABLE_STATS), e.g. to see which exports dominate.
+
+
+//Keeps the compiler from dropping work whose result is never read
+static void ClobberMemory() {
+#if defined(_MSC_VER)
+    _ReadWriteBarrier();
+#else
+    asm volatile("" : : : "memory");
+#endif
+}
+
+static unsigned int g_seed = 12345u;
+
+static float RandomFloat(float minVal, float maxVal) {
+    g_seed = g_seed * 1664525u + 1013904223u;
+    return minVal + (maxVal - minVal) * (float)(g_seed >> 8) / 16777216.0f;
+}
+
+
+//Input and output buffers shared by every case, sized for the largest run
+struct BenchData {
+    std::vector<Vec2> a2, b2, out2;
+    std::vector<Vec3> a3, b3, out3;
+    std::vector<float> ax, ay, az, bx, by, bz, outX, outY, outZ, outS;
+    std::vector<Mat4> mats, outMats;
+    std::vector<Vec3> outScale;
+    std::vector<Vec2> bodies2, bodyVelocities2;
+    std::vector<Vec3> bodies3, bodyVelocities3;
+    std::vector<Quat> quats, outQuats;
+    std::vector<unsigned char> contacts;
+    std::vector<Vec2> gridPoints;
+    std::vector<Vec2> sortedGridPoints; //first sortedCount gridPoints in Morton order
+    size_t sortedCount = 0;
+    std::vector<uint32_t> permutation;
+    std::vector<int> gridResults;
+    SpatialGrid2D* grid = nullptr;
+    std::vector<Vec3> boxMin, boxMax, rayOrigins, rayDirections;
+    std::vector<RayHit> rayHits;
+    Bvh3D* bvh = nullptr;
+    std::vector<float> sweepRadii;
+    std::vector<Vec2> sweepBoxMin, sweepBoxMax;
+    std::vector<SweepHit2D> sweepHits;
+    std::vector<Half> halves;
+    std::vector<BFloat16> bfloats;
+    std::vector<double> doubles;
+    std::vector<Vec3d> a3d, b3d, out3d;
+    std::vector<Vec3A> a3a, b3a, out3a;
+    Mat4 transform;
+    std::vector<float> curveT;          //kCurveSamples sorted parameters
+    std::vector<float> curveDistances;  //n sorted distances along curve
+    Curve3D* curve = nullptr;           //Catmull-Rom through the first kCurvePoints a3
+    SnapshotReader* snapshot = nullptr; //kSnapshotFrames frames of n / kSnapshotFrames points
+    size_t snapshotCount = 0;
+};
+
+//The curve cases sample n / kCurveSamples Catmull-Rom curves of 4 points
+//kCurveSamples times each, and one rail of kCurvePoints points n times
+static const size_t kCurveSamples = 64;
+static const size_t kCurvePoints = 64;
+
+//The snapshot cases spread n points over this many frames
+static const size_t kSnapshotFrames = 4;
+static const char* kSnapshotPath = "VectorMathBenchSnapshot.bin";
+static const char* kRecordPath = "VectorMathBenchRecord.bin";
+
+//Records a2 moving along b2, as a raw channel and a delta channel (1 mm steps)
+static bool RecordSnapshot(BenchData& d, size_t n, const char* path) {
+    size_t count = n / kSnapshotFrames > 0 ? n / kSnapshotFrames : 1;
+    VectorMathSnapshotChannel channels[2] = {};
+    for (int c = 0; c < 2; ++c) {
+        strcpy(channels[c].name, c == 0 ? "raw" : "delta");
+        channels[c].components = 2;
+        channels[c].count = (uint32_t)count;
+        channels[c].encoding = c == 0 ? VECTORMATH_SNAPSHOT_RAW : VECTORMATH_SNAPSHOT_DELTA;
+        channels[c].step = 0.001f;
+    }
+    SnapshotWriter* writer = SnapshotWriterCreate(path, channels, 2, 0);
+    if (writer == nullptr) {
+        return false;
+    }
+    for (size_t f = 0; f < kSnapshotFrames; ++f) {
+        VectorScaleAdd2DArray(d.a2.data(), d.b2.data(), 0.016f * (float)f, d.out2.data(), count);
+        SnapshotWriterWrite(writer, 0, (const float*)d.out2.data());
+        SnapshotWriterWrite(writer, 1, (const float*)d.out2.data());
+        SnapshotWriterEndFrame(writer);
+    }
+    return SnapshotWriterClose(writer) == 1;
+}
+
+//Opens a snapshot of n points for the replay cases (on their warm-up run)
+static void PrepareSnapshot(BenchData& d, size_t n) {
+    if (d.snapshot != nullptr && d.snapshotCount == n) {
+        return;
+    }
+    SnapshotReaderClose(d.snapshot);
+    d.snapshot = RecordSnapshot(d, n, kSnapshotPath) ? SnapshotReaderOpen(kSnapshotPath) : nullptr;
+    d.snapshotCount = n;
+}
+
+//Replays every frame into an array call, straight from the mapping for raw
+//channels and decoded into out2 for delta ones
+static void ReplaySnapshot(BenchData& d, size_t n, bool decode) {
+    PrepareSnapshot(d, n);
+    size_t count = n / kSnapshotFrames > 0 ? n / kSnapshotFrames : 1;
+    for (size_t f = 0; d.snapshot != nullptr && f < kSnapshotFrames; ++f) {
+        const Vec2* frame = d.out2.data();
+        if (decode) {
+            SnapshotReaderRead(d.snapshot, 1, f, 1, (float*)d.out2.data());
+        }
+        else {
+            frame = (const Vec2*)SnapshotReaderFrameData(d.snapshot, 0, f);
+        }
+        VectorAdd2DArray(frame, d.b2.data(), d.out2.data(), count);
+    }
+}
+
+static void FillData(BenchData& d, size_t n) {
+    d.a2.resize(n); d.b2.resize(n); d.out2.resize(n);
+    d.a3.resize(n); d.b3.resize(n); d.out3.resize(n);
+    for (std::vector<float>* v : { &d.ax, &d.ay, &d.az, &d.bx, &d.by, &d.bz, &d.outX, &d.outY, &d.outZ, &d.outS }) {
+        v->resize(n);
+    }
+    d.outScale.resize(n);
+    d.mats.resize(n); d.outMats.resize(n); d.quats.resize(n); d.outQuats.resize(n);
+    d.contacts.resize(n);
+    d.halves.resize(n); d.bfloats.resize(n); d.doubles.resize(n);
+    d.a3d.resize(n); d.b3d.resize(n); d.out3d.resize(n);
+    d.a3a.resize(n); d.b3a.resize(n); d.out3a.resize(n);
+
+    for (size_t i = 0; i < n; ++i) {
+        d.a3[i] = { RandomFloat(-10.0f, 10.0f), RandomFloat(-10.0f, 10.0f), RandomFloat(-10.0f, 10.0f) };
+        d.b3[i] = { RandomFloat(-10.0f, 10.0f), RandomFloat(-10.0f, 10.0f), RandomFloat(-10.0f, 10.0f) };
+        d.a2[i] = { d.a3[i].x, d.a3[i].y };
+        d.b2[i] = { d.b3[i].x, d.b3[i].y };
+        d.ax[i] = d.a3[i].x; d.ay[i] = d.a3[i].y; d.az[i] = d.a3[i].z;
+        d.bx[i] = d.b3[i].x; d.by[i] = d.b3[i].y; d.bz[i] = d.b3[i].z;
+        d.quats[i] = QuatFromAxisAngle(d.a3[i], RandomFloat(-3.0f, 3.0f));
+        Mat4ComposeTRS(d.b3[i], d.quats[i], { 1.0f, 2.0f, 0.5f }, &d.mats[i]);
+        d.contacts[i] = RandomFloat(0.0f, 1.0f) < 0.5f ? 1 : 0;
+        d.a3d[i] = VectorToDouble(d.a3[i]);
+        d.b3d[i] = VectorToDouble(d.b3[i]);
+        d.a3a[i] = ToVec3A(d.a3[i]);
+        d.b3a[i] = ToVec3A(d.b3[i]);
+    }
+    //The integration cases move these every run, so they get their own copies
+    d.bodies2 = d.a2; d.bodyVelocities2 = d.b2;
+    d.bodies3 = d.a3; d.bodyVelocities3 = d.b3;
+
+    //About one point per unit square, so a 0.5 pair distance finds ~0.8 neighbours per point
+    float side = std::sqrt((float)n);
+    d.gridPoints.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        d.gridPoints[i] = { RandomFloat(0.0f, side), RandomFloat(0.0f, side) };
+    }
+    d.gridResults.resize(n * 2);
+    d.sortedGridPoints.resize(n);
+    d.permutation.resize(n);
+    d.grid = SpatialGrid2DCreate(1.0f);
+
+    //Unit boxes spread so the volume grows with n. The rays fan out from one
+    //corner in scanline order like camera rays, so neighbours are coherent.
+    float cube = 2.0f * std::cbrt((float)n);
+    size_t rayRows = (size_t)std::sqrt((float)n) + 1;
+    d.boxMin.resize(n); d.boxMax.resize(n); d.rayOrigins.resize(n); d.rayDirections.resize(n); d.rayHits.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        d.boxMin[i] = { RandomFloat(0.0f, cube), RandomFloat(0.0f, cube), RandomFloat(0.0f, cube) };
+        d.boxMax[i] = d.boxMin[i] + Vec3{ 1.0f, 1.0f, 1.0f };
+        d.rayOrigins[i] = { -1.0f, -1.0f, -1.0f };
+        d.rayDirections[i] = { 1.0f, 0.5f + 0.5f * (float)(i % rayRows) / rayRows, 0.5f + 0.5f * (float)(i / rayRows) / rayRows };
+    }
+    d.bvh = Bvh3DCreate();
+
+    d.curveT.resize(kCurveSamples);
+    for (size_t i = 0; i < kCurveSamples; ++i) {
+        d.curveT[i] = (float)i / (float)(kCurveSamples - 1);
+    }
+    d.curve = Curve3DCreate(VECTORMATH_CURVE_CATMULL_ROM, d.a3.data(), n < kCurvePoints ? n : kCurvePoints, 0);
+    d.curveDistances.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        d.curveDistances[i] = Curve3DLength(d.curve) * (float)i / (float)n;
+    }
+
+    //Circles moving up to 10 units past 2x2 boxes near the origin, about a third hit
+    d.sweepRadii.resize(n); d.sweepBoxMin.resize(n); d.sweepBoxMax.resize(n); d.sweepHits.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        d.sweepRadii[i] = RandomFloat(0.1f, 1.0f);
+        d.sweepBoxMin[i] = { RandomFloat(-3.0f, 1.0f), RandomFloat(-3.0f, 1.0f) };
+        d.sweepBoxMax[i] = d.sweepBoxMin[i] + Vec2{ 2.0f, 2.0f };
+    }
+    Mat4ComposeTRS({ 1.0f, 2.0f, 3.0f }, QuatFromAxisAngle({ 0.0f, 1.0f, 0.0f }, 0.5f), { 2.0f, 2.0f, 2.0f }, &d.transform);
+}
+
+
+enum BenchKind {
+    KIND_LOOP,
+    KIND_INLINE,
+    KIND_ARRAY,
+    KIND_BATCH,
+    KIND_EXPR,
+    KIND_QUERY //whole-array native call that does not use the SIMD kernels
+};
+
+static const char* KindName(BenchKind kind) {
+    switch (kind) {
+    case KIND_LOOP: return "loop";
+    case KIND_INLINE: return "inline";
+    case KIND_ARRAY: return "array";
+    case KIND_EXPR: return "expr";
+    case KIND_QUERY: return "query";
+    default: return "batch";
+    }
+}
+
+struct BenchCase {
+    const char* name;
+    BenchKind kind;
+    void (*run)(BenchData& d, size_t n);
+};
+
+struct BenchResult {
+    std::string name;
+    std::string kind;
+    std::string kernels;
+    size_t size;
+    unsigned long long iterations;
+    double nsPerOp;
+    double itemsPerSecond;
+};
+
+
+//Benchmark Cases
+using namespace vmath;
+
+static const BenchCase kCases[] = {
+    //Vec2
+    { "VectorAdd2D", KIND_LOOP, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out2[i] = VectorAdd2D(d.a2[i], d.b2[i]); } },
+    { "VectorAdd2D", KIND_INLINE, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out2[i] = d.a2[i] + d.b2[i]; } },
+    { "VectorAdd2D", KIND_ARRAY, [](BenchData& d, size_t n) { VectorAdd2DArray(d.a2.data(), d.b2.data(), d.out2.data(), n); } },
+    { "VectorAdd2D", KIND_BATCH, [](BenchData& d, size_t n) { VectorAdd2DBatch(d.ax.data(), d.ay.data(), d.bx.data(), d.by.data(), d.outX.data(), d.outY.data(), n); } },
+
+    { "VectorSubtract2D", KIND_LOOP, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out2[i] = VectorSubtract2D(d.a2[i], d.b2[i]); } },
+    { "VectorSubtract2D", KIND_INLINE, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out2[i] = d.a2[i] - d.b2[i]; } },
+    { "VectorSubtract2D", KIND_ARRAY, [](BenchData& d, size_t n) { VectorSubtract2DArray(d.a2.data(), d.b2.data(), d.out2.data(), n); } },
+    { "VectorSubtract2D", KIND_BATCH, [](BenchData& d, size_t n) { VectorSubtract2DBatch(d.ax.data(), d.ay.data(), d.bx.data(), d.by.data(), d.outX.data(), d.outY.data(), n); } },
+
+    { "VectorScale2D", KIND_LOOP, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out2[i] = VectorScale2D(d.a2[i], 1.5f); } },
+    { "VectorScale2D", KIND_INLINE, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out2[i] = d.a2[i] * 1.5f; } },
+    { "VectorScale2D", KIND_ARRAY, [](BenchData& d, size_t n) { VectorScale2DArray(d.a2.data(), 1.5f, d.out2.data(), n); } },
+    { "VectorScale2D", KIND_BATCH, [](BenchData& d, size_t n) { VectorScale2DBatch(d.ax.data(), d.ay.data(), 1.5f, d.outX.data(), d.outY.data(), n); } },
+
+    { "VectorDivide2D", KIND_LOOP, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out2[i] = VectorDivide2D(d.a2[i], 1.5f); } },
+    { "VectorDivide2D", KIND_INLINE, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out2[i] = d.a2[i] / 1.5f; } },
+    { "VectorDivide2D", KIND_ARRAY, [](BenchData& d, size_t n) { VectorDivide2DArray(d.a2.data(), 1.5f, d.out2.data(), n); } },
+    { "VectorDivide2D", KIND_BATCH, [](BenchData& d, size_t n) { VectorDivide2DBatch(d.ax.data(), d.ay.data(), 1.5f, d.outX.data(), d.outY.data(), n); } },
+
+    { "VectorMagnitude2D", KIND_LOOP, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.outS[i] = VectorMagnitude2D(d.a2[i]); } },
+    { "VectorMagnitude2D", KIND_INLINE, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.outS[i] = Magnitude(d.a2[i]); } },
+    { "VectorMagnitude2D", KIND_ARRAY, [](BenchData& d, size_t n) { VectorMagnitude2DArray(d.a2.data(), d.outS.data(), n); } },
+    { "VectorMagnitude2D", KIND_BATCH, [](BenchData& d, size_t n) { VectorMagnitude2DBatch(d.ax.data(), d.ay.data(), d.outS.data(), n); } },
+
+    { "VectorNormalize2D", KIND_LOOP, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out2[i] = VectorNormalize2D(d.a2[i]); } },
+    { "VectorNormalize2D", KIND_INLINE, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out2[i] = Normalize(d.a2[i]); } },
+    { "VectorNormalize2D", KIND_ARRAY, [](BenchData& d, size_t n) { VectorNormalize2DArray(d.a2.data(), d.out2.data(), n); } },
+    { "VectorNormalize2D", KIND_BATCH, [](BenchData& d, size_t n) { VectorNormalize2DBatch(d.ax.data(), d.ay.data(), d.outX.data(), d.outY.data(), n); } },
+
+    { "VectorNormalizeFast2D", KIND_LOOP, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out2[i] = VectorNormalizeFast2D(d.a2[i]); } },
+    { "VectorNormalizeFast2D", KIND_INLINE, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out2[i] = NormalizeFast(d.a2[i]); } },
+    { "VectorNormalizeFast2D", KIND_ARRAY, [](BenchData& d, size_t n) { VectorNormalizeFast2DArray(d.a2.data(), d.out2.data(), n); } },
+    { "VectorNormalizeFast2D", KIND_BATCH, [](BenchData& d, size_t n) { VectorNormalizeFast2DBatch(d.ax.data(), d.ay.data(), d.outX.data(), d.outY.data(), n); } },
+
+    { "VectorDot2D", KIND_LOOP, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.outS[i] = VectorDot2D(d.a2[i], d.b2[i]); } },
+    { "VectorDot2D", KIND_INLINE, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.outS[i] = Dot(d.a2[i], d.b2[i]); } },
+    { "VectorDot2D", KIND_ARRAY, [](BenchData& d, size_t n) { VectorDot2DArray(d.a2.data(), d.b2.data(), d.outS.data(), n); } },
+    { "VectorDot2D", KIND_BATCH, [](BenchData& d, size_t n) { VectorDot2DBatch(d.ax.data(), d.ay.data(), d.bx.data(), d.by.data(), d.outS.data(), n); } },
+
+    { "VectorCross2D", KIND_LOOP, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.outS[i] = VectorCross2D(d.a2[i], d.b2[i]); } },
+    { "VectorCross2D", KIND_INLINE, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.outS[i] = Cross(d.a2[i], d.b2[i]); } },
+    { "VectorCross2D", KIND_ARRAY, [](BenchData& d, size_t n) { VectorCross2DArray(d.a2.data(), d.b2.data(), d.outS.data(), n); } },
+    { "VectorCross2D", KIND_BATCH, [](BenchData& d, size_t n) { VectorCross2DBatch(d.ax.data(), d.ay.data(), d.bx.data(), d.by.data(), d.outS.data(), n); } },
+
+    { "VectorLerp2D", KIND_LOOP, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out2[i] = VectorLerp2D(d.a2[i], d.b2[i], 0.25f); } },
+    { "VectorLerp2D", KIND_INLINE, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out2[i] = Lerp(d.a2[i], d.b2[i], 0.25f); } },
+    { "VectorLerp2D", KIND_ARRAY, [](BenchData& d, size_t n) { VectorLerp2DArray(d.a2.data(), d.b2.data(), 0.25f, d.out2.data(), n); } },
+    { "VectorLerp2D", KIND_BATCH, [](BenchData& d, size_t n) { VectorLerp2DBatch(d.ax.data(), d.ay.data(), d.bx.data(), d.by.data(), 0.25f, d.outX.data(), d.outY.data(), n); } },
+
+    { "VectorReflect2D", KIND_LOOP, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out2[i] = VectorReflect2D(d.a2[i], d.b2[i]); } },
+    { "VectorReflect2D", KIND_INLINE, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out2[i] = Reflect(d.a2[i], d.b2[i]); } },
+    { "VectorReflect2D", KIND_ARRAY, [](BenchData& d, size_t n) { VectorReflect2DArray(d.a2.data(), d.b2.data(), d.out2.data(), n); } },
+    { "VectorReflect2D", KIND_BATCH, [](BenchData& d, size_t n) { VectorReflect2DBatch(d.ax.data(), d.ay.data(), d.bx.data(), d.by.data(), d.outX.data(), d.outY.data(), n); } },
+
+    { "VectorClampMagnitude2D", KIND_LOOP, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out2[i] = VectorClampMagnitude2D(d.a2[i], 5.0f); } },
+    { "VectorClampMagnitude2D", KIND_INLINE, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out2[i] = ClampMagnitude(d.a2[i], 5.0f); } },
+    { "VectorClampMagnitude2D", KIND_ARRAY, [](BenchData& d, size_t n) { VectorClampMagnitude2DArray(d.a2.data(), 5.0f, d.out2.data(), n); } },
+    { "VectorClampMagnitude2D", KIND_BATCH, [](BenchData& d, size_t n) { VectorClampMagnitude2DBatch(d.ax.data(), d.ay.data(), 5.0f, d.outX.data(), d.outY.data(), n); } },
+
+    { "VectorClamp2D", KIND_LOOP, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out2[i] = VectorClamp2D(d.a2[i], -5.0f, 5.0f); } },
+    { "VectorClamp2D", KIND_INLINE, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out2[i] = vmath::Clamp(d.a2[i], -5.0f, 5.0f); } },
+    { "VectorClamp2D", KIND_ARRAY, [](BenchData& d, size_t n) { VectorClamp2DArray(d.a2.data(), -5.0f, 5.0f, d.out2.data(), n); } },
+    { "VectorClamp2D", KIND_BATCH, [](BenchData& d, size_t n) { VectorClamp2DBatch(d.ax.data(), d.ay.data(), -5.0f, 5.0f, d.outX.data(), d.outY.data(), n); } },
+
+    //Vec3
+    { "VectorAdd", KIND_LOOP, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out3[i] = VectorAdd(d.a3[i], d.b3[i]); } },
+    { "VectorAdd", KIND_INLINE, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out3[i] = d.a3[i] + d.b3[i]; } },
+    { "VectorAdd", KIND_ARRAY, [](BenchData& d, size_t n) { VectorAddArray(d.a3.data(), d.b3.data(), d.out3.data(), n); } },
+    { "VectorAdd", KIND_BATCH, [](BenchData& d, size_t n) { VectorAddBatch(d.ax.data(), d.ay.data(), d.az.data(), d.bx.data(), d.by.data(), d.bz.data(), d.outX.data(), d.outY.data(), d.outZ.data(), n); } },
+
+    { "VectorSubtract", KIND_LOOP, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out3[i] = VectorSubtract(d.a3[i], d.b3[i]); } },
+    { "VectorSubtract", KIND_INLINE, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out3[i] = d.a3[i] - d.b3[i]; } },
+    { "VectorSubtract", KIND_ARRAY, [](BenchData& d, size_t n) { VectorSubtractArray(d.a3.data(), d.b3.data(), d.out3.data(), n); } },
+    { "VectorSubtract", KIND_BATCH, [](BenchData& d, size_t n) { VectorSubtractBatch(d.ax.data(), d.ay.data(), d.az.data(), d.bx.data(), d.by.data(), d.bz.data(), d.outX.data(), d.outY.data(), d.outZ.data(), n); } },
+
+    { "VectorScale", KIND_LOOP, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out3[i] = VectorScale(d.a3[i], 1.5f); } },
+    { "VectorScale", KIND_INLINE, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out3[i] = d.a3[i] * 1.5f; } },
+    { "VectorScale", KIND_ARRAY, [](BenchData& d, size_t n) { VectorScaleArray(d.a3.data(), 1.5f, d.out3.data(), n); } },
+    { "VectorScale", KIND_BATCH, [](BenchData& d, size_t n) { VectorScaleBatch(d.ax.data(), d.ay.data(), d.az.data(), 1.5f, d.outX.data(), d.outY.data(), d.outZ.data(), n); } },
+
+    { "VectorDivide", KIND_LOOP, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out3[i] = VectorDivide(d.a3[i], 1.5f); } },
+    { "VectorDivide", KIND_INLINE, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out3[i] = d.a3[i] / 1.5f; } },
+    { "VectorDivide", KIND_ARRAY, [](BenchData& d, size_t n) { VectorDivideArray(d.a3.data(), 1.5f, d.out3.data(), n); } },
+    { "VectorDivide", KIND_BATCH, [](BenchData& d, size_t n) { VectorDivideBatch(d.ax.data(), d.ay.data(), d.az.data(), 1.5f, d.outX.data(), d.outY.data(), d.outZ.data(), n); } },
+
+    { "VectorMagnitude", KIND_LOOP, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.outS[i] = VectorMagnitude(d.a3[i]); } },
+    { "VectorMagnitude", KIND_INLINE, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.outS[i] = Magnitude(d.a3[i]); } },
+    { "VectorMagnitude", KIND_ARRAY, [](BenchData& d, size_t n) { VectorMagnitudeArray(d.a3.data(), d.outS.data(), n); } },
+    { "VectorMagnitude", KIND_BATCH, [](BenchData& d, size_t n) { VectorMagnitudeBatch(d.ax.data(), d.ay.data(), d.az.data(), d.outS.data(), n); } },
+
+    { "VectorNormalize", KIND_LOOP, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out3[i] = VectorNormalize(d.a3[i]); } },
+    { "VectorNormalize", KIND_INLINE, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out3[i] = Normalize(d.a3[i]); } },
+    { "VectorNormalize", KIND_ARRAY, [](BenchData& d, size_t n) { VectorNormalizeArray(d.a3.data(), d.out3.data(), n); } },
+    { "VectorNormalize", KIND_BATCH, [](BenchData& d, size_t n) { VectorNormalizeBatch(d.ax.data(), d.ay.data(), d.az.data(), d.outX.data(), d.outY.data(), d.outZ.data(), n); } },
+
+    { "VectorNormalizeFast", KIND_LOOP, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out3[i] = VectorNormalizeFast(d.a3[i]); } },
+    { "VectorNormalizeFast", KIND_INLINE, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out3[i] = NormalizeFast(d.a3[i]); } },
+    { "VectorNormalizeFast", KIND_ARRAY, [](BenchData& d, size_t n) { VectorNormalizeFastArray(d.a3.data(), d.out3.data(), n); } },
+    { "VectorNormalizeFast", KIND_BATCH, [](BenchData& d, size_t n) { VectorNormalizeFastBatch(d.ax.data(), d.ay.data(), d.az.data(), d.outX.data(), d.outY.data(), d.outZ.data(), n); } },
+
+    { "VectorDot", KIND_LOOP, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.outS[i] = VectorDot(d.a3[i], d.b3[i]); } },
+    { "VectorDot", KIND_INLINE, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.outS[i] = Dot(d.a3[i], d.b3[i]); } },
+    { "VectorDot", KIND_ARRAY, [](BenchData& d, size_t n) { VectorDotArray(d.a3.data(), d.b3.data(), d.outS.data(), n); } },
+    { "VectorDot", KIND_BATCH, [](BenchData& d, size_t n) { VectorDotBatch(d.ax.data(), d.ay.data(), d.az.data(), d.bx.data(), d.by.data(), d.bz.data(), d.outS.data(), n); } },
+
+    { "VectorCross", KIND_LOOP, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out3[i] = VectorCross(d.a3[i], d.b3[i]); } },
+    { "VectorCross", KIND_INLINE, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out3[i] = Cross(d.a3[i], d.b3[i]); } },
+    { "VectorCross", KIND_ARRAY, [](BenchData& d, size_t n) { VectorCrossArray(d.a3.data(), d.b3.data(), d.out3.data(), n); } },
+    { "VectorCross", KIND_BATCH, [](BenchData& d, size_t n) { VectorCrossBatch(d.ax.data(), d.ay.data(), d.az.data(), d.bx.data(), d.by.data(), d.bz.data(), d.outX.data(), d.outY.data(), d.outZ.data(), n); } },
+
+    { "VectorLerp", KIND_LOOP, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out3[i] = VectorLerp(d.a3[i], d.b3[i], 0.25f); } },
+    { "VectorLerp", KIND_INLINE, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out3[i] = Lerp(d.a3[i], d.b3[i], 0.25f); } },
+    { "VectorLerp", KIND_ARRAY, [](BenchData& d, size_t n) { VectorLerpArray(d.a3.data(), d.b3.data(), 0.25f, d.out3.data(), n); } },
+    { "VectorLerp", KIND_BATCH, [](BenchData& d, size_t n) { VectorLerpBatch(d.ax.data(), d.ay.data(), d.az.data(), d.bx.data(), d.by.data(), d.bz.data(), 0.25f, d.outX.data(), d.outY.data(), d.outZ.data(), n); } },
+
+    { "VectorReflect", KIND_LOOP, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out3[i] = VectorReflect(d.a3[i], d.b3[i]); } },
+    { "VectorReflect", KIND_INLINE, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out3[i] = Reflect(d.a3[i], d.b3[i]); } },
+    { "VectorReflect", KIND_ARRAY, [](BenchData& d, size_t n) { VectorReflectArray(d.a3.data(), d.b3.data(), d.out3.data(), n); } },
+    { "VectorReflect", KIND_BATCH, [](BenchData& d, size_t n) { VectorReflectBatch(d.ax.data(), d.ay.data(), d.az.data(), d.bx.data(), d.by.data(), d.bz.data(), d.outX.data(), d.outY.data(), d.outZ.data(), n); } },
+
+    { "VectorClampMagnitude", KIND_LOOP, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out3[i] = VectorClampMagnitude(d.a3[i], 5.0f); } },
+    { "VectorClampMagnitude", KIND_INLINE, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out3[i] = ClampMagnitude(d.a3[i], 5.0f); } },
+    { "VectorClampMagnitude", KIND_ARRAY, [](BenchData& d, size_t n) { VectorClampMagnitudeArray(d.a3.data(), 5.0f, d.out3.data(), n); } },
+    { "VectorClampMagnitude", KIND_BATCH, [](BenchData& d, size_t n) { VectorClampMagnitudeBatch(d.ax.data(), d.ay.data(), d.az.data(), 5.0f, d.outX.data(), d.outY.data(), d.outZ.data(), n); } },
+
+    { "VectorClamp", KIND_LOOP, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out3[i] = VectorClamp(d.a3[i], -5.0f, 5.0f); } },
+    { "VectorClamp", KIND_INLINE, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out3[i] = vmath::Clamp(d.a3[i], -5.0f, 5.0f); } },
+    { "VectorClamp", KIND_ARRAY, [](BenchData& d, size_t n) { VectorClampArray(d.a3.data(), -5.0f, 5.0f, d.out3.data(), n); } },
+    { "VectorClamp", KIND_BATCH, [](BenchData& d, size_t n) { VectorClampBatch(d.ax.data(), d.ay.data(), d.az.data(), -5.0f, 5.0f, d.outX.data(), d.outY.data(), d.outZ.data(), n); } },
+
+    { "Clamp", KIND_LOOP, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.outS[i] = Clamp(d.ax[i], -5.0f, 5.0f); } },
+    { "Clamp", KIND_INLINE, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.outS[i] = vmath::Clamp(d.ax[i], -5.0f, 5.0f); } },
+    { "Clamp", KIND_BATCH, [](BenchData& d, size_t n) { ClampBatch(d.ax.data(), -5.0f, 5.0f, d.outS.data(), n); } },
+
+    //Fused Operations (compare with the VectorScale2D + VectorAdd2D and VectorLerp + VectorClamp passes)
+    { "VectorScaleAdd2D", KIND_LOOP, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out2[i] = VectorScaleAdd2D(d.a2[i], d.b2[i], 0.016f); } },
+    { "VectorScaleAdd2D", KIND_INLINE, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out2[i] = ScaleAdd(d.a2[i], d.b2[i], 0.016f); } },
+    { "VectorScaleAdd2D", KIND_ARRAY, [](BenchData& d, size_t n) { VectorScaleAdd2DArray(d.a2.data(), d.b2.data(), 0.016f, d.out2.data(), n); } },
+    { "VectorScaleAdd2D", KIND_BATCH, [](BenchData& d, size_t n) { VectorScaleAdd2DBatch(d.ax.data(), d.ay.data(), d.bx.data(), d.by.data(), 0.016f, d.outX.data(), d.outY.data(), n); } },
+    { "VectorScaleAdd2D", KIND_EXPR, [](BenchData& d, size_t n) { MakeVecSpan(d.out2.data(), n) = MakeVecSpan(d.a2.data(), n) + MakeVecSpan(d.b2.data(), n) * 0.016f; } },
+
+    { "VectorLerpClamp", KIND_LOOP, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out3[i] = VectorLerpClamp(d.a3[i], d.b3[i], 0.25f, -5.0f, 5.0f); } },
+    { "VectorLerpClamp", KIND_INLINE, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out3[i] = LerpClamp(d.a3[i], d.b3[i], 0.25f, -5.0f, 5.0f); } },
+    { "VectorLerpClamp", KIND_ARRAY, [](BenchData& d, size_t n) { VectorLerpClampArray(d.a3.data(), d.b3.data(), 0.25f, -5.0f, 5.0f, d.out3.data(), n); } },
+    { "VectorLerpClamp", KIND_BATCH, [](BenchData& d, size_t n) { VectorLerpClampBatch(d.ax.data(), d.ay.data(), d.az.data(), d.bx.data(), d.by.data(), d.bz.data(), 0.25f, -5.0f, 5.0f, d.outX.data(), d.outY.data(), d.outZ.data(), n); } },
+
+    //A chain with no fused export: two Array passes against one expression loop
+    { "VectorChain2D", KIND_LOOP, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out2[i] = VectorClampMagnitude2D(VectorAdd2D(d.a2[i], VectorScale2D(d.b2[i], 0.016f)), 5.0f); } },
+    { "VectorChain2D", KIND_ARRAY, [](BenchData& d, size_t n) { VectorScaleAdd2DArray(d.a2.data(), d.b2.data(), 0.016f, d.out2.data(), n); VectorClampMagnitude2DArray(d.out2.data(), 5.0f, d.out2.data(), n); } },
+    { "VectorChain2D", KIND_EXPR, [](BenchData& d, size_t n) { MakeVecSpan(d.out2.data(), n) = ClampMagnitude(MakeVecSpan(d.a2.data(), n) + MakeVecSpan(d.b2.data(), n) * 0.016f, 5.0f); } },
+
+    { "VectorClampMagnitudeRange", KIND_LOOP, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out3[i] = VectorClampMagnitudeRange(d.a3[i], 1.0f, 5.0f); } },
+    { "VectorClampMagnitudeRange", KIND_INLINE, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out3[i] = ClampMagnitude(d.a3[i], 1.0f, 5.0f); } },
+    { "VectorClampMagnitudeRange", KIND_ARRAY, [](BenchData& d, size_t n) { VectorClampMagnitudeRangeArray(d.a3.data(), 1.0f, 5.0f, d.out3.data(), n); } },
+    { "VectorClampMagnitudeRange", KIND_BATCH, [](BenchData& d, size_t n) { VectorClampMagnitudeRangeBatch(d.ax.data(), d.ay.data(), d.az.data(), 1.0f, 5.0f, d.outX.data(), d.outY.data(), d.outZ.data(), n); } },
+
+    //Aligned Vec3A (compare with the packed Vec3 Array cases above)
+    { "VectorNormalize3A", KIND_INLINE, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out3a[i] = Normalize(d.a3a[i]); } },
+    { "VectorNormalize3A", KIND_ARRAY, [](BenchData& d, size_t n) { VectorNormalize3AArray(d.a3a.data(), d.out3a.data(), n); } },
+    { "VectorDot3A", KIND_ARRAY, [](BenchData& d, size_t n) { VectorDot3AArray(d.a3a.data(), d.b3a.data(), d.outS.data(), n); } },
+    { "VectorMagnitude3A", KIND_ARRAY, [](BenchData& d, size_t n) { VectorMagnitude3AArray(d.a3a.data(), d.outS.data(), n); } },
+    { "VectorCross3A", KIND_INLINE, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out3a[i] = Cross(d.a3a[i], d.b3a[i]); } },
+    { "VectorCross3A", KIND_ARRAY, [](BenchData& d, size_t n) { VectorCross3AArray(d.a3a.data(), d.b3a.data(), d.out3a.data(), n); } },
+    { "VectorAdd3A", KIND_ARRAY, [](BenchData& d, size_t n) { VectorAdd3AArray(d.a3a.data(), d.b3a.data(), d.out3a.data(), n); } },
+
+    //Precision (Double is the scalar Vec3d path, Convert the flat float arrays)
+    { "VectorAddDouble", KIND_LOOP, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out3d[i] = VectorAddDouble(d.a3d[i], d.b3d[i]); } },
+    { "VectorAddDouble", KIND_INLINE, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out3d[i] = d.a3d[i] + d.b3d[i]; } },
+    { "VectorNormalizeDouble", KIND_LOOP, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out3d[i] = VectorNormalizeDouble(d.a3d[i]); } },
+    { "VectorNormalizeDouble", KIND_INLINE, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out3d[i] = Normalize(d.a3d[i]); } },
+
+    { "ConvertFloatToHalf", KIND_LOOP, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.halves[i] = HalfFromFloat(d.ax[i]); } },
+    { "ConvertFloatToHalf", KIND_BATCH, [](BenchData& d, size_t n) { ConvertFloatToHalf(d.ax.data(), d.halves.data(), n); } },
+    { "ConvertHalfToFloat", KIND_LOOP, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.outS[i] = HalfToFloat(d.halves[i]); } },
+    { "ConvertHalfToFloat", KIND_BATCH, [](BenchData& d, size_t n) { ConvertHalfToFloat(d.halves.data(), d.outS.data(), n); } },
+    { "ConvertFloatToBFloat16", KIND_LOOP, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.bfloats[i] = BFloat16FromFloat(d.ax[i]); } },
+    { "ConvertFloatToBFloat16", KIND_BATCH, [](BenchData& d, size_t n) { ConvertFloatToBFloat16(d.ax.data(), d.bfloats.data(), n); } },
+    { "ConvertBFloat16ToFloat", KIND_BATCH, [](BenchData& d, size_t n) { ConvertBFloat16ToFloat(d.bfloats.data(), d.outS.data(), n); } },
+    { "ConvertFloatToDouble", KIND_BATCH, [](BenchData& d, size_t n) { ConvertFloatToDouble(d.ax.data(), d.doubles.data(), n); } },
+
+    //Matrices & Quaternions
+    { "Mat4TransformPoint", KIND_LOOP, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out3[i] = Mat4TransformPoint(&d.transform, d.a3[i]); } },
+    { "Mat4TransformPoint", KIND_INLINE, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out3[i] = TransformPoint(d.transform, d.a3[i]); } },
+    { "Mat4TransformPoint", KIND_ARRAY, [](BenchData& d, size_t n) { Mat4TransformPoints(&d.transform, d.a3.data(), d.out3.data(), n); } },
+
+    { "Mat4TransformDirection", KIND_LOOP, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out3[i] = Mat4TransformDirection(&d.transform, d.a3[i]); } },
+    { "Mat4TransformDirection", KIND_INLINE, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out3[i] = TransformDirection(d.transform, d.a3[i]); } },
+    { "Mat4TransformDirection", KIND_ARRAY, [](BenchData& d, size_t n) { Mat4TransformDirections(&d.transform, d.a3.data(), d.out3.data(), n); } },
+
+    { "Mat4Multiply", KIND_LOOP, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) Mat4Multiply(&d.transform, &d.mats[i], &d.outMats[i]); } },
+    { "Mat4Multiply", KIND_INLINE, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.outMats[i] = d.transform * d.mats[i]; } },
+    { "Mat4Inverse", KIND_LOOP, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) Mat4Inverse(&d.mats[i], &d.outMats[i]); } },
+    { "Mat4Inverse", KIND_INLINE, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.outMats[i] = Inverse(d.mats[i]); } },
+    { "Mat4ComposeTRS", KIND_LOOP, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) Mat4ComposeTRS(d.a3[i], d.quats[i], d.b3[i], &d.outMats[i]); } },
+    { "Mat4DecomposeTRS", KIND_LOOP, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) Mat4DecomposeTRS(&d.mats[i], &d.out3[i], &d.outQuats[i], &d.outScale[i]); } },
+    { "QuatMultiply", KIND_LOOP, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.outQuats[i] = QuatMultiply(d.quats[i], d.quats[n - 1 - i]); } },
+    { "QuatRotateVector", KIND_LOOP, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out3[i] = QuatRotateVector(d.quats[i], d.b3[i]); } },
+    { "QuatRotateVector", KIND_INLINE, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) d.out3[i] = Rotate(d.quats[i], d.b3[i]); } },
+
+    //Physics
+    { "IntegrateBodies2D", KIND_LOOP, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) { d.bodyVelocities2[i] = VectorAdd2D(d.bodyVelocities2[i], VectorScale2D(d.b2[i], 0.001f)); d.bodies2[i] = VectorAdd2D(d.bodies2[i], VectorScale2D(d.bodyVelocities2[i], 0.001f)); } } },
+    { "IntegrateBodies2D", KIND_INLINE, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) { d.bodyVelocities2[i] += d.b2[i] * 0.001f; d.bodies2[i] += d.bodyVelocities2[i] * 0.001f; } } },
+    { "IntegrateBodies2D", KIND_ARRAY, [](BenchData& d, size_t n) { IntegrateBodies2D(d.bodies2.data(), d.bodyVelocities2.data(), d.b2.data(), n, 0.001f); } },
+    { "IntegrateBodies", KIND_ARRAY, [](BenchData& d, size_t n) { IntegrateBodies(d.bodies3.data(), d.bodyVelocities3.data(), d.b3.data(), n, 0.001f); } },
+    { "IntegrateBodiesVerlet2D", KIND_ARRAY, [](BenchData& d, size_t n) { IntegrateBodiesVerlet2D(d.bodies2.data(), d.bodyVelocities2.data(), d.b2.data(), n, 0.001f); } },
+    { "IntegrateBodiesVerlet", KIND_ARRAY, [](BenchData& d, size_t n) { IntegrateBodiesVerlet(d.bodies3.data(), d.bodyVelocities3.data(), d.b3.data(), n, 0.001f); } },
+
+    //Collision response runs in place; restitution 1 and friction 0 keep the speeds stable across runs
+    { "VectorReflectResponse2D", KIND_INLINE, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) if (d.contacts[i] != 0) d.bodyVelocities2[i] = ReflectResponse(d.bodyVelocities2[i], Normalize(d.b2[i]), 1.0f, 0.0f); } },
+    { "VectorReflectResponse2D", KIND_ARRAY, [](BenchData& d, size_t n) { VectorReflectResponse2DArray(d.bodyVelocities2.data(), d.b2.data(), d.contacts.data(), n, 1.0f, 0.0f, VECTORMATH_REFLECT_DEFAULT); } },
+    { "VectorReflectResponse2D", KIND_BATCH, [](BenchData& d, size_t n) { VectorReflectResponse2DBatch(d.outX.data(), d.outY.data(), d.bx.data(), d.by.data(), d.contacts.data(), n, 1.0f, 0.0f, VECTORMATH_REFLECT_DEFAULT); } },
+    { "VectorReflectResponse", KIND_ARRAY, [](BenchData& d, size_t n) { VectorReflectResponseArray(d.bodyVelocities3.data(), d.b3.data(), d.contacts.data(), n, 1.0f, 0.0f, VECTORMATH_REFLECT_DEFAULT); } },
+    { "VectorReflectResponse", KIND_BATCH, [](BenchData& d, size_t n) { VectorReflectResponseBatch(d.outX.data(), d.outY.data(), d.outZ.data(), d.bx.data(), d.by.data(), d.bz.data(), d.contacts.data(), n, 1.0f, 0.0f, VECTORMATH_REFLECT_DEFAULT); } },
+
+    //Reductions (one value per call, kept in out)
+    { "VectorBoundsArray", KIND_LOOP, [](BenchData& d, size_t n) { Vec3 lo = d.a3[0], hi = d.a3[0]; for (size_t i = 0; i < n; ++i) { lo = Min(lo, d.a3[i]); hi = Max(hi, d.a3[i]); } d.out3[0] = lo; d.out3[1] = hi; } },
+    { "VectorBoundsArray", KIND_ARRAY, [](BenchData& d, size_t n) { VectorBoundsArray(d.a3.data(), n, &d.out3[0], &d.out3[1]); } },
+    { "VectorBounds2DArray", KIND_ARRAY, [](BenchData& d, size_t n) { VectorBounds2DArray(d.a2.data(), n, &d.out2[0], &d.out2[1]); } },
+    { "VectorSumArray", KIND_LOOP, [](BenchData& d, size_t n) { Vec3 sum = { 0.0f, 0.0f, 0.0f }; for (size_t i = 0; i < n; ++i) sum += d.a3[i]; d.out3[0] = sum; } },
+    { "VectorSumArray", KIND_ARRAY, [](BenchData& d, size_t n) { d.out3[0] = VectorSumArray(d.a3.data(), n, VECTORMATH_SUM_PAIRWISE); } },
+    { "VectorSumArrayKahan", KIND_ARRAY, [](BenchData& d, size_t n) { d.out3[0] = VectorSumArray(d.a3.data(), n, VECTORMATH_SUM_KAHAN); } },
+    { "VectorCentroidArray", KIND_ARRAY, [](BenchData& d, size_t n) { d.out3[0] = VectorCentroidArray(d.a3.data(), n); } },
+    { "VectorDotTotalArray", KIND_ARRAY, [](BenchData& d, size_t n) { d.outS[0] = VectorDotTotalArray(d.a3.data(), d.b3.data(), n, VECTORMATH_SUM_PAIRWISE); } },
+    { "VectorMagnitudeRangeArray", KIND_ARRAY, [](BenchData& d, size_t n) { VectorMathMagnitudeRange range; VectorMagnitudeRangeArray(d.a3.data(), n, &range); d.outS[0] = range.maxMagnitude; } },
+
+    //Curves (n samples in total)
+    { "VectorCurveEvaluate3D", KIND_LOOP, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) VectorCurveEvaluate3D(VECTORMATH_CURVE_CATMULL_ROM, &d.a3[i / kCurveSamples * 4], 4, 1, &d.curveT[i % kCurveSamples], 1, &d.out3[i]); } },
+    { "VectorCurveEvaluate3D", KIND_ARRAY, [](BenchData& d, size_t n) { VectorCurveEvaluate3D(VECTORMATH_CURVE_CATMULL_ROM, d.a3.data(), 4, n / kCurveSamples, d.curveT.data(), kCurveSamples, d.out3.data()); } },
+    { "VectorCurveEvaluate2D", KIND_ARRAY, [](BenchData& d, size_t n) { VectorCurveEvaluate2D(VECTORMATH_CURVE_CATMULL_ROM, d.a2.data(), 4, n / kCurveSamples, d.curveT.data(), kCurveSamples, d.out2.data()); } },
+    { "Curve3DSampleDistance", KIND_ARRAY, [](BenchData& d, size_t n) { Curve3DSampleDistance(d.curve, d.curveDistances.data(), d.out3.data(), n); } },
+
+    //Spatial Hash Grid
+    { "SpatialGrid2DBuild", KIND_QUERY, [](BenchData& d, size_t n) { SpatialGrid2DBuild(d.grid, d.gridPoints.data(), n); } },
+    { "SpatialGrid2DUpdate", KIND_QUERY, [](BenchData& d, size_t n) { SpatialGrid2DUpdate(d.grid, d.gridPoints.data(), n); } },
+    { "SpatialGrid2DQueryRadius", KIND_QUERY, [](BenchData& d, size_t n) { SpatialGrid2DUpdate(d.grid, d.gridPoints.data(), n); for (size_t i = 0; i < n; ++i) SpatialGrid2DQueryRadius(d.grid, d.gridPoints[i], 1.0f, d.gridResults.data(), 64); } },
+    //The same queries over Morton-sorted points (sorted once per size)
+    { "SpatialGrid2DQueryRadiusSorted", KIND_QUERY, [](BenchData& d, size_t n) {
+        if (d.sortedCount != n) {
+            VectorMortonSort2D(d.gridPoints.data(), d.permutation.data(), d.sortedGridPoints.data(), n);
+            d.sortedCount = n;
+        }
+        SpatialGrid2DUpdate(d.grid, d.sortedGridPoints.data(), n);
+        for (size_t i = 0; i < n; ++i) SpatialGrid2DQueryRadius(d.grid, d.sortedGridPoints[i], 1.0f, d.gridResults.data(), 64);
+    } },
+    { "SpatialGrid2DQueryPairs", KIND_QUERY, [](BenchData& d, size_t n) { SpatialGrid2DUpdate(d.grid, d.gridPoints.data(), n); SpatialGrid2DQueryPairs(d.grid, 0.5f, d.gridResults.data(), n); } },
+
+    //Spatial Sorting
+    { "VectorMortonSort2D", KIND_QUERY, [](BenchData& d, size_t n) { VectorMortonSort2D(d.gridPoints.data(), d.permutation.data(), d.out2.data(), n); } },
+    { "VectorMortonSort3D", KIND_QUERY, [](BenchData& d, size_t n) { VectorMortonSort3D(d.a3.data(), d.permutation.data(), d.out3.data(), n); } },
+    { "VectorReorderArray", KIND_QUERY, [](BenchData& d, size_t n) { VectorReorderArray(d.b3.data(), d.permutation.data(), d.out3.data(), n); } },
+
+    //Snapshots (n points spread over kSnapshotFrames frames; replay adds each frame to b2)
+    { "SnapshotRecord2D", KIND_QUERY, [](BenchData& d, size_t n) { RecordSnapshot(d, n, kRecordPath); } },
+    { "SnapshotReplay2D", KIND_QUERY, [](BenchData& d, size_t n) { ReplaySnapshot(d, n, false); } },
+    { "SnapshotReplayDelta2D", KIND_QUERY, [](BenchData& d, size_t n) { ReplaySnapshot(d, n, true); } },
+
+    //Bounding Volume Hierarchy (the query cases build a tree over n boxes on their warm-up run)
+    { "Bvh3DBuild", KIND_QUERY, [](BenchData& d, size_t n) { Bvh3DBuild(d.bvh, d.boxMin.data(), d.boxMax.data(), n); } },
+    { "Bvh3DRefit", KIND_QUERY, [](BenchData& d, size_t n) { if (Bvh3DCount(d.bvh) != n) Bvh3DBuild(d.bvh, d.boxMin.data(), d.boxMax.data(), n); Bvh3DRefit(d.bvh, d.boxMin.data(), d.boxMax.data()); } },
+    { "Bvh3DRaycast", KIND_LOOP, [](BenchData& d, size_t n) { if (Bvh3DCount(d.bvh) != n) Bvh3DBuild(d.bvh, d.boxMin.data(), d.boxMax.data(), n); for (size_t i = 0; i < n; ++i) Bvh3DRaycast(d.bvh, d.rayOrigins[i], d.rayDirections[i], 1e30f, &d.rayHits[i]); } },
+    { "Bvh3DRaycast", KIND_QUERY, [](BenchData& d, size_t n) { if (Bvh3DCount(d.bvh) != n) Bvh3DBuild(d.bvh, d.boxMin.data(), d.boxMax.data(), n); Bvh3DRaycastBatch(d.bvh, d.rayOrigins.data(), d.rayDirections.data(), n, 1e30f, d.rayHits.data()); } },
+
+    //Swept Collision (a2 are the start points, b2 the motions)
+    { "SweepCircleAABB2D", KIND_LOOP, [](BenchData& d, size_t n) { for (size_t i = 0; i < n; ++i) SweepCircleAABB2D(d.a2[i], d.sweepRadii[i], d.b2[i], d.sweepBoxMin[i], d.sweepBoxMax[i], &d.sweepHits[i]); } },
+    { "SweepCircleAABB2D", KIND_QUERY, [](BenchData& d, size_t n) { SweepCircleAABB2DArray(d.a2.data(), d.sweepRadii.data(), d.b2.data(), d.sweepBoxMin.data(), d.sweepBoxMax.data(), d.sweepHits.data(), n); } },
+    { "SweepCircleSegment2D", KIND_QUERY, [](BenchData& d, size_t n) { SweepCircleSegment2DArray(d.a2.data(), d.sweepRadii.data(), d.b2.data(), d.sweepBoxMin.data(), d.sweepBoxMax.data(), d.sweepHits.data(), n); } },
+    { "RayAABB2D", KIND_QUERY, [](BenchData& d, size_t n) { RayAABB2DArray(d.a2.data(), d.b2.data(), d.sweepBoxMin.data(), d.sweepBoxMax.data(), d.sweepHits.data(), n); } },
+    { "SegmentIntersect2D", KIND_QUERY, [](BenchData& d, size_t n) { SegmentIntersect2DArray(d.a2.data(), d.b2.data(), d.sweepBoxMin.data(), d.sweepBoxMax.data(), d.sweepHits.data(), n); } },
+};
+
+
+//Runner
+struct BenchOptions {
+    std::string filter;
+    std::vector<size_t> sizes = { 256, 4096, 65536, 1048576 };
+    double minTime = 0.1;
+    std::string jsonPath;
+    std::string statsPath;
+    int threads = 1; //single threaded by default so the kernel timings compare
+};
+
+//Runs the case with a growing iteration count until one timed run lasts at
+//least minTime (the same scheme Google Benchmark uses).
+static BenchResult RunCase(const BenchCase& c, BenchData& data, size_t n, double minTime) {
+    typedef std::chrono::steady_clock Clock;
+
+    c.run(data, n); //warm up caches and page in the buffers
+    ClobberMemory();
+
+    unsigned long long iterations = 1;
+    double seconds = 0.0;
+    for (;;) {
+        Clock::time_point start = Clock::now();
+        for (unsigned long long i = 0; i < iterations; ++i) {
+            c.run(data, n);
+            ClobberMemory();
+        }
+        seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        if (seconds >= minTime || iterations >= 1000000000ull) {
+            break;
+        }
+
+        //Aim 40% past the target, but never grow more than 10x per step
+        double multiplier = seconds > 0.0 ? minTime * 1.4 / seconds : 10.0;
+        multiplier = multiplier > 10.0 ? 10.0 : (multiplier < 2.0 ? 2.0 : multiplier);
+        iterations = (unsigned long long)(iterations * multiplier);
+    }
+
+    BenchResult r;
+    r.name = c.name;
+    r.kind = KindName(c.kind);
+    r.size = n;
+    r.iterations = iterations;
+    double ops = (double)iterations * (double)n;
+    r.nsPerOp = seconds * 1e9 / ops;
+    r.itemsPerSecond = ops / seconds;
+    return r;
+}
+
+static std::string JsonEscape(const std::string& s) {
+    std::string out;
+    for (char ch : s) {
+        if (ch == '"' || ch == '\\') {
+            out += '\\';
+        }
+        out += ch;
+    }
+    return out;
+}
+
+static bool WriteJson(const std::string& path, const std::vector<BenchResult>& results, const BenchOptions& options) {
+    std::ofstream file(path);
+    if (!file) {
+        return false;
+    }
+
+    char date[32];
+    std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    file << "{\n";
+    file << "  \"context\": {\n";
+    file << "    \"date\": \"" << date << "\",\n";
+    file << "    \"best_kernels\": \"" << JsonEscape(VectorMathGetSimdName()) << "\",\n";
+    file << "    \"min_time_s\": " << options.minTime << ",\n";
+    file << "    \"threads\": " << VectorMathGetThreadCount() << ",\n";
+#if defined(NDEBUG)
+    file << "    \"build_type\": \"release\"\n";
+#else
+    file << "    \"build_type\": \"debug\"\n";
+#endif
+    file << "  },\n";
+    file << "  \"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& r = results[i];
+        file << "    {";
+        file << "\"name\": \"" << JsonEscape(r.name) << "/" << r.kind;
+        if (!r.kernels.empty()) {
+            file << "/" << JsonEscape(r.kernels);
+        }
+        file << "/" << r.size << "\", ";
+        file << "\"function\": \"" << JsonEscape(r.name) << "\", ";
+        file << "\"variant\": \"" << r.kind << "\", ";
+        file << "\"kernels\": \"" << JsonEscape(r.kernels) << "\", ";
+        file << "\"size\": " << r.size << ", ";
+        file << "\"iterations\": " << r.iterations << ", ";
+        file << "\"ns_per_op\": " << std::setprecision(6) << r.nsPerOp << ", ";
+        file << "\"items_per_second\": " << std::setprecision(6) << r.itemsPerSecond;
+        file << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    file << "  ]\n";
+    file << "}\n";
+    return true;
+}
+
+static void PrintResult(const BenchResult& r) {
+    std::string label = r.name + "/" + r.kind + (r.kernels.empty() ? "" : "/" + r.kernels);
+    std::cout << std::left << std::setw(44) << label
+              << std::right << std::setw(10) << r.size
+              << std::setw(14) << std::fixed << std::setprecision(3) << r.nsPerOp
+              << std::setw(14) << std::setprecision(1) << r.itemsPerSecond / 1e6 << "M/s"
+              << std::setw(14) << r.iterations << std::endl;
+}
+
+static bool ParseArgs(int argc, char** argv, BenchOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.compare(0, 9, "--filter=") == 0) {
+            options.filter = arg.substr(9);
+        }
+        else if (arg.compare(0, 11, "--min-time=") == 0) {
+            options.minTime = std::atof(arg.c_str() + 11);
+        }
+        else if (arg.compare(0, 10, "--threads=") == 0) {
+            options.threads = std::atoi(arg.c_str() + 10);
+        }
+        else if (arg.compare(0, 7, "--json=") == 0) {
+            options.jsonPath = arg.substr(7);
+        }
+        else if (arg.compare(0, 8, "--stats=") == 0) {
+            options.statsPath = arg.substr(8);
+        }
+        else if (arg.compare(0, 8, "--sizes=") == 0) {
+            options.sizes.clear();
+            std::stringstream list(arg.substr(8));
+            std::string item;
+            while (std::getline(list, item, ',')) {
+                size_t size = (size_t)std::strtoull(item.c_str(), nullptr, 10);
+                if (size > 0) {
+                    options.sizes.push_back(size);
+                }
+            }
+        }
+        else if (arg == "--quick") {
+            //Smoke run: every case at one small size with a tiny time budget
+            options.sizes = { 1000 };
+            options.minTime = 0.001;
+        }
+        else {
+            std::cerr << "Unknown argument: " << arg << std::endl;
+            std::cerr << "Usage: VectorMathematicsBench [--filter=<text>] [--sizes=256,4096,...] [--min-time=<seconds>] [--json=<file>] [--stats=<file>] [--quick]" << std::endl;
+            return false;
+        }
+    }
+    return !options.sizes.empty();
+}
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    if (!ParseArgs(argc, argv, options)) {
+        return 1;
+    }
+
+    size_t maxSize = 0;
+    for (size_t size : options.sizes) {
+        maxSize = size > maxSize ? size : maxSize;
+    }
+
+    BenchData data;
+    FillData(data, maxSize);
+    VectorMathSetThreadCount(options.threads);
+
+    const int levels[] = { VECTORMATH_SIMD_SCALAR, VECTORMATH_SIMD_SSE41, VECTORMATH_SIMD_AVX2, VECTORMATH_SIMD_NEON };
+
+    std::cout << "VectorMathematics benchmarks (best kernels: " << VectorMathGetSimdName() << ", threads: " << VectorMathGetThreadCount() << ")" << std::endl;
+#if !defined(NDEBUG)
+    std::cout << "***WARNING*** Debug build, timings are not representative" << std::endl;
+#endif
+    std::cout << std::left << std::setw(44) << "Benchmark"
+              << std::right << std::setw(10) << "Size"
+              << std::setw(14) << "ns/op"
+              << std::setw(17) << "Items/s"
+              << std::setw(14) << "Iterations" << std::endl;
+    std::cout << std::string(99, '-') << std::endl;
+
+    VectorMathResetStats();
+    std::vector<BenchResult> results;
+    for (const BenchCase& c : kCases) {
+        if (!options.filter.empty() && std::string(c.name).find(options.filter) == std::string::npos) {
+            continue;
+        }
+        for (size_t size : options.sizes) {
+            bool dispatched = c.kind == KIND_ARRAY || c.kind == KIND_BATCH;
+            if (!dispatched) {
+                results.push_back(RunCase(c, data, size, options.minTime));
+                PrintResult(results.back());
+                continue;
+            }
+            for (int level : levels) {
+                if (!VectorMathSetSimdLevel(level)) {
+                    continue;
+                }
+                BenchResult r = RunCase(c, data, size, options.minTime);
+                r.kernels = VectorMathGetSimdName();
+                results.push_back(r);
+                PrintResult(r);
+            }
+            VectorMathSetSimdLevel(VECTORMATH_SIMD_BEST);
+        }
+    }
+
+    if (!options.jsonPath.empty()) {
+        if (!WriteJson(options.jsonPath, results, options)) {
+            std::cerr << "Could not write " << options.jsonPath << std::endl;
+            return 1;
+        }
+        std::cout << std::endl << "Wrote " << results.size() << " results to " << options.jsonPath << std::endl;
+    }
+
+    if (!options.statsPath.empty()) {
+        if (!VectorMathStatsEnabled()) {
+            std::cerr << "Call counters are off, configure with -DVECTORMATH_ENABLE_STATS=ON" << std::endl;
+        }
+        if (!VectorMathWriteStatsJson(options.statsPath.c_str())) {
+            std::cerr << "Could not write " << options.statsPath << std::endl;
+            return 1;
+        }
+        std::cout << "Wrote call counters to " << options.statsPath << std::endl;
+    }
+
+    SpatialGrid2DDestroy(data.grid);
+    Bvh3DDestroy(data.bvh);
+    Curve3DDestroy(data.curve);
+    SnapshotReaderClose(data.snapshot);
+    remove(kSnapshotPath);
+    remove(kRecordPath);
+    return 0;
+}
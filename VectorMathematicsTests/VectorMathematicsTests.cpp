@@ -1,7 +1,15 @@
 #include <iostream>
 #include "VectorMath.h"
+#include "VectorMathFixed.h"
+#include "VectorMathArray.h"
 #include <cmath>
 #include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <algorithm>
 
 #define endline "\n\n"
 
@@ -10,11 +18,16 @@ bool FloatEquals(float a, float b, float epsilon = 0.0001f) {
     return fabs(a - b) < epsilon;
 }
 
+// Keeps the console window open when run from Visual Studio; CTest passes --no-pause
+static bool g_pauseOnExit = true;
+
 // Custom assert function
 void Assert(bool condition, const char* message) {
     if (!condition) {
         std::cerr << "[FAIL] " << message << std::endl;
-        std::cin.get();
+        if (g_pauseOnExit) {
+            std::cin.get();
+        }
         exit(1);
     }
 }
@@ -125,7 +138,7 @@ void TestVectorNormalize() {
 
     float result = VectorMagnitude(normalizedV);
 
-    Assert(FloatEquals(result, 1.0f), "Normalized vector magnitude should be 1");
+    Assert(FloatEquals(result, expectedResult), "Normalized vector magnitude should be 1");
 
     std::cout << "[PASS] VectorNormalize: all checks passed!" << endline;
 }
@@ -334,9 +347,9 @@ void TestVectorLerp() {
 
     Vec3 result = VectorLerp(a, b, 0.5f);
 
-    Assert(result.x == 5.0f, "VectorLerp X component should be 5");
-    Assert(result.y == 10.0f, "VectorLerp Y component should be 10");
-    Assert(result.z == 15.0f, "VectorLerp Z component should be 15");
+    Assert(result.x == expectedResult.x, "VectorLerp X component should be 5");
+    Assert(result.y == expectedResult.y, "VectorLerp Y component should be 10");
+    Assert(result.z == expectedResult.z, "VectorLerp Z component should be 15");
 
     std::cout << "[PASS] VectorLerp: all component checks passed" << endline;
 }
@@ -380,8 +393,8 @@ void TestVectorLerp2D() {
 
     Vec2 result = VectorLerp2D(a, b, 0.5f);
 
-    Assert(result.x == 5.0f, "VectorLerp2D X component should be 5");
-    Assert(result.y == 10.0f, "VectorLerp2D Y component should be 10");
+    Assert(result.x == expectedResult.x, "VectorLerp2D X component should be 5");
+    Assert(result.y == expectedResult.y, "VectorLerp2D Y component should be 10");
 
     std::cout << "[PASS] VectorLerp2D: all component checks passed" << endline;
 }
@@ -613,7 +626,2426 @@ void TestVectorClamp2DEdgeCase() {
     std::cout << "[PASS] VectorClamp2DEdgeCase: all component checks passed" << endline;
 }
 
-int main() {
+//Batch Tests
+
+void TestVectorAdd2DBatch() {
+    std::cout << "Testing VectorAdd2DBatch..." << std::endl;
+
+    float ax[3] = { 1.0f, 2.0f, 3.0f };
+    float ay[3] = { 4.0f, 5.0f, 6.0f };
+    float bx[3] = { 10.0f, 20.0f, 30.0f };
+    float by[3] = { 40.0f, 50.0f, 60.0f };
+    float outX[3];
+    float outY[3];
+
+    VectorAdd2DBatch(ax, ay, bx, by, outX, outY, 3);
+
+    Assert(outX[0] == 11.0f && outX[1] == 22.0f && outX[2] == 33.0f, "VectorAdd2DBatch X components incorrect");
+    Assert(outY[0] == 44.0f && outY[1] == 55.0f && outY[2] == 66.0f, "VectorAdd2DBatch Y components incorrect");
+
+    std::cout << "[PASS] VectorAdd2DBatch: all component checks passed" << endline;
+}
+
+void TestVectorScaleBatchInPlace() {
+    std::cout << "Testing VectorScaleBatch in place..." << std::endl;
+
+    float x[2] = { 1.0f, -2.0f };
+    float y[2] = { 3.0f, 4.0f };
+    float z[2] = { 0.5f, 0.0f };
+
+    VectorScaleBatch(x, y, z, 2.0f, x, y, z, 2);
+
+    Assert(x[0] == 2.0f && y[0] == 6.0f && z[0] == 1.0f, "VectorScaleBatch first element incorrect");
+    Assert(x[1] == -4.0f && y[1] == 8.0f && z[1] == 0.0f, "VectorScaleBatch second element incorrect");
+
+    std::cout << "[PASS] VectorScaleBatch in place: all component checks passed" << endline;
+}
+
+void TestVectorNormalize2DArray() {
+    std::cout << "Testing VectorNormalize2DArray..." << std::endl;
+
+    Vec2 v[3] = { { 3.0f, 4.0f }, { 0.0f, 0.0f }, { -6.0f, 8.0f } };
+    Vec2 out[3];
+
+    VectorNormalize2DArray(v, out, 3);
+
+    for (int i = 0; i < 3; ++i) {
+        Vec2 expectedResult = VectorNormalize2D(v[i]);
+        Assert(out[i].x == expectedResult.x && out[i].y == expectedResult.y, "VectorNormalize2DArray should match VectorNormalize2D");
+    }
+
+    std::cout << "[PASS] VectorNormalize2DArray: all checks passed!" << endline;
+}
+
+void TestVectorReflectArray() {
+    std::cout << "Testing VectorReflectArray..." << std::endl;
+
+    Vec3 v[2] = { { 1.0f, -1.0f, 0.0f }, { 2.0f, 3.0f, -4.0f } };
+    Vec3 normals[2] = { { 0.0f, 5.0f, 0.0f }, { 1.0f, 1.0f, 1.0f } };
+    Vec3 expectedResult[2] = { VectorReflect(v[0], normals[0]), VectorReflect(v[1], normals[1]) };
+
+    VectorReflectArray(v, normals, v, 2);
+
+    for (int i = 0; i < 2; ++i) {
+        Assert(FloatEquals(v[i].x, expectedResult[i].x), "VectorReflectArray X should match VectorReflect");
+        Assert(FloatEquals(v[i].y, expectedResult[i].y), "VectorReflectArray Y should match VectorReflect");
+        Assert(FloatEquals(v[i].z, expectedResult[i].z), "VectorReflectArray Z should match VectorReflect");
+    }
+
+    std::cout << "[PASS] VectorReflectArray: all component checks passed" << endline;
+}
+
+void TestVectorClampMagnitudeBatch() {
+    std::cout << "Testing VectorClampMagnitude2DBatch..." << std::endl;
+
+    float x[3] = { 6.0f, 2.0f, 0.0f };
+    float y[3] = { 8.0f, 1.0f, 0.0f };
+    float outX[3];
+    float outY[3];
+
+    VectorClampMagnitude2DBatch(x, y, 5.0f, outX, outY, 3);
+
+    Assert(outX[0] == 3.0f && outY[0] == 4.0f, "VectorClampMagnitude2DBatch should clamp (6,8) to (3,4)");
+    Assert(outX[1] == 2.0f && outY[1] == 1.0f, "VectorClampMagnitude2DBatch should keep short vectors");
+    Assert(outX[2] == 0.0f && outY[2] == 0.0f, "VectorClampMagnitude2DBatch should return zero for zero vectors");
+
+    std::cout << "[PASS] VectorClampMagnitude2DBatch: all component checks passed" << endline;
+}
+
+void TestSimdLevelsMatchScalar() {
+    std::cout << "Testing SIMD batch kernels against scalar functions..." << std::endl;
+
+    const int count = 37; // not a multiple of the SIMD width, so the tail path runs too
+    float ax[count], ay[count], az[count], bx[count], by[count], bz[count];
+    for (int i = 0; i < count; ++i) {
+        ax[i] = (float)(i % 7) - 3.0f;
+        ay[i] = (float)(i % 5) * 0.75f - 1.0f;
+        az[i] = (float)(i % 3) * 2.5f;
+        bx[i] = (float)(i % 4) - 1.5f;
+        by[i] = (float)(i % 6) * 0.5f;
+        bz[i] = (float)(i % 2) - 0.25f;
+    }
+    ax[0] = ay[0] = az[0] = 0.0f; // zero vector case
+
+    int levels[] = { VECTORMATH_SIMD_SCALAR, VECTORMATH_SIMD_SSE41, VECTORMATH_SIMD_AVX2, VECTORMATH_SIMD_NEON };
+    for (int level : levels) {
+        if (!VectorMathSetSimdLevel(level)) {
+            continue;
+        }
+        std::cout << "  kernels: " << VectorMathGetSimdName() << std::endl;
+
+        float outX[count], outY[count], outZ[count], out[count];
+
+        VectorNormalizeBatch(ax, ay, az, outX, outY, outZ, count);
+        for (int i = 0; i < count; ++i) {
+            Vec3 expectedResult = VectorNormalize({ ax[i], ay[i], az[i] });
+            Assert(FloatEquals(outX[i], expectedResult.x) && FloatEquals(outY[i], expectedResult.y) && FloatEquals(outZ[i], expectedResult.z), "VectorNormalizeBatch should match VectorNormalize");
+        }
+
+        VectorReflect2DBatch(ax, ay, bx, by, outX, outY, count);
+        for (int i = 0; i < count; ++i) {
+            Vec2 expectedResult = VectorReflect2D({ ax[i], ay[i] }, { bx[i], by[i] });
+            Assert(FloatEquals(outX[i], expectedResult.x) && FloatEquals(outY[i], expectedResult.y), "VectorReflect2DBatch should match VectorReflect2D");
+        }
+
+        VectorClampMagnitudeBatch(ax, ay, az, 2.0f, outX, outY, outZ, count);
+        for (int i = 0; i < count; ++i) {
+            Vec3 expectedResult = VectorClampMagnitude({ ax[i], ay[i], az[i] }, 2.0f);
+            Assert(FloatEquals(outX[i], expectedResult.x) && FloatEquals(outY[i], expectedResult.y) && FloatEquals(outZ[i], expectedResult.z), "VectorClampMagnitudeBatch should match VectorClampMagnitude");
+        }
+
+        VectorDotBatch(ax, ay, az, bx, by, bz, out, count);
+        for (int i = 0; i < count; ++i) {
+            Assert(FloatEquals(out[i], VectorDot({ ax[i], ay[i], az[i] }, { bx[i], by[i], bz[i] })), "VectorDotBatch should match VectorDot");
+        }
+
+        VectorMagnitude2DBatch(ax, ay, out, count);
+        for (int i = 0; i < count; ++i) {
+            Assert(FloatEquals(out[i], VectorMagnitude2D({ ax[i], ay[i] })), "VectorMagnitude2DBatch should match VectorMagnitude2D");
+        }
+
+        ClampBatch(ax, -1.0f, 1.5f, out, count);
+        for (int i = 0; i < count; ++i) {
+            Assert(out[i] == Clamp(ax[i], -1.0f, 1.5f), "ClampBatch should match Clamp");
+        }
+    }
+
+    VectorMathSetSimdLevel(VECTORMATH_SIMD_BEST);
+
+    std::cout << "[PASS] SIMD kernels: all checks passed" << endline;
+}
+
+void TestSimdArraysMatchScalar() {
+    std::cout << "Testing packed Array kernels against scalar functions..." << std::endl;
+
+    const size_t count = 601; // several 256-vector blocks plus a tail
+    std::vector<Vec2> a2(count), b2(count), out2(count);
+    std::vector<Vec3> a3(count), b3(count), out3(count);
+    std::vector<float> out(count);
+    for (size_t i = 0; i < count; ++i) {
+        a2[i] = { (float)(i % 7) - 3.0f, (float)(i % 5) * 0.75f - 1.0f };
+        b2[i] = { (float)(i % 4) - 1.5f, (float)(i % 6) * 0.5f };
+        a3[i] = { (float)(i % 7) - 3.0f, (float)(i % 5) * 0.75f - 1.0f, (float)(i % 3) * 2.5f };
+        b3[i] = { (float)(i % 4) - 1.5f, (float)(i % 6) * 0.5f, (float)(i % 2) - 0.25f };
+    }
+    a2[300] = { 0.0f, 0.0f }; // zero vector case
+    a3[300] = { 0.0f, 0.0f, 0.0f };
+
+    int levels[] = { VECTORMATH_SIMD_SCALAR, VECTORMATH_SIMD_SSE41, VECTORMATH_SIMD_AVX2, VECTORMATH_SIMD_NEON };
+    for (int level : levels) {
+        if (!VectorMathSetSimdLevel(level)) {
+            continue;
+        }
+        std::cout << "  kernels: " << VectorMathGetSimdName() << std::endl;
+        bool match = true;
+
+        VectorDot2DArray(a2.data(), b2.data(), out.data(), count);
+        for (size_t i = 0; i < count; ++i) {
+            match = match && out[i] == VectorDot2D(a2[i], b2[i]);
+        }
+        Assert(match, "VectorDot2DArray should match VectorDot2D");
+        VectorDotArray(a3.data(), b3.data(), out.data(), count);
+        for (size_t i = 0; i < count; ++i) {
+            match = match && out[i] == VectorDot(a3[i], b3[i]);
+        }
+        Assert(match, "VectorDotArray should match VectorDot");
+
+        VectorMagnitude2DArray(a2.data(), out.data(), count);
+        for (size_t i = 0; i < count; ++i) {
+            match = match && FloatEquals(out[i], VectorMagnitude2D(a2[i]));
+        }
+        Assert(match, "VectorMagnitude2DArray should match VectorMagnitude2D");
+        VectorMagnitudeArray(a3.data(), out.data(), count);
+        for (size_t i = 0; i < count; ++i) {
+            match = match && FloatEquals(out[i], VectorMagnitude(a3[i]));
+        }
+        Assert(match, "VectorMagnitudeArray should match VectorMagnitude");
+
+        VectorReflect2DArray(a2.data(), b2.data(), out2.data(), count);
+        VectorClampMagnitudeArray(a3.data(), 2.0f, out3.data(), count);
+        for (size_t i = 0; i < count; ++i) {
+            Vec2 reflected = VectorReflect2D(a2[i], b2[i]);
+            Vec3 clamped = VectorClampMagnitude(a3[i], 2.0f);
+            match = match && FloatEquals(out2[i].x, reflected.x) && FloatEquals(out2[i].y, reflected.y);
+            match = match && FloatEquals(out3[i].x, clamped.x) && FloatEquals(out3[i].y, clamped.y) && FloatEquals(out3[i].z, clamped.z);
+        }
+        Assert(match, "VectorReflect2DArray and VectorClampMagnitudeArray should match the scalar functions");
+
+        //In place
+        out2 = a2;
+        out3 = a3;
+        VectorNormalize2DArray(out2.data(), out2.data(), count);
+        VectorReflectArray(out3.data(), b3.data(), out3.data(), count);
+        for (size_t i = 0; i < count; ++i) {
+            Vec2 normalized = VectorNormalize2D(a2[i]);
+            Vec3 reflected = VectorReflect(a3[i], b3[i]);
+            match = match && FloatEquals(out2[i].x, normalized.x) && FloatEquals(out2[i].y, normalized.y);
+            match = match && FloatEquals(out3[i].x, reflected.x) && FloatEquals(out3[i].y, reflected.y) && FloatEquals(out3[i].z, reflected.z);
+        }
+        Assert(match, "In-place VectorNormalize2DArray and VectorReflectArray should match the scalar functions");
+    }
+
+    VectorMathSetSimdLevel(VECTORMATH_SIMD_BEST);
+
+    std::cout << "[PASS] SIMD Array kernels: all checks passed" << endline;
+}
+
+//Inline C++ Layer Tests
+
+void TestInlineOperators() {
+    std::cout << "Testing inline C++ operators..." << std::endl;
+
+    using namespace vmath;
+
+    static_assert(Dot(Vec2{ 1.0f, 2.0f }, Vec2{ 3.0f, 4.0f }) == 11.0f, "Dot should be usable at compile time");
+    static_assert(Cross(Vec3{ 1.0f, 0.0f, 0.0f }, Vec3{ 0.0f, 1.0f, 0.0f }).z == 1.0f, "Cross should be usable at compile time");
+
+    Vec2 position = { 1.0f, 2.0f };
+    Vec2 velocity = { 3.0f, -4.0f };
+    position += velocity * 0.5f;
+
+    Vec2 expectedResult = VectorAdd2D({ 1.0f, 2.0f }, VectorScale2D(velocity, 0.5f));
+    Assert(position == expectedResult, "position += velocity * dt should match VectorAdd2D/VectorScale2D");
+
+    Vec3 v = { 3.0f, 4.0f, 0.0f };
+    Assert(Normalize(v) == VectorNormalize(v), "Inline Normalize should match VectorNormalize");
+    Assert(Reflect(v, Vec3{ 0.0f, 2.0f, 0.0f }) == VectorReflect(v, { 0.0f, 2.0f, 0.0f }), "Inline Reflect should match VectorReflect");
+    Assert(v / 0.0f == Vec3{ 0.0f, 0.0f, 0.0f }, "Inline divide by zero should return zero");
+
+    std::cout << "[PASS] Inline operators: all checks passed" << endline;
+}
+
+void TestInlineDoubleVectors() {
+    std::cout << "Testing inline double precision vectors..." << std::endl;
+
+    vmath::Vec3T<double> a = { 1.0, 2.0, 2.0 };
+    vmath::Vec3T<double> b = vmath::ClampMagnitude(a, 1.5);
+
+    Assert(fabs(vmath::Magnitude(b) - 1.5) < 1e-12, "Double ClampMagnitude should clamp to 1.5");
+    Assert(vmath::Lerp(a, b, 0) == a, "Double Lerp at 0 should return start v");
+
+    std::cout << "[PASS] Inline double vectors: all checks passed" << endline;
+}
+
+//Fast Normalize Tests
+
+void TestVectorNormalizeFast() {
+    std::cout << "Testing VectorNormalizeFast..." << std::endl;
+
+    Vec3 v = { 3.0f, 4.0f, 12.0f };
+    Vec3 expectedResult = VectorNormalize(v);
+    Vec3 result = VectorNormalizeFast(v);
+
+    Assert(FloatEquals(result.x, expectedResult.x), "VectorNormalizeFast X should match VectorNormalize");
+    Assert(FloatEquals(result.y, expectedResult.y), "VectorNormalizeFast Y should match VectorNormalize");
+    Assert(FloatEquals(result.z, expectedResult.z), "VectorNormalizeFast Z should match VectorNormalize");
+
+    Vec2 zero = VectorNormalizeFast2D({ 0.0f, 0.0f });
+    Assert(zero.x == 0.0f && zero.y == 0.0f, "VectorNormalizeFast2D should return zero vector for zero input");
+
+    Vec2 result2D = VectorNormalizeFast2D({ -6.0f, 8.0f });
+    Assert(FloatEquals(VectorMagnitude2D(result2D), 1.0f), "VectorNormalizeFast2D magnitude should be 1");
+
+    std::cout << "[PASS] VectorNormalizeFast: all checks passed!" << endline;
+}
+
+void TestNormalizePrecisionSwitch() {
+    std::cout << "Testing batch normalize precision switch..." << std::endl;
+
+    const int count = 19;
+    float x[count], y[count], outX[count], outY[count];
+    for (int i = 0; i < count; ++i) {
+        x[i] = (float)i * 1.5f - 10.0f;
+        y[i] = (float)(i % 4) * 0.25f;
+    }
+    x[3] = y[3] = 0.0f;
+
+    int levels[] = { VECTORMATH_SIMD_SCALAR, VECTORMATH_SIMD_SSE41, VECTORMATH_SIMD_AVX2, VECTORMATH_SIMD_NEON };
+    for (int level : levels) {
+        if (!VectorMathSetSimdLevel(level)) {
+            continue;
+        }
+
+        VectorNormalize2DBatchEx(x, y, outX, outY, count, VECTORMATH_PRECISION_FAST);
+        for (int i = 0; i < count; ++i) {
+            Vec2 expectedResult = VectorNormalize2D({ x[i], y[i] });
+            Assert(FloatEquals(outX[i], expectedResult.x) && FloatEquals(outY[i], expectedResult.y), "Fast batch normalize should match VectorNormalize2D");
+        }
+    }
+    VectorMathSetSimdLevel(VECTORMATH_SIMD_BEST);
+
+    VectorMathSetPrecision(VECTORMATH_PRECISION_FAST);
+    Assert(VectorMathGetPrecision() == VECTORMATH_PRECISION_FAST, "Global precision should switch to fast");
+    VectorNormalize2DBatch(x, y, outX, outY, count);
+    VectorMathSetPrecision(VECTORMATH_PRECISION_EXACT);
+
+    float fastX[count], fastY[count];
+    VectorNormalizeFast2DBatch(x, y, fastX, fastY, count);
+    for (int i = 0; i < count; ++i) {
+        Assert(outX[i] == fastX[i] && outY[i] == fastY[i], "Global fast precision should use the fast kernels");
+    }
+
+    std::cout << "[PASS] Normalize precision switch: all checks passed" << endline;
+}
+
+//Matrix & Quaternion Tests
+
+void TestMat4InverseMultiply() {
+    std::cout << "Testing Mat4Inverse and Mat4Multiply..." << std::endl;
+
+    Mat4 m;
+    Mat4ComposeTRS({ 1.0f, -2.0f, 3.0f }, QuatFromAxisAngle({ 1.0f, 1.0f, 0.0f }, 0.7f), { 2.0f, 0.5f, 1.5f }, &m);
+
+    Mat4 inv, result;
+    Mat4Inverse(&m, &inv);
+    Mat4Multiply(&m, &inv, &result);
+
+    Mat4 identity;
+    Mat4Identity(&identity);
+    for (int i = 0; i < 16; ++i) {
+        Assert(FloatEquals(result.m[i], identity.m[i]), "M * inverse(M) should be the identity");
+    }
+    Assert(FloatEquals(Mat4Determinant(&m) * Mat4Determinant(&inv), 1.0f), "det(M) * det(inverse(M)) should be 1");
+
+    Mat4 singular = {};
+    Mat4Inverse(&singular, &inv);
+    for (int i = 0; i < 16; ++i) {
+        Assert(inv.m[i] == 0.0f, "Inverse of a singular matrix should be the zero matrix");
+    }
+
+    Mat3 r, rInv, r3;
+    QuatToMat3(QuatFromAxisAngle({ 0.0f, 0.0f, 1.0f }, 1.2f), &r);
+    Mat3Inverse(&r, &rInv);
+    Mat3Transpose(&r, &r3);
+    for (int i = 0; i < 9; ++i) {
+        Assert(FloatEquals(rInv.m[i], r3.m[i]), "Inverse of a rotation matrix should be its transpose");
+    }
+
+    std::cout << "[PASS] Mat4Inverse: all checks passed" << endline;
+}
+
+void TestQuatRotateAndTRS() {
+    std::cout << "Testing QuatRotateVector and TRS compose / decompose..." << std::endl;
+
+    const float halfPi = 1.5707963f;
+    Quat q = QuatFromAxisAngle({ 0.0f, 0.0f, 1.0f }, halfPi);
+    Vec3 rotated = QuatRotateVector(q, { 1.0f, 0.0f, 0.0f });
+    Assert(FloatEquals(rotated.x, 0.0f) && FloatEquals(rotated.y, 1.0f) && FloatEquals(rotated.z, 0.0f), "90 degrees around Z should rotate X onto Y");
+
+    Quat twice = QuatMultiply(q, q);
+    rotated = QuatRotateVector(twice, { 1.0f, 0.0f, 0.0f });
+    Assert(FloatEquals(rotated.x, -1.0f) && FloatEquals(rotated.y, 0.0f), "Two 90 degree rotations should rotate X onto -X");
+
+    Vec3 back = QuatRotateVector(QuatInverse(q), QuatRotateVector(q, { 0.3f, -0.4f, 2.0f }));
+    Assert(FloatEquals(back.x, 0.3f) && FloatEquals(back.y, -0.4f) && FloatEquals(back.z, 2.0f), "QuatInverse should undo the rotation");
+
+    Vec3 t = { 4.0f, 5.0f, -6.0f };
+    Quat r = QuatFromAxisAngle({ 0.2f, 1.0f, -0.5f }, 2.5f);
+    Vec3 s = { 1.5f, 2.0f, 0.25f };
+    Mat4 m;
+    Mat4ComposeTRS(t, r, s, &m);
+
+    Vec3 p = { 1.0f, 2.0f, 3.0f };
+    Vec3 expectedResult = VectorAdd(QuatRotateVector(r, { p.x * s.x, p.y * s.y, p.z * s.z }), t);
+    Vec3 result = Mat4TransformPoint(&m, p);
+    Assert(FloatEquals(result.x, expectedResult.x) && FloatEquals(result.y, expectedResult.y) && FloatEquals(result.z, expectedResult.z), "Mat4TransformPoint should apply scale, rotation then translation");
+
+    Vec3 outT, outS;
+    Quat outR;
+    Mat4DecomposeTRS(&m, &outT, &outR, &outS);
+    Assert(FloatEquals(outT.x, t.x) && FloatEquals(outT.y, t.y) && FloatEquals(outT.z, t.z), "Decomposed translation should match");
+    Assert(FloatEquals(outS.x, s.x) && FloatEquals(outS.y, s.y) && FloatEquals(outS.z, s.z), "Decomposed scale should match");
+    float sign = outR.w * r.w < 0.0f ? -1.0f : 1.0f; // q and -q are the same rotation
+    Assert(FloatEquals(outR.x, sign * r.x) && FloatEquals(outR.y, sign * r.y) && FloatEquals(outR.z, sign * r.z) && FloatEquals(outR.w, sign * r.w), "Decomposed rotation should match");
+
+    std::cout << "[PASS] Quat and TRS: all checks passed" << endline;
+}
+
+void TestMat4TransformPoints() {
+    std::cout << "Testing Mat4TransformPoints on every SIMD level..." << std::endl;
+
+    Mat4 m;
+    Mat4ComposeTRS({ 10.0f, -1.0f, 0.5f }, QuatFromAxisAngle({ 1.0f, 2.0f, 3.0f }, 0.9f), { 1.0f, 3.0f, 0.5f }, &m);
+
+    const int count = 29; // not a multiple of the SIMD width, so the tail path runs too
+    Vec3 points[count];
+    for (int i = 0; i < count; ++i) {
+        points[i] = { (float)(i % 7) - 3.0f, (float)(i % 5) * 0.75f, (float)i * 0.5f };
+    }
+
+    int levels[] = { VECTORMATH_SIMD_SCALAR, VECTORMATH_SIMD_SSE41, VECTORMATH_SIMD_AVX2, VECTORMATH_SIMD_NEON };
+    for (int level : levels) {
+        if (!VectorMathSetSimdLevel(level)) {
+            continue;
+        }
+
+        Vec3 out[count];
+        Mat4TransformPoints(&m, points, out, count);
+        for (int i = 0; i < count; ++i) {
+            Vec3 expectedResult = Mat4TransformPoint(&m, points[i]);
+            Assert(out[i] == expectedResult, "Mat4TransformPoints should match Mat4TransformPoint exactly");
+        }
+
+        Mat4TransformDirections(&m, points, out, count);
+        for (int i = 0; i < count; ++i) {
+            Vec3 expectedResult = Mat4TransformDirection(&m, points[i]);
+            Assert(out[i] == expectedResult, "Mat4TransformDirections should match Mat4TransformDirection exactly");
+        }
+
+        Vec3 inPlace[count];
+        for (int i = 0; i < count; ++i) {
+            inPlace[i] = points[i];
+        }
+        Mat4TransformPoints(&m, inPlace, inPlace, count);
+        for (int i = 0; i < count; ++i) {
+            Assert(inPlace[i] == Mat4TransformPoint(&m, points[i]), "Mat4TransformPoints should work in place");
+        }
+    }
+    VectorMathSetSimdLevel(VECTORMATH_SIMD_BEST);
+
+    std::cout << "[PASS] Mat4TransformPoints: all checks passed" << endline;
+}
+
+//Physics Integration Tests
+
+void TestIntegrateBodies2D() {
+    std::cout << "Testing IntegrateBodies2D on every SIMD level..." << std::endl;
+
+    const int count = 13; // 26 floats, so the SIMD tail path runs too
+    const float dt = 0.02f;
+    Vec2 gravity[count];
+    for (int i = 0; i < count; ++i) {
+        gravity[i] = { 0.0f, -9.81f };
+    }
+
+    int levels[] = { VECTORMATH_SIMD_SCALAR, VECTORMATH_SIMD_SSE41, VECTORMATH_SIMD_AVX2, VECTORMATH_SIMD_NEON };
+    for (int level : levels) {
+        if (!VectorMathSetSimdLevel(level)) {
+            continue;
+        }
+
+        Vec2 positions[count], velocities[count];
+        for (int i = 0; i < count; ++i) {
+            positions[i] = { (float)i, 0.0f };
+            velocities[i] = { 2.0f, (float)i * 0.5f };
+        }
+
+        IntegrateBodies2D(positions, velocities, gravity, count, dt);
+        for (int i = 0; i < count; ++i) {
+            Vec2 expectedVelocity = VectorAdd2D({ 2.0f, (float)i * 0.5f }, VectorScale2D(gravity[i], dt));
+            Vec2 expectedPosition = VectorAdd2D({ (float)i, 0.0f }, VectorScale2D(expectedVelocity, dt));
+            Assert(velocities[i] == expectedVelocity, "IntegrateBodies2D should update velocity first (semi-implicit Euler)");
+            Assert(positions[i] == expectedPosition, "IntegrateBodies2D should move by the new velocity");
+        }
+
+        IntegrateBodies2D(positions, velocities, nullptr, count, dt);
+        for (int i = 0; i < count; ++i) {
+            Vec2 expectedVelocity = VectorAdd2D({ 2.0f, (float)i * 0.5f }, VectorScale2D(gravity[i], dt));
+            Assert(velocities[i] == expectedVelocity, "IntegrateBodies2D without accelerations should keep the velocity");
+        }
+    }
+    VectorMathSetSimdLevel(VECTORMATH_SIMD_BEST);
+
+    std::cout << "[PASS] IntegrateBodies2D: all checks passed" << endline;
+}
+
+void TestIntegrateBodiesVerlet() {
+    std::cout << "Testing IntegrateBodiesVerlet..." << std::endl;
+
+    const int count = 11;
+    const float dt = 0.1f;
+    Vec3 accelerations[count];
+    for (int i = 0; i < count; ++i) {
+        accelerations[i] = { 1.0f, -2.0f, (float)i };
+    }
+
+    Vec3 reference[count];
+    int levels[] = { VECTORMATH_SIMD_SCALAR, VECTORMATH_SIMD_SSE41, VECTORMATH_SIMD_AVX2, VECTORMATH_SIMD_NEON };
+    for (int level : levels) {
+        if (!VectorMathSetSimdLevel(level)) {
+            continue;
+        }
+
+        Vec3 positions[count], previous[count];
+        for (int i = 0; i < count; ++i) {
+            positions[i] = previous[i] = { 0.0f, 10.0f, (float)i };
+        }
+        for (int step = 0; step < 10; ++step) {
+            IntegrateBodiesVerlet(positions, previous, accelerations, count, dt);
+        }
+
+        //From rest, after k steps p = p0 + a * dt^2 * k(k+1)/2
+        Assert(FloatEquals(positions[0].x, 0.55f) && FloatEquals(positions[0].y, 8.9f), "IntegrateBodiesVerlet should follow constant acceleration");
+        Assert(FloatEquals(positions[0].x - previous[0].x, 0.1f), "Previous positions should hold the last step");
+
+        for (int i = 0; i < count; ++i) {
+            if (level == VECTORMATH_SIMD_SCALAR) {
+                reference[i] = positions[i];
+            }
+            Assert(positions[i] == reference[i], "IntegrateBodiesVerlet should match the scalar kernels exactly");
+        }
+    }
+    VectorMathSetSimdLevel(VECTORMATH_SIMD_BEST);
+
+    std::cout << "[PASS] IntegrateBodiesVerlet: all checks passed" << endline;
+}
+
+//Collision Response Tests
+
+void TestReflectResponse2DBatch() {
+    std::cout << "Testing VectorReflectResponse2DBatch on every SIMD level..." << std::endl;
+
+    const int count = 19; // not a multiple of 8, so the SIMD tail path runs too
+    float nx[count], ny[count];
+    unsigned char mask[count];
+    for (int i = 0; i < count; ++i) {
+        nx[i] = (float)(i % 5) - 2.0f;
+        ny[i] = 1.0f + (float)(i % 3);
+        mask[i] = (i % 4 == 3) ? 0 : 1;
+    }
+    nx[7] = 0.0f; // zero length normal counts as no contact
+    ny[7] = 0.0f;
+
+    float referenceX[count], referenceY[count];
+    int levels[] = { VECTORMATH_SIMD_SCALAR, VECTORMATH_SIMD_SSE41, VECTORMATH_SIMD_AVX2, VECTORMATH_SIMD_NEON };
+    for (int level : levels) {
+        if (!VectorMathSetSimdLevel(level)) {
+            continue;
+        }
+
+        //restitution 1 and friction 0 is a plain reflection
+        float vx[count], vy[count];
+        for (int i = 0; i < count; ++i) {
+            vx[i] = 3.0f - (float)i * 0.25f;
+            vy[i] = -4.0f + (float)i * 0.5f;
+        }
+        VectorReflectResponse2DBatch(vx, vy, nx, ny, nullptr, count, 1.0f, 0.0f, VECTORMATH_REFLECT_DEFAULT);
+        for (int i = 0; i < count; ++i) {
+            Vec2 v = { 3.0f - (float)i * 0.25f, -4.0f + (float)i * 0.5f };
+            Vec2 expected = i == 7 ? v : VectorReflect2D(v, { nx[i], ny[i] });
+            Assert(FloatEquals(vx[i], expected.x) && FloatEquals(vy[i], expected.y), "VectorReflectResponse2DBatch should match VectorReflect2D");
+        }
+
+        //Masked contacts keep their velocity
+        for (int i = 0; i < count; ++i) {
+            vx[i] = 3.0f - (float)i * 0.25f;
+            vy[i] = -4.0f + (float)i * 0.5f;
+        }
+        VectorReflectResponse2DBatch(vx, vy, nx, ny, mask, count, 0.5f, 0.25f, VECTORMATH_REFLECT_DEFAULT);
+        for (int i = 0; i < count; ++i) {
+            if (mask[i] == 0 || i == 7) {
+                Assert(vx[i] == 3.0f - (float)i * 0.25f && vy[i] == -4.0f + (float)i * 0.5f, "Inactive contacts should keep their velocity");
+            }
+            if (level == VECTORMATH_SIMD_SCALAR) {
+                referenceX[i] = vx[i];
+                referenceY[i] = vy[i];
+            }
+            Assert(vx[i] == referenceX[i] && vy[i] == referenceY[i], "VectorReflectResponse2DBatch should match the scalar kernels exactly");
+        }
+    }
+    VectorMathSetSimdLevel(VECTORMATH_SIMD_BEST);
+
+    std::cout << "[PASS] VectorReflectResponse2DBatch: all checks passed" << endline;
+}
+
+void TestReflectResponseArray() {
+    std::cout << "Testing VectorReflectResponseArray..." << std::endl;
+
+    //Ball hitting the floor: the bounce loses half its speed, sliding loses 20%
+    Vec3 velocities[3] = { { 4.0f, -10.0f, 2.0f }, { 1.0f, -1.0f, 0.0f }, { 0.0f, -3.0f, 0.0f } };
+    Vec3 normals[3] = { { 0.0f, 1.0f, 0.0f }, { 0.0f, 1.0f, 0.0f }, { 0.0f, 1.0f, 0.0f } };
+    unsigned char mask[3] = { 1, 0, 1 };
+    VectorReflectResponseArray(velocities, normals, mask, 3, 0.5f, 0.2f, VECTORMATH_REFLECT_UNIT_NORMALS);
+
+    Assert(FloatEquals(velocities[0].x, 3.2f) && FloatEquals(velocities[0].y, 5.0f) && FloatEquals(velocities[0].z, 1.6f), "Restitution and friction should scale the normal and tangential parts");
+    Assert(velocities[1] == Vec3{ 1.0f, -1.0f, 0.0f }, "Masked contact should keep its velocity");
+    Assert(FloatEquals(velocities[2].y, 1.5f), "Head-on hit should bounce back with restitution");
+
+    std::cout << "[PASS] VectorReflectResponseArray: all checks passed" << endline;
+}
+
+//Threading Tests
+
+static void MarkRange(void* userData, size_t begin, size_t end) {
+    std::vector<int>& hits = *(std::vector<int>*)userData;
+    for (size_t i = begin; i < end; ++i) {
+        hits[i] += 1;
+    }
+    //Nested calls must not deadlock; they run on the calling thread
+    VectorMathParallelFor(0, 0, MarkRange, userData);
+}
+
+void TestParallelFor() {
+    std::cout << "Testing VectorMathParallelFor..." << std::endl;
+
+    VectorMathSetThreadCount(4);
+    Assert(VectorMathGetThreadCount() == 4 || VectorMathGetThreadCount() == 1, "Thread count should be 4 (or 1 when built without threads)");
+
+    const size_t count = 100003; // not a multiple of the grain
+    std::vector<int> hits(count, 0);
+    VectorMathParallelFor(count, 1000, MarkRange, &hits);
+    for (size_t i = 0; i < count; ++i) {
+        Assert(hits[i] == 1, "VectorMathParallelFor should visit every element exactly once");
+    }
+
+    //The pool starts again after an explicit shutdown
+    VectorMathShutdownThreads();
+    VectorMathShutdownThreads();
+    VectorMathParallelFor(count, 1000, MarkRange, &hits);
+    for (size_t i = 0; i < count; ++i) {
+        Assert(hits[i] == 2, "VectorMathParallelFor should run again after VectorMathShutdownThreads");
+    }
+
+    VectorMathSetThreadCount(0);
+    Assert(VectorMathGetThreadCount() >= 1, "Thread count 0 should pick one thread per CPU");
+
+    std::cout << "[PASS] VectorMathParallelFor: all checks passed" << endline;
+}
+
+void TestParallelBatchMatchesSerial() {
+    std::cout << "Testing threaded batch calls against single threaded ones..." << std::endl;
+
+    const size_t count = 50001;
+    std::vector<float> x(count), y(count), z(count);
+    std::vector<Vec3> positions(count), velocities(count), accelerations(count);
+    for (size_t i = 0; i < count; ++i) {
+        x[i] = (float)(i % 97) - 48.0f;
+        y[i] = (float)(i % 13) * 0.5f;
+        z[i] = 1.0f / (float)(i + 1);
+        positions[i] = { x[i], y[i], z[i] };
+        velocities[i] = { z[i], x[i], y[i] };
+        accelerations[i] = { 0.0f, -9.81f, (float)(i % 3) };
+    }
+
+    size_t threshold = VectorMathGetParallelThreshold();
+    std::vector<float> serialX(count), serialY(count), serialZ(count);
+    std::vector<Vec3> serialPositions = positions, serialVelocities = velocities;
+    VectorMathSetThreadCount(1);
+    VectorNormalizeBatch(x.data(), y.data(), z.data(), serialX.data(), serialY.data(), serialZ.data(), count);
+    IntegrateBodies(serialPositions.data(), serialVelocities.data(), accelerations.data(), count, 0.02f);
+
+    std::vector<float> outX(count), outY(count), outZ(count);
+    VectorMathSetThreadCount(4);
+    VectorMathSetParallelThreshold(1000);
+    VectorNormalizeBatch(x.data(), y.data(), z.data(), outX.data(), outY.data(), outZ.data(), count);
+    IntegrateBodies(positions.data(), velocities.data(), accelerations.data(), count, 0.02f);
+    VectorMathSetParallelThreshold(threshold);
+    VectorMathSetThreadCount(0);
+
+    for (size_t i = 0; i < count; ++i) {
+        Assert(outX[i] == serialX[i] && outY[i] == serialY[i] && outZ[i] == serialZ[i], "Threaded VectorNormalizeBatch should match the single threaded result exactly");
+        Assert(positions[i] == serialPositions[i] && velocities[i] == serialVelocities[i], "Threaded IntegrateBodies should match the single threaded result exactly");
+    }
+
+    std::cout << "[PASS] Threaded batch calls: all checks passed" << endline;
+}
+
+//Spatial Grid Tests
+
+static std::vector<Vec2> GridTestPoints(size_t count) {
+    std::vector<Vec2> points(count);
+    unsigned int seed = 12345;
+    for (size_t i = 0; i < count; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        float x = (float)(seed >> 8) / 16777216.0f * 40.0f - 20.0f;
+        seed = seed * 1664525u + 1013904223u;
+        float y = (float)(seed >> 8) / 16777216.0f * 40.0f - 20.0f;
+        points[i] = { x, y };
+    }
+    return points;
+}
+
+void TestSpatialGridQueries() {
+    std::cout << "Testing SpatialGrid2D radius and AABB queries..." << std::endl;
+
+    Assert(SpatialGrid2DCreate(0.0f) == nullptr, "A grid needs a positive cell size");
+
+    std::vector<Vec2> points = GridTestPoints(500);
+    SpatialGrid2D* grid = SpatialGrid2DCreate(2.0f);
+    SpatialGrid2DBuild(grid, points.data(), points.size());
+    Assert(SpatialGrid2DCount(grid) == 500, "Grid should hold every point");
+
+    std::vector<int> found(points.size());
+    Vec2 center = { 1.5f, -3.0f };
+    size_t count = SpatialGrid2DQueryRadius(grid, center, 5.0f, found.data(), found.size());
+    found.resize(count);
+    std::sort(found.begin(), found.end());
+    std::vector<int> expected;
+    for (size_t i = 0; i < points.size(); ++i) {
+        if (VectorMagnitude2D(VectorSubtract2D(points[i], center)) <= 5.0f) {
+            expected.push_back((int)i);
+        }
+    }
+    Assert(found == expected, "QueryRadius should find exactly the points inside the circle");
+    Assert(SpatialGrid2DQueryRadius(grid, center, 5.0f, nullptr, 0) == count, "QueryRadius should return the full count when the buffer is too small");
+
+    //A box much larger than the cells takes the full scan path
+    Vec2 boxMin = { -30.0f, -2.0f }, boxMax = { 30.0f, 3.0f };
+    found.assign(points.size(), -1);
+    count = SpatialGrid2DQueryAABB(grid, boxMin, boxMax, found.data(), found.size());
+    expected.clear();
+    for (size_t i = 0; i < points.size(); ++i) {
+        if (points[i].x >= boxMin.x && points[i].x <= boxMax.x && points[i].y >= boxMin.y && points[i].y <= boxMax.y) {
+            expected.push_back((int)i);
+        }
+    }
+    found.resize(count);
+    std::sort(found.begin(), found.end());
+    Assert(found == expected, "QueryAABB should find exactly the points inside the box");
+
+    SpatialGrid2DDestroy(grid);
+
+    std::cout << "[PASS] SpatialGrid2D queries: all checks passed" << endline;
+}
+
+void TestSpatialGridPairsAndUpdate() {
+    std::cout << "Testing SpatialGrid2D pairs and incremental updates..." << std::endl;
+
+    std::vector<Vec2> points = GridTestPoints(400);
+    SpatialGrid2D* grid = SpatialGrid2DCreate(1.0f);
+    SpatialGrid2DBuild(grid, points.data(), points.size());
+
+    for (int frame = 0; frame < 3; ++frame) {
+        size_t bruteForce = 0;
+        for (size_t i = 0; i < points.size(); ++i) {
+            for (size_t j = i + 1; j < points.size(); ++j) {
+                if (VectorMagnitude2D(VectorSubtract2D(points[i], points[j])) <= 1.5f) {
+                    ++bruteForce;
+                }
+            }
+        }
+        std::vector<int> pairs(bruteForce * 2 + 2);
+        size_t count = SpatialGrid2DQueryPairs(grid, 1.5f, pairs.data(), bruteForce + 1);
+        Assert(count == bruteForce, "QueryPairs should find the same pairs as a brute force check");
+        for (size_t p = 0; p < count; ++p) {
+            Assert(pairs[p * 2] < pairs[p * 2 + 1], "Pairs should be reported once, lower id first");
+        }
+
+        //Small moves stay in their cell, the last frame moves everything
+        float step = frame == 1 ? 3.0f : 0.01f;
+        for (size_t i = 0; i < points.size(); ++i) {
+            points[i] = VectorAdd2D(points[i], { step, -step * 0.5f });
+        }
+        SpatialGrid2DUpdate(grid, points.data(), points.size());
+    }
+
+    int id = SpatialGrid2DInsert(grid, { 100.0f, 100.0f });
+    int hit = -1;
+    Assert(id == 400, "Insert should return the next id");
+    Assert(SpatialGrid2DQueryRadius(grid, { 100.5f, 100.0f }, 1.0f, &hit, 1) == 1 && hit == id, "Inserted point should be found");
+    SpatialGrid2DMove(grid, id, { -100.0f, 0.0f });
+    Assert(SpatialGrid2DQueryRadius(grid, { 100.5f, 100.0f }, 1.0f, &hit, 1) == 0, "Moved point should leave its old cell");
+
+    SpatialGrid2DDestroy(grid);
+
+    std::cout << "[PASS] SpatialGrid2D pairs and updates: all checks passed" << endline;
+}
+
+//BVH Tests
+
+static float TestRandom(unsigned int& seed, float minVal, float maxVal) {
+    seed = seed * 1664525u + 1013904223u;
+    return minVal + (maxVal - minVal) * (float)(seed >> 8) / 16777216.0f;
+}
+
+//Brute force reference: closest sphere along a unit direction, -1 on a miss
+static int ClosestSphere(const std::vector<Vec3>& centers, const std::vector<float>& radii, Vec3 origin, Vec3 unitDirection, float& distance) {
+    int best = -1;
+    distance = 1000.0f;
+    for (size_t i = 0; i < centers.size(); ++i) {
+        Vec3 offset = VectorSubtract(origin, centers[i]);
+        float b = VectorDot(offset, unitDirection);
+        float c = VectorDot(offset, offset) - radii[i] * radii[i];
+        float discriminant = b * b - c;
+        if ((c > 0.0f && b > 0.0f) || discriminant < 0.0f) {
+            continue;
+        }
+        float t = -b - sqrtf(discriminant);
+        t = t > 0.0f ? t : 0.0f;
+        if (t < distance) {
+            distance = t;
+            best = (int)i;
+        }
+    }
+    return best;
+}
+
+void TestBvhRaycast() {
+    std::cout << "Testing Bvh3D ray casts against brute force..." << std::endl;
+
+    unsigned int seed = 777;
+    const size_t count = 300;
+    std::vector<Vec3> centers(count);
+    std::vector<float> radii(count);
+    for (size_t i = 0; i < count; ++i) {
+        centers[i] = { TestRandom(seed, -50.0f, 50.0f), TestRandom(seed, -50.0f, 50.0f), TestRandom(seed, -50.0f, 50.0f) };
+        radii[i] = TestRandom(seed, 0.5f, 3.0f);
+    }
+
+    Bvh3D* bvh = Bvh3DCreate();
+    Bvh3DBuildSpheres(bvh, centers.data(), radii.data(), count);
+    Assert(Bvh3DCount(bvh) == count && Bvh3DNodeCount(bvh) < count * 2, "BVH should hold every sphere in fewer than 2n nodes");
+
+    for (int pass = 0; pass < 2; ++pass) {
+        const size_t rayCount = 203;
+        std::vector<Vec3> origins(rayCount), directions(rayCount);
+        std::vector<RayHit> hits(rayCount);
+        for (size_t r = 0; r < rayCount; ++r) {
+            origins[r] = { 0.0f, 0.0f, -80.0f };
+            directions[r] = { TestRandom(seed, -0.6f, 0.6f), TestRandom(seed, -0.6f, 0.6f), 1.0f };
+        }
+        Bvh3DRaycastBatch(bvh, origins.data(), directions.data(), rayCount, 1000.0f, hits.data());
+
+        int hitCount = 0;
+        for (size_t r = 0; r < rayCount; ++r) {
+            float expectedDistance;
+            int expected = ClosestSphere(centers, radii, origins[r], VectorNormalize(directions[r]), expectedDistance);
+            RayHit hit;
+            int found = Bvh3DRaycast(bvh, origins[r], directions[r], 1000.0f, &hit);
+            Assert(hit.id == expected && found == (expected >= 0 ? 1 : 0), "Bvh3DRaycast should find the closest sphere");
+            Assert(expected < 0 || FloatEquals(hit.distance, expectedDistance, 0.001f), "Bvh3DRaycast should report the hit distance");
+            Assert(hits[r].id == hit.id && hits[r].distance == hit.distance, "Bvh3DRaycastBatch should match single ray casts");
+            hitCount += expected >= 0 ? 1 : 0;
+        }
+        Assert(hitCount > 0, "Some rays should hit");
+
+        //Move every sphere a little and refit for the second pass
+        for (size_t i = 0; i < count; ++i) {
+            centers[i] = VectorAdd(centers[i], { 0.5f, -0.25f, 1.0f });
+        }
+        Bvh3DRefitSpheres(bvh, centers.data(), radii.data());
+    }
+
+    RayHit miss;
+    Assert(Bvh3DRaycast(bvh, { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, 1000.0f, &miss) == 0 && miss.id == -1, "A zero direction should not hit anything");
+
+    Bvh3DDestroy(bvh);
+
+    //Rays lying in a face plane of the unit box graze it on every axis alike,
+    //whichever face they run along and whichever way they point
+    Vec3 boxMin = { 0.0f, 0.0f, 0.0f };
+    Vec3 boxMax = { 1.0f, 1.0f, 1.0f };
+    bvh = Bvh3DCreate();
+    Bvh3DBuild(bvh, &boxMin, &boxMax, 1);
+    std::vector<Vec3> grazeOrigins, grazeDirections;
+    for (int axis = 0; axis < 3; ++axis) {
+        for (int face = 0; face < 4; ++face) {
+            float o[3] = { 0.5f, 0.5f, 0.5f };
+            float d[3] = { 0.0f, 0.0f, 0.0f };
+            bool forward = face % 2 == 0;
+            o[axis] = forward ? -1.0f : 2.0f;
+            d[axis] = forward ? 1.0f : -1.0f;
+            o[(axis + 1 + face / 2) % 3] = face == 1 || face == 2 ? 1.0f : 0.0f;
+            grazeOrigins.push_back({ o[0], o[1], o[2] });
+            grazeDirections.push_back({ d[0], d[1], d[2] });
+        }
+    }
+    //The forward rays also share a packet, as their directions agree in sign
+    std::vector<Vec3> forwardOrigins, forwardDirections;
+    for (size_t r = 0; r < grazeOrigins.size(); r += 2) {
+        forwardOrigins.push_back(grazeOrigins[r]);
+        forwardDirections.push_back(grazeDirections[r]);
+    }
+    std::vector<RayHit> grazeHits(grazeOrigins.size());
+    std::vector<RayHit> forwardHits(forwardOrigins.size());
+    Bvh3DRaycastBatch(bvh, grazeOrigins.data(), grazeDirections.data(), grazeOrigins.size(), 1000.0f, grazeHits.data());
+    Bvh3DRaycastBatch(bvh, forwardOrigins.data(), forwardDirections.data(), forwardOrigins.size(), 1000.0f, forwardHits.data());
+    for (size_t r = 0; r < grazeOrigins.size(); ++r) {
+        RayHit hit;
+        Assert(Bvh3DRaycast(bvh, grazeOrigins[r], grazeDirections[r], 1000.0f, &hit) == 1 && hit.id == 0 && hit.distance == 1.0f, "A ray grazing a box face should hit it");
+        Assert(grazeHits[r].id == 0 && grazeHits[r].distance == 1.0f, "A grazing ray in a batch should hit like a single cast");
+        Assert(r % 2 != 0 || (forwardHits[r / 2].id == 0 && forwardHits[r / 2].distance == 1.0f), "A grazing ray in a packet should hit like a single cast");
+    }
+    RayHit outside;
+    Assert(Bvh3DRaycast(bvh, { -1.0f, -0.001f, 0.5f }, { 1.0f, 0.0f, 0.0f }, 1000.0f, &outside) == 0, "A parallel ray just off the face should miss");
+
+    Bvh3DDestroy(bvh);
+
+    std::cout << "[PASS] Bvh3D ray casts: all checks passed" << endline;
+}
+
+void TestBvhOverlap() {
+    std::cout << "Testing Bvh3D overlap queries..." << std::endl;
+
+    unsigned int seed = 4242;
+    const size_t count = 500;
+    std::vector<Vec3> boxMin(count), boxMax(count);
+    for (size_t i = 0; i < count; ++i) {
+        boxMin[i] = { TestRandom(seed, -40.0f, 40.0f), TestRandom(seed, -40.0f, 40.0f), TestRandom(seed, -40.0f, 40.0f) };
+        boxMax[i] = VectorAdd(boxMin[i], { TestRandom(seed, 0.1f, 4.0f), TestRandom(seed, 0.1f, 4.0f), TestRandom(seed, 0.1f, 4.0f) });
+    }
+    Bvh3D* bvh = Bvh3DCreate();
+    Bvh3DBuild(bvh, boxMin.data(), boxMax.data(), count);
+
+    Vec3 queryMin = { -10.0f, -5.0f, -20.0f }, queryMax = { 10.0f, 15.0f, 0.0f };
+    std::vector<int> found(count);
+    size_t foundCount = Bvh3DOverlapAABB(bvh, queryMin, queryMax, found.data(), found.size());
+    found.resize(foundCount);
+    std::sort(found.begin(), found.end());
+    std::vector<int> expected;
+    for (size_t i = 0; i < count; ++i) {
+        if (boxMin[i].x <= queryMax.x && boxMax[i].x >= queryMin.x && boxMin[i].y <= queryMax.y && boxMax[i].y >= queryMin.y && boxMin[i].z <= queryMax.z && boxMax[i].z >= queryMin.z) {
+            expected.push_back((int)i);
+        }
+    }
+    Assert(!expected.empty() && found == expected, "Bvh3DOverlapAABB should find exactly the overlapping boxes");
+
+    Vec3 center = { 5.0f, 5.0f, 5.0f };
+    found.assign(count, -1);
+    foundCount = Bvh3DOverlapSphere(bvh, center, 12.0f, found.data(), found.size());
+    found.resize(foundCount);
+    std::sort(found.begin(), found.end());
+    expected.clear();
+    for (size_t i = 0; i < count; ++i) {
+        Vec3 closest = { fmaxf(boxMin[i].x, fminf(center.x, boxMax[i].x)), fmaxf(boxMin[i].y, fminf(center.y, boxMax[i].y)), fmaxf(boxMin[i].z, fminf(center.z, boxMax[i].z)) };
+        Vec3 offset = VectorSubtract(center, closest);
+        if (VectorDot(offset, offset) <= 144.0f) {
+            expected.push_back((int)i);
+        }
+    }
+    Assert(!expected.empty() && found == expected, "Bvh3DOverlapSphere should find exactly the boxes touching the sphere");
+
+    Bvh3DDestroy(bvh);
+
+    std::cout << "[PASS] Bvh3D overlap queries: all checks passed" << endline;
+}
+
+void TestSweptCollision() {
+    std::cout << "Testing swept collision tests..." << std::endl;
+
+    SweepHit2D hit;
+
+    //A fast ball skips over a thin paddle in one discrete step but not when swept
+    Vec2 paddleMin = { -0.1f, -1.0f }, paddleMax = { 0.1f, 1.0f };
+    Vec2 ball = { -5.0f, 0.0f }, motion = { 10.0f, 0.0f };
+    Vec2 stepped = VectorAdd2D(ball, motion);
+    Assert(stepped.x - 0.25f > paddleMax.x, "Discrete step should land past the paddle");
+    Assert(SweepCircleAABB2D(ball, 0.25f, motion, paddleMin, paddleMax, &hit) == 1, "Swept ball should hit the paddle");
+    Assert(FloatEquals(hit.time, 0.465f) && FloatEquals(hit.normal.x, -1.0f) && FloatEquals(hit.normal.y, 0.0f), "Swept ball should hit the near face");
+
+    //Corner hits use the rounded corner
+    Assert(SweepCircleAABB2D({ -2.0f, -2.0f }, 0.5f, { 2.0f, 2.0f }, { 0.0f, 0.0f }, { 1.0f, 1.0f }, &hit) == 1, "Diagonal sweep should hit the corner");
+    Assert(FloatEquals(hit.time, 1.0f - 0.5f / (2.0f * sqrtf(2.0f)), 0.0001f) && FloatEquals(hit.normal.x, -0.70710678f, 0.0001f) && FloatEquals(hit.normal.y, -0.70710678f, 0.0001f), "Corner hit should have the diagonal normal");
+
+    Assert(SweepCircleAABB2D({ -2.0f, -2.0f }, 0.5f, { 2.0f, 0.0f }, { 0.0f, 0.0f }, { 1.0f, 1.0f }, &hit) == 0, "Sweep passing below the box should miss");
+    Assert(hit.time == 1.0f && hit.normal.x == 0.0f && hit.normal.y == 0.0f, "A miss should report the full step and no normal");
+
+    Assert(SweepCircleAABB2D({ 0.5f, 0.9f }, 0.25f, { 1.0f, 0.0f }, { 0.0f, 0.0f }, { 1.0f, 1.0f }, &hit) == 1, "Starting inside should hit");
+    Assert(hit.time == 0.0f && FloatEquals(hit.normal.y, 1.0f), "Starting inside should push out through the nearest face");
+
+    //Circle against a segment: flat side and round end
+    Assert(SweepCircleSegment2D({ 0.0f, 2.0f }, 0.5f, { 0.0f, -4.0f }, { -1.0f, 0.0f }, { 1.0f, 0.0f }, &hit) == 1, "Circle should hit the segment");
+    Assert(FloatEquals(hit.time, 0.375f) && FloatEquals(hit.normal.x, 0.0f) && FloatEquals(hit.normal.y, 1.0f), "Flat side hit should use the segment normal");
+    Assert(SweepCircleSegment2D({ 1.3f, 2.0f }, 0.5f, { 0.0f, -4.0f }, { -1.0f, 0.0f }, { 1.0f, 0.0f }, &hit) == 1, "Circle should hit the segment end");
+    Assert(FloatEquals(hit.time, 0.4f, 0.0001f) && FloatEquals(hit.normal.x, 0.6f, 0.0001f) && FloatEquals(hit.normal.y, 0.8f, 0.0001f), "End hit should use the normal from the end point");
+    Assert(SweepCircleSegment2D({ 2.0f, 2.0f }, 0.5f, { 0.0f, -4.0f }, { -1.0f, 0.0f }, { 1.0f, 0.0f }, nullptr) == 0, "Circle passing beside the segment should miss");
+
+    //Ray against a box
+    Assert(RayAABB2D({ -1.0f, 0.5f }, { 4.0f, 0.0f }, { 0.0f, 0.0f }, { 1.0f, 1.0f }, &hit) == 1, "Ray should hit the box");
+    Assert(FloatEquals(hit.time, 0.25f) && FloatEquals(hit.normal.x, -1.0f), "Ray should enter through the left face");
+    Assert(RayAABB2D({ -1.0f, 0.5f }, { 0.5f, 0.0f }, { 0.0f, 0.0f }, { 1.0f, 1.0f }, &hit) == 0, "Short ray should stop before the box");
+
+    //Segment against segment
+    Assert(SegmentIntersect2D({ 0.0f, 0.0f }, { 2.0f, 2.0f }, { 0.0f, 2.0f }, { 2.0f, 0.0f }, &hit) == 1, "Crossing segments should intersect");
+    Assert(FloatEquals(hit.time, 0.5f) && FloatEquals(hit.normal.x, -0.70710678f, 0.0001f) && FloatEquals(hit.normal.y, -0.70710678f, 0.0001f), "Segment normal should face against the first segment");
+    Assert(SegmentIntersect2D({ 0.0f, 0.0f }, { 2.0f, 0.0f }, { 0.0f, 1.0f }, { 2.0f, 1.0f }, &hit) == 0, "Parallel segments should not intersect");
+
+    std::cout << "[PASS] Swept collision tests: all checks passed" << endline;
+}
+
+void TestSweptCollisionArrays() {
+    std::cout << "Testing swept collision arrays against substepping..." << std::endl;
+
+    unsigned int seed = 777;
+    const size_t count = 300;
+    std::vector<Vec2> centers(count), motions(count), boxMin(count), boxMax(count), segmentStarts(count), segmentEnds(count);
+    std::vector<float> radii(count);
+    for (size_t i = 0; i < count; ++i) {
+        centers[i] = { TestRandom(seed, -6.0f, 6.0f), TestRandom(seed, -6.0f, 6.0f) };
+        motions[i] = { TestRandom(seed, -12.0f, 12.0f), TestRandom(seed, -12.0f, 12.0f) };
+        radii[i] = TestRandom(seed, 0.1f, 1.0f);
+        boxMin[i] = { TestRandom(seed, -2.0f, 1.0f), TestRandom(seed, -2.0f, 1.0f) };
+        boxMax[i] = VectorAdd2D(boxMin[i], { TestRandom(seed, 0.05f, 2.0f), TestRandom(seed, 0.05f, 2.0f) });
+        segmentStarts[i] = { TestRandom(seed, -3.0f, 3.0f), TestRandom(seed, -3.0f, 3.0f) };
+        segmentEnds[i] = { TestRandom(seed, -3.0f, 3.0f), TestRandom(seed, -3.0f, 3.0f) };
+    }
+
+    std::vector<SweepHit2D> boxHits(count), segmentHits(count), rayHits(count), crossHits(count);
+    SweepCircleAABB2DArray(centers.data(), radii.data(), motions.data(), boxMin.data(), boxMax.data(), boxHits.data(), count);
+    SweepCircleSegment2DArray(centers.data(), radii.data(), motions.data(), segmentStarts.data(), segmentEnds.data(), segmentHits.data(), count);
+    RayAABB2DArray(centers.data(), motions.data(), boxMin.data(), boxMax.data(), rayHits.data(), count);
+    std::vector<Vec2> ends(count);
+    VectorAdd2DArray(centers.data(), motions.data(), ends.data(), count);
+    SegmentIntersect2DArray(centers.data(), ends.data(), segmentStarts.data(), segmentEnds.data(), crossHits.data(), count);
+
+    int boxHitCount = 0;
+    for (size_t i = 0; i < count; ++i) {
+        SweepHit2D single;
+        int found = SweepCircleAABB2D(centers[i], radii[i], motions[i], boxMin[i], boxMax[i], &single);
+        Assert(single.time == boxHits[i].time && single.normal.x == boxHits[i].normal.x && single.normal.y == boxHits[i].normal.y, "SweepCircleAABB2DArray should match the single test");
+        SweepCircleSegment2D(centers[i], radii[i], motions[i], segmentStarts[i], segmentEnds[i], &single);
+        Assert(single.time == segmentHits[i].time && single.normal.x == segmentHits[i].normal.x && single.normal.y == segmentHits[i].normal.y, "SweepCircleSegment2DArray should match the single test");
+        RayAABB2D(centers[i], motions[i], boxMin[i], boxMax[i], &single);
+        Assert(single.time == rayHits[i].time && single.normal.x == rayHits[i].normal.x, "RayAABB2DArray should match the single test");
+        SegmentIntersect2D(centers[i], ends[i], segmentStarts[i], segmentEnds[i], &single);
+        Assert(single.time == crossHits[i].time && single.normal.y == crossHits[i].normal.y, "SegmentIntersect2DArray should match the single test");
+        boxHitCount += found;
+
+        //Substepping up to the reported time must never find an overlap, and
+        //the circle must touch the box at that time
+        float radiusSquared = radii[i] * radii[i];
+        for (int step = 0; step < 256; ++step) {
+            float t = boxHits[i].time * (float)step / 256.0f;
+            Vec2 p = VectorAdd2D(centers[i], VectorScale2D(motions[i], t));
+            Vec2 closest = { fmaxf(boxMin[i].x, fminf(p.x, boxMax[i].x)), fmaxf(boxMin[i].y, fminf(p.y, boxMax[i].y)) };
+            Vec2 offset = VectorSubtract2D(p, closest);
+            Assert(boxHits[i].time == 0.0f || VectorDot2D(offset, offset) > radiusSquared * 0.999f, "No overlap should happen before the time of impact");
+        }
+        if (found == 1) {
+            Vec2 p = VectorAdd2D(centers[i], VectorScale2D(motions[i], boxHits[i].time));
+            Vec2 closest = { fmaxf(boxMin[i].x, fminf(p.x, boxMax[i].x)), fmaxf(boxMin[i].y, fminf(p.y, boxMax[i].y)) };
+            Assert(boxHits[i].time == 0.0f || FloatEquals(VectorMagnitude2D(VectorSubtract2D(p, closest)), radii[i], 0.001f), "The circle should touch the box at the time of impact");
+            Assert(FloatEquals(VectorMagnitude2D(boxHits[i].normal), 1.0f, 0.0001f), "Hit normals should be unit length");
+        }
+    }
+    Assert(boxHitCount > 20 && boxHitCount < (int)count, "Random sweeps should include hits and misses");
+
+    std::cout << "[PASS] Swept collision arrays: all checks passed" << endline;
+}
+
+void TestFrameArena() {
+    std::cout << "Testing frame arena allocation..." << std::endl;
+
+    VectorMathSetFrameArenaCapacity(64 * 1024);
+    VectorMathFrameBegin();
+
+    void* first = VectorMathFrameAlloc(100, 0);
+    void* aligned = VectorMathFrameAlloc(256, 64);
+    Assert(first != nullptr && aligned != nullptr, "Small frame allocations should succeed");
+    Assert(((size_t)first % 16) == 0 && ((size_t)aligned % 64) == 0, "Frame allocations should respect the alignment");
+    Assert((char*)aligned >= (char*)first + 100, "Frame allocations should not overlap");
+    Assert(VectorMathFrameAlloc(16, 3) == nullptr, "Alignment must be a power of two");
+
+    VectorMathArenaStats before;
+    VectorMathGetFrameArenaStats(&before);
+    Assert(before.capacity == 64 * 1024 && before.arenaCount >= 1, "Stats should report the capacity and the arena");
+    Assert(VectorMathFrameAlloc(64 * 1024, 16) == nullptr, "Allocations past the capacity should fail");
+    VectorMathArenaStats after;
+    VectorMathGetFrameArenaStats(&after);
+    Assert(after.overflowCount == before.overflowCount + 1 && after.peakUsed >= 356, "Overflows and peak use should be counted");
+
+    //Library scratch (the BVH build) goes on top of frame data and is given back
+    void* beforeBuild = VectorMathFrameAlloc(16, 16);
+    std::vector<Vec3> centers(1000);
+    std::vector<float> radii(1000, 0.5f);
+    for (size_t i = 0; i < centers.size(); ++i) {
+        centers[i] = { (float)(i % 10), (float)(i / 10 % 10), (float)(i / 100) };
+    }
+    Bvh3D* bvh = Bvh3DCreate();
+    Bvh3DBuildSpheres(bvh, centers.data(), radii.data(), centers.size());
+    Bvh3DDestroy(bvh);
+    void* afterBuild = VectorMathFrameAlloc(16, 16);
+    Assert((char*)afterBuild == (char*)beforeBuild + 16, "Scratch buffers should be released at the end of the call");
+
+    //A new frame starts from an empty arena
+    VectorMathFrameEnd();
+    VectorMathFrameBegin();
+    Assert(VectorMathFrameAlloc(100, 0) == first, "A new frame should reuse the arena from the start");
+    Assert(VectorMathFrameAlloc(60 * 1024, 16) != nullptr, "A new frame should have the full capacity again");
+    VectorMathFrameEnd();
+
+    VectorMathSetFrameArenaCapacity(0);
+    VectorMathFrameBegin();
+    VectorMathGetFrameArenaStats(&after);
+    Assert(after.capacity == 4 * 1024 * 1024 && VectorMathFrameAlloc(1024 * 1024, 16) != nullptr, "Capacity 0 should restore the default");
+    VectorMathFrameEnd();
+
+    std::cout << "[PASS] Frame arena: all checks passed" << endline;
+}
+
+void TestFusedOperations() {
+    std::cout << "Testing fused operations..." << std::endl;
+
+    //pos += v * dt
+    Vec2 p = VectorScaleAdd2D({ 1.0f, 2.0f }, { 4.0f, -2.0f }, 0.5f);
+    Assert(FloatEquals(p.x, 3.0f) && FloatEquals(p.y, 1.0f), "VectorScaleAdd2D should add b scaled");
+    Vec3 m = VectorMulAdd({ 1.0f, 2.0f, 3.0f }, { 2.0f, 3.0f, 4.0f }, { 0.5f, 0.5f, 0.5f });
+    Assert(FloatEquals(m.x, 2.5f) && FloatEquals(m.y, 6.5f) && FloatEquals(m.z, 12.5f), "VectorMulAdd should be a * b + c");
+
+    Vec2 lc = VectorLerpClamp2D({ 0.0f, 0.0f }, { 10.0f, -10.0f }, 0.75f, -5.0f, 5.0f);
+    Assert(FloatEquals(lc.x, 5.0f) && FloatEquals(lc.y, -5.0f), "VectorLerpClamp2D should clamp the lerped value");
+
+    //Too long, too short, in range and zero
+    Vec3 longer = VectorClampMagnitudeRange({ 0.0f, 6.0f, 8.0f }, 2.0f, 5.0f);
+    Assert(FloatEquals(VectorMagnitude(longer), 5.0f), "Long vectors should shrink to maxLength");
+    Vec3 shorter = VectorClampMagnitudeRange({ 0.3f, 0.4f, 0.0f }, 2.0f, 5.0f);
+    Assert(FloatEquals(shorter.x, 1.2f) && FloatEquals(shorter.y, 1.6f), "Short vectors should grow to minLength");
+    Vec3 inRange = VectorClampMagnitudeRange({ 3.0f, 0.0f, 0.0f }, 2.0f, 5.0f);
+    Assert(inRange.x == 3.0f, "Vectors in range should be kept");
+    Vec2 zero = VectorClampMagnitudeRange2D({ 0.0f, 0.0f }, 2.0f, 5.0f);
+    Assert(zero.x == 0.0f && zero.y == 0.0f, "Zero vectors have no direction and should stay zero");
+
+    //Must match the separate calls exactly
+    unsigned int seed = 7;
+    for (int i = 0; i < 100; ++i) {
+        Vec3 a = { TestRandom(seed, -10.0f, 10.0f), TestRandom(seed, -10.0f, 10.0f), TestRandom(seed, -10.0f, 10.0f) };
+        Vec3 b = { TestRandom(seed, -10.0f, 10.0f), TestRandom(seed, -10.0f, 10.0f), TestRandom(seed, -10.0f, 10.0f) };
+        float t = TestRandom(seed, 0.0f, 1.0f);
+        Vec3 fused = VectorScaleAdd(a, b, t);
+        Vec3 separate = VectorAdd(a, VectorScale(b, t));
+        Assert(fused.x == separate.x && fused.y == separate.y && fused.z == separate.z, "VectorScaleAdd should match Add(a, Scale(b, t))");
+        fused = VectorLerpClamp(a, b, t, -4.0f, 4.0f);
+        separate = VectorClamp(VectorLerp(a, b, t), -4.0f, 4.0f);
+        Assert(fused.x == separate.x && fused.y == separate.y && fused.z == separate.z, "VectorLerpClamp should match Clamp(Lerp(a, b, t))");
+        fused = VectorClampMagnitudeRange(a, 0.0f, 6.0f);
+        separate = VectorClampMagnitude(a, 6.0f);
+        Assert(fused.x == separate.x && fused.y == separate.y && fused.z == separate.z, "minLength 0 should match VectorClampMagnitude");
+    }
+
+    std::cout << "[PASS] Fused operations: all checks passed" << endline;
+}
+
+void TestFusedBatchLevels() {
+    std::cout << "Testing fused batch operations on every SIMD level..." << std::endl;
+
+    const int count = 19; // not a multiple of 8, so the SIMD tail path runs too
+    Vec3 a[count], b[count], c[count];
+    unsigned int seed = 11;
+    for (int i = 0; i < count; ++i) {
+        a[i] = { TestRandom(seed, -8.0f, 8.0f), TestRandom(seed, -8.0f, 8.0f), TestRandom(seed, -8.0f, 8.0f) };
+        b[i] = { TestRandom(seed, -8.0f, 8.0f), TestRandom(seed, -8.0f, 8.0f), TestRandom(seed, -8.0f, 8.0f) };
+        c[i] = { TestRandom(seed, -1.0f, 1.0f), TestRandom(seed, -1.0f, 1.0f), TestRandom(seed, -1.0f, 1.0f) };
+    }
+    a[4] = { 0.0f, 0.0f, 0.0f }; // zero length for ClampMagnitudeRange
+    a[5] = { 0.1f, 0.0f, 0.2f }; // shorter than minLength
+
+    float ax[count], ay[count], az[count], bx[count], by[count];
+    for (int i = 0; i < count; ++i) {
+        ax[i] = a[i].x; ay[i] = a[i].y; az[i] = a[i].z;
+        bx[i] = b[i].x; by[i] = b[i].y;
+    }
+
+    int levels[] = { VECTORMATH_SIMD_SCALAR, VECTORMATH_SIMD_SSE41, VECTORMATH_SIMD_AVX2, VECTORMATH_SIMD_NEON };
+    for (int level : levels) {
+        if (!VectorMathSetSimdLevel(level)) {
+            continue;
+        }
+
+        Vec3 scaleAdd[count], mulAdd[count], lerpClamp[count];
+        VectorScaleAddArray(a, b, 0.016f, scaleAdd, count);
+        VectorMulAddArray(a, b, c, mulAdd, count);
+        VectorLerpClampArray(a, b, 0.3f, -3.0f, 3.0f, lerpClamp, count);
+        float rx[count], ry[count], rz[count];
+        VectorClampMagnitudeRangeBatch(ax, ay, az, 1.0f, 6.0f, rx, ry, rz, count);
+
+        for (int i = 0; i < count; ++i) {
+            Vec3 expected = VectorScaleAdd(a[i], b[i], 0.016f);
+            Assert(scaleAdd[i].x == expected.x && scaleAdd[i].y == expected.y && scaleAdd[i].z == expected.z, "VectorScaleAddArray should match VectorScaleAdd exactly");
+            expected = VectorMulAdd(a[i], b[i], c[i]);
+            Assert(mulAdd[i].x == expected.x && mulAdd[i].y == expected.y && mulAdd[i].z == expected.z, "VectorMulAddArray should match VectorMulAdd exactly");
+            expected = VectorLerpClamp(a[i], b[i], 0.3f, -3.0f, 3.0f);
+            Assert(lerpClamp[i].x == expected.x && lerpClamp[i].y == expected.y && lerpClamp[i].z == expected.z, "VectorLerpClampArray should match VectorLerpClamp exactly");
+            expected = VectorClampMagnitudeRange(a[i], 1.0f, 6.0f);
+            Assert(rx[i] == expected.x && ry[i] == expected.y && rz[i] == expected.z, "VectorClampMagnitudeRangeBatch should match VectorClampMagnitudeRange exactly");
+        }
+
+        //In place, the way a physics step uses it: pos += v * dt
+        float px[count], py[count];
+        for (int i = 0; i < count; ++i) {
+            px[i] = ax[i];
+            py[i] = ay[i];
+        }
+        VectorScaleAdd2DBatch(px, py, bx, by, 0.016f, px, py, count);
+        VectorClampMagnitudeRange2DBatch(px, py, 1.0f, 6.0f, px, py, count);
+        for (int i = 0; i < count; ++i) {
+            Vec2 expected = VectorClampMagnitudeRange2D(VectorScaleAdd2D({ ax[i], ay[i] }, { bx[i], by[i] }, 0.016f), 1.0f, 6.0f);
+            Assert(px[i] == expected.x && py[i] == expected.y, "In-place fused batches should match the scalar functions");
+        }
+    }
+    VectorMathSetSimdLevel(VECTORMATH_SIMD_BEST);
+
+    std::cout << "[PASS] Fused batch operations: all checks passed" << endline;
+}
+
+void TestPortableMath() {
+    std::cout << "Testing the portable sqrt, sin and cos..." << std::endl;
+
+    //Must match the correctly rounded hardware sqrt bit for bit
+    auto sameBits = [](float a, float b) { return std::memcmp(&a, &b, sizeof(float)) == 0; };
+    float edges[] = { 0.0f, -0.0f, 1.0f, 2.0f, 4.0f, 0.25f, 1e-45f, 1e-40f, 1.17549435e-38f, 3.40282347e+38f, INFINITY };
+    for (float v : edges) {
+        Assert(sameBits(vmath::PortableSqrt(v), std::sqrt(v)), "PortableSqrt should match sqrt on edge cases");
+    }
+    Assert(std::isnan(vmath::PortableSqrt(-1.0f)) && std::isnan(vmath::PortableSqrt(-INFINITY)), "PortableSqrt of a negative number should be NaN");
+    uint32_t bits = 12345;
+    for (int i = 0; i < 1000000; ++i) {
+        bits = bits * 1664525u + 1013904223u;
+        uint32_t positive = bits & 0x7fffffffu;
+        float v;
+        std::memcpy(&v, &positive, sizeof(v));
+        if (std::isnan(v)) {
+            continue;
+        }
+        Assert(sameBits(vmath::PortableSqrt(v), std::sqrt(v)), "PortableSqrt should match sqrt bit for bit");
+    }
+
+    for (int i = -2000; i <= 2000; ++i) {
+        double x = i * 0.01;
+        Assert(std::fabs(vmath::PortableSinCos(x, false) - std::sin(x)) < 1e-15, "Portable sin should match sin");
+        Assert(std::fabs(vmath::PortableSinCos(x, true) - std::cos(x)) < 1e-15, "Portable cos should match cos");
+    }
+
+    std::cout << "[PASS] Portable math: all checks passed" << endline;
+}
+
+void TestFixedPoint() {
+    std::cout << "Testing Q16.16 fixed point vectors..." << std::endl;
+    using vmath::Fixed;
+    using vmath::FixedVec2;
+    using vmath::FixedVec3;
+
+    Assert(Fixed(1.5) * Fixed(-2) == Fixed(-3), "Fixed multiply");
+    Assert(Fixed(7) / Fixed(2) == Fixed(3.5), "Fixed divide");
+    Assert(Fixed(1) / Fixed(3) == Fixed::FromRaw(21845) && Fixed(2) / Fixed(3) == Fixed::FromRaw(43691), "Fixed divide should round to nearest");
+    Assert(Fixed(1) / Fixed(0) == Fixed(0), "Dividing by zero should give zero");
+    Assert(vmath::Sqrt(Fixed(16)) == Fixed(4) && vmath::Sqrt(Fixed(2)) == Fixed::FromRaw(92682), "Fixed sqrt should round to nearest");
+    Assert(Fixed(32767) + Fixed(1) == Fixed(-32768), "Fixed overflow should wrap");
+    Assert(Fixed::FromFloat(1e9f).raw == INT32_MAX && Fixed::FromFloat(-1e9f).raw == INT32_MIN && Fixed(40000.0).raw == INT32_MAX, "Conversions past the range should saturate");
+    Assert(Fixed::FromFloat(NAN) == Fixed(0) && Fixed::FromFloat(-32768.0f) == Fixed(-32768), "NaN should convert to zero and the range ends exactly");
+
+    FixedVec2 a = { Fixed(3), Fixed(4) };
+    Assert(vmath::Magnitude(a) == Fixed(5), "Fixed magnitude");
+    FixedVec2 n = vmath::Normalize(a);
+    Assert(n.x == Fixed(0.6) && n.y == Fixed(0.8), "Fixed normalize");
+    //Far past the range of MagnitudeSquared
+    FixedVec3 big = { Fixed(3000), Fixed(0), Fixed(4000) };
+    Assert(vmath::Magnitude(big) == Fixed(5000), "Fixed magnitude should not overflow on long vectors");
+    FixedVec3 unit = vmath::Normalize(big);
+    Assert(unit.x == Fixed(0.6) && unit.z == Fixed(0.8), "Fixed normalize of a long vector");
+    FixedVec2 corner = { Fixed(-32768), Fixed(-32768) };
+    Assert(vmath::Magnitude(corner).raw == INT32_MAX, "Lengths past the range should saturate");
+    FixedVec2 cornerUnit = vmath::Normalize(corner);
+    Assert(cornerUnit.x == cornerUnit.y && FloatEquals(cornerUnit.x.ToFloat(), -0.70710678f, 0.0001f), "Fixed normalize of a vector longer than the range");
+    FixedVec3 far = vmath::Normalize(FixedVec3{ Fixed(32767), Fixed(-32768), Fixed(32767) });
+    Assert(FloatEquals(far.y.ToFloat(), -0.57735f, 0.0001f), "Fixed normalize of the longest Vec3");
+    FixedVec2 zero = vmath::Normalize(FixedVec2{ Fixed(0), Fixed(0) });
+    Assert(zero.x == Fixed(0) && zero.y == Fixed(0), "Fixed normalize of zero should be zero");
+
+    FixedVec2 reflected = vmath::Reflect(FixedVec2{ Fixed(1), Fixed(-1) }, FixedVec2{ Fixed(0), Fixed(2) });
+    Assert(reflected.x == Fixed(1) && reflected.y == Fixed(1), "Fixed reflect");
+    FixedVec2 clamped = vmath::ClampMagnitude(FixedVec2{ Fixed(30), Fixed(40) }, Fixed(10));
+    Assert(FloatEquals(clamped.x.ToFloat(), 6.0f, 0.001f) && FloatEquals(clamped.y.ToFloat(), 8.0f, 0.001f), "Fixed clamp magnitude");
+    Vec2 back = vmath::ToFloat(vmath::Lerp(a, FixedVec2{ Fixed(5), Fixed(0) }, Fixed(0.5)));
+    Assert(back.x == 4.0f && back.y == 2.0f, "Fixed lerp and conversion");
+
+    std::cout << "[PASS] Fixed point: all checks passed" << endline;
+}
+
+//FNV-1a over the raw bits
+static uint64_t HashBytes(uint64_t hash, const void* data, size_t size) {
+    const unsigned char* bytes = (const unsigned char*)data;
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+//A few seconds of bouncing bodies plus a spinning point cloud, through the
+//batch entry points, so every instruction set and the thread pool take part
+static uint64_t RunFloatSimulation() {
+    const size_t count = 53; // not a multiple of 8, so the SIMD tails run too
+    std::vector<Vec2> positions(count), velocities(count), gravity(count, Vec2{ 0.0f, -9.81f }), normals(count);
+    std::vector<unsigned char> contacts(count);
+    std::vector<Vec3> points(count), rotated(count);
+    std::vector<float> x(count), y(count), z(count);
+    unsigned int seed = 2024;
+    for (size_t i = 0; i < count; ++i) {
+        positions[i] = { TestRandom(seed, -10.0f, 10.0f), TestRandom(seed, 0.0f, 10.0f) };
+        velocities[i] = { TestRandom(seed, -5.0f, 5.0f), TestRandom(seed, -5.0f, 5.0f) };
+        points[i] = { TestRandom(seed, -3.0f, 3.0f), TestRandom(seed, -3.0f, 3.0f), TestRandom(seed, -3.0f, 3.0f) };
+    }
+
+    for (int step = 0; step < 240; ++step) {
+        IntegrateBodies2D(positions.data(), velocities.data(), gravity.data(), count, 1.0f / 60.0f);
+        for (size_t i = 0; i < count; ++i) {
+            contacts[i] = positions[i].y < 0.0f ? 1 : 0;
+            normals[i] = { TestRandom(seed, -0.2f, 0.2f), 1.0f };
+            if (contacts[i]) {
+                positions[i].y = -positions[i].y;
+            }
+        }
+        VectorReflectResponse2DArray(velocities.data(), normals.data(), contacts.data(), count, 0.8f, 0.1f, VECTORMATH_REFLECT_DEFAULT);
+        VectorClampMagnitudeRange2DArray(velocities.data(), 0.5f, 20.0f, velocities.data(), count);
+
+        Mat4 transform;
+        Mat4ComposeTRS({ 0.0f, 1.0f, 0.0f }, QuatFromAxisAngle({ 1.0f, 2.0f, 3.0f }, (float)step * 0.05f), { 1.0f, 1.0f, 1.0f }, &transform);
+        Mat4TransformPoints(&transform, points.data(), rotated.data(), count);
+        for (size_t i = 0; i < count; ++i) {
+            x[i] = rotated[i].x;
+            y[i] = rotated[i].y;
+            z[i] = rotated[i].z;
+        }
+        VectorNormalizeBatchEx(x.data(), y.data(), z.data(), x.data(), y.data(), z.data(), count, VECTORMATH_PRECISION_FAST);
+    }
+
+    uint64_t hash = 14695981039346656037ull;
+    hash = HashBytes(hash, positions.data(), count * sizeof(Vec2));
+    hash = HashBytes(hash, velocities.data(), count * sizeof(Vec2));
+    hash = HashBytes(hash, x.data(), count * sizeof(float));
+    hash = HashBytes(hash, y.data(), count * sizeof(float));
+    hash = HashBytes(hash, z.data(), count * sizeof(float));
+    return hash;
+}
+
+//The same bouncing bodies in Q16.16
+static uint64_t RunFixedSimulation() {
+    using namespace vmath;
+    const size_t count = 53;
+    std::vector<FixedVec2> positions(count), velocities(count);
+    unsigned int seed = 2024;
+    for (size_t i = 0; i < count; ++i) {
+        positions[i] = { Fixed::FromFloat(TestRandom(seed, -10.0f, 10.0f)), Fixed::FromFloat(TestRandom(seed, 0.0f, 10.0f)) };
+        velocities[i] = { Fixed::FromFloat(TestRandom(seed, -5.0f, 5.0f)), Fixed::FromFloat(TestRandom(seed, -5.0f, 5.0f)) };
+    }
+
+    const Fixed dt = Fixed(1.0 / 60.0);
+    const FixedVec2 gravity = { Fixed(0), Fixed(-9.81) };
+    for (int step = 0; step < 240; ++step) {
+        for (size_t i = 0; i < count; ++i) {
+            velocities[i] = ScaleAdd(velocities[i], gravity, dt);
+            positions[i] = ScaleAdd(positions[i], velocities[i], dt);
+            FixedVec2 normal = { Fixed::FromFloat(TestRandom(seed, -0.2f, 0.2f)), Fixed(1) };
+            if (positions[i].y < Fixed(0)) {
+                positions[i].y = -positions[i].y;
+                velocities[i] = ReflectResponse(velocities[i], Normalize(normal), Fixed(0.8), Fixed(0.1));
+            }
+            velocities[i] = ClampMagnitude(velocities[i], Fixed(0.5), Fixed(20));
+        }
+    }
+
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < count; ++i) {
+        int32_t raw[4] = { positions[i].x.raw, positions[i].y.raw, velocities[i].x.raw, velocities[i].y.raw };
+        hash = HashBytes(hash, raw, sizeof(raw));
+    }
+    return hash;
+}
+
+void TestDeterminismGoldenHash() {
+    std::cout << "Testing deterministic results across SIMD levels, threads and builds..." << std::endl;
+
+    //Golden hashes from an x86-64 deterministic build. Any deterministic build
+    //(MSVC, GCC, Clang; x86 or ARM) has to reproduce them exactly.
+    const uint64_t floatGolden = 0x76d91e36ffbd47eeull;
+    const uint64_t fixedGolden = 0x87dd8233f3357afaull;
+
+    size_t threshold = VectorMathGetParallelThreshold();
+    uint64_t reference = 0;
+    bool first = true;
+    int levels[] = { VECTORMATH_SIMD_SCALAR, VECTORMATH_SIMD_SSE41, VECTORMATH_SIMD_AVX2, VECTORMATH_SIMD_NEON };
+    for (int threads : { 1, 4 }) {
+        VectorMathSetThreadCount(threads);
+        VectorMathSetParallelThreshold(16);
+        for (int level : levels) {
+            if (!VectorMathSetSimdLevel(level)) {
+                continue;
+            }
+            uint64_t hash = RunFloatSimulation();
+            if (first) {
+                reference = hash;
+                first = false;
+            }
+            Assert(hash == reference, "The simulation should give the same bits on every SIMD level and thread count");
+        }
+    }
+    VectorMathSetSimdLevel(VECTORMATH_SIMD_BEST);
+    VectorMathSetParallelThreshold(threshold);
+    VectorMathSetThreadCount(0);
+
+    std::cout << "float hash " << std::hex << reference << ", fixed hash " << RunFixedSimulation() << std::dec << std::endl;
+    if (VectorMathIsDeterministic()) {
+        Assert(reference == floatGolden, "A deterministic build should reproduce the golden float hash");
+    }
+    Assert(RunFixedSimulation() == fixedGolden, "Fixed point should reproduce the golden hash in every build");
+
+    std::cout << "[PASS] Determinism: all checks passed" << endline;
+}
+
+void TestDoublePrecision() {
+    std::cout << "Testing double precision vectors..." << std::endl;
+
+    //10000 km from the origin a float step is 1 m; double still resolves 1 mm
+    Vec3d position = { 1.0e7, -2.5e6, 3.0e7 };
+    Vec3d moved = VectorAddDouble(position, { 0.001, 0.0, -0.001 });
+    Assert(moved.x - position.x > 0.0009 && moved.x - position.x < 0.0011, "Double add should keep a millimetre step far from the origin");
+    Vec3d offset = VectorSubtractDouble(moved, position);
+    Assert(fabs(offset.z + 0.001) < 1e-8, "Double subtract should recover the small offset");
+    Vec3 single = VectorFromDouble(moved);
+    Assert(single.x == 1.0e7f, "The same step is lost when narrowed to float");
+
+    Assert(VectorMagnitudeDouble({ 3.0e8, 4.0e8, 0.0 }) == 5.0e8, "Double magnitude should be exact for a 3-4-5 triangle");
+    Assert(VectorMagnitude2DDouble({ 6.0, 8.0 }) == 10.0, "Double 2D magnitude should be 10");
+    Vec3d unit = VectorNormalizeDouble({ 0.0, 0.0, 2.0e9 });
+    Assert(unit.x == 0.0 && unit.y == 0.0 && unit.z == 1.0, "Double normalize should give a unit vector");
+    Vec2d zero = VectorNormalize2DDouble({ 0.0, 0.0 });
+    Assert(zero.x == 0.0 && zero.y == 0.0, "Double normalize of zero should stay zero");
+
+    Vec3d cross = VectorCrossDouble({ 1.0, 0.0, 0.0 }, { 0.0, 1.0, 0.0 });
+    Assert(cross.x == 0.0 && cross.y == 0.0 && cross.z == 1.0, "Double cross of X and Y should be Z");
+    Assert(VectorDotDouble({ 1.0, 2.0, 3.0 }, { 4.0, 5.0, 6.0 }) == 32.0, "Double dot should be 32");
+    Vec2d reflected = VectorReflect2DDouble({ 1.0, -1.0 }, { 0.0, 1.0 });
+    Assert(reflected.x == 1.0 && reflected.y == 1.0, "Double reflect should flip the normal part");
+    Vec3d clamped = VectorClampMagnitudeDouble({ 0.0, 30.0, 40.0 }, 5.0);
+    Assert(fabs(VectorMagnitudeDouble(clamped) - 5.0) < 1e-12, "Double clamp magnitude should shorten to 5");
+    Vec3d lerp = VectorLerpDouble({ 0.0, 0.0, 0.0 }, { 10.0, 20.0, 30.0 }, 0.5);
+    Assert(lerp.x == 5.0 && lerp.y == 10.0 && lerp.z == 15.0, "Double lerp at 0.5 should be the midpoint");
+
+    //float -> double -> float is exact
+    float floats[5] = { 1.0f, -0.1f, 3.4e38f, 1.0e-40f, 0.0f };
+    double doubles[5];
+    float back[5];
+    ConvertFloatToDouble(floats, doubles, 5);
+    ConvertDoubleToFloat(doubles, back, 5);
+    Assert(std::memcmp(floats, back, sizeof(floats)) == 0, "float -> double -> float should round trip exactly");
+    Assert(doubles[1] == (double)-0.1f, "ConvertFloatToDouble should widen exactly");
+
+    std::cout << "[PASS] Double precision: all checks passed" << endline;
+}
+
+static float FloatFromBitsTest(uint32_t bits) {
+    float v;
+    std::memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+void TestHalfConversion() {
+    std::cout << "Testing half and bfloat16 conversion..." << std::endl;
+
+    Assert(vmath::HalfFromFloat(1.0f).bits == 0x3c00, "1 should be 0x3c00 as a half");
+    Assert(vmath::HalfFromFloat(-2.0f).bits == 0xc000, "-2 should be 0xc000 as a half");
+    Assert(vmath::HalfFromFloat(-0.0f).bits == 0x8000, "-0 should keep its sign as a half");
+    Assert(vmath::HalfFromFloat(65504.0f).bits == 0x7bff, "65504 is the largest half");
+    Assert(vmath::HalfFromFloat(65519.0f).bits == 0x7bff, "65519 should round down to 65504");
+    Assert(vmath::HalfFromFloat(65520.0f).bits == 0x7c00, "65520 should round up to infinity");
+    Assert(vmath::HalfFromFloat(1.0e10f).bits == 0x7c00, "Large floats should overflow to infinity");
+    Assert(vmath::HalfFromFloat(FloatFromBitsTest(0x33800000)).bits == 0x0001, "2^-24 is the smallest subnormal half");
+    Assert(vmath::HalfFromFloat(FloatFromBitsTest(0x33000000)).bits == 0x0000, "2^-25 is a tie and should round to even (zero)");
+    Assert(vmath::HalfFromFloat(FloatFromBitsTest(0x33400000)).bits == 0x0001, "1.5 * 2^-25 should round up to the smallest subnormal");
+    Assert(vmath::HalfFromFloat(1.0f + 1.0f / 2048.0f).bits == 0x3c00, "A tie above 1 should round to even");
+    Assert(vmath::HalfFromFloat(1.0f + 3.0f / 2048.0f).bits == 0x3c02, "A tie above an odd mantissa should round up");
+    uint16_t nan = vmath::HalfFromFloat(std::nanf("")).bits;
+    Assert((nan & 0x7c00) == 0x7c00 && (nan & 0x03ff) != 0, "NaN should stay NaN as a half");
+
+    //Every half converts to float and back unchanged
+    for (uint32_t bits = 0; bits < 0x10000; ++bits) {
+        vmath::Half h = { (uint16_t)bits };
+        float f = vmath::HalfToFloat(h);
+        bool isNan = (bits & 0x7c00) == 0x7c00 && (bits & 0x03ff) != 0;
+        if (isNan) {
+            Assert(f != f, "NaN halves should convert to NaN");
+            continue;
+        }
+        Assert(vmath::HalfFromFloat(f).bits == bits, "Every half should round trip through float");
+    }
+    Assert(vmath::HalfToFloat({ 0x0001 }) == FloatFromBitsTest(0x33800000), "Subnormal halves should convert exactly");
+
+    Assert(vmath::BFloat16FromFloat(1.0f).bits == 0x3f80, "1 should be 0x3f80 as a bfloat16");
+    Assert(vmath::BFloat16FromFloat(FloatFromBitsTest(0x3f808000)).bits == 0x3f80, "A bfloat16 tie should round to even (down)");
+    Assert(vmath::BFloat16FromFloat(FloatFromBitsTest(0x3f818000)).bits == 0x3f82, "A bfloat16 tie should round to even (up)");
+    Assert(vmath::BFloat16FromFloat(3.4e38f).bits == 0x7f80, "The largest floats should round to infinity as bfloat16");
+    Assert(vmath::BFloat16ToFloat(vmath::BFloat16FromFloat(std::nanf(""))) != vmath::BFloat16ToFloat(vmath::BFloat16FromFloat(std::nanf(""))), "NaN should stay NaN as bfloat16");
+
+    Vec2h h2 = VectorToHalf2D({ 0.5f, -1024.0f });
+    Vec2 f2 = VectorFromHalf2D(h2);
+    Assert(f2.x == 0.5f && f2.y == -1024.0f, "Exact values should survive VectorToHalf2D");
+
+    std::cout << "[PASS] Half conversion: all checks passed" << endline;
+}
+
+void TestConversionLevels() {
+    std::cout << "Testing batched precision conversion on every SIMD level..." << std::endl;
+
+    std::vector<Half> halves(0x10000);
+    for (uint32_t bits = 0; bits < 0x10000; ++bits) {
+        halves[bits].bits = (uint16_t)bits;
+    }
+
+    const size_t count = 1003; // not a multiple of 16, so the SIMD tail path runs too
+    std::vector<float> floats(count);
+    unsigned int seed = 23;
+    for (size_t i = 0; i < count; ++i) {
+        floats[i] = TestRandom(seed, -70000.0f, 70000.0f);
+    }
+    uint32_t edges[] = { 0x00000000, 0x80000000, 0x7f800000, 0xff800000, 0x7fc00000, 0x7f800001, 0xffbfffff,
+        0x477ff000, 0x477fefff, 0x33000000, 0x33000001, 0x387fe000, 0x00000001, 0x3f808000, 0x3f818000, 0x7f7fffff };
+    for (size_t i = 0; i < sizeof(edges) / sizeof(edges[0]); ++i) {
+        floats[i * 7] = FloatFromBitsTest(edges[i]);
+    }
+    for (size_t i = 200; i < 400; ++i) {
+        floats[i] *= 1.0e-9f; // half subnormals
+    }
+
+    int levels[] = { VECTORMATH_SIMD_SCALAR, VECTORMATH_SIMD_SSE41, VECTORMATH_SIMD_AVX2, VECTORMATH_SIMD_NEON };
+    for (int level : levels) {
+        if (!VectorMathSetSimdLevel(level)) {
+            continue;
+        }
+
+        std::vector<float> wide(0x10000);
+        ConvertHalfToFloat(halves.data(), wide.data(), wide.size());
+        for (uint32_t bits = 0; bits < 0x10000; ++bits) {
+            float expected = vmath::HalfToFloat(halves[bits]);
+            Assert(std::memcmp(&wide[bits], &expected, sizeof(float)) == 0, "ConvertHalfToFloat should match HalfToFloat for every half");
+        }
+
+        std::vector<Half> narrow(count);
+        std::vector<BFloat16> brain(count);
+        std::vector<float> brainBack(count);
+        ConvertFloatToHalf(floats.data(), narrow.data(), count);
+        ConvertFloatToBFloat16(floats.data(), brain.data(), count);
+        ConvertBFloat16ToFloat(brain.data(), brainBack.data(), count);
+        for (size_t i = 0; i < count; ++i) {
+            Assert(narrow[i].bits == vmath::HalfFromFloat(floats[i]).bits, "ConvertFloatToHalf should match HalfFromFloat bit for bit");
+            Assert(brain[i].bits == vmath::BFloat16FromFloat(floats[i]).bits, "ConvertFloatToBFloat16 should match BFloat16FromFloat bit for bit");
+            float expected = vmath::BFloat16ToFloat(brain[i]);
+            Assert(std::memcmp(&brainBack[i], &expected, sizeof(float)) == 0, "ConvertBFloat16ToFloat should match BFloat16ToFloat");
+        }
+    }
+    VectorMathSetSimdLevel(VECTORMATH_SIMD_BEST);
+
+    std::cout << "[PASS] Batched precision conversion: all checks passed" << endline;
+}
+
+void TestAlignedVectors() {
+    std::cout << "Testing aligned Vec4 / Vec3A..." << std::endl;
+
+    Assert(sizeof(Vec4) == 16 && alignof(Vec4) == 16, "Vec4 should be 16 bytes and 16-byte aligned");
+    Assert(sizeof(Vec3A) == 16 && alignof(Vec3A) == 16, "Vec3A should be 16 bytes and 16-byte aligned");
+
+    Vec4 a = { 1.0f, 2.0f, 3.0f, 4.0f };
+    Vec4 b = { -2.0f, 0.5f, 1.0f, 2.0f };
+    Vec4 r;
+    VectorAdd4D(&a, &b, &r);
+    Assert(r.x == -1.0f && r.y == 2.5f && r.z == 4.0f && r.w == 6.0f, "VectorAdd4D should add all four components");
+    VectorScale4D(&a, 2.0f, &r);
+    Assert(r.w == 8.0f, "VectorScale4D should scale w");
+    Assert(VectorDot4D(&a, &b) == -2.0f + 1.0f + 3.0f + 8.0f, "VectorDot4D should include w");
+    Vec4 unit = { 0.0f, 3.0f, 0.0f, 4.0f };
+    Assert(VectorMagnitude4D(&unit) == 5.0f, "VectorMagnitude4D of (0, 3, 0, 4) should be 5");
+    VectorNormalize4D(&unit, &r);
+    Assert(FloatEquals(r.y, 0.6f) && FloatEquals(r.w, 0.8f), "VectorNormalize4D should give a unit vector");
+    Vec4 zero = { 0.0f, 0.0f, 0.0f, 0.0f };
+    VectorNormalize4D(&zero, &r);
+    Assert(r.x == 0.0f && r.w == 0.0f, "VectorNormalize4D of zero should stay zero");
+    VectorClampMagnitude4D(&unit, 1.0f, &r);
+    Assert(FloatEquals(VectorMagnitude4D(&r), 1.0f), "VectorClampMagnitude4D should shorten to 1");
+
+    //Vec3A gives exactly the Vec3 results
+    unsigned int seed = 5;
+    for (int i = 0; i < 100; ++i) {
+        Vec3 u = { TestRandom(seed, -10.0f, 10.0f), TestRandom(seed, -10.0f, 10.0f), TestRandom(seed, -10.0f, 10.0f) };
+        Vec3 v = { TestRandom(seed, -10.0f, 10.0f), TestRandom(seed, -10.0f, 10.0f), TestRandom(seed, -10.0f, 10.0f) };
+        Vec3A ua = vmath::ToVec3A(u);
+        Vec3A va = vmath::ToVec3A(v);
+        Vec3A out;
+
+        Assert(VectorMagnitude3A(&ua) == VectorMagnitude(u), "VectorMagnitude3A should match VectorMagnitude");
+        Assert(VectorDot3A(&ua, &va) == VectorDot(u, v), "VectorDot3A should match VectorDot");
+        VectorCross3A(&ua, &va, &out);
+        Vec3 expected = VectorCross(u, v);
+        Assert(out.x == expected.x && out.y == expected.y && out.z == expected.z && out.pad == 0.0f, "VectorCross3A should match VectorCross");
+        VectorNormalize3A(&ua, &out);
+        expected = VectorNormalize(u);
+        Assert(out.x == expected.x && out.y == expected.y && out.z == expected.z && out.pad == 0.0f, "VectorNormalize3A should match VectorNormalize");
+        VectorReflect3A(&ua, &va, &out);
+        expected = VectorReflect(u, v);
+        Assert(out.x == expected.x && out.y == expected.y && out.z == expected.z, "VectorReflect3A should match VectorReflect");
+        VectorClampMagnitude3A(&ua, 4.0f, &out);
+        expected = VectorClampMagnitude(u, 4.0f);
+        Assert(out.x == expected.x && out.y == expected.y && out.z == expected.z, "VectorClampMagnitude3A should match VectorClampMagnitude");
+        VectorLerp3A(&ua, &va, 0.3f, &out);
+        expected = VectorLerp(u, v, 0.3f);
+        Assert(out.x == expected.x && out.y == expected.y && out.z == expected.z && out.pad == 0.0f, "VectorLerp3A should match VectorLerp");
+    }
+
+    //Inline layer
+    Vec3A p = { 1.0f, 2.0f, 3.0f, 0.0f };
+    p += Vec3A{ 1.0f, 1.0f, 1.0f, 0.0f } * 2.0f;
+    Assert(p == Vec3A{ 3.0f, 4.0f, 5.0f, 0.0f } && p.pad == 0.0f, "Vec3A operators should keep a zero pad at zero");
+    Vec4 q = vmath::ToVec4(Vec3{ 1.0f, 2.0f, 3.0f }, 1.0f);
+    Assert(q.w == 1.0f && vmath::Dot(q, q) == 15.0f, "ToVec4 should set w");
+
+    std::cout << "[PASS] Aligned vectors: all checks passed" << endline;
+}
+
+void TestAlignedArrayLevels() {
+    std::cout << "Testing aligned vector arrays on every SIMD level..." << std::endl;
+
+    const int count = 19; // not a multiple of 8, so the SIMD tail path runs too
+    Vec4 a4[count], b4[count];
+    Vec3A a3[count], b3[count];
+    Vec3 v3[count];
+    unsigned int seed = 17;
+    for (int i = 0; i < count; ++i) {
+        a4[i] = { TestRandom(seed, -8.0f, 8.0f), TestRandom(seed, -8.0f, 8.0f), TestRandom(seed, -8.0f, 8.0f), TestRandom(seed, -8.0f, 8.0f) };
+        b4[i] = { TestRandom(seed, -8.0f, 8.0f), TestRandom(seed, -8.0f, 8.0f), TestRandom(seed, -8.0f, 8.0f), TestRandom(seed, -8.0f, 8.0f) };
+        v3[i] = { a4[i].x, a4[i].y, a4[i].z };
+        //Garbage pad: everything but the component-wise operations must ignore it
+        a3[i] = { a4[i].x, a4[i].y, a4[i].z, 1.0e30f };
+        b3[i] = { b4[i].x, b4[i].y, b4[i].z, -7.0f };
+    }
+    a4[3] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    a3[3] = { 0.0f, 0.0f, 0.0f, 5.0f };
+
+    int levels[] = { VECTORMATH_SIMD_SCALAR, VECTORMATH_SIMD_SSE41, VECTORMATH_SIMD_AVX2, VECTORMATH_SIMD_NEON };
+    for (int level : levels) {
+        if (!VectorMathSetSimdLevel(level)) {
+            continue;
+        }
+
+        Vec4 sum4[count], norm4[count];
+        float dot4[count], mag4[count];
+        VectorAdd4DArray(a4, b4, sum4, count);
+        VectorNormalize4DArray(a4, norm4, count);
+        VectorDot4DArray(a4, b4, dot4, count);
+        VectorMagnitude4DArray(a4, mag4, count);
+        for (int i = 0; i < count; ++i) {
+            Vec4 expected;
+            VectorAdd4D(&a4[i], &b4[i], &expected);
+            Assert(sum4[i] == expected, "VectorAdd4DArray should match VectorAdd4D");
+            VectorNormalize4D(&a4[i], &expected);
+            Assert(norm4[i] == expected, "VectorNormalize4DArray should match VectorNormalize4D exactly");
+            Assert(dot4[i] == VectorDot4D(&a4[i], &b4[i]), "VectorDot4DArray should match VectorDot4D exactly");
+            Assert(mag4[i] == VectorMagnitude4D(&a4[i]), "VectorMagnitude4DArray should match VectorMagnitude4D exactly");
+        }
+
+        Vec3A norm3[count], cross3[count];
+        float dot3[count], mag3[count];
+        VectorNormalize3AArray(a3, norm3, count);
+        VectorCross3AArray(a3, b3, cross3, count);
+        VectorDot3AArray(a3, b3, dot3, count);
+        VectorMagnitude3AArray(a3, mag3, count);
+        for (int i = 0; i < count; ++i) {
+            Vec3 u = vmath::ToVec3(a3[i]);
+            Vec3 v = vmath::ToVec3(b3[i]);
+            Vec3 expected = VectorNormalize(u);
+            Assert(norm3[i].x == expected.x && norm3[i].y == expected.y && norm3[i].z == expected.z && norm3[i].pad == 0.0f, "VectorNormalize3AArray should match VectorNormalize and ignore pad");
+            expected = VectorCross(u, v);
+            Assert(cross3[i].x == expected.x && cross3[i].y == expected.y && cross3[i].z == expected.z && cross3[i].pad == 0.0f, "VectorCross3AArray should match VectorCross");
+            Assert(dot3[i] == VectorDot(u, v), "VectorDot3AArray should match VectorDot and ignore pad");
+            Assert(mag3[i] == VectorMagnitude(u), "VectorMagnitude3AArray should match VectorMagnitude and ignore pad");
+        }
+
+        //In place, and through the Vec3 conversion
+        Vec3A moved[count];
+        VectorToVec3AArray(v3, moved, count);
+        VectorScale3AArray(moved, 0.5f, moved, count);
+        VectorNormalize3AArray(moved, moved, count);
+        Vec3 back[count];
+        VectorFromVec3AArray(moved, back, count);
+        for (int i = 0; i < count; ++i) {
+            Vec3 expected = VectorNormalize(VectorScale(v3[i], 0.5f));
+            Assert(back[i].x == expected.x && back[i].y == expected.y && back[i].z == expected.z, "In-place Vec3A arrays should match the Vec3 functions");
+        }
+    }
+    VectorMathSetSimdLevel(VECTORMATH_SIMD_BEST);
+
+    std::cout << "[PASS] Aligned vector arrays: all checks passed" << endline;
+}
+
+const VectorMathFunctionStats* FindStats(const std::vector<VectorMathFunctionStats>& stats, const char* name) {
+    for (const VectorMathFunctionStats& entry : stats) {
+        if (strcmp(entry.name, name) == 0) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+void TestStats() {
+    std::cout << "Testing instrumentation counters..." << std::endl;
+
+    bool enabled = VectorMathStatsEnabled() != 0;
+    VectorMathResetStats();
+    Assert(VectorMathGetStats(nullptr, 0) == 0, "Nothing should be counted right after a reset");
+
+    const size_t count = 1000;
+    std::vector<Vec2> v(count, { 3.0f, 4.0f });
+    for (int i = 0; i < 3; ++i) {
+        VectorAdd2D({ 1.0f, 2.0f }, { 3.0f, 4.0f });
+    }
+    VectorAdd2DArray(v.data(), v.data(), v.data(), count);
+    VectorAdd2DArray(v.data(), v.data(), v.data(), count);
+
+    size_t total = VectorMathGetStats(nullptr, 0);
+    std::vector<VectorMathFunctionStats> stats(total);
+    Assert(VectorMathGetStats(stats.data(), stats.size()) == total, "Sizing and filling calls should agree");
+    if (enabled) {
+        Assert(total == 2, "Only the called functions should be listed");
+        const VectorMathFunctionStats* add = FindStats(stats, "VectorAdd2D");
+        const VectorMathFunctionStats* array = FindStats(stats, "VectorAdd2DArray");
+        Assert(add != nullptr && add->calls == 3 && add->elements == 3, "Scalar calls should count one element each");
+        Assert(array != nullptr && array->calls == 2 && array->elements == 2 * count, "Array calls should count n elements");
+        Assert(stats[0].ticks >= stats[1].ticks, "Entries should be sorted by time, slowest first");
+
+        VectorMathFunctionStats first;
+        Assert(VectorMathGetStats(&first, 1) == 2 && strcmp(first.name, stats[0].name) == 0, "A short array should get the slowest entries");
+    }
+    else {
+        Assert(total == 0, "Builds without stats should report nothing");
+    }
+
+    //JSON, whole and cut short
+    std::string json(VectorMathGetStatsJson(nullptr, 0), '\0');
+    VectorMathGetStatsJson(&json[0], json.size() + 1);
+    Assert(json.compare(0, 12, enabled ? "{\"enabled\":t" : "{\"enabled\":f") == 0, "JSON should report whether stats are on");
+    Assert(!enabled || json.find("{\"name\":\"VectorAdd2D\",\"calls\":3,\"elements\":3,") != std::string::npos, "JSON should list each function");
+    char small[16];
+    Assert(VectorMathGetStatsJson(small, sizeof(small)) == json.size() && strlen(small) == 15 && json.compare(0, 15, small) == 0, "A short buffer should get a terminated prefix and the full length");
+
+    const char* path = "VectorMathStatsTest.json";
+    Assert(VectorMathWriteStatsJson(path) == 1, "Writing the JSON file should succeed");
+    FILE* file = fopen(path, "rb");
+    std::string written(json.size() + 1, '\0');
+    size_t read = file != nullptr ? fread(&written[0], 1, written.size(), file) : 0;
+    if (file != nullptr) {
+        fclose(file);
+    }
+    remove(path);
+    Assert(read == json.size() && written.compare(0, read, json) == 0, "The file should hold the same JSON");
+    Assert(VectorMathWriteStatsJson(nullptr) == 0, "A null path should fail");
+
+    //An export built on another export is still one call
+    if (enabled) {
+        std::vector<uint32_t> order(count);
+        const char* nested[] = { "VectorNormalize2DArray", "VectorMortonSort2D" };
+        for (int which = 0; which < 2; ++which) {
+            VectorMathResetStats();
+            if (which == 0) {
+                VectorNormalize2DArray(v.data(), v.data(), count);
+            }
+            else {
+                VectorMortonSort2D(v.data(), order.data(), nullptr, count);
+            }
+            stats.resize(VectorMathGetStats(nullptr, 0));
+            VectorMathGetStats(stats.data(), stats.size());
+            uint64_t calls = 0;
+            uint64_t elements = 0;
+            for (const VectorMathFunctionStats& entry : stats) {
+                calls += entry.calls;
+                elements += entry.elements;
+            }
+            Assert(stats.size() == 1 && strcmp(stats[0].name, nested[which]) == 0, "Only the outer export should be listed");
+            Assert(calls == 1 && elements == count, "One call should record one call and n elements");
+        }
+    }
+
+    VectorMathResetStats();
+    Assert(VectorMathGetStats(nullptr, 0) == 0, "Reset should clear the counters");
+
+    std::cout << "[PASS] Instrumentation: all checks passed" << endline;
+}
+
+void TestArrayExpressions() {
+    std::cout << "Testing array expressions..." << std::endl;
+
+    using namespace vmath;
+
+    const size_t count = 257;
+    VecArray2 pos(count);
+    VecArray2 vel(count);
+    unsigned int seed = 2024;
+    for (size_t i = 0; i < count; ++i) {
+        pos[i] = { TestRandom(seed, -100.0f, 100.0f), TestRandom(seed, -100.0f, 100.0f) };
+        vel[i] = { TestRandom(seed, -10.0f, 10.0f), TestRandom(seed, -10.0f, 10.0f) };
+    }
+    VecArray2 start = pos;
+
+    //In place, one pass, same bits as the fused export
+    pos = pos + vel * 0.016f;
+    bool same = pos.size() == count;
+    for (size_t i = 0; i < count; ++i) {
+        same = same && pos[i] == VectorScaleAdd2D(start[i], vel[i], 0.016f);
+    }
+    Assert(same, "pos = pos + vel * dt should match VectorScaleAdd2D");
+
+    pos -= vel * 0.016f;
+    pos *= 2.0f;
+    pos /= 2.0f;
+    same = true;
+    for (size_t i = 0; i < count; ++i) {
+        same = same && pos[i] == (ScaleAdd(start[i], vel[i], 0.016f) - vel[i] * 0.016f) * 2.0f / 2.0f;
+    }
+    Assert(same, "Compound assignment should match the inline operators");
+
+    //Functions, broadcast values and scalar expressions
+    VecArray2 result = ClampMagnitude(Normalize(vel) * 3.0f + Vec2{ 1.0f, 0.0f }, 2.5f);
+    VecArray2 lerped = Clamp(Lerp(start, -vel, 0.25f), -5.0f, 5.0f);
+    VecArray2 scaled = vel * Magnitude(start) / Dot(start, start);
+    std::vector<float> cross(count);
+    EvaluateTo(Cross(start, vel), cross.data());
+    same = result.size() == count && lerped.size() == count;
+    float dotSum = 0.0f;
+    for (size_t i = 0; i < count; ++i) {
+        same = same && result[i] == VectorClampMagnitude2D(VectorAdd2D(VectorScale2D(VectorNormalize2D(vel[i]), 3.0f), { 1.0f, 0.0f }), 2.5f);
+        same = same && lerped[i] == VectorClamp2D(VectorLerp2D(start[i], VectorScale2D(vel[i], -1.0f), 0.25f), -5.0f, 5.0f);
+        same = same && scaled[i] == vel[i] * Magnitude(start[i]) / Dot(start[i], start[i]);
+        same = same && cross[i] == VectorCross2D(start[i], vel[i]);
+        dotSum += Dot(start[i], vel[i]);
+    }
+    Assert(same, "Expression functions should match the exports element for element");
+    Assert(Sum(Dot(start, vel)) == dotSum, "Sum should add the elements in order");
+    Vec2 total = Sum(start - start);
+    Assert(total.x == 0.0f && total.y == 0.0f, "Sum of vectors should add component-wise");
+
+    //Spans over existing memory: C API arrays, read-only inputs
+    Vec3 raw[4] = { { 1.0f, 0.0f, 0.0f }, { 0.0f, 2.0f, 0.0f }, { 0.0f, 0.0f, 3.0f }, { 3.0f, 4.0f, 0.0f } };
+    const Vec3 axis[4] = { { 0.0f, 1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }, { 1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f } };
+    VecSpan3 span(raw, 4);
+    VecSpanT<const Vec3> axes(axis, 4);
+    VecArray3 crossed = Cross(span, axes);
+    span = Normalize(span) + Vec3{ 0.0f, 0.0f, 1.0f };
+    Assert(raw[1] == Vec3{ 0.0f, 1.0f, 1.0f } && raw[3] == Vec3{ 0.6f, 0.8f, 1.0f }, "Assigning to a span should write through to the memory");
+    Assert(crossed.size() == 4 && crossed[0] == Vec3{ 0.0f, 0.0f, 1.0f } && crossed[3] == Vec3{ 4.0f, -3.0f, 0.0f }, "Cross of spans should be element-wise");
+    VecSpan3 copy = span;
+    Assert(copy.data() == raw, "Copying a span should view the same memory");
+    VecArray3 other(4, Vec3{ 1.0f, 1.0f, 1.0f });
+    span = MakeVecSpan(other.data(), other.size());
+    Assert(raw[2] == Vec3{ 1.0f, 1.0f, 1.0f }, "Assigning a span should copy the elements");
+
+    //Assigning to an array of another size resizes it
+    VecArray3 grown;
+    grown = Min(crossed, other) + Max(crossed, other);
+    Assert(grown.size() == 4 && grown[0] == Vec3{ 1.0f, 1.0f, 2.0f }, "Assignment should size the array to the expression");
+
+    std::cout << "[PASS] Array expressions: all checks passed" << endline;
+}
+
+void TestMortonCodes() {
+    std::cout << "Testing Morton codes..." << std::endl;
+
+    Vec2 points2[5] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 0.0f, 1.0f }, { -5.0f, 2.0f }, { NAN, 1.0f } };
+    uint32_t codes2[5];
+    VectorMortonCodes2D(points2, { 0.0f, 0.0f }, { 1.0f, 1.0f }, codes2, 5);
+    Assert(codes2[0] == 0 && codes2[1] == 0x55555555u && codes2[2] == 0xaaaaaaaau, "2D codes should interleave x in the even bits and y in the odd bits");
+    Assert(codes2[3] == 0xaaaaaaaau && codes2[4] == 0xaaaaaaaau, "Points outside the bounds (and NaN) should be clamped");
+
+    Vec3 points3[3] = { { 1.0f, 1.0f, 1.0f }, { 0.0f, 0.0f, 1.0f }, { 0.5f, 0.0f, 0.0f } };
+    uint32_t codes3[3];
+    VectorMortonCodes3D(points3, { 0.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 1.0f }, codes3, 3);
+    Assert(codes3[0] == 0x3fffffffu && codes3[1] == 0x24924924u, "3D codes should use 10 bits per axis");
+    Assert(codes3[2] == 0x01249249u, "Half way along x should set the lower 9 x bits");
+
+    uint32_t flat[2];
+    VectorMortonCodes2D(points2, { 1.0f, 1.0f }, { 1.0f, 1.0f }, flat, 2);
+    Assert(flat[0] == 0 && flat[1] == 0, "Empty bounds should give code 0");
+
+    std::cout << "[PASS] Morton codes: all checks passed" << endline;
+}
+
+void TestMortonSort() {
+    std::cout << "Testing Morton sort and reorder..." << std::endl;
+
+    //Radix sort against std::stable_sort, on one and several threads
+    const size_t count = 100000;
+    unsigned int seed = 99;
+    std::vector<uint32_t> keys(count);
+    for (size_t i = 0; i < count; ++i) {
+        keys[i] = (uint32_t)(TestRandom(seed, 0.0f, 1.0f) * 16777216.0f) * 251u % (i % 2 == 0 ? 1000u : 0xffffffffu);
+    }
+    std::vector<uint32_t> expected(count);
+    for (size_t i = 0; i < count; ++i) {
+        expected[i] = (uint32_t)i;
+    }
+    std::stable_sort(expected.begin(), expected.end(), [&](uint32_t a, uint32_t b) { return keys[a] < keys[b]; });
+
+    size_t threshold = VectorMathGetParallelThreshold();
+    std::vector<uint32_t> permutation(count);
+    for (int threads : { 1, 4 }) {
+        VectorMathSetThreadCount(threads);
+        VectorMathSetParallelThreshold(1000);
+        VectorRadixSortKeys(keys.data(), permutation.data(), count);
+        Assert(permutation == expected, "Radix sort should match a stable sort on any thread count");
+    }
+
+    std::vector<uint32_t> same(count, 7u);
+    VectorRadixSortKeys(same.data(), permutation.data(), count);
+    bool identity = true;
+    for (size_t i = 0; i < count; ++i) {
+        identity = identity && permutation[i] == (uint32_t)i;
+    }
+    Assert(identity, "Equal keys should keep their order");
+
+    //Morton sort: sorted positions follow the curve
+    std::vector<Vec2> positions(count);
+    for (size_t i = 0; i < count; ++i) {
+        positions[i] = { TestRandom(seed, -500.0f, 500.0f), TestRandom(seed, -20.0f, 20.0f) };
+    }
+    std::vector<Vec2> sorted(count);
+    VectorMortonSort2D(positions.data(), permutation.data(), sorted.data(), count);
+    Vec2 boundsMin = positions[0];
+    Vec2 boundsMax = positions[0];
+    for (const Vec2& p : positions) {
+        boundsMin = vmath::Min(boundsMin, p);
+        boundsMax = vmath::Max(boundsMax, p);
+    }
+    std::vector<uint32_t> codes(count);
+    VectorMortonCodes2D(sorted.data(), boundsMin, boundsMax, codes.data(), count);
+    std::vector<bool> seen(count, false);
+    bool valid = true;
+    for (size_t i = 0; i < count; ++i) {
+        valid = valid && permutation[i] < count && !seen[permutation[i]] && sorted[i] == positions[permutation[i]];
+        valid = valid && (i == 0 || codes[i - 1] <= codes[i]);
+        seen[permutation[i] < count ? permutation[i] : 0] = true;
+    }
+    Assert(valid, "VectorMortonSort2D should return a permutation in Morton order");
+
+    std::vector<Vec3> positions3(count);
+    for (size_t i = 0; i < count; ++i) {
+        positions3[i] = { TestRandom(seed, -50.0f, 50.0f), TestRandom(seed, -50.0f, 50.0f), TestRandom(seed, -50.0f, 50.0f) };
+    }
+    std::vector<uint32_t> permutation3(count);
+    VectorMathSetThreadCount(1);
+    VectorMortonSort3D(positions3.data(), permutation3.data(), nullptr, count);
+    std::vector<uint32_t> serial3 = permutation3;
+    VectorMathSetThreadCount(4);
+    VectorMortonSort3D(positions3.data(), permutation3.data(), nullptr, count);
+    Assert(permutation3 == serial3, "VectorMortonSort3D should not depend on the thread count");
+    VectorMathSetParallelThreshold(threshold);
+    VectorMathSetThreadCount(0);
+
+    //Companion arrays
+    const uint32_t order[4] = { 2, 0, 3, 1 };
+    Vec3 v3[4] = { { 0, 0, 0 }, { 1, 1, 1 }, { 2, 2, 2 }, { 3, 3, 3 } };
+    Vec3 out3[4];
+    VectorReorderArray(v3, order, out3, 4);
+    float f[4] = { 10.0f, 11.0f, 12.0f, 13.0f };
+    float outF[4];
+    VectorReorderFloatArray(f, order, outF, 4);
+    Vec2 v2[4] = { { 0, 0 }, { 1, 1 }, { 2, 2 }, { 3, 3 } };
+    Vec2 out2[4];
+    VectorReorder2DArray(v2, order, out2, 4);
+    Assert(out3[0] == v3[2] && out3[3] == v3[1] && outF[1] == 10.0f && outF[2] == 13.0f && out2[0] == v2[2], "Reorder should gather in permutation order");
+    char bytes[4][5] = { "aaaa", "bbbb", "cccc", "dddd" };
+    char outBytes[4][5];
+    VectorReorderElements(bytes, 5, order, outBytes, 4);
+    Mat4 matrices[4] = {};
+    Mat4 outMatrices[4];
+    for (int i = 0; i < 4; ++i) {
+        matrices[i].m[15] = (float)i;
+    }
+    VectorReorderElements(matrices, sizeof(Mat4), order, outMatrices, 4);
+    Assert(strcmp(outBytes[0], "cccc") == 0 && strcmp(outBytes[3], "bbbb") == 0 && outMatrices[2].m[15] == 3.0f, "Reorder should work for any element size");
+
+    std::cout << "[PASS] Morton sort: all checks passed" << endline;
+}
+
+void TestSnapshots() {
+    std::cout << "Testing snapshot files..." << std::endl;
+
+    const char* path = "VectorMathSnapshotTest.bin";
+    const size_t balls = 3;
+    const size_t paddles = 4096;
+    const size_t frames = 100;
+    const float step = 0.001f;
+    VectorMathSnapshotChannel channels[2] = {};
+    strcpy(channels[0].name, "ball");
+    channels[0].components = 2;
+    channels[0].count = (uint32_t)balls;
+    channels[0].encoding = VECTORMATH_SNAPSHOT_RAW;
+    strcpy(channels[1].name, "paddles");
+    channels[1].components = 3;
+    channels[1].count = (uint32_t)paddles;
+    channels[1].encoding = VECTORMATH_SNAPSHOT_DELTA;
+    channels[1].step = step;
+
+    VectorMathSnapshotChannel bad = channels[1];
+    bad.step = 0.0f;
+    Assert(SnapshotWriterCreate(path, &bad, 1, 16) == nullptr, "A delta channel needs a positive step");
+
+    //Small moves, then a jump (int32 changes) and a medium move (int16)
+    unsigned int seed = 5;
+    std::vector<Vec2> ballFrames(frames * balls);
+    std::vector<Vec3> paddleFrames(frames * paddles);
+    for (size_t f = 0; f < frames; ++f) {
+        for (size_t i = 0; i < balls; ++i) {
+            ballFrames[f * balls + i] = { (float)f * 0.5f + (float)i, TestRandom(seed, -10.0f, 10.0f) };
+        }
+        for (size_t i = 0; i < paddles; ++i) {
+            Vec3 previous = f > 0 ? paddleFrames[(f - 1) * paddles + i] : Vec3{ (float)i, 0.0f, -5.0f };
+            float move = f == 40 ? 100.0f : (f == 70 ? 1.0f : 0.01f);
+            paddleFrames[f * paddles + i] = { previous.x, previous.y + TestRandom(seed, -move, move), previous.z };
+        }
+    }
+
+    SnapshotWriter* writer = SnapshotWriterCreate(path, channels, 2, 16);
+    Assert(writer != nullptr, "SnapshotWriterCreate should succeed");
+    bool appended = true;
+    for (size_t f = 0; f < frames; ++f) {
+        appended = appended && SnapshotWriterWrite(writer, 0, (const float*)&ballFrames[f * balls]) == 1;
+        //Paddles skip odd frames 80..90 and keep their previous values
+        if (f < 80 || f > 90 || f % 2 == 0) {
+            appended = appended && SnapshotWriterWrite(writer, 1, (const float*)&paddleFrames[f * paddles]) == 1;
+        }
+        else {
+            for (size_t i = 0; i < paddles; ++i) {
+                paddleFrames[f * paddles + i] = paddleFrames[(f - 1) * paddles + i];
+            }
+        }
+        appended = appended && SnapshotWriterEndFrame(writer) == 1;
+    }
+    Assert(appended && SnapshotWriterFrameCount(writer) == frames, "Every frame should be appended");
+    Assert(SnapshotWriterWrite(writer, 2, (const float*)ballFrames.data()) == 0, "Writing a missing channel should fail");
+    Assert(SnapshotWriterClose(writer) == 1, "SnapshotWriterClose should succeed");
+
+#if !defined(_WIN32)
+    //Once the file stops taking data, Write reports the failure as well
+    SnapshotWriter* full = SnapshotWriterCreate("/dev/full", channels, 2, 1);
+    if (full != nullptr) {
+        bool failed = false;
+        for (size_t f = 0; f < 10000 && !failed; ++f) {
+            failed = SnapshotWriterEndFrame(full) == 0;
+        }
+        Assert(failed && SnapshotWriterWrite(full, 0, (const float*)ballFrames.data()) == 0, "Writing after a failed flush should fail");
+        Assert(SnapshotWriterClose(full) == 0, "Closing a failed writer should fail");
+    }
+#endif
+
+    SnapshotReader* reader = SnapshotReaderOpen(path);
+    Assert(reader != nullptr && SnapshotReaderFrameCount(reader) == frames && SnapshotReaderChannelCount(reader) == 2, "The reader should see every frame and channel");
+    VectorMathSnapshotChannel info;
+    Assert(SnapshotReaderFindChannel(reader, "paddles") == 1 && SnapshotReaderFindChannel(reader, "net") == -1, "Channels should be found by name");
+    Assert(SnapshotReaderGetChannel(reader, 1, &info) == 1 && info.count == paddles && info.step == step, "Channel descriptions should round-trip");
+
+    //Raw frames are used in place, bit for bit
+    bool exact = true;
+    for (size_t f = 0; f < frames; ++f) {
+        const Vec2* ball = (const Vec2*)SnapshotReaderFrameData(reader, 0, f);
+        exact = exact && ball != nullptr && memcmp(ball, &ballFrames[f * balls], balls * sizeof(Vec2)) == 0;
+    }
+    Assert(exact, "Raw frames should read back unchanged");
+    Assert(SnapshotReaderFrameData(reader, 1, 0) == nullptr && SnapshotReaderFrameData(reader, 0, frames) == nullptr, "Delta channels and missing frames have no frame data");
+
+    //Delta frames come back within half a step, across chunk boundaries and
+    //whatever the thread count
+    std::vector<Vec3> decoded(frames * paddles);
+    size_t threshold = VectorMathGetParallelThreshold();
+    VectorMathSetParallelThreshold(1000);
+    VectorMathSetThreadCount(4);
+    Assert(SnapshotReaderRead(reader, 1, 0, frames + 10, (float*)decoded.data()) == frames, "Reads should stop at the last frame");
+    VectorMathSetThreadCount(1);
+    std::vector<Vec3> serial(paddles * 30);
+    Assert(SnapshotReaderRead(reader, 1, 10, 30, (float*)serial.data()) == 30, "A range should be read whole");
+    VectorMathSetThreadCount(0);
+    VectorMathSetParallelThreshold(threshold);
+    bool close = true;
+    for (size_t i = 0; i < frames * paddles; ++i) {
+        close = close && fabs(decoded[i].x - paddleFrames[i].x) <= step && fabs(decoded[i].y - paddleFrames[i].y) <= step && fabs(decoded[i].z - paddleFrames[i].z) <= step;
+    }
+    Assert(close, "Delta frames should be within the quantization step");
+    Assert(memcmp(serial.data(), &decoded[10 * paddles], serial.size() * sizeof(Vec3)) == 0, "Partial reads should match a full read on any thread count");
+    SnapshotReaderClose(reader);
+
+    //A file cut short (no index, partial last chunk) keeps its complete chunks
+    FILE* file = fopen(path, "rb");
+    std::vector<char> bytes;
+    char buffer[65536];
+    size_t read;
+    while (file != nullptr && (read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        bytes.insert(bytes.end(), buffer, buffer + read);
+    }
+    if (file != nullptr) {
+        fclose(file);
+    }
+    file = fopen(path, "wb");
+    if (file != nullptr) {
+        fwrite(bytes.data(), 1, bytes.size() * 3 / 4, file);
+        fclose(file);
+    }
+    reader = SnapshotReaderOpen(path);
+    Assert(reader != nullptr && SnapshotReaderFrameCount(reader) > 0 && SnapshotReaderFrameCount(reader) < frames && SnapshotReaderFrameCount(reader) % 16 == 0, "A cut file should read up to its last complete chunk");
+    std::vector<Vec3> recovered(paddles * 16);
+    Assert(SnapshotReaderRead(reader, 1, 16, 16, (float*)recovered.data()) == 16 && memcmp(recovered.data(), &decoded[16 * paddles], recovered.size() * sizeof(Vec3)) == 0, "Recovered chunks should decode the same");
+    SnapshotReaderClose(reader);
+
+    //A closed file whose first chunk claims 8 frames, with the footer total
+    //patched to match: frames past the short chunk must not be looked up in it
+    uint64_t footer[3];
+    memcpy(footer, &bytes[bytes.size() - 32], sizeof(footer));
+    uint64_t firstChunk;
+    memcpy(&firstChunk, &bytes[(size_t)footer[0]], sizeof(firstChunk));
+    uint32_t shortCount = 8;
+    memcpy(&bytes[(size_t)firstChunk + 4], &shortCount, sizeof(shortCount));
+    footer[2] -= 16 - shortCount;
+    memcpy(&bytes[bytes.size() - 32], footer, sizeof(footer));
+    file = fopen(path, "wb");
+    if (file != nullptr) {
+        fwrite(bytes.data(), 1, bytes.size(), file);
+        fclose(file);
+    }
+    reader = SnapshotReaderOpen(path);
+    Assert(reader != nullptr && SnapshotReaderFrameCount(reader) == shortCount, "A short chunk before the last one should end the file");
+    Assert(SnapshotReaderRead(reader, 1, 0, 64, (float*)decoded.data()) == shortCount, "Reads should stop at the short chunk");
+    const Vec2* lastBall = (const Vec2*)SnapshotReaderFrameData(reader, 0, shortCount - 1);
+    Assert(lastBall != nullptr && memcmp(lastBall, &ballFrames[(shortCount - 1) * balls], balls * sizeof(Vec2)) == 0, "Frames in the short chunk should still read");
+    Assert(SnapshotReaderFrameData(reader, 0, 40) == nullptr, "Frames past the short chunk have no frame data");
+    SnapshotReaderClose(reader);
+
+    file = fopen(path, "wb");
+    if (file != nullptr) {
+        fwrite("not a snapshot", 1, 14, file);
+        fclose(file);
+    }
+    Assert(SnapshotReaderOpen(path) == nullptr && SnapshotReaderOpen("VectorMathMissingSnapshot.bin") == nullptr, "Other files should not open");
+    remove(path);
+
+    std::cout << "[PASS] Snapshots: all checks passed" << endline;
+}
+
+
+void TestReductions() {
+    std::cout << "Testing reductions..." << std::endl;
+
+    //Odd sizes, so partial groups and a partial last block run too
+    const size_t count = 100003;
+    unsigned int seed = 61;
+    std::vector<Vec3> a(count), b(count);
+    for (size_t i = 0; i < count; ++i) {
+        a[i] = { TestRandom(seed, -100.0f, 100.0f), TestRandom(seed, 0.0f, 10.0f), TestRandom(seed, -1.0f, 1.0f) };
+        b[i] = { TestRandom(seed, -1.0f, 1.0f), TestRandom(seed, -1.0f, 1.0f), TestRandom(seed, -1.0f, 1.0f) };
+    }
+    std::vector<Vec2> a2(count);
+    for (size_t i = 0; i < count; ++i) {
+        a2[i] = { a[i].x, a[i].y };
+    }
+
+    //Double references
+    double sum[3] = { 0.0, 0.0, 0.0 };
+    double dot = 0.0;
+    Vec3 boundsMin = a[0], boundsMax = a[0];
+    size_t shortest = 0, longest = 0;
+    for (size_t i = 0; i < count; ++i) {
+        sum[0] += a[i].x;
+        sum[1] += a[i].y;
+        sum[2] += a[i].z;
+        dot += (double)a[i].x * b[i].x + (double)a[i].y * b[i].y + (double)a[i].z * b[i].z;
+        boundsMin = vmath::Min(boundsMin, a[i]);
+        boundsMax = vmath::Max(boundsMax, a[i]);
+        shortest = VectorMagnitude(a[i]) < VectorMagnitude(a[shortest]) ? i : shortest;
+        longest = VectorMagnitude(a[i]) > VectorMagnitude(a[longest]) ? i : longest;
+    }
+
+    Vec3 firstMin{}, firstMax{}, firstSum{}, firstKahan{}, firstCentroid{};
+    float firstDot = 0.0f;
+    VectorMathMagnitudeRange firstRange{};
+    bool first = true;
+    size_t threshold = VectorMathGetParallelThreshold();
+    VectorMathSetParallelThreshold(1000);
+    int levels[] = { VECTORMATH_SIMD_SCALAR, VECTORMATH_SIMD_SSE41, VECTORMATH_SIMD_AVX2, VECTORMATH_SIMD_NEON };
+    for (int level : levels) {
+        if (!VectorMathSetSimdLevel(level)) {
+            continue;
+        }
+        for (int threads : { 1, 4 }) {
+            VectorMathSetThreadCount(threads);
+            Vec3 lo, hi;
+            VectorBoundsArray(a.data(), count, &lo, &hi);
+            Vec3 pairwise = VectorSumArray(a.data(), count, VECTORMATH_SUM_PAIRWISE);
+            Vec3 kahan = VectorSumArray(a.data(), count, VECTORMATH_SUM_KAHAN);
+            Vec3 centroid = VectorCentroidArray(a.data(), count);
+            float dotTotal = VectorDotTotalArray(a.data(), b.data(), count, VECTORMATH_SUM_PAIRWISE);
+            VectorMathMagnitudeRange range;
+            VectorMagnitudeRangeArray(a.data(), count, &range);
+            if (first) {
+                first = false;
+                firstMin = lo;
+                firstMax = hi;
+                firstSum = pairwise;
+                firstKahan = kahan;
+                firstCentroid = centroid;
+                firstDot = dotTotal;
+                firstRange = range;
+            }
+            Assert(lo == firstMin && hi == firstMax && pairwise == firstSum && kahan == firstKahan && centroid == firstCentroid && dotTotal == firstDot,
+                "Reductions should be bit-identical on every SIMD level and thread count");
+            Assert(range.minIndex == firstRange.minIndex && range.maxIndex == firstRange.maxIndex && range.minMagnitude == firstRange.minMagnitude && range.maxMagnitude == firstRange.maxMagnitude,
+                "VectorMagnitudeRangeArray should be bit-identical on every SIMD level and thread count");
+        }
+    }
+    VectorMathSetSimdLevel(VECTORMATH_SIMD_BEST);
+    VectorMathSetThreadCount(0);
+    VectorMathSetParallelThreshold(threshold);
+
+    Assert(firstMin == boundsMin && firstMax == boundsMax, "VectorBoundsArray should match a serial min / max");
+    Assert(std::fabs(firstSum.x - sum[0]) < 1.0 && std::fabs(firstSum.y - sum[1]) < 1.0 && std::fabs(firstSum.z - sum[2]) < 0.1,
+        "Pairwise VectorSumArray should be close to the double sum");
+    //Kahan sums stay within a float rounding of the double sum
+    auto closeToSum = [](float value, double expected) { return std::fabs(value - expected) <= std::fabs(expected) * 1.2e-7 + 1.0e-6; };
+    Assert(closeToSum(firstKahan.x, sum[0]) && closeToSum(firstKahan.y, sum[1]) && closeToSum(firstKahan.z, sum[2]),
+        "Kahan VectorSumArray should match the double sum");
+    Assert(closeToSum(firstCentroid.x, sum[0] / count) && closeToSum(firstCentroid.y, sum[1] / count), "VectorCentroidArray should be the mean");
+    Assert(std::fabs(firstDot - dot) < 0.1, "VectorDotTotalArray should be close to the double dot total");
+    Assert(firstRange.minIndex == shortest && firstRange.maxIndex == longest, "VectorMagnitudeRangeArray should find the shortest and longest vector");
+    Assert(firstRange.minMagnitude == VectorMagnitude(a[shortest]) && firstRange.maxMagnitude == VectorMagnitude(a[longest]), "VectorMagnitudeRangeArray should return the magnitudes");
+
+    //2D matches the 3D x / y
+    Vec2 lo2, hi2;
+    VectorBounds2DArray(a2.data(), count, &lo2, &hi2);
+    Assert(lo2.x == boundsMin.x && lo2.y == boundsMin.y && hi2.x == boundsMax.x && hi2.y == boundsMax.y, "VectorBounds2DArray should match a serial min / max");
+    Vec2 kahan2 = VectorSum2DArray(a2.data(), count, VECTORMATH_SUM_KAHAN);
+    Assert(kahan2.x == firstKahan.x && kahan2.y == firstKahan.y, "VectorSum2DArray should match the VectorSumArray x / y");
+    Assert(VectorDotTotal2DArray(a2.data(), a2.data(), 2, VECTORMATH_SUM_KAHAN) == VectorDot2D(a2[0], a2[0]) + VectorDot2D(a2[1], a2[1]), "VectorDotTotal2DArray should add the dot products");
+
+    //Kahan keeps small values that a plain float sum loses
+    std::vector<Vec2> tiny(50000, Vec2{ 1.0e-4f, 1.0f });
+    tiny[0] = { 1.0e4f, 1.0f };
+    Vec2 tinySum = VectorSum2DArray(tiny.data(), tiny.size(), VECTORMATH_SUM_KAHAN);
+    Assert(std::fabs(tinySum.x - 10005.0f) < 0.002f && tinySum.y == 50000.0f, "Kahan sums should not lose small values");
+
+    //NaN is skipped, ties go to the lower index, empty arrays
+    Vec2 special[] = { { 3.0f, 4.0f }, { NAN, 1.0f }, { 0.0f, -5.0f }, { 1.0f, 0.0f }, { 0.0f, 1.0f } };
+    VectorBounds2DArray(special, 5, &lo2, &hi2);
+    Assert(lo2.x == 0.0f && hi2.x == 3.0f && lo2.y == -5.0f && hi2.y == 4.0f, "Bounds should skip NaN");
+    VectorMathMagnitudeRange range2;
+    VectorMagnitudeRange2DArray(special, 5, &range2);
+    Assert(range2.minIndex == 3 && range2.maxIndex == 0 && range2.minMagnitude == 1.0f && range2.maxMagnitude == 5.0f, "Magnitude range ties should go to the lower index and skip NaN");
+    VectorBounds2DArray(special, 0, &lo2, &hi2);
+    Assert(std::isinf(lo2.x) && lo2.x > 0.0f && std::isinf(hi2.y) && hi2.y < 0.0f, "Empty bounds should be +inf / -inf");
+    VectorMagnitudeRange2DArray(special, 0, &range2);
+    Assert(range2.minIndex == SIZE_MAX && range2.maxIndex == SIZE_MAX && range2.maxMagnitude == 0.0f, "An empty magnitude range should have no index");
+    Vec2 centroid2 = VectorCentroid2DArray(special, 0);
+    Assert(centroid2.x == 0.0f && centroid2.y == 0.0f, "The centroid of nothing should be zero");
+
+    std::cout << "[PASS] Reductions: all checks passed" << endline;
+}
+
+void TestCurveEvaluate() {
+    std::cout << "Testing curve evaluation..." << std::endl;
+
+    //19 samples, so the SIMD tails run too
+    const int samples = 19;
+    float t[samples];
+    for (int i = 0; i < samples; ++i) {
+        t[i] = (float)i / (float)(samples - 1);
+    }
+
+    //One Bezier segment against the Bernstein form in double
+    Vec2 bezier[4] = { { 0.0f, 0.0f }, { 1.0f, 2.0f }, { 3.0f, 2.0f }, { 4.0f, 0.0f } };
+    Vec2 out[samples];
+    Assert(VectorCurveEvaluate2D(VECTORMATH_CURVE_BEZIER, bezier, 4, 1, t, samples, out) == 1, "A 4 point Bezier curve should be valid");
+    bool close = true;
+    for (int i = 0; i < samples; ++i) {
+        double u = t[i], s = 1.0 - u;
+        double x = s * s * s * bezier[0].x + 3.0 * s * s * u * bezier[1].x + 3.0 * s * u * u * bezier[2].x + u * u * u * bezier[3].x;
+        double y = s * s * s * bezier[0].y + 3.0 * s * s * u * bezier[1].y + 3.0 * s * u * u * bezier[2].y + u * u * u * bezier[3].y;
+        close = close && std::fabs(out[i].x - x) < 1e-5 && std::fabs(out[i].y - y) < 1e-5;
+    }
+    Assert(close, "VectorCurveEvaluate2D should match the Bernstein form");
+    Assert(out[0] == bezier[0] && out[samples - 1] == bezier[3], "Bezier end points should be exact");
+
+    //Catmull-Rom passes through every point, at t = k / segments
+    Vec3 rail[5] = { { 0.0f, 0.0f, 0.0f }, { 1.0f, 2.0f, 0.5f }, { 3.0f, 2.5f, -1.0f }, { 4.0f, 0.0f, 2.0f }, { 6.0f, 1.0f, 0.0f } };
+    float knots[5] = { 0.0f, 0.25f, 0.5f, 0.75f, 1.0f };
+    Vec3 through[5];
+    VectorCurveEvaluate3D(VECTORMATH_CURVE_CATMULL_ROM, rail, 5, 1, knots, 5, through);
+    bool exact = true;
+    for (int i = 0; i < 5; ++i) {
+        exact = exact && through[i] == rail[i];
+    }
+    Assert(exact, "Catmull-Rom curves should pass through their points");
+
+    //Hermite with matching tangents along a line moves at constant speed
+    Vec2 hermite[4] = { { 0.0f, 1.0f }, { 3.0f, 0.0f }, { 3.0f, 1.0f }, { 3.0f, 0.0f } };
+    float half = 0.5f;
+    Vec2 middle;
+    VectorCurveEvaluate2D(VECTORMATH_CURVE_HERMITE, hermite, 4, 1, &half, 1, &middle);
+    Assert(std::fabs(middle.x - 1.5f) < 1e-6f && middle.y == 1.0f, "A straight Hermite segment should be linear in t");
+
+    //Many curves in one call match one call per curve, on every SIMD level; t is clamped
+    const size_t curves = 7;
+    const size_t perCurve = 7; //two Bezier segments
+    std::vector<Vec3> points(curves * perCurve);
+    unsigned int seed = 5;
+    for (Vec3& p : points) {
+        p = { TestRandom(seed, -10.0f, 10.0f), TestRandom(seed, -10.0f, 10.0f), TestRandom(seed, -10.0f, 10.0f) };
+    }
+    float mixed[samples];
+    for (int i = 0; i < samples; ++i) {
+        mixed[i] = TestRandom(seed, -0.2f, 1.2f);
+    }
+    std::vector<Vec3> reference(curves * samples);
+    Assert(VectorMathSetSimdLevel(VECTORMATH_SIMD_SCALAR) == 1, "The scalar level should always be available");
+    for (size_t c = 0; c < curves; ++c) {
+        VectorCurveEvaluate3D(VECTORMATH_CURVE_BEZIER, &points[c * perCurve], perCurve, 1, mixed, samples, &reference[c * samples]);
+    }
+    int levels[] = { VECTORMATH_SIMD_SCALAR, VECTORMATH_SIMD_SSE41, VECTORMATH_SIMD_AVX2, VECTORMATH_SIMD_NEON };
+    for (int level : levels) {
+        if (!VectorMathSetSimdLevel(level)) {
+            continue;
+        }
+        std::vector<Vec3> all(curves * samples);
+        VectorCurveEvaluate3D(VECTORMATH_CURVE_BEZIER, points.data(), perCurve, curves, mixed, samples, all.data());
+        Assert(all == reference, "Batched curve evaluation should be bit-identical on every SIMD level");
+        std::vector<Vec2> flat(curves * perCurve);
+        for (size_t i = 0; i < flat.size(); ++i) {
+            flat[i] = { points[i].x, points[i].y };
+        }
+        std::vector<Vec2> all2(curves * samples);
+        VectorCurveEvaluate2D(VECTORMATH_CURVE_BEZIER, flat.data(), perCurve, curves, mixed, samples, all2.data());
+        bool same = true;
+        for (size_t i = 0; i < all2.size(); ++i) {
+            same = same && all2[i].x == reference[i].x && all2[i].y == reference[i].y;
+        }
+        Assert(same, "VectorCurveEvaluate2D should match the 3D x / y");
+    }
+    VectorMathSetSimdLevel(VECTORMATH_SIMD_BEST);
+    float clamped[2] = { -5.0f, 5.0f };
+    Vec3 ends[2];
+    VectorCurveEvaluate3D(VECTORMATH_CURVE_BEZIER, points.data(), perCurve, 1, clamped, 2, ends);
+    Assert(ends[0] == points[0] && ends[1] == points[perCurve - 1], "t outside [0, 1] should be clamped");
+
+    //Point counts that do not fit the type
+    Assert(VectorCurveEvaluate2D(VECTORMATH_CURVE_BEZIER, bezier, 3, 1, t, samples, out) == 0, "3 points should not be a Bezier curve");
+    Assert(VectorCurveEvaluate2D(VECTORMATH_CURVE_HERMITE, bezier, 3, 1, t, samples, out) == 0, "Hermite curves need position / tangent pairs");
+    Assert(VectorCurveEvaluate2D(7, bezier, 4, 1, t, samples, out) == 0, "Unknown curve types should be rejected");
+
+    std::cout << "[PASS] Curve evaluation: all checks passed" << endline;
+}
+
+void TestCurveArcLength() {
+    std::cout << "Testing curve arc-length tables..." << std::endl;
+
+    //A straight Bezier with uneven control points: distance sampling undoes the uneven speed
+    Vec2 line[4] = { { 0.0f, 0.0f }, { 0.1f, 0.0f }, { 0.2f, 0.0f }, { 10.0f, 0.0f } };
+    Curve2D* curve = Curve2DCreate(VECTORMATH_CURVE_BEZIER, line, 4, 0);
+    Assert(curve != nullptr, "Curve2DCreate should accept a Bezier segment");
+    Assert(std::fabs(Curve2DLength(curve) - 10.0f) < 1e-4f, "A straight curve should be as long as its chord");
+    float distances[6] = { -1.0f, 0.0f, 2.5f, 5.0f, 10.0f, 20.0f };
+    Vec2 at[6];
+    Curve2DSampleDistance(curve, distances, at, 6);
+    Assert(at[0] == line[0] && at[1] == line[0] && at[4] == line[3] && at[5] == line[3], "Distances should be clamped to the curve");
+    Assert(std::fabs(at[2].x - 2.5f) < 0.02f && std::fabs(at[3].x - 5.0f) < 0.02f, "Distance sampling should move at constant speed");
+    float params[6];
+    Curve2DParameterAtDistance(curve, distances, params, 6);
+    Assert(params[1] == 0.0f && params[4] == 1.0f && params[2] < params[3], "Parameters should run from 0 to 1 with the distance");
+    Vec2 byT[6];
+    Curve2DSample(curve, params, byT, 6);
+    Assert(std::fabs(byT[3].x - at[3].x) < 1e-4f, "Sampling at the parameter should give the distance sample");
+
+    //Update rebuilds the table
+    Vec2 doubled[4] = { { 0.0f, 0.0f }, { 0.2f, 0.0f }, { 0.4f, 0.0f }, { 20.0f, 0.0f } };
+    Curve2DUpdate(curve, doubled);
+    Assert(std::fabs(Curve2DLength(curve) - 20.0f) < 2e-4f, "Curve2DUpdate should rebuild the arc-length table");
+    Curve2DDestroy(curve);
+
+    //Quarter circle: the usual Bezier approximation is within 0.03% of pi / 2
+    const float k = 0.5522847f;
+    Vec2 arc[4] = { { 1.0f, 0.0f }, { 1.0f, k }, { k, 1.0f }, { 0.0f, 1.0f } };
+    curve = Curve2DCreate(VECTORMATH_CURVE_BEZIER, arc, 4, 64);
+    Assert(std::fabs(Curve2DLength(curve) - 1.5707963f) < 1e-3f, "The quarter circle should be pi / 2 long");
+    Curve2DDestroy(curve);
+
+    Assert(Curve2DCreate(VECTORMATH_CURVE_HERMITE, line, 3, 0) == nullptr, "Curve2DCreate should reject a point count that does not fit");
+    Assert(Curve2DLength(nullptr) == 0.0f, "A null curve should have no length");
+
+    //Even spacing along a 3D rail, the same on any thread count
+    Vec3 rail[6] = { { 0.0f, 0.0f, 0.0f }, { 5.0f, 1.0f, 0.0f }, { 6.0f, 6.0f, 2.0f }, { 2.0f, 9.0f, 4.0f }, { -3.0f, 7.0f, 4.0f }, { -4.0f, 2.0f, 1.0f } };
+    Curve3D* curve3 = Curve3DCreate(VECTORMATH_CURVE_CATMULL_ROM, rail, 6, 0);
+    float length = Curve3DLength(curve3);
+    const size_t count = 5000;
+    std::vector<float> spaced(count);
+    for (size_t i = 0; i < count; ++i) {
+        spaced[i] = length * (float)i / (float)(count - 1);
+    }
+    size_t threshold = VectorMathGetParallelThreshold();
+    VectorMathSetParallelThreshold(1000);
+    std::vector<Vec3> serial(count), parallel(count);
+    VectorMathSetThreadCount(1);
+    Curve3DSampleDistance(curve3, spaced.data(), serial.data(), count);
+    VectorMathSetThreadCount(4);
+    Curve3DSampleDistance(curve3, spaced.data(), parallel.data(), count);
+    VectorMathSetThreadCount(0);
+    VectorMathSetParallelThreshold(threshold);
+    Assert(serial == parallel, "Curve3DSampleDistance should not depend on the thread count");
+    float step = length / (float)(count - 1);
+    bool even = serial[0] == rail[0] && serial[count - 1] == rail[5];
+    for (size_t i = 1; i < count; ++i) {
+        float gap = VectorMagnitude(VectorSubtract(serial[i], serial[i - 1]));
+        even = even && std::fabs(gap - step) < step * 0.02f;
+    }
+    Assert(even, "Distance samples should be evenly spaced along the curve");
+    Curve3DDestroy(curve3);
+
+    std::cout << "[PASS] Curve arc length: all checks passed" << endline;
+}
+
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--no-pause") {
+            g_pauseOnExit = false;
+        }
+    }
+
     std::cout << "=== Vector 3 Math Tests ===" << std::endl << std::endl;
 
     // ===== Vector3 Basic =====
@@ -685,9 +3117,119 @@ int main() {
     TestVectorClamp2D();
     TestVectorClamp2DEdgeCase();
 
+    std::cout << "=== Batch Tests ===" << std::endl << std::endl;
+
+    TestVectorAdd2DBatch();
+    TestVectorScaleBatchInPlace();
+    TestVectorNormalize2DArray();
+    TestVectorReflectArray();
+    TestVectorClampMagnitudeBatch();
+    TestSimdLevelsMatchScalar();
+    TestSimdArraysMatchScalar();
+
+    std::cout << "=== Inline C++ Layer Tests ===" << std::endl << std::endl;
+
+    TestInlineOperators();
+    TestInlineDoubleVectors();
+
+    std::cout << "=== Fast Normalize Tests ===" << std::endl << std::endl;
+
+    TestVectorNormalizeFast();
+    TestNormalizePrecisionSwitch();
+
+    std::cout << "=== Matrix & Quaternion Tests ===" << std::endl << std::endl;
+
+    TestMat4InverseMultiply();
+    TestQuatRotateAndTRS();
+    TestMat4TransformPoints();
+
+    std::cout << "=== Physics Integration Tests ===" << std::endl << std::endl;
+
+    TestIntegrateBodies2D();
+    TestIntegrateBodiesVerlet();
+
+    std::cout << "=== Collision Response Tests ===" << std::endl << std::endl;
+
+    TestReflectResponse2DBatch();
+    TestReflectResponseArray();
+
+    std::cout << "=== Threading Tests ===" << std::endl << std::endl;
+
+    TestParallelFor();
+    TestParallelBatchMatchesSerial();
+
+    std::cout << "=== Spatial Grid Tests ===" << std::endl << std::endl;
+
+    TestSpatialGridQueries();
+    TestSpatialGridPairsAndUpdate();
+
+    std::cout << "=== BVH Tests ===" << std::endl << std::endl;
+
+    TestBvhRaycast();
+    TestBvhOverlap();
+
+    std::cout << "=== Swept Collision Tests ===" << std::endl << std::endl;
+
+    TestSweptCollision();
+    TestSweptCollisionArrays();
+
+    std::cout << "=== Frame Arena Tests ===" << std::endl << std::endl;
+
+    TestFrameArena();
+
+    std::cout << "=== Fused Operation Tests ===" << std::endl << std::endl;
+
+    TestFusedOperations();
+    TestFusedBatchLevels();
+
+    std::cout << "=== Determinism Tests ===" << std::endl << std::endl;
+
+    TestPortableMath();
+    TestFixedPoint();
+    TestDeterminismGoldenHash();
+
+    std::cout << "=== Precision Tests ===" << std::endl << std::endl;
+
+    TestDoublePrecision();
+    TestHalfConversion();
+    TestConversionLevels();
+
+    std::cout << "=== Aligned Vector Tests ===" << std::endl << std::endl;
+
+    TestAlignedVectors();
+    TestAlignedArrayLevels();
+
+    std::cout << "=== Instrumentation Tests ===" << std::endl << std::endl;
+
+    TestStats();
+
+    std::cout << "=== Array Expression Tests ===" << std::endl << std::endl;
+
+    TestArrayExpressions();
+
+    std::cout << "=== Spatial Sorting Tests ===" << std::endl << std::endl;
+
+    TestMortonCodes();
+    TestMortonSort();
+
+    std::cout << "=== Snapshot Tests ===" << std::endl << std::endl;
+
+    TestSnapshots();
+
+    std::cout << "=== Reduction Tests ===" << std::endl << std::endl;
+
+    TestReductions();
+
+    std::cout << "=== Curve Tests ===" << std::endl << std::endl;
+
+    TestCurveEvaluate();
+    TestCurveArcLength();
+
     std::cout << std::endl << "All tests passed!" << std::endl;
-    std::cout << "\nPress Enter to exit..." << std::endl;
-    std::cin.get();
+    if (g_pauseOnExit) {
+        std::cout << "\nPress Enter to exit..." << std::endl;
+        std::cin.get();
+    }
 
     return 0;
 }